@@ -0,0 +1,101 @@
+// 小对象分配 / 释放的耗时，对比 slab 与直通 libc 两种后端 (py_mem)
+//
+// 构建: cmake -DLLVMPY_BUILD_BENCHMARKS=ON ... && cmake --build . --target alloc_bench
+// 运行: ./alloc_bench [对象个数，默认 1000000]
+#include "RunTime/runtime.h"
+#include "TypeIDs.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+static double now_seconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// 短命的临时整数: 每次创建后立即释放
+static void churn_ints(int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        PyObject* value = py_create_int(i);
+        py_decref(value);
+    }
+}
+
+// n 个 (str, float) 元组组成的列表，构建后整体释放
+static void build_records(int n)
+{
+    PyObject* list = py_create_list(n, llvmpy::PY_TYPE_ANY);
+    for (int i = 0; i < n; i++)
+    {
+        PyObject* name = py_create_string("record");
+        PyObject* score = py_create_double(i * 0.5);
+        PyObject* tuple = py_create_tuple(2);
+        py_tuple_set_item(tuple, 0, name);
+        py_tuple_set_item(tuple, 1, score);
+        py_list_append(list, tuple);
+        py_decref(name);
+        py_decref(score);
+        py_decref(tuple);
+    }
+    py_decref(list);
+}
+
+// 小字典反复插入: 条目数组从 8 个槽位扩容
+static void churn_dicts(int n)
+{
+    for (int i = 0; i < n / 8; i++)
+    {
+        PyObject* dict = py_create_dict(0, llvmpy::PY_TYPE_INT);
+        for (int k = 0; k < 8; k++)
+        {
+            PyObject* key = py_create_int(k);
+            py_dict_set_item(dict, key, key);
+            py_decref(key);
+        }
+        py_decref(dict);
+    }
+}
+
+static void run(const char* backendName, PyMemBackend backend, int n)
+{
+    if (!py_mem_set_backend(backend))
+    {
+        printf("%-6s unavailable (external allocator linked)\n", backendName);
+        return;
+    }
+
+    struct
+    {
+        const char* name;
+        void (*body)(int);
+    } workloads[] = {{"ints", churn_ints}, {"records", build_records}, {"dicts", churn_dicts}};
+
+    for (auto& workload : workloads)
+    {
+        // 先用少量对象预热: 新建 arena、libc 合并上一轮释放的空闲块等一次性开销不计入
+        workload.body(n / 100 > 8 ? n / 100 : 8);
+        double start = now_seconds();
+        workload.body(n);
+        double elapsed = now_seconds() - start;
+        printf("%-6s %-8s n=%d  %8.2f ms\n", backendName, workload.name, n, elapsed * 1e3);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (n <= 0)
+    {
+        fprintf(stderr, "usage: %s [n > 0]\n", argv[0]);
+        return 1;
+    }
+    py_initialize_builtin_type_methods();  // 字典的键需要哈希方法
+    run("malloc", PY_MEM_BACKEND_PASSTHROUGH, n);
+    run("slab", PY_MEM_BACKEND_SLAB, n);
+    return 0;
+}
@@ -0,0 +1,77 @@
+// 释放大型嵌套结构的耗时 (py_decref 的延迟释放栈)
+//
+// 构建: cmake -DLLVMPY_BUILD_BENCHMARKS=ON ... && cmake --build . --target teardown_bench
+// 运行: ./teardown_bench [元素个数，默认 1000000]
+#include "RunTime/runtime.h"
+#include "TypeIDs.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+static double now_seconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// [n-1, [n-2, ... [0, []]]]: 每层列表持有下一层的唯一引用
+static PyObject* build_chain(int n)
+{
+    PyObject* node = py_create_list(0, llvmpy::PY_TYPE_ANY);
+    for (int i = 0; i < n; i++)
+    {
+        PyObject* outer = py_create_list(2, llvmpy::PY_TYPE_ANY);
+        PyObject* value = py_create_int(i);
+        py_list_append(outer, value);
+        py_list_append(outer, node);
+        py_decref(value);
+        py_decref(node);
+        node = outer;
+    }
+    return node;
+}
+
+// n 个 (i, [i]) 元组组成的列表: 宽而浅
+static PyObject* build_wide(int n)
+{
+    PyObject* list = py_create_list(n, llvmpy::PY_TYPE_ANY);
+    for (int i = 0; i < n; i++)
+    {
+        PyObject* value = py_create_int(i);
+        PyObject* inner = py_create_list(1, llvmpy::PY_TYPE_ANY);
+        py_list_append(inner, value);
+        PyObject* tuple = py_create_tuple(2);
+        py_tuple_set_item(tuple, 0, value);
+        py_tuple_set_item(tuple, 1, inner);
+        py_list_append(list, tuple);
+        py_decref(value);
+        py_decref(inner);
+        py_decref(tuple);
+    }
+    return list;
+}
+
+static void run(const char* name, PyObject* (*build)(int), int n)
+{
+    double start = now_seconds();
+    PyObject* root = build(n);
+    double built = now_seconds();
+    py_decref(root);
+    double released = now_seconds();
+    printf("%-6s n=%d  build %8.2f ms  teardown %8.2f ms\n", name, n, (built - start) * 1e3, (released - built) * 1e3);
+}
+
+int main(int argc, char** argv)
+{
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    if (n <= 0)
+    {
+        fprintf(stderr, "usage: %s [n > 0]\n", argv[0]);
+        return 1;
+    }
+    run("chain", build_chain, n);
+    run("wide", build_wide, n);
+    return 0;
+}
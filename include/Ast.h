@@ -21,6 +21,7 @@ class PyType;
 #include <optional>
 #include <unordered_map>
 #include <functional>
+#include <algorithm>
 //#include <typeindex>
 #include <utility>  // For std::pair
 
@@ -64,12 +65,17 @@ enum class ASTKind
     CallExpr,         ///< 函数调用表达式节点
     ListExpr,         ///< 列表字面量表达式节点
     IndexExpr,        ///< 索引访问表达式节点 (如 a[0])
+    SliceExpr,        ///< 切片表达式节点 (如 a[1:3])
+    ListCompExpr,     ///< 列表推导式节点 (如 [x * x for x in a if x])
     IndexAssignStmt,  ///< 索引赋值语句节点 (如 a[0] = 1)
     BoolExpr,         ///< 布尔字面量表达式节点 (True, False)
     NoneExpr,         ///< None 字面量表达式节点
     DictExpr,         ///< 字典字面量表达式节点
     FunctionDefStmt,  ///< 函数定义语句节点包装
     ForStmt,          ///< for 循环语句节点
+    TupleExpr,        ///< 元组字面量表达式节点 (如 (1, 2) 或 return a, b)
+    SetExpr,          ///< 集合字面量表达式节点 (如 {1, 2})
+    UnpackAssignStmt, ///< 解包赋值语句节点 (如 x, y = t)
     Unknown           ///< 未知或错误节点类型
 };
 
@@ -711,6 +717,70 @@ public:
     }
 };
 
+/**
+ * @brief 元组字面量表达式节点 (例如 (1, "a")、(x,) 或 return a, b 中的 a, b)。
+ *
+ * 元组的元素类型不做静态跟踪，表达式类型为 any，运行时通过类型分派访问。
+ */
+class TupleExprAST : public ExprASTBase<TupleExprAST, ASTKind::TupleExpr>
+{
+    std::vector<std::unique_ptr<ExprAST>> elements;  ///< 元组元素。
+
+public:
+    /** @brief 构造函数。*/
+    TupleExprAST(std::vector<std::unique_ptr<ExprAST>> elems)
+        : elements(std::move(elems))
+    {
+        setHeapAllocation(true);  // 元组对象总是在堆上分配
+    }
+
+    /** @brief 获取元组元素。*/
+    const std::vector<std::unique_ptr<ExprAST>>& getElements() const
+    {
+        return elements;
+    }
+    /** @brief 获取元组类型 (any)。*/
+    std::shared_ptr<PyType> getType() const override;
+
+    /** @brief 新创建的元组对象不需要复制。*/
+    bool needsCopy() const override
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief 集合字面量表达式节点 (例如 {1, 2, 3})。空集合只能写作 set()。
+ *
+ * 与元组相同，元素类型不做静态跟踪，表达式类型为 any。
+ */
+class SetExprAST : public ExprASTBase<SetExprAST, ASTKind::SetExpr>
+{
+    std::vector<std::unique_ptr<ExprAST>> elements;  ///< 集合元素 (可能有重复，运行时去重)。
+
+public:
+    /** @brief 构造函数。*/
+    SetExprAST(std::vector<std::unique_ptr<ExprAST>> elems)
+        : elements(std::move(elems))
+    {
+        setHeapAllocation(true);
+    }
+
+    /** @brief 获取集合元素。*/
+    const std::vector<std::unique_ptr<ExprAST>>& getElements() const
+    {
+        return elements;
+    }
+    /** @brief 获取集合类型 (any)。*/
+    std::shared_ptr<PyType> getType() const override;
+
+    /** @brief 新创建的集合对象不需要复制。*/
+    bool needsCopy() const override
+    {
+        return false;
+    }
+};
+
 /**
  * @brief 字典字面量表达式节点 (例如 {"a": 1, "b": 2})。
  */
@@ -793,6 +863,110 @@ public:
     }
 };
 
+/**
+ * @brief 切片表达式节点 (例如 a[1:3]、s[::-1])。
+ *
+ * start/stop/step 均可省略 (为空)。列表切片的结果仍是同元素类型的列表，字符串切片仍是字符串。
+ */
+class SliceExprAST : public ExprASTBase<SliceExprAST, ASTKind::SliceExpr>
+{
+    std::unique_ptr<ExprAST> target;  ///< 被切片的序列。
+    std::unique_ptr<ExprAST> start;   ///< 起始下标 (可为空)。
+    std::unique_ptr<ExprAST> stop;    ///< 结束下标 (可为空)。
+    std::unique_ptr<ExprAST> step;    ///< 步长 (可为空)。
+
+public:
+    /** @brief 构造函数。*/
+    SliceExprAST(std::unique_ptr<ExprAST> target, std::unique_ptr<ExprAST> start,
+                 std::unique_ptr<ExprAST> stop, std::unique_ptr<ExprAST> step)
+        : target(std::move(target)), start(std::move(start)), stop(std::move(stop)), step(std::move(step))
+    {
+        setHeapAllocation(true);
+    }
+
+    /** @brief 获取目标序列。*/
+    const ExprAST* getTarget() const
+    {
+        return target.get();
+    }
+    /** @brief 获取起始下标 (可能为 nullptr)。*/
+    const ExprAST* getStart() const
+    {
+        return start.get();
+    }
+    /** @brief 获取结束下标 (可能为 nullptr)。*/
+    const ExprAST* getStop() const
+    {
+        return stop.get();
+    }
+    /** @brief 获取步长 (可能为 nullptr)。*/
+    const ExprAST* getStep() const
+    {
+        return step.get();
+    }
+    /** @brief 获取切片结果的类型 (与目标序列相同，无法确定时为 any)。*/
+    std::shared_ptr<PyType> getType() const override;
+};
+
+/**
+ * @brief 列表推导式节点 ([element for var in iterable if condition])。
+ *
+ * 只支持单个 for 子句和可选的单个 if 子句。循环变量只在推导式内部可见。
+ */
+class ListCompExprAST : public ExprASTBase<ListCompExprAST, ASTKind::ListCompExpr>
+{
+    std::unique_ptr<ExprAST> element;    ///< 每次迭代产生的元素。
+    std::string varName;                 ///< 循环变量名。
+    std::unique_ptr<ExprAST> iterable;   ///< 被迭代的对象。
+    std::unique_ptr<ExprAST> condition;  ///< 过滤条件 (可为空)。
+    /** @brief 代码生成时推断出的结果类型。*/
+    mutable std::shared_ptr<PyType> cachedType;
+
+public:
+    /** @brief 构造函数。*/
+    ListCompExprAST(std::unique_ptr<ExprAST> element, std::string varName,
+                    std::unique_ptr<ExprAST> iterable, std::unique_ptr<ExprAST> condition)
+        : element(std::move(element)), varName(std::move(varName)),
+          iterable(std::move(iterable)), condition(std::move(condition))
+    {
+        setHeapAllocation(true);
+    }
+
+    /** @brief 获取元素表达式。*/
+    const ExprAST* getElement() const
+    {
+        return element.get();
+    }
+    /** @brief 获取循环变量名。*/
+    const std::string& getVarName() const
+    {
+        return varName;
+    }
+    /** @brief 获取被迭代的对象。*/
+    const ExprAST* getIterable() const
+    {
+        return iterable.get();
+    }
+    /** @brief 获取过滤条件 (可能为 nullptr)。*/
+    const ExprAST* getCondition() const
+    {
+        return condition.get();
+    }
+    /** @brief 获取结果类型 (代码生成前为 list[any])。*/
+    std::shared_ptr<PyType> getType() const override;
+
+    /** @brief 设置推断出的结果类型 (由代码生成调用)。*/
+    void setType(std::shared_ptr<PyType> type)
+    {
+        cachedType = type;
+    }
+    /** @brief 新创建的列表不需要复制。*/
+    bool needsCopy() const override
+    {
+        return false;
+    }
+};
+
 // ======================== 具体语句类 ========================
 
 /**
@@ -1131,7 +1305,7 @@ class AssignStmtAST : public StmtASTBase<AssignStmtAST, ASTKind::AssignStmt>
 {
     std::string name;                ///< 被赋值的变量名。
     std::unique_ptr<ExprAST> value;  ///< 赋值表达式。
-    // @note 不支持多重赋值 (a = b = 1) 或解包赋值 (x, y = t)。
+    // @note 不支持多重赋值 (a = b = 1)，解包赋值 (x, y = t) 见 UnpackAssignStmtAST。
 
 public:
     /** @brief 默认构造函数，用于工厂创建。*/
@@ -1156,6 +1330,34 @@ public:
     }
 };
 
+/**
+ * @brief 解包赋值语句节点 (例如 x, y = t 或 a, b = b, a)。
+ * 右侧先完整求值，再按顺序赋给各个目标变量。
+ */
+class UnpackAssignStmtAST : public StmtASTBase<UnpackAssignStmtAST, ASTKind::UnpackAssignStmt>
+{
+    std::vector<std::string> targets;  ///< 目标变量名 (按从左到右的顺序)。
+    std::unique_ptr<ExprAST> value;    ///< 被解包的表达式。
+
+public:
+    /** @brief 构造函数。*/
+    UnpackAssignStmtAST(std::vector<std::string> targets, std::unique_ptr<ExprAST> value)
+        : targets(std::move(targets)), value(std::move(value))
+    {
+    }
+
+    /** @brief 获取目标变量名列表。*/
+    const std::vector<std::string>& getTargets() const
+    {
+        return targets;
+    }
+    /** @brief 获取被解包的表达式。*/
+    const ExprAST* getValue() const
+    {
+        return value.get();
+    }
+};
+
 /**
  * @brief pass 语句节点。
  * 表示一个空操作。
@@ -1512,7 +1714,7 @@ public:
  */
 class ForStmtAST : public StmtASTBase<ForStmtAST, ASTKind::ForStmt>
 {
-    std::string loopVariable;                            ///< 循环变量名。
+    std::vector<std::string> loopVariables;              ///< 循环变量名 (for k, v in ... 时有多个，逐项解包)。
     std::unique_ptr<ExprAST> iterableExpr;               ///< 可迭代对象表达式。
     std::vector<std::unique_ptr<StmtAST>> body;          ///< 循环体语句块。
     std::unique_ptr<StmtAST> elseStmt;                   ///< 可选的 else 子句语句块。
@@ -1523,17 +1725,44 @@ public:
                std::unique_ptr<ExprAST> iterExpr,
                std::vector<std::unique_ptr<StmtAST>> loopBody,
                std::unique_ptr<StmtAST> elseS = nullptr)
-        : loopVariable(varName),
+        : ForStmtAST(std::vector<std::string>{varName}, std::move(iterExpr), std::move(loopBody), std::move(elseS))
+    {
+    }
+
+    /** @brief 构造函数 (解包形式的循环变量)。*/
+    ForStmtAST(std::vector<std::string> varNames,
+               std::unique_ptr<ExprAST> iterExpr,
+               std::vector<std::unique_ptr<StmtAST>> loopBody,
+               std::unique_ptr<StmtAST> elseS = nullptr)
+        : loopVariables(std::move(varNames)),
           iterableExpr(std::move(iterExpr)),
           body(std::move(loopBody)),
           elseStmt(std::move(elseS))
     {
     }
 
-    /** @brief 获取循环变量名。*/
+    /** @brief 获取 (第一个) 循环变量名。*/
     const std::string& getLoopVariable() const
     {
-        return loopVariable;
+        return loopVariables.front();
+    }
+
+    /** @brief 获取全部循环变量名 (按从左到右的顺序)。*/
+    const std::vector<std::string>& getLoopVariables() const
+    {
+        return loopVariables;
+    }
+
+    /** @brief 循环变量是否为解包形式 (for k, v in ...)。*/
+    bool isUnpacking() const
+    {
+        return loopVariables.size() > 1;
+    }
+
+    /** @brief name 是否为循环变量之一。*/
+    bool bindsLoopVariable(const std::string& name) const
+    {
+        return std::find(loopVariables.begin(), loopVariables.end(), name) != loopVariables.end();
     }
 
     /** @brief 获取可迭代对象表达式。*/
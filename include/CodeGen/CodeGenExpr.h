@@ -51,15 +51,49 @@ private:
     // 处理函数调用表达式
     llvm::Value* handleCallExpr(CallExprAST* expr);
 
+    // 内置函数 (len/sum/min/max/any/all, vec_add/vec_sub/vec_mul/vec_div)
+    bool isBuiltinFunction(const std::string& name) const;
+    llvm::Value* handleBuiltinCall(const std::string& name, CallExprAST* expr);
+
     // 处理列表表达式
     llvm::Value* handleListExpr(ListExprAST* expr);
+    llvm::Value* handleTupleExpr(TupleExprAST* expr);
+    llvm::Value* handleSetExpr(SetExprAST* expr);
+
+    // 键值全是常量的字典字面量: 首次执行时构建模板 (之后不再释放)，每次求值复制模板
+    llvm::Value* createDictFromTemplate(DictExprAST* expr, ObjectType* keyType);
 
     // 处理索引表达式
     llvm::Value* handleIndexExpr(IndexExprAST* expr);
+    // 静态类型为 list[...][int] 的下标: 内联读取，失败时退回 py_list_get_item
+    llvm::Value* handleListIndexInline(IndexExprAST* expr, llvm::Value* list, llvm::Value* index);
+    llvm::Value* handleSliceExpr(SliceExprAST* expr);
+
+    // 处理列表推导式
+    llvm::Value* handleListCompExpr(ListCompExprAST* expr);
 
     // 初始化表达式处理器
     static void initializeHandlers();
 
+public:
+    /**
+     * @brief `while i < len(a)` 循环体内已知的下标事实。
+     *
+     * 由 CodeGenStmt 在条件块中计算: 进入循环体时 a 是列表，且 i 为满足 0 <= i < len(a) 的 int。
+     * 只在 i 与 a 都未被重新赋值的语句中有效 (列表不会原地缩短)，此时 a[i] 跳过下标解码与边界检查。
+     */
+    struct ListBoundsFact
+    {
+        llvm::Value* listStorage = nullptr;   ///< a 的 alloca
+        llvm::Value* indexStorage = nullptr;  ///< i 的 alloca
+        llvm::Value* inRange = nullptr;       ///< i1，条件块中计算
+        llvm::Value* index64 = nullptr;       ///< i 的 int64 值
+        llvm::Function* function = nullptr;  ///< 事实所属的函数 (嵌套函数中不适用)
+    };
+
+private:
+    ListBoundsFact listBoundsFact;
+
 public:
     CodeGenExpr(CodeGenBase& cg) : codeGen(cg)
     {
@@ -90,6 +124,20 @@ public:
     // 处理字典表达式
     llvm::Value* handleDictExpr(DictExprAST* expr);
 
+    // 列表下标内联访问: list 是列表且 index 是单 limb 的非负 int 时给出 {inRange (i1), index (i64)}
+    std::pair<llvm::Value*, llvm::Value*> emitListIndexCheck(llvm::Value* list, llvm::Value* index);
+    // 按存储策略读取已确认在界内的元素 (返回新引用)
+    llvm::Value* emitListItemLoad(llvm::Value* list, llvm::Value* index64);
+
+    const ListBoundsFact& getListBoundsFact() const
+    {
+        return listBoundsFact;
+    }
+    void setListBoundsFact(const ListBoundsFact& fact)
+    {
+        listBoundsFact = fact;
+    }
+
     // 字面量创建
     llvm::Value* createIntLiteral(int value);
     llvm::Value* createDoubleLiteral(double value);
@@ -103,8 +151,10 @@ llvm::Value* createDoubleLiteralFromString(const std::string& value);
 
     // 列表操作
     llvm::Value* createList(int size, std::shared_ptr<PyType> elemType);
+    // 一次性构建列表 (py_create_list_from_array)；stealValues 为 true 时列表接管 values 的引用
     llvm::Value* createListWithValues(const std::vector<llvm::Value*>& values,
-                                      std::shared_ptr<PyType> elemType);
+                                      std::shared_ptr<PyType> elemType,
+                                      bool stealValues = false);
     llvm::Value* getListElement(llvm::Value* list, llvm::Value* index,
                                 std::shared_ptr<PyType> listType);
     void setListElement(llvm::Value* list, llvm::Value* index,
@@ -112,10 +162,11 @@ llvm::Value* createDoubleLiteralFromString(const std::string& value);
 
     // 字典操作
     llvm::Value* createDict(ObjectType* keyType, ObjectType* valueType);
+    // 一次性构建预先定好容量的字典 (py_create_dict_from_pairs)；stealValues 为 true 时字典接管键值的引用
     llvm::Value* createDictWithPairs(
             const std::vector<std::pair<llvm::Value*, llvm::Value*>>& pairs,
             ObjectType* keyType,
-            ObjectType* valueType);
+            bool stealValues = false);
     llvm::Value* getDictItem(llvm::Value* dict, llvm::Value* key,
                              std::shared_ptr<PyType> dictType);
     void setDictItem(llvm::Value* dict, llvm::Value* key, llvm::Value* value,
@@ -58,6 +58,7 @@ public:
     llvm::Value* createList(llvm::Value* initialCapacity, llvm::Value* elemTypeIdValue);
     llvm::Value* createIntObjectFromString(llvm::Value* strPtr);
     llvm::Value* createDoubleObjectFromString(llvm::Value* strPtr);
+    llvm::Value* createConstantObject(const char* runtimeFunc, const std::string& text, const char* name);  // 字面量常量 (py_const_*)
     llvm::Value* getListElement(llvm::Value* list, llvm::Value* index);
     void setListElement(llvm::Value* list, llvm::Value* index, llvm::Value* value);
 
@@ -142,8 +143,16 @@ public:
 
     // Added methods
     llvm::Type* getPyObjectPtrType();
+    // 与 runtime_common.h 中的结构布局保持一致，用于在 IR 中直接访问字段
+    llvm::StructType* getPyObjectHeaderType();  // PyObject {refCount, typeId, flags}
+    llvm::StructType* getPyListStructType();    // PyListObject
+    llvm::StructType* getPyDictStructType();    // PyDictObject
+    llvm::StructType* getPyDictEntryType();     // PyDictEntry
+    llvm::StructType* getPyIntObjectType();     // 整数 PyPrimitiveObject (mpz_t 展开)
+    llvm::Value* loadTypeId(llvm::Value* obj, const llvm::Twine& name = "typeid");  // 头中的 16 位 typeId，零扩展为 i32
     // void callDecRef(llvm::Value* obj); // Removed, use decRef
     void callRuntimeError(const std::string& errorType, int line);
+    void callFatalRuntimeError(const std::string& errorType, int line);  // 报告后退出，并结束当前基本块
 };
 
 }  // namespace llvmpy
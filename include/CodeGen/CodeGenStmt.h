@@ -4,6 +4,7 @@
 #include "CodeGen/CodeGenBase.h"
 //#include "Ast.h"
 #include <unordered_map>
+#include <map>
 #include <set>
 #include <memory>
 #include <functional>
@@ -11,6 +12,9 @@
 namespace llvmpy
 {
 
+// 表达式中是否读取了变量 name (未知表达式保守地返回 true)
+bool exprReferencesName(const ExprAST* expr, const std::string& name);
+
 // 语句处理器类型
 using StmtHandlerFunc = std::function<void(CodeGenBase&, StmtAST*)>;
 
@@ -24,6 +28,9 @@ private:
     static std::unordered_map<ASTKind, StmtHandlerFunc> stmtHandlers;
     static bool handlersInitialized;
 
+    // 当前函数中可原地追加的字符串变量 -> 其值是否为该变量独占的追加缓冲区 (i1 alloca)
+    std::map<std::string, llvm::AllocaInst*> stringAppendFlags;
+
     // 处理表达式语句
     void handleExprStmt(ExprStmtAST* stmt);
 
@@ -51,16 +58,39 @@ private:
     void popBreakTarget();
     void pushContinueTarget(llvm::BasicBlock* target);
     void popContinueTarget();
+    // while i < len(a): 在条件块中一次性计算 a[i] 的边界事实 (CodeGenExpr::ListBoundsFact)，
+    // 返回事实保持有效的循环体前缀语句数，不匹配时返回 0
+    size_t emitWhileListBoundsFact(WhileStmtAST* stmt);
 
 
     // 处理for语句 (如果支持)
     void handleForStmt(const ForStmtAST* stmt); // Added ForStmt handler declaration
+    // for i in range(...) 的原生整数循环，不匹配时返回 false
+    bool tryHandleRangeForStmt(const ForStmtAST* stmt);
+    // 可迭代对象静态类型为列表时的下标循环 (不创建迭代器)
+    void handleListForStmt(const ForStmtAST* stmt, llvm::Value* listValue);
+    // for k in d / for k, v in items(d) 等: 直接扫描字典条目数组，不匹配时返回 false
+    bool tryHandleDictForStmt(const ForStmtAST* stmt);
+    // 循环变量的 alloca，首次使用时在入口块创建并初始化为 NULL
+    llvm::AllocaInst* getForLoopVariableSlot(const std::string& loopVarName);
+    void storeForLoopVariable(const std::string& loopVarName, llvm::Value* value);
+    // 把迭代得到的元素 (新引用) 绑定到循环变量，解包形式时按序列拆开
+    void bindForLoopTargets(const ForStmtAST* stmt, llvm::Value* item);
+    void emitForLoopBody(const ForStmtAST* stmt, llvm::BasicBlock* breakBB, llvm::BasicBlock* continueBB);
+    void emitForElse(const ForStmtAST* stmt, llvm::BasicBlock* elseBB, llvm::BasicBlock* endBB);
 
     // 处理print语句
     void handlePrintStmt(PrintStmtAST* stmt);
 
     // 处理变量赋值语句
     void handleAssignStmt(AssignStmtAST* stmt);
+    // x = x + <str> / x += <str> (x 为字符串变量) 时原地追加，不匹配时返回 false
+    bool tryHandleStringAppendAssign(AssignStmtAST* stmt);
+    // 把值绑定到变量 (局部 alloca 或模块级全局变量)，管理新旧值的引用计数
+    bool assignVariable(const std::string& varName, llvm::Value* valueToStore, ObjectType* valueObjType, int line, int col);
+
+    // 处理解包赋值语句 (x, y = value)
+    void handleUnpackAssignStmt(UnpackAssignStmtAST* stmt);
 
     // 处理pass语句
     void handlePassStmt(PassStmtAST* stmt);
@@ -111,6 +141,10 @@ public:
                          llvm::BasicBlock* bodyBlock,
                          llvm::BasicBlock* afterBlock);
 
+    // 函数体开始时找出可原地追加的字符串变量并创建所有权标志，返回外层函数的标志表 (结束时传回)
+    std::map<std::string, llvm::AllocaInst*> beginStringAppendTracking(const FunctionAST* funcAST);
+    void endStringAppendTracking(std::map<std::string, llvm::AllocaInst*> savedFlags);
+
     // 变量声明与赋值
     void declareVariable(const std::string& name,
                          llvm::Value* value,
@@ -74,6 +74,13 @@ public:
     std::shared_ptr<PyType> inferListElementType(
             const std::vector<std::unique_ptr<ExprAST>>& elements);
 
+    // 推导列表推导式的循环变量类型与元素类型 (元素在绑定了循环变量类型的临时作用域中推导)
+    std::shared_ptr<PyType> inferListCompVarType(const ListCompExprAST* expr);
+    std::shared_ptr<PyType> inferListCompElementType(const ListCompExprAST* expr);
+
+    // 表达式是否为未被遮蔽的内置 range(...) 调用 (1 到 3 个参数)
+    bool isBuiltinRangeCall(const ExprAST* expr);
+
     // 获取两个类型的共同超类型
     std::shared_ptr<PyType> getCommonType(
             std::shared_ptr<PyType> typeA,
@@ -0,0 +1,36 @@
+#ifndef CODEGEN_REFCOUNT_ELISION_H
+#define CODEGEN_REFCOUNT_ELISION_H
+
+#include <llvm/IR/Function.h>
+#include <llvm/Pass.h>
+
+namespace llvmpy
+{
+
+/**
+ * @brief 引用计数消除 (在生成的 IR 上运行的函数级 pass)。
+ *
+ * 代码生成保守地插入 py_incref / py_decref (每次赋值、循环变量更新等)。本 pass 在
+ * 直线区域 (基本块及其唯一后继链) 内:
+ *  - 通过只被 load/store 访问的变量槽位 (alloca) 把 load 追溯到最近一次 store 的值；
+ *  - 抵消同一对象上的 incref ... decref (中间没有可能释放对象的调用)；
+ *  - 把 decref 向后下沉，遇到同一对象的 incref 时两者一起删除 (下沉只会推迟释放)；
+ *  - 删除永生对象 (None) 的 incref / decref。
+ */
+class RefCountElisionPass : public llvm::FunctionPass
+{
+public:
+    static char ID;
+
+    RefCountElisionPass();
+
+    bool runOnFunction(llvm::Function& F) override;
+    void getAnalysisUsage(llvm::AnalysisUsage& AU) const override;
+    llvm::StringRef getPassName() const override;
+};
+
+llvm::FunctionPass* createRefCountElisionPass();
+
+}  // namespace llvmpy
+
+#endif  // CODEGEN_REFCOUNT_ELISION_H
@@ -0,0 +1,57 @@
+#ifndef CODEGEN_STACK_PROMOTION_H
+#define CODEGEN_STACK_PROMOTION_H
+
+#include <llvm/IR/Function.h>
+#include <llvm/Pass.h>
+
+namespace llvmpy
+{
+
+/**
+ * @brief 不逃逸临时对象的栈分配 (在生成的 IR 上运行的函数级 pass)。
+ *
+ * 对 py_object_compare / py_object_add / py_create_int 等返回新对象的运行时调用做逃逸分析:
+ * 结果只在同一基本块内作为参数传给不会保留它的运行时函数 (没有 store、ret、PHI、
+ * incref/decref 或未知调用) 时，改为调用对应的 *_into 版本，把对象初始化在入口块的
+ * alloca 中，并在最后一次使用之后插入 py_release_into。
+ */
+class TempStackPromotionPass : public llvm::FunctionPass
+{
+public:
+    static char ID;
+
+    TempStackPromotionPass();
+
+    bool runOnFunction(llvm::Function& F) override;
+    void getAnalysisUsage(llvm::AnalysisUsage& AU) const override;
+    llvm::StringRef getPassName() const override;
+};
+
+llvm::FunctionPass* createTempStackPromotionPass();
+
+/**
+ * @brief 函数作用域的区域分配 (在 TempStackPromotionPass 之后运行)。
+ *
+ * 处理栈分配无法覆盖的临时对象: 结果跨基本块使用，或先存入变量槽位再读取。不在循环中的
+ * 生产者改为在 py_region_alloc_object 分配的槽位上调用 *_into，函数入口 py_region_push、
+ * 每个 ret 之前 py_region_pop 整体释放。通过槽位 / PHI 到达的逃逸点 (ret、store 到非局部
+ * 内存、传给会保留参数的调用) 之前插入 py_region_promote，把区域中的对象复制到堆上。
+ * 在所有路径上都会逃逸的对象 (逃逸点后支配生产者) 和逃逸点位于循环中的对象保持直接在堆上分配。
+ */
+class RegionAllocationPass : public llvm::FunctionPass
+{
+public:
+    static char ID;
+
+    RegionAllocationPass();
+
+    bool runOnFunction(llvm::Function& F) override;
+    void getAnalysisUsage(llvm::AnalysisUsage& AU) const override;
+    llvm::StringRef getPassName() const override;
+};
+
+llvm::FunctionPass* createRegionAllocationPass();
+
+}  // namespace llvmpy
+
+#endif  // CODEGEN_STACK_PROMOTION_H
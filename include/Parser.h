@@ -205,8 +205,11 @@ private:
     std::unique_ptr<ExprAST> parseExpression();
     //std::unique_ptr<ExprAST> parseUnaryExpr();
     std::unique_ptr<ExprAST> parseListExpr();
+    std::unique_ptr<ExprAST> parseListCompTail(std::unique_ptr<ExprAST> element, int line, int column);
     std::unique_ptr<ExprAST> parseIndexExpr(std::unique_ptr<ExprAST> target);
     std::unique_ptr<ExprAST> parseDictExpr(); 
+    std::unique_ptr<ExprAST> parseTupleTail(std::unique_ptr<ExprAST> first, int line, int column);
+    std::unique_ptr<ExprAST> parseSetTail(std::unique_ptr<ExprAST> first, int line, int column);
 
     // 新增：类型检查辅助方法
     bool validateBinaryOp(PyTokenType opType, const std::shared_ptr<PyType>& leftType,
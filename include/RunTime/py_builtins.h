@@ -0,0 +1,56 @@
+// 内置函数
+#ifndef PY_BUILTINS_H
+#define PY_BUILTINS_H
+
+#include "runtime_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 归约内置函数: 参数为可迭代对象，返回新引用 (出错时返回 NULL)。
+// 非装箱存储的列表直接在 int64/double/位图 上计算，其余可迭代对象走 py_iter/py_next 通用路径。
+PyObject* py_builtin_sum(PyObject* iterable);
+PyObject* py_builtin_min(PyObject* iterable);
+PyObject* py_builtin_max(PyObject* iterable);
+PyObject* py_builtin_any(PyObject* iterable);
+PyObject* py_builtin_all(PyObject* iterable);
+
+// 逐元素运算内置函数 (vec_add/vec_sub/vec_mul/vec_div): 操作数为等长列表或 列表与标量，返回新列表。
+// int64/double 非装箱列表使用向量化内核，整数溢出或其他元素类型退回逐元素的 py_object_* 运算。
+PyObject* py_builtin_vec_add(PyObject* a, PyObject* b);
+PyObject* py_builtin_vec_sub(PyObject* a, PyObject* b);
+PyObject* py_builtin_vec_mul(PyObject* a, PyObject* b);
+PyObject* py_builtin_vec_div(PyObject* a, PyObject* b);
+
+// len(x): 字符串/列表/元组/字典/集合的长度，返回新的 int (其他类型报 TypeError 并返回 NULL)。
+PyObject* py_builtin_len(PyObject* obj);
+
+// range(stop) / range(start, stop[, step]): 缺省参数传 NULL，返回惰性 range 对象。
+PyObject* py_builtin_range(PyObject* a, PyObject* b, PyObject* c);
+/**
+ * @brief 按 range() 的规则解析参数 (缺省参数为 NULL)。
+ * 供 `for i in range(...)` 的原生循环使用；参数非法时打印错误并返回 false。
+ */
+bool py_range_unpack(PyObject* a, PyObject* b, PyObject* c, int64_t* start, int64_t* stop, int64_t* step);
+
+// set([iterable]) 直接对应 py_set_from_iterable，set_union 等对应 py_set_* 批量运算。
+// set_add(s, x) / set_discard(s, x) 原地修改集合，返回 None。
+PyObject* py_builtin_set_add(PyObject* set, PyObject* item);
+PyObject* py_builtin_set_discard(PyObject* set, PyObject* item);
+
+// keys(d) / values(d) / items(d): 返回直接遍历字典条目数组的迭代器 (不复制)，items 产出 (key, value) 元组。
+PyObject* py_builtin_dict_keys(PyObject* dict);
+PyObject* py_builtin_dict_values(PyObject* dict);
+PyObject* py_builtin_dict_items(PyObject* dict);
+
+// gc_collect([generation]): 收集到指定代 (缺省为全部)，返回释放的对象个数。
+// gc_set_threshold(t0[, t1[, t2]]): 设置各代阈值，缺省的沿用默认值，t0 为 0 时关闭自动收集。
+PyObject* py_builtin_gc_collect(PyObject* generation);
+PyObject* py_builtin_gc_set_threshold(PyObject* threshold0, PyObject* threshold1, PyObject* threshold2);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif // PY_BUILTINS_H
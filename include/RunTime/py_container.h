@@ -21,19 +21,73 @@ void py_list_decref_items(PyListObject* list);
 PyObject* py_list_get_item_with_type(PyObject* listObj, PyObject* indexObj, int* out_type_id); 
 int py_get_list_element_type_id(PyObject* list);
 
+// 列表存储策略 (非装箱 int/float/bool 存储)
+int py_list_storage_for_type(int elemTypeId);
+size_t py_list_storage_bytes(int storage, int count);
+PyObject* py_list_box_item(PyListObject* list, int index);  // 返回新引用
+bool py_list_despecialize(PyListObject* list);
+bool py_list_reserve(PyListObject* list, int minCapacity);
+bool py_list_store_reserved(PyListObject* list, int index, PyObject* item);  // 写入已预留的槽位 (不转换类型、不扩容)
+// 由 n 个元素一次性构建列表 (只分配一次)；steal 为 true 时接管每个元素的引用
+PyObject* py_create_list_from_array(PyObject** items, int n, int elemTypeId, bool steal);
+void py_list_release_storage(PyListObject* list);  // 释放缓冲区 (含切片视图与旧缓冲区)，不释放列表本身
+PyObject* py_list_share(PyObject* obj);  // 写时复制副本: 与 obj 共享缓冲区，第一次写入时才复制 (返回新引用)
+bool py_list_copy_can_share(PyListObject* list);  // 元素的深度复制与原元素无法区分 (非装箱或不可变)，复制时可以共享缓冲区
+bool py_list_extend_unboxed(PyListObject* dst, PyListObject* src);
+
+// 元组操作 (构造见 py_create_tuple)
+int py_tuple_len(PyObject* obj);
+void py_tuple_set_item(PyObject* tupleObj, int index, PyObject* item);  // 仅用于构造，增加 item 引用计数
+PyObject* py_tuple_get_item(PyObject* tupleObj, PyObject* indexObj);   // 返回新引用
+unsigned int py_tuple_hash(PyObject* obj);                              // 结果缓存在元组中
+PyObject* py_tuple_equals(PyObject* self, PyObject* other);
+bool py_unpack_sequence(PyObject* seq, int count, PyObject** out);     // out 接收 count 个新引用
+
 // 字典操作
 int py_dict_len(PyObject* obj);
 void py_dict_set_item(PyObject* obj, PyObject* key, PyObject* value);
 PyObject* py_dict_get_item(PyObject* obj, PyObject* key);
 PyObject* py_dict_keys(PyObject* obj);
+PyObject* py_dict_iter(PyObject* obj, int kind);  // kind 为 PyDictIterKind，返回新的迭代器
 bool py_dict_resize(PyDictObject* dict);
 PyDictEntry* py_dict_find_entry(PyDictObject* dict, PyObject* key);
 PyObject* py_dict_get_item_with_type(PyObject* dict, PyObject* key, int* out_type_id);
+// 容纳 n 个键且插入后不触发扩容的最小容量 (与 py_dict_set_item 的装载因子一致)
+int py_dict_capacity_for(int n);
+// 由键值对数组 [k0, v0, k1, v1, ...] 一次性构建字典: 条目表按 py_dict_capacity_for(n) 只分配一次，
+// 插入时不检查扩容；steal 为 true 时接管 items 中的引用
+PyObject* py_create_dict_from_pairs(PyObject** items, int n, int keyTypeId, bool steal);
+PyObject* py_dict_clone(PyObject* obj);  // 浅复制: 写时复制，与 obj 共享条目表直到任一方被写入
+bool py_dict_copy_can_share(PyDictObject* dict);     // 键值都不可变，深度复制时可以改用 py_dict_clone
+void py_dict_release_storage(PyDictObject* dict);  // 释放条目表 (含副本借用与旧条目表)，不释放字典本身
+
+// 集合操作 (构造见 py_create_set)，与字典共用哈希探测逻辑
+int py_set_len(PyObject* obj);
+bool py_set_add(PyObject* obj, PyObject* key);      // 返回是否新插入
+bool py_set_discard(PyObject* obj, PyObject* key);  // 元素不存在时不报错
+bool py_set_contains(PyObject* obj, PyObject* key);
+PyObject* py_set_from_iterable(PyObject* iterable);  // iterable 为 NULL 时返回空集合
+// 批量运算: 结果表按最终大小的上界一次性分配; b 可以是任意可迭代对象
+PyObject* py_set_union(PyObject* a, PyObject* b);
+PyObject* py_set_intersection(PyObject* a, PyObject* b);
+PyObject* py_set_difference(PyObject* a, PyObject* b);
+PyObject* py_set_equals(PyObject* self, PyObject* other);
+
+// 容器比较: 列表 / 元组按字典序，字典只比较相等。逐元素比较不分配中间 bool 对象
+int py_object_equal(PyObject* a, PyObject* b);  // a == b: 1 / 0，出错返回 -1
+int py_sequence_compare(PyObject* a, PyObject* b, PyCompareOp op);   // 列表或元组 (两者同类)，1 / 0 / -1
+int py_container_compare(PyObject* a, PyObject* b, PyCompareOp op);  // 同类型的列表 / 元组 / 字典，1 / 0 / -1
+PyObject* py_list_equals(PyObject* self, PyObject* other);
+PyObject* py_dict_equals(PyObject* self, PyObject* other);
+
+// 成员测试: item in container，返回 bool 对象
+PyObject* py_object_contains(PyObject* item, PyObject* container);
 
 // 索引操作
 void py_object_set_index(PyObject* obj, PyObject* index, PyObject* value);// 通用索引赋值
 PyObject* py_object_index(PyObject* obj, PyObject* index);
 PyObject* py_object_index_with_type(PyObject* obj, PyObject* index, int* out_type_id);
+PyObject* py_object_slice(PyObject* obj, PyObject* start, PyObject* stop, PyObject* step);  // start/stop/step 可为 NULL
 //PyObject* py_string_get_char(PyObject* str, int index);
 PyObject* py_string_get_char(PyObject* strObj, PyObject* indexObj); // <-- 新声明
 void py_set_index_result_type(PyObject* result, int typeId);
@@ -12,6 +12,7 @@ extern "C"
 #endif  // __cplusplus
 
     void py_runtime_error(const char* errorType, int line);
+    [[noreturn]] void py_runtime_fatal_error(const char* errorType, int line);  // 报告后退出进程
    
 
 #ifdef __cplusplus
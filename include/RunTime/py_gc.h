@@ -0,0 +1,66 @@
+// 循环垃圾收集 (分代，只跟踪容器对象)
+#ifndef PY_GC_H
+#define PY_GC_H
+
+#include "runtime_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 容器对象之前的 GC 头。
+ *
+ * 列表、字典、元组、集合、类与实例由 py_gc_malloc 分配，对象地址之前紧挨着这个头；
+ * 创建完成后 py_gc_track 把它链入第 0 代。int / float / str 等标量照常 malloc，
+ * 没有 GC 头，收集器也从不访问它们。
+ */
+typedef struct PyGCHead_t
+{
+    struct PyGCHead_t* next;
+    struct PyGCHead_t* prev;
+    int gcRefs;      ///< 收集期间: 引用计数减去来自同批被收集对象的引用
+    int generation;  ///< 所在的代 (0..PY_GC_GENERATIONS-1)，未跟踪时为 -1
+} PyGCHead;
+
+#define PY_GC_GENERATIONS 3
+
+typedef void (*PyGCVisitProc)(PyObject* child, void* arg);
+
+// 分配 / 释放带 GC 头的容器对象 (py_gc_free 会先取消跟踪，NULL 时什么也不做)
+void* py_gc_malloc(size_t size);
+void py_gc_free(PyObject* obj);
+
+void py_gc_track(PyObject* obj);  ///< 对象初始化完成后调用，可能触发一次收集
+void py_gc_untrack(PyObject* obj);
+bool py_gc_is_tracked(const PyObject* obj);
+
+/**
+ * @brief 收集第 0 代到第 generation 代 (超出范围时按最老一代处理)，返回释放的对象个数。
+ *
+ * 不可达的环先整体 incref，再逐个清空它们持有的引用，最后 decref 让引用计数归零，
+ * 释放仍走 py_decref 的正常路径。
+ */
+int py_gc_collect(int generation);
+
+/**
+ * @brief 设置各代的收集阈值。
+ *
+ * 第 0 代: 跟踪的容器数 (新建减去释放) 超过 threshold0 时收集，为 0 时关闭自动收集；
+ * 第 1 / 2 代: 更年轻一代被收集的次数超过阈值时一并收集。默认 700 / 10 / 10。
+ */
+void py_gc_set_threshold(int threshold0, int threshold1, int threshold2);
+
+// 列表缓冲区的遍历与清空 (视图只引用根列表；根列表的旧缓冲区仍持有元素)，实现在 py_container.cpp
+void py_list_traverse(PyListObject* list, PyGCVisitProc visit, void* arg);
+void py_list_clear_refs(PyListObject* list);
+
+// 字典条目表的遍历与清空 (写时复制副本只引用根字典)，实现在 py_container.cpp
+void py_dict_traverse(PyDictObject* dict, PyGCVisitProc visit, void* arg);
+void py_dict_clear_refs(PyDictObject* dict);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // PY_GC_H
@@ -0,0 +1,65 @@
+// 运行时内存分配层 (小对象 slab / 直通 libc / 外部分配器)
+#ifndef PY_MEM_H
+#define PY_MEM_H
+
+#include <cstddef>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 分配后端。
+ *
+ * - SLAB: 不超过 PY_MEM_SMALL_MAX 字节的请求按 8 字节分级 (8 字节对齐)，从 slab 页中分配；更大的请求走 libc。
+ * - PASSTHROUGH: 全部直接调用 libc malloc / free。
+ * - EXTERNAL: 全部交给链接进来的外部分配器 (见 py_mem_external_allocator)。
+ *
+ * 默认后端由编译选项 PY_MEM_DEFAULT_BACKEND 决定 (CMake: LLVMPY_MEM_BACKEND)，
+ * 运行时可用环境变量 PYRT_ALLOCATOR=slab|malloc 覆盖；链接了外部分配器时总是 EXTERNAL。
+ * 用 ASan / valgrind 检查内存错误时应设置 PYRT_ALLOCATOR=malloc，slab 中的悬空访问它们看不到。
+ */
+typedef enum
+{
+    PY_MEM_BACKEND_SLAB = 0,
+    PY_MEM_BACKEND_PASSTHROUGH = 1,
+    PY_MEM_BACKEND_EXTERNAL = 2
+} PyMemBackend;
+
+#define PY_MEM_SMALL_MAX 256
+
+/// 外部分配器的函数表 (calloc 可以为 NULL，由 alloc + memset 代替)
+typedef struct
+{
+    void* (*alloc)(size_t size);
+    void* (*calloc)(size_t count, size_t size);
+    void* (*realloc)(void* ptr, size_t size);
+    void (*free)(void* ptr);
+} PyMemAllocator;
+
+/**
+ * @brief 链接期钩子: 运行时内置一个返回 NULL 的弱定义。
+ *
+ * 程序或另一个库提供同名的强定义并返回非 NULL 的函数表时，运行时的所有分配都转交给它。
+ * 第一次分配时查询一次，之后不再改变。
+ */
+const PyMemAllocator* py_mem_external_allocator(void);
+
+void* py_mem_alloc(size_t size);
+void* py_mem_calloc(size_t count, size_t size);
+void* py_mem_realloc(void* ptr, size_t size);
+void py_mem_free(void* ptr);  ///< 接受本层分配的任何指针 (包括 slab 后端下转给 libc 的大块)，NULL 时什么也不做
+
+PyMemBackend py_mem_backend(void);
+
+/**
+ * @brief 在 SLAB 与 PASSTHROUGH 之间切换 (之前分配的内存仍可正常释放)。
+ * 外部分配器只能在链接期选择；已使用外部分配器或参数无效时返回 false。
+ */
+bool py_mem_set_backend(PyMemBackend backend);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // PY_MEM_H
@@ -0,0 +1,54 @@
+// 运行时内存统计与采样分配分析 (编译开关 RUNTIME_MEMSTATS，见 runtime_level.h)
+#ifndef PY_MEMSTATS_H
+#define PY_MEMSTATS_H
+
+#include "runtime_common.h"
+#include "runtime_level.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 两类计数，都只在程序启动时由环境变量打开:
+ *
+ * - PYRT_MEMSTATS=1: 按 typeId 统计对象的分配 / 释放次数、存活个数与字节数，
+ *   另有一行 py_mem 层的总计 (包括列表缓冲区、字典条目等非对象内存)；
+ *   程序退出时 entry.c 调用 py_memstats_report() 把表格打印到 stderr。
+ * - PYRT_MEMPROF=<文件>: 每 PYRT_MEMPROF_RATE 次 (默认 512) py_mem 分配采样一次调用栈
+ *   (其中包括生成代码中的调用点)，退出时按 pprof 可读取的 heap profile 文本格式写入文件，
+ *   计数已按采样间隔放大: `pprof --text <程序> <文件>`。
+ *
+ * 对象的字节数只计对象本身 (含 GC 头与元组的内联元素)，不含它另外持有的缓冲区。
+ */
+extern bool py_memstats_active;
+extern bool py_memprof_active;
+
+void py_memstats_object_alloc(PyObject* obj);  ///< 对象初始化完成 (typeId 已设置) 后调用
+void py_memstats_object_free(PyObject* obj);   ///< 引用计数归零、释放任何字段之前调用
+
+// py_mem 层的钩子: bytes 为实际占用的大小 (slab 槽位或 malloc_usable_size，外部分配器时为 0)
+void py_memstats_heap_alloc(void* ptr, size_t bytes);
+void py_memstats_heap_free(void* ptr, size_t bytes);
+
+/// typeId 所在统计行当前的存活对象个数 (分配减去释放，PYRT_MEMSTATS 没有打开时为 0)
+int64_t py_memstats_live_objects(int typeId);
+
+/// 打印统计表格 / 写出采样文件 (对应的开关没有打开时什么也不做)
+void py_memstats_report(void);
+
+#ifdef RUNTIME_MEMSTATS
+#define PY_MEMSTATS_OBJECT_ALLOC(obj) \
+    do { if (py_memstats_active) py_memstats_object_alloc((PyObject*)(obj)); } while (0)
+#define PY_MEMSTATS_OBJECT_FREE(obj) \
+    do { if (py_memstats_active) py_memstats_object_free((PyObject*)(obj)); } while (0)
+#else
+#define PY_MEMSTATS_OBJECT_ALLOC(obj) ((void)0)
+#define PY_MEMSTATS_OBJECT_FREE(obj) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // PY_MEMSTATS_H
@@ -13,8 +13,16 @@ PyObject* py_create_int(long long int value);
 PyObject* py_create_double(double value);
 PyObject* py_create_bool(bool value);
 PyObject* py_create_string(const char* value);
+PyObject* py_create_string_with_length(const char* value, size_t len);
+PyObject* py_create_string_view(PyObject* str, size_t offset);  // 共享缓冲区的后缀 str[offset:]
 PyObject* py_create_list(int size, int elemTypeId);
 PyObject* py_create_dict(int initialCapacity, int keyTypeId);
+PyObject* py_create_tuple(int size);  // 元素初始为 NULL，用 py_tuple_set_item 填充
+PyObject* py_create_set(int minSize);  // 空集合，按 minSize 个元素预分配哈希表
+int py_set_capacity_for(int n);
+PyObject* py_create_range(int64_t start, int64_t stop, int64_t step);  // step 为 0 时报错并返回 NULL
+int64_t py_range_length(int64_t start, int64_t stop, int64_t step);
+void py_range_bind_counter(PyObject** slot, int64_t value);  // range 循环变量: 私有整数原地更新，否则换新对象
 PyObject* py_create_int_from_mpz(mpz_srcptr src) ;
 PyObject* py_create_double_from_mpf(mpf_srcptr src);
 PyObject* py_get_none(void);
@@ -22,6 +30,12 @@ PyObject* py_create_int_bystring(const char* s, int base);
 
 PyObject* py_create_double_bystring(const char* s, int base, mp_bitcnt_t precision);
 
+// 在调用者提供的 storage 中初始化 (不逃逸的临时对象放在栈上)，以 py_release_into 结束生命周期
+PyObject* py_init_int_into(PyPrimitiveObject* storage, long long value);
+PyObject* py_init_int_bystring_into(PyPrimitiveObject* storage, const char* s, int base);
+PyObject* py_init_bool_into(PyPrimitiveObject* storage, bool value);
+void py_release_into(PyObject* obj, PyPrimitiveObject* storage);  // storage 外的结果 (堆上回退) 被 decref
+
 PyObject* py_create_class(const char* name, PyObject* base_cls_obj, PyObject* class_dict_obj);
 PyObject* py_create_instance(PyObject* cls_obj); // 参数是类对象
 
@@ -30,6 +44,27 @@ PyObject* py_create_instance(PyObject* cls_obj); // 参数是类对象
 void py_incref(PyObject* obj);
 void py_decref(PyObject* obj);
 
+/**
+ * @brief 永生对象 (PY_OBJECT_FLAG_IMMORTAL，引用计数固定为 INT_MAX)。
+ *
+ * None、True / False、[_PY_SMALL_INT_MIN, _PY_SMALL_INT_MAX] 内的小整数、驻留字符串、
+ * 字面量常量以及栈上 / 区域中的临时对象都是永生的: py_incref / py_decref 不写它们的引用计数，
+ * 被到处共享的对象所在的缓存行不会被反复写脏，它们也永远不会被释放。
+ */
+static inline bool py_is_immortal(const PyObject* obj)
+{
+    return (obj->flags & PY_OBJECT_FLAG_IMMORTAL) != 0;
+}
+
+PyObject* py_make_immortal(PyObject* obj);      ///< 标记为永生并返回 obj (之后不再释放)，NULL 原样返回
+PyObject* py_intern_string(const char* value);  ///< 按内容驻留的永生字符串，相同内容返回同一个对象
+
+// 字面量常量: slot 是代码生成为每个字面量生成的模块级全局变量 (初始为 NULL)，
+// 第一次求值时创建永生对象存入 slot，之后直接返回它
+PyObject* py_const_int(PyObject** slot, const char* text);
+PyObject* py_const_double(PyObject** slot, const char* text);
+PyObject* py_const_string(PyObject** slot, const char* text);
+
 /**
  * @brief 专门用于处理迭代器对象引用计数减少的内部辅助函数。
  * 当迭代器的引用计数降为0时，此函数负责释放迭代器持有的资源
@@ -44,6 +79,7 @@ PyObject* py_object_copy(PyObject* obj, int typeId);
 
 // 对象长度
 int py_object_len(PyObject* obj);
+int py_object_length_hint(PyObject* obj);  // 预分配用的元素个数，长度未知时返回 0 (不报错)
 
 // 添加函数创建声明
 PyObject* py_create_function(void* func_ptr, int signature_type_id);
@@ -14,6 +14,7 @@ bool py_coerce_numeric(PyObject* a, PyObject* b, double* out_a, double* out_b);
 // 算术运算
 PyObject* py_object_power(PyObject* a, PyObject* b);
 PyObject* py_object_add(PyObject* a, PyObject* b);
+bool py_string_append_to(PyObject** slot, PyObject* piece, bool ownsBuffer);  // 字符串变量的 x = x + piece
 PyObject* py_object_subtract(PyObject* a, PyObject* b);
 PyObject* py_object_multiply(PyObject* a, PyObject* b);
 PyObject* py_object_divide(PyObject* a, PyObject* b);
@@ -23,9 +24,17 @@ PyObject* py_object_not(PyObject* a);
 
 // 比较运算
 PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op);
+int py_object_compare_result(PyObject* a, PyObject* b, PyCompareOp op);  // 1 / 0，出错返回 -1，不分配对象
 bool py_compare_eq(PyObject* a, PyObject* b);
 bool py_compare_ne(PyObject* a, PyObject* b);
 
+// 结果写入调用者提供的 storage (不逃逸的临时对象)，以 py_release_into 结束。
+// 算术运算只在 int 与 int 时使用 storage，否则返回堆上的普通结果
+PyObject* py_object_compare_into(PyObject* a, PyObject* b, PyCompareOp op, PyPrimitiveObject* storage);
+PyObject* py_object_add_into(PyObject* a, PyObject* b, PyPrimitiveObject* storage);
+PyObject* py_object_subtract_into(PyObject* a, PyObject* b, PyPrimitiveObject* storage);
+PyObject* py_object_multiply_into(PyObject* a, PyObject* b, PyPrimitiveObject* storage);
+
 // 辅助函数
 const char* py_compare_op_name(PyCompareOp op);
 
@@ -0,0 +1,37 @@
+// 函数作用域的临时对象区域 (bump 分配，整体释放)
+#ifndef PY_REGION_H
+#define PY_REGION_H
+
+#include "runtime_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 区域是按函数调用嵌套的栈: 函数入口 py_region_push，每个 ret 之前 py_region_pop。
+ *
+ * 区域中的对象是 PyPrimitiveObject 大小的槽位，由 py_*_into 初始化，引用计数为 INT_MAX
+ * (incref / decref 不影响它们)。py_region_pop 清理本层所有槽位的 GMP 数据并回收内存，
+ * 槽位所在的块保留给之后的调用复用。
+ */
+void py_region_push(void);
+void py_region_pop(void);
+
+/// 在当前区域中分配一个清零的对象槽位 (没有打开的区域时返回 NULL)
+PyPrimitiveObject* py_region_alloc_object(void);
+
+/// 对象是否位于当前 (最内层) 区域中
+bool py_region_contains(const PyObject* obj);
+
+/**
+ * @brief 逃逸点上的提升: 区域中的 int / float / bool 复制为堆上的新对象 (引用计数 1)，
+ * 其他对象原样返回。
+ */
+PyObject* py_region_promote(PyObject* obj);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // PY_REGION_H
@@ -0,0 +1,55 @@
+// 非装箱列表存储的向量化内核 (运行时 CPU 分派)
+#ifndef PY_SIMD_H
+#define PY_SIMD_H
+
+#include "runtime_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 当前选用的指令集名称 ("avx2" / "sse4.2" / "scalar")。
+ *
+ * 内核在首次调用时根据 CPU 能力选择一次，定义 RUNTIME_DISABLE_SIMD 时始终为 "scalar"。
+ */
+const char* py_simd_isa_name(void);
+
+// 归约 (n 为元素个数，min/max 要求 n > 0)
+__int128 py_simd_sum_i64(const int64_t* data, int n);  ///< 精确求和，不会溢出
+int64_t py_simd_min_i64(const int64_t* data, int n);
+int64_t py_simd_max_i64(const int64_t* data, int n);
+double py_simd_min_f64(const double* data, int n);
+double py_simd_max_f64(const double* data, int n);
+
+// 真值测试 (非零即为真)
+bool py_simd_any_i64(const int64_t* data, int n);
+bool py_simd_all_i64(const int64_t* data, int n);
+bool py_simd_any_f64(const double* data, int n);
+bool py_simd_all_f64(const double* data, int n);
+
+// 逐元素二元运算
+typedef enum
+{
+    PY_SIMD_ADD = 0,
+    PY_SIMD_SUB = 1,
+    PY_SIMD_MUL = 2,
+    PY_SIMD_DIV = 3  ///< 仅 f64
+} PySimdBinOp;
+
+/**
+ * @brief out[i] = a[i] op b[i]。步长为 1 表示连续数组，为 0 表示广播的标量。
+ * @return int64 版本在任一元素溢出时返回 false (out 内容未定义)，不支持 PY_SIMD_DIV。
+ */
+bool py_simd_binop_i64(PySimdBinOp op, const int64_t* a, int strideA, const int64_t* b, int strideB, int64_t* out, int n);
+void py_simd_binop_f64(PySimdBinOp op, const double* a, int strideA, const double* b, int strideB, double* out, int n);
+
+// 比较: 返回第一个 a[i] != b[i] 的下标，全部相等时返回 n (找到后立即停止)
+int py_simd_mismatch_i64(const int64_t* a, const int64_t* b, int n);
+int py_simd_mismatch_f64(const double* a, const double* b, int n);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif // PY_SIMD_H
@@ -24,6 +24,12 @@
 #include "py_function.h"
 #include "py_log.h"
 #include "py_error.h"
+#include "py_simd.h"
+#include "py_mem.h"
+#include "py_memstats.h"
+#include "py_region.h"
+#include "py_gc.h"
+#include "py_builtins.h"
 
 // 此头文件集中导出所有运行时API
 // 不需要任何额外代码，只需包含其他模块头文件
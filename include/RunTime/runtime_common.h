@@ -6,6 +6,7 @@
 
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <cstddef> // For size_t, NULL
 #include <cstring> // For strcmp
@@ -31,19 +32,54 @@ extern "C"
     typedef struct PyFunctionObject_t PyFunctionObject;
 
     // 结构体定义
+    /**
+     * @brief 所有对象共有的 8 字节头。
+     *
+     * 代码生成按 {i32, i16, i16} 读取 (见 CodeGenRuntime::getPyObjectHeaderType)，
+     * typeId 的取值 (含实例类型 PY_TYPE_INSTANCE_BASE + n) 都在 16 位以内。
+     */
     struct PyObject_t
     {
-        int refCount;  // 引用计数
-        int typeId;    // 类型ID
+        int32_t refCount;  // 引用计数 (INT_MAX: 不计数，见 PY_OBJECT_FLAG_IMMORTAL)
+        uint16_t typeId;   // 类型ID
+        uint16_t flags;    // PY_OBJECT_FLAG_*
     };
 
+#define PY_OBJECT_FLAG_IMMORTAL 0x1    ///< 单例、栈上或区域中的对象: 引用计数固定为 INT_MAX，永不释放
+#define PY_OBJECT_FLAG_GC_TRACKED 0x2  ///< 容器已链入某一代 (由 py_gc_track / py_gc_untrack 维护)
+
+    /**
+     * @brief 列表元素存储策略。
+     *
+     * 由 elemTypeId 在创建时选择。同构的 int/float/bool 列表以非装箱的
+     * 连续数组保存元素，遇到无法无损表示的元素时退化为 BOXED。
+     */
+    typedef enum
+    {
+        PY_LIST_STORAGE_BOXED = 0,   ///< PyObject* 数组 (默认)
+        PY_LIST_STORAGE_INT64 = 1,   ///< int64_t 数组，元素 elemTypeId == PY_TYPE_INT
+        PY_LIST_STORAGE_DOUBLE = 2,  ///< double 数组，元素 elemTypeId == PY_TYPE_DOUBLE
+        PY_LIST_STORAGE_BOOL = 3     ///< 位图 (每元素 1 bit)，元素 elemTypeId == PY_TYPE_BOOL
+    } PyListStorageKind;
+
     struct PyListObject_t
     {
         PyObject header;  // PyObject头
         int length;       // 当前长度
         int capacity;     // 分配容量
         int elemTypeId;   // 元素类型ID
-        PyObject** data;  // 元素数据指针数组
+        int storage;      // 存储策略 (PyListStorageKind)
+        union
+        {
+            PyObject** data;  // BOXED: 元素数据指针数组
+            int64_t* ints;    // INT64: 非装箱整数
+            double* doubles;  // DOUBLE: 非装箱浮点数
+            uint64_t* bits;   // BOOL: 位图
+        };
+        // 以下字段只由运行时使用，代码生成只依赖上面的前缀布局
+        PyObject* base;   // 切片视图: data 借用根列表 base 的缓冲区，视图不持有元素引用，写入前先复制
+        int exports;      // 根列表: 指向当前缓冲区的存活视图个数 (> 0 时写入前先换新缓冲区)
+        struct PyListRetiredBuffer_t* retired;  // 根列表: 仍被视图引用的旧缓冲区，最后一个视图释放时回收
     };
 
     struct PyDictEntry_t
@@ -60,7 +96,12 @@ extern "C"
         int size;              // 条目数量
         int capacity;          // 哈希表容量
         int keyTypeId;         // 键类型ID
+        unsigned int version;  // 表结构版本: 插入新键或扩容时递增，迭代器据此检测修改
         PyDictEntry* entries;  // 哈希表
+        // 以下字段只由运行时使用，代码生成只依赖上面的前缀布局
+        PyObject* base;        // 写时复制副本: entries 借用根字典 base 的条目表，副本不持有键值引用，写入前先复制
+        int exports;           // 根字典: 借用当前条目表的存活副本个数 (> 0 时写入前先换新条目表)
+        struct PyDictRetiredTable_t* retired;  // 根字典: 仍被副本借用的旧条目表，最后一个副本释放时回收
     };
 
     struct PyPrimitiveObject_t
@@ -74,9 +115,51 @@ extern "C"
             mpf_t doubleValue;  // <--- 使用 GMP 浮点数类型 (需要设置精度)
             bool boolValue;
             char* stringValue;
+            struct
+            {
+                char* chars;      // 与 stringValue 是同一字段
+                PyObject* owner;  // 非 NULL 时 chars 指向 owner 缓冲区的后缀 (零拷贝切片)，不单独释放
+                int length;       // capacity > 0 时有效
+                int capacity;     // > 0: 由 py_string_append_to 创建的可增长缓冲区 (含结尾 NUL)
+            } stringView;
         } value;
     };
 
+    /**
+     * @brief 按负载收紧的标量布局。
+     *
+     * PyPrimitiveObject 按最大的成员 (mpf_t / 字符串视图) 定大小，仍是运行时访问标量的通用视图，
+     * 栈上与区域中的槽位也按它分配；堆上的对象只分配各自类型的大小，字段与
+     * PyPrimitiveObject::value 的对应成员位于同一偏移 (py_object.cpp 中有静态检查)。
+     * bool 不在堆上分配: py_create_bool 返回两个静态单例。
+     */
+    typedef struct
+    {
+        PyObject header;
+        bool value;
+    } PyBoolObject;
+
+    typedef struct
+    {
+        PyObject header;
+        mpz_t value;
+    } PyIntObject;
+
+    typedef struct
+    {
+        PyObject header;
+        mpf_t value;
+    } PyFloatObject;
+
+    typedef struct
+    {
+        PyObject header;
+        char* chars;
+        PyObject* owner;
+        int length;
+        int capacity;
+    } PyStringObject;
+
     // 类对象结构体
     struct PyClassObject_t
     {
@@ -133,6 +216,104 @@ extern "C"
         size_t current_char_index;  ///< 当前迭代到的字符索引。
     } PyStringIteratorObject;
 
+    /**
+     * @brief range 对象结构。不可变，只保存规范化后的起点、终点和步长 (step != 0)。
+     */
+    typedef struct PyRangeObject_t {
+        PyObject header;  ///< 对象头，类型 ID 为 PY_TYPE_RANGE。
+        int64_t start;
+        int64_t stop;
+        int64_t step;
+        int64_t length;   ///< 元素个数，创建时计算。
+    } PyRangeObject;
+
+    /**
+     * @brief range 迭代器对象结构。直接复制 range 的参数，不持有 range 对象的引用。
+     */
+    typedef struct PyRangeIteratorObject_t {
+        PyObject header;     ///< 对象头，类型 ID 为 PY_TYPE_RANGE_ITERATOR。
+        int64_t next;        ///< 下一次返回的值。
+        int64_t step;
+        int64_t remaining;   ///< 剩余元素个数。
+    } PyRangeIteratorObject;
+
+    /**
+     * @brief 元组对象结构。元素紧跟在对象头之后存放，整个元组只需一次分配。
+     *
+     * 元组不可变，哈希值在第一次计算后缓存 (hashCached 置 1)。
+     */
+    typedef struct PyTupleObject_t {
+        PyObject header;      ///< 对象头，类型 ID 为 PY_TYPE_TUPLE。
+        int length;           ///< 元素个数，创建后不变。
+        int hashCached;       ///< hash 字段是否有效。
+        unsigned int hash;    ///< 缓存的哈希值。
+        PyObject* items[];    ///< 内联元素数组 (长度为 length)，元组持有每个元素的引用。
+    } PyTupleObject;
+
+    /**
+     * @brief 元组迭代器对象结构。
+     */
+    typedef struct PyTupleIteratorObject_t {
+        PyObject header;      ///< 对象头，类型 ID 为 PY_TYPE_TUPLE_ITERATOR。
+        PyObject* iterable;   ///< 被迭代的元组 (PyTupleObject*)，迭代器持有其引用。
+        int current_index;    ///< 下一次返回的元素下标。
+    } PyTupleIteratorObject;
+
+    /**
+     * @brief 集合的哈希表槽位。与 PyDictEntry 使用同一套探测逻辑，只是没有 value。
+     *
+     * used && key == NULL 表示已删除的槽位 (墓碑)，探测时跳过但不终止。
+     */
+    typedef struct PySetEntry_t {
+        PyObject* key;
+        unsigned int hash;    ///< 插入时计算的哈希值，扩容和集合运算直接复用。
+        bool used;
+    } PySetEntry;
+
+    /**
+     * @brief 集合对象结构。容量总是 2 的幂，装载因子 (含墓碑) 保持在 3/4 以下。
+     */
+    typedef struct PySetObject_t {
+        PyObject header;      ///< 对象头，类型 ID 为 PY_TYPE_SET。
+        int size;             ///< 元素个数。
+        int fill;             ///< 已占用的槽位数 (元素 + 墓碑)。
+        int capacity;         ///< 槽位总数。
+        PySetEntry* entries;
+    } PySetObject;
+
+    /**
+     * @brief 集合迭代器对象结构。按槽位顺序遍历。
+     */
+    typedef struct PySetIteratorObject_t {
+        PyObject header;      ///< 对象头，类型 ID 为 PY_TYPE_SET_ITERATOR。
+        PyObject* iterable;   ///< 被迭代的集合 (PySetObject*)，迭代器持有其引用。
+        int current_slot;     ///< 下一次开始扫描的槽位下标。
+    } PySetIteratorObject;
+
+    /**
+     * @brief 字典迭代器产出的内容。
+     */
+    typedef enum
+    {
+        PY_DICT_ITER_KEYS = 0,
+        PY_DICT_ITER_VALUES = 1,
+        PY_DICT_ITER_ITEMS = 2  ///< (key, value) 元组
+    } PyDictIterKind;
+
+    /**
+     * @brief 字典迭代器对象结构。直接按槽位顺序扫描条目数组，不复制键。
+     *
+     * 创建时记录字典的 version，之后字典插入新键或扩容会使迭代报错 (与 CPython 一致，
+     * 只修改已有键的值不影响迭代)。
+     */
+    typedef struct PyDictIteratorObject_t {
+        PyObject header;       ///< 对象头，类型 ID 为 PY_TYPE_DICT_ITERATOR。
+        PyObject* iterable;    ///< 被迭代的字典 (PyDictObject*)，迭代器持有其引用。
+        int current_slot;      ///< 下一次开始扫描的槽位下标。
+        unsigned int version;  ///< 创建时字典的 version。
+        int kind;              ///< PyDictIterKind
+    } PyDictIteratorObject;
+
     
 
 #ifdef __cplusplus
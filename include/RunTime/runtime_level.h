@@ -10,6 +10,10 @@
 
 #define MPFR_DEFAULT_RND_MODE MPFR_RNDN
 
+// #define RUNTIME_DISABLE_SIMD // 关闭非装箱列表的 SIMD 内核 (AVX2/SSE4.2)，始终使用标量实现
+
+#define RUNTIME_MEMSTATS // 编译进内存统计与采样分配分析 (仍需 PYRT_MEMSTATS=1 / PYRT_MEMPROF=<文件> 在运行时打开)，注释掉后相关钩子完全不生成代码
+
 #define _PY_SMALL_INT_MIN -500
 #define _PY_SMALL_INT_MAX 500
 
@@ -55,12 +55,16 @@ enum PyTypeId : int
 
     PY_TYPE_CLASS = 12,     // 类对象本身的类型 ID
     PY_TYPE_INSTANCE = 13,  // 通用实例类型 ID (或者作为基类)
+    PY_TYPE_RANGE = 14,     // range 对象 (惰性整数序列)
 
     // 迭代器类型 ID 基础
     PY_TYPE_ITERATOR_BASE = 50,                           // 新的基础 ID
     PY_TYPE_LIST_ITERATOR = PY_TYPE_ITERATOR_BASE + 0,    // 50
     PY_TYPE_STRING_ITERATOR = PY_TYPE_ITERATOR_BASE + 1,  // 51
-    // PY_TYPE_DICT_ITERATOR = PY_TYPE_ITERATOR_BASE + 2, // etc.
+    PY_TYPE_DICT_ITERATOR = PY_TYPE_ITERATOR_BASE + 2,    // 52
+    PY_TYPE_RANGE_ITERATOR = PY_TYPE_ITERATOR_BASE + 3,   // 53
+    PY_TYPE_TUPLE_ITERATOR = PY_TYPE_ITERATOR_BASE + 4,   // 54
+    PY_TYPE_SET_ITERATOR = PY_TYPE_ITERATOR_BASE + 5,     // 55
 
     // 复合类型ID基础 - 用于运行时扩展类型ID
     PY_TYPE_LIST_BASE = 100,  // 列表类型基础 ID
@@ -594,6 +594,32 @@ std::shared_ptr<PyType> ListExprAST::getType() const
     return cachedType;
 }
 
+std::shared_ptr<PyType> TupleExprAST::getType() const
+{
+    // 元组元素类型不做静态跟踪，按 any 处理，由运行时分派
+    return PyType::getAny();
+}
+
+std::shared_ptr<PyType> SetExprAST::getType() const
+{
+    return PyType::getAny();
+}
+
+std::shared_ptr<PyType> SliceExprAST::getType() const
+{
+    auto targetType = target->getType();
+    if (targetType && (targetType->isList() || targetType->isString()))
+    {
+        return targetType;
+    }
+    return PyType::getAny();
+}
+
+std::shared_ptr<PyType> ListCompExprAST::getType() const
+{
+    return cachedType ? cachedType : PyType::getList(PyType::getAny());
+}
+
 std::shared_ptr<PyType> IndexExprAST::getType() const
 {
     if (cachedType)
@@ -3,6 +3,7 @@
 #include "CodeGen/CodeGenType.h"
 #include "CodeGen/CodeGenRuntime.h"
 #include "CodeGen/CodeGenModule.h"
+#include "CodeGen/CodeGenStmt.h"  // exprReferencesName / handleCondition
 #include "CodeGen/CodeGenUtil.h"  // For llvmObjToString
 
 //#include "ObjectRuntime.h"
@@ -12,10 +13,16 @@
 #include "Parser.h"  // For PyTypeParser
 
 #include <llvm/IR/Constants.h>
+#include <llvm/IR/Intrinsics.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/IR/ValueSymbolTable.h>
 
+#include <cerrno>
+#include <climits>
 #include <cmath>
+#include <cstdlib>
 #include <iostream>  // For errors
+#include <tuple>
 namespace llvmpy
 {
 
@@ -76,6 +83,15 @@ void CodeGenExpr::initializeHandlers()
         return static_cast<CodeGenExpr*>(cg.getExprGen())->handleListExpr(static_cast<ListExprAST*>(expr));
     };
 
+    exprHandlers[ASTKind::TupleExpr] = [](CodeGenBase& cg, ExprAST* expr)
+    {
+        return static_cast<CodeGenExpr*>(cg.getExprGen())->handleTupleExpr(static_cast<TupleExprAST*>(expr));
+    };
+    exprHandlers[ASTKind::SetExpr] = [](CodeGenBase& cg, ExprAST* expr)
+    {
+        return static_cast<CodeGenExpr*>(cg.getExprGen())->handleSetExpr(static_cast<SetExprAST*>(expr));
+    };
+
     exprHandlers[ASTKind::DictExpr] = [](CodeGenBase& cg, ExprAST* expr)
     {
         // 注意这里的转型和调用
@@ -86,6 +102,14 @@ void CodeGenExpr::initializeHandlers()
     {
         return static_cast<CodeGenExpr*>(cg.getExprGen())->handleIndexExpr(static_cast<IndexExprAST*>(expr));
     };
+    exprHandlers[ASTKind::SliceExpr] = [](CodeGenBase& cg, ExprAST* expr)
+    {
+        return static_cast<CodeGenExpr*>(cg.getExprGen())->handleSliceExpr(static_cast<SliceExprAST*>(expr));
+    };
+    exprHandlers[ASTKind::ListCompExpr] = [](CodeGenBase& cg, ExprAST* expr)
+    {
+        return static_cast<CodeGenExpr*>(cg.getExprGen())->handleListCompExpr(static_cast<ListCompExprAST*>(expr));
+    };
 
     handlersInitialized = true;
 }
@@ -432,6 +456,11 @@ llvm::Value* CodeGenExpr::handleCallExpr(CallExprAST* expr)
                 }
     #endif
             }
+            else if (isBuiltinFunction(calleeNameForContext))
+            {
+                // 3. 内置函数 (未被同名变量或函数遮蔽)
+                return handleBuiltinCall(calleeNameForContext, expr);
+            }
             else
             {
                 std::cerr << "--- Symbol Table Dump (Variable and AST Lookup Failed for '" << calleeNameForContext << "') ---" << std::endl;
@@ -616,6 +645,107 @@ llvm::Value* CodeGenExpr::handleCallExpr(CallExprAST* expr)
 
     return callResult;
 }
+
+// 内置函数表: 名称 -> 运行时函数及参数个数
+struct BuiltinFunctionInfo
+{
+    const char* runtimeName;
+    size_t minArgs;
+    size_t maxArgs;  // SIZE_MAX 表示可变参数
+};
+
+static const std::unordered_map<std::string, BuiltinFunctionInfo>& builtinRuntimeFunctions()
+{
+    static const std::unordered_map<std::string, BuiltinFunctionInfo> builtins = {
+            {"sum", {"py_builtin_sum", 1, 1}},
+            {"min", {"py_builtin_min", 1, SIZE_MAX}},
+            {"max", {"py_builtin_max", 1, SIZE_MAX}},
+            {"any", {"py_builtin_any", 1, 1}},
+            {"all", {"py_builtin_all", 1, 1}},
+            {"len", {"py_builtin_len", 1, 1}},
+            {"vec_add", {"py_builtin_vec_add", 2, 2}},
+            {"vec_sub", {"py_builtin_vec_sub", 2, 2}},
+            {"vec_mul", {"py_builtin_vec_mul", 2, 2}},
+            {"vec_div", {"py_builtin_vec_div", 2, 2}},
+            {"range", {"py_builtin_range", 1, 3}},
+            {"set", {"py_set_from_iterable", 0, 1}},
+            {"set_add", {"py_builtin_set_add", 2, 2}},
+            {"set_discard", {"py_builtin_set_discard", 2, 2}},
+            {"set_union", {"py_set_union", 2, 2}},
+            {"set_intersection", {"py_set_intersection", 2, 2}},
+            {"set_difference", {"py_set_difference", 2, 2}},
+            {"keys", {"py_builtin_dict_keys", 1, 1}},
+            {"values", {"py_builtin_dict_values", 1, 1}},
+            {"items", {"py_builtin_dict_items", 1, 1}},
+            {"gc_collect", {"py_builtin_gc_collect", 0, 1}},
+            {"gc_set_threshold", {"py_builtin_gc_set_threshold", 1, 3}}};
+    return builtins;
+}
+
+bool CodeGenExpr::isBuiltinFunction(const std::string& name) const
+{
+    return builtinRuntimeFunctions().count(name) > 0;
+}
+
+// 内置函数调用: 参数求值后直接调用对应的运行时函数 (py_builtin_*)
+llvm::Value* CodeGenExpr::handleBuiltinCall(const std::string& name, CallExprAST* expr)
+{
+    auto& builder = codeGen.getBuilder();
+    auto* runtime = codeGen.getRuntimeGen();
+    auto* typeGen = codeGen.getTypeGen();
+    llvm::Type* pyObjectPtrType = llvm::PointerType::get(codeGen.getContext(), 0);
+
+    const BuiltinFunctionInfo& info = builtinRuntimeFunctions().at(name);
+    const auto& callArgs = expr->getArgs();
+    if (callArgs.size() < info.minArgs || callArgs.size() > info.maxArgs)
+    {
+        std::string expected = info.maxArgs == SIZE_MAX ? "at least " + std::to_string(info.minArgs)
+                                                        : std::to_string(info.minArgs);
+        return codeGen.logError(name + "() expects " + expected + " argument(s), got " + std::to_string(callArgs.size()),
+                                expr->line.value_or(0), expr->column.value_or(0));
+    }
+
+    std::vector<llvm::Value*> args;
+    std::vector<std::shared_ptr<PyType>> argTypes;
+    for (const auto& arg : callArgs)
+    {
+        llvm::Value* argValue = handleExpr(arg.get());
+        if (!argValue) return nullptr;
+        args.push_back(argValue);
+        argTypes.push_back(arg->getType());
+    }
+
+    // min(a, b, ...) / max(a, b, ...): 先把参数打包成临时列表
+    llvm::Value* packedList = nullptr;
+    if (info.maxArgs == SIZE_MAX && args.size() > 1)
+    {
+        packedList = createListWithValues(args, PyType::getAny());
+        if (!packedList) return nullptr;
+        args = {packedList};
+    }
+
+    // 可选参数 (如 range 的 stop/step): 缺省的位置以 NULL 补齐，运行时函数签名固定
+    if (info.maxArgs != SIZE_MAX)
+    {
+        while (args.size() < info.maxArgs)
+        {
+            args.push_back(llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(pyObjectPtrType)));
+        }
+    }
+
+    std::vector<llvm::Type*> paramTypes(args.size(), pyObjectPtrType);
+    llvm::Function* builtinFunc = runtime->getRuntimeFunction(info.runtimeName, pyObjectPtrType, paramTypes);
+    llvm::Value* callResult = builder.CreateCall(builtinFunc, args, name + "_result");
+
+    if (packedList)
+    {
+        runtime->decRef(packedList);
+    }
+
+    runtime->markObjectSource(callResult, ObjectLifecycleManager::ObjectSource::FUNCTION_RETURN);
+    expr->setType(typeGen->inferCallExprType(name, argTypes));
+    return callResult;
+}
 // 字典表达式的具体代码生成逻辑 (修正后)
 llvm::Value* CodeGenExpr::handleDictExpr(DictExprAST* expr)
 {
@@ -650,45 +780,46 @@ llvm::Value* CodeGenExpr::handleDictExpr(DictExprAST* expr)
         return codeGen.logError("Internal error: Could not resolve ObjectType for dict key/value", expr->line.value_or(0), expr->column.value_or(0));
     }
 
-    // 2. 创建空字典对象 (使用 CodeGenExpr 辅助函数，它内部调用 CodeGenRuntime)
-    llvm::Value* dictObj = createDict(keyObjType, valueObjType);
+    // 2. 键值全是字面量时，新建的对象只被字典引用: 常量字面量复制模板，否则由字典接管所有权
+    const auto& exprPairs = expr->getPairs();
+    auto isLiteral = [](const std::unique_ptr<ExprAST>& e)
+    {
+        ASTKind kind = e->kind();
+        return kind == ASTKind::NumberExpr || kind == ASTKind::StringExpr || kind == ASTKind::BoolExpr;
+    };
+    bool allLiterals = std::all_of(exprPairs.begin(), exprPairs.end(), [&](const auto& pair)
+                                   { return isLiteral(pair.first) && isLiteral(pair.second); });
 
-    if (!dictObj)
+    llvm::Value* dictObj = nullptr;
+    if (allLiterals && !exprPairs.empty())
     {
-        // 错误已在 createDict 或 runtime->createDict 中记录
-        return nullptr;
+        dictObj = createDictFromTemplate(expr, keyObjType);
     }
-
-    // 3. 迭代并添加键值对
-    for (const auto& pair : expr->getPairs())
+    else
     {
-        // 使用 handleExpr 生成键和值的代码
-        llvm::Value* keyValRaw = handleExpr(pair.first.get());
-        llvm::Value* valueValRaw = handleExpr(pair.second.get());
-
-        if (!keyValRaw || !valueValRaw)
+        // 3. 按顺序求值全部键值，再一次性插入
+        std::vector<std::pair<llvm::Value*, llvm::Value*>> pairValues;
+        for (const auto& pair : exprPairs)
         {
-            return nullptr;  // 错误已由 handleExpr 记录
+            llvm::Value* keyVal = handleExpr(pair.first.get());
+            llvm::Value* valueVal = handleExpr(pair.second.get());
+            if (!keyVal || !valueVal)
+            {
+                return nullptr;  // 错误已由 handleExpr 记录
+            }
+            pairValues.emplace_back(keyVal, valueVal);
         }
-
-        // 注意：原始代码在这里有 ObjectLifecycleManager::adjustObject。
-        // 按照要求，我们在此函数中避免了需要它的 PyCodeGen* 转型。
-        // 这假设原始的键/值对象适合插入，或者任何必要的调整（如复制）
-        // 在其他地方发生，或由运行时的 setDictItem 隐式处理（这可能有风险）。
-        // 为了简化并满足要求，我们直接使用原始值。
-        llvm::Value* keyValAdjusted = keyValRaw;
-        llvm::Value* valueValAdjusted = valueValRaw;
-
-        // 4. 调用运行时设置项 (使用 CodeGenExpr 辅助函数，它内部调用 CodeGenRuntime)
-        // 传递推断出的 dictType，尽管基本的 setDictItem 可能不使用它。
-        setDictItem(dictObj, keyValAdjusted, valueValAdjusted, dictType);
-        // 键/值的引用计数由 py_dict_set_item 内部处理
+        dictObj = createDictWithPairs(pairValues, keyObjType, allLiterals);
+    }
+    if (!dictObj)
+    {
+        return nullptr;
     }
 
-    // 5. 将字典标记为字面量来源
+    // 4. 将字典标记为字面量来源
     runtime->markObjectSource(dictObj, ObjectLifecycleManager::ObjectSource::LITERAL);
 
-    // 6. 在 CodeGenBase 状态中设置结果
+    // 5. 在 CodeGenBase 状态中设置结果
     codeGen.setLastExprValue(dictObj);
     codeGen.setLastExprType(dictType);
     return dictObj;  // 返回生成的值
@@ -718,8 +849,15 @@ llvm::Value* CodeGenExpr::handleListExpr(ListExprAST* expr)
     std::shared_ptr<PyType> listType = PyType::getList(elemType);
     expr->setType(listType);
 
-    // 使用运行时API创建列表
-    llvm::Value* list = createListWithValues(elemValues, elemType);
+    // 元素全是字面量时，其新建的对象只被列表引用，直接转交所有权
+    bool allLiterals = std::all_of(elements.begin(), elements.end(), [](const std::unique_ptr<ExprAST>& elem)
+                                   {
+                                       ASTKind kind = elem->kind();
+                                       return kind == ASTKind::NumberExpr || kind == ASTKind::StringExpr || kind == ASTKind::BoolExpr;
+                                   });
+
+    // 使用运行时API一次性创建列表
+    llvm::Value* list = createListWithValues(elemValues, elemType, allLiterals);
 
     // 标记列表为字面量，便于生命周期管理
     runtime->markObjectSource(list, ObjectLifecycleManager::ObjectSource::LITERAL);
@@ -727,6 +865,72 @@ llvm::Value* CodeGenExpr::handleListExpr(ListExprAST* expr)
     return list;
 }
 
+// 处理元组表达式: 一次分配出带内联元素的元组，再逐个填入元素
+llvm::Value* CodeGenExpr::handleTupleExpr(TupleExprAST* expr)
+{
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+    llvm::Type* pyObjectPtrType = llvm::PointerType::get(context, 0);
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+
+    const auto& elements = expr->getElements();
+    std::vector<llvm::Value*> elemValues;
+    for (const auto& elem : elements)
+    {
+        llvm::Value* elemValue = handleExpr(elem.get());
+        if (!elemValue) return nullptr;
+        elemValues.push_back(elemValue);
+    }
+
+    llvm::Function* createFunc = runtime->getRuntimeFunction("py_create_tuple", pyObjectPtrType, {int32Type});
+    llvm::Value* tuple = builder.CreateCall(createFunc, {llvm::ConstantInt::get(int32Type, elemValues.size())}, "tuple");
+
+    // py_tuple_set_item 会增加元素的引用计数
+    llvm::Function* setItemFunc = runtime->getRuntimeFunction(
+            "py_tuple_set_item", llvm::Type::getVoidTy(context), {pyObjectPtrType, int32Type, pyObjectPtrType});
+    for (size_t i = 0; i < elemValues.size(); ++i)
+    {
+        builder.CreateCall(setItemFunc, {tuple, llvm::ConstantInt::get(int32Type, i), elemValues[i]});
+    }
+
+    runtime->markObjectSource(tuple, ObjectLifecycleManager::ObjectSource::LITERAL);
+    return tuple;
+}
+
+// 处理集合表达式: 按元素个数预分配哈希表，再逐个插入 (重复元素由运行时去重)
+llvm::Value* CodeGenExpr::handleSetExpr(SetExprAST* expr)
+{
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+    llvm::Type* pyObjectPtrType = llvm::PointerType::get(context, 0);
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+
+    const auto& elements = expr->getElements();
+    std::vector<llvm::Value*> elemValues;
+    for (const auto& elem : elements)
+    {
+        llvm::Value* elemValue = handleExpr(elem.get());
+        if (!elemValue) return nullptr;
+        elemValues.push_back(elemValue);
+    }
+
+    llvm::Function* createFunc = runtime->getRuntimeFunction("py_create_set", pyObjectPtrType, {int32Type});
+    llvm::Value* set = builder.CreateCall(createFunc, {llvm::ConstantInt::get(int32Type, elemValues.size())}, "set");
+
+    // py_set_add 会增加元素的引用计数
+    llvm::Function* addFunc = runtime->getRuntimeFunction(
+            "py_set_add", llvm::Type::getInt1Ty(context), {pyObjectPtrType, pyObjectPtrType});
+    for (llvm::Value* elemValue : elemValues)
+    {
+        builder.CreateCall(addFunc, {set, elemValue});
+    }
+
+    runtime->markObjectSource(set, ObjectLifecycleManager::ObjectSource::LITERAL);
+    return set;
+}
+
 // 处理索引表达式
 llvm::Value* CodeGenExpr::handleIndexExpr(IndexExprAST* expr)
 {
@@ -756,8 +960,16 @@ llvm::Value* CodeGenExpr::handleIndexExpr(IndexExprAST* expr)
     std::shared_ptr<PyType> resultType = typeGen->inferIndexExprType(targetType, indexType);
     expr->setType(resultType);
 
-    // 执行索引操作
-    llvm::Value* result = handleIndexOperation(target, index, targetType, indexType);
+    // 执行索引操作 (list[int] 走内联读取)
+    llvm::Value* result = nullptr;
+    if (targetType && targetType->isList() && indexType && indexType->isInt() && index->getType()->isPointerTy())
+    {
+        result = handleListIndexInline(expr, target, index);
+    }
+    else
+    {
+        result = handleIndexOperation(target, index, targetType, indexType);
+    }
 
     // 标记索引结果为索引访问，便于生命周期管理
     if (result)
@@ -768,6 +980,408 @@ llvm::Value* CodeGenExpr::handleIndexExpr(IndexExprAST* expr)
     return result;
 }
 
+// 处理切片表达式: 统一交给 py_object_slice，省略的部分传 NULL
+llvm::Value* CodeGenExpr::handleSliceExpr(SliceExprAST* expr)
+{
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& builder = codeGen.getBuilder();
+    llvm::Type* pyObjectPtrType = llvm::PointerType::get(codeGen.getContext(), 0);
+
+    llvm::Value* target = handleExpr(expr->getTarget());
+    if (!target) return nullptr;
+
+    // 非装箱的下标临时装箱，调用后释放
+    std::vector<llvm::Value*> boxedTemps;
+    auto genBound = [&](const ExprAST* bound) -> llvm::Value*
+    {
+        if (!bound) return llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(pyObjectPtrType));
+        llvm::Value* value = handleExpr(bound);
+        if (value && !value->getType()->isPointerTy())
+        {
+            PyCodeGen* pyCodeGen = codeGen.asPyCodeGen();
+            if (!pyCodeGen) return nullptr;
+            int typeId = OperationCodeGenerator::getTypeId(bound->getType()->getObjectType());
+            value = OperationCodeGenerator::createObject(*pyCodeGen, value, typeId);
+            boxedTemps.push_back(value);
+        }
+        return value;
+    };
+
+    llvm::Value* start = genBound(expr->getStart());
+    llvm::Value* stop = genBound(expr->getStop());
+    llvm::Value* step = genBound(expr->getStep());
+    if (!start || !stop || !step) return nullptr;
+
+    llvm::Function* sliceFunc = runtime->getRuntimeFunction(
+            "py_object_slice", pyObjectPtrType, {pyObjectPtrType, pyObjectPtrType, pyObjectPtrType, pyObjectPtrType});
+    llvm::Value* result = builder.CreateCall(sliceFunc, {target, start, stop, step}, "slice");
+
+    for (llvm::Value* temp : boxedTemps)
+    {
+        runtime->decRef(temp);
+    }
+
+    runtime->markObjectSource(result, ObjectLifecycleManager::ObjectSource::FUNCTION_RETURN);
+    return result;
+}
+
+// 推导式元素能否直接按 i64 计算: 只含循环变量、int64 范围内的整数字面量以及 + - * 和取负
+static bool isNativeIntElement(const ExprAST* expr, const std::string& varName)
+{
+    switch (expr->kind())
+    {
+        case ASTKind::VariableExpr:
+            return static_cast<const VariableExprAST*>(expr)->getName() == varName;
+        case ASTKind::NumberExpr:
+        {
+            auto* numExpr = static_cast<const NumberExprAST*>(expr);
+            if (!numExpr->getType() || !numExpr->getType()->isInt()) return false;
+            const std::string& text = numExpr->getValueString();
+            char* end = nullptr;
+            errno = 0;
+            std::strtoll(text.c_str(), &end, 10);
+            return !text.empty() && errno == 0 && end && *end == '\0';
+        }
+        case ASTKind::BinaryExpr:
+        {
+            auto* binExpr = static_cast<const BinaryExprAST*>(expr);
+            PyTokenType op = binExpr->getOpType();
+            if (op != TOK_PLUS && op != TOK_MINUS && op != TOK_MUL) return false;
+            return isNativeIntElement(binExpr->getLHS(), varName) && isNativeIntElement(binExpr->getRHS(), varName);
+        }
+        case ASTKind::UnaryExpr:
+        {
+            auto* unaryExpr = static_cast<const UnaryExprAST*>(expr);
+            return unaryExpr->getOpType() == TOK_MINUS && isNativeIntElement(unaryExpr->getOperand(), varName);
+        }
+        default:
+            return false;
+    }
+}
+
+// 按 i64 生成 isNativeIntElement 接受的表达式，任一步溢出时 overflow 为真
+static llvm::Value* emitNativeIntElement(llvm::IRBuilder<>& builder, const ExprAST* expr,
+                                         llvm::Value* varValue, llvm::Value*& overflow)
+{
+    llvm::Type* int64Type = builder.getInt64Ty();
+    llvm::Value* lhs = nullptr;
+    llvm::Value* rhs = nullptr;
+    llvm::Intrinsic::ID intrinsic = llvm::Intrinsic::ssub_with_overflow;
+    switch (expr->kind())
+    {
+        case ASTKind::VariableExpr:
+            return varValue;
+        case ASTKind::NumberExpr:
+            return llvm::ConstantInt::get(int64Type, std::strtoll(static_cast<const NumberExprAST*>(expr)->getValueString().c_str(), nullptr, 10), true);
+        case ASTKind::UnaryExpr:
+            lhs = llvm::ConstantInt::get(int64Type, 0);
+            rhs = emitNativeIntElement(builder, static_cast<const UnaryExprAST*>(expr)->getOperand(), varValue, overflow);
+            break;
+        default:
+        {
+            auto* binExpr = static_cast<const BinaryExprAST*>(expr);
+            lhs = emitNativeIntElement(builder, binExpr->getLHS(), varValue, overflow);
+            rhs = emitNativeIntElement(builder, binExpr->getRHS(), varValue, overflow);
+            if (binExpr->getOpType() == TOK_PLUS) intrinsic = llvm::Intrinsic::sadd_with_overflow;
+            if (binExpr->getOpType() == TOK_MUL) intrinsic = llvm::Intrinsic::smul_with_overflow;
+            break;
+        }
+    }
+    llvm::Value* result = builder.CreateBinaryIntrinsic(intrinsic, lhs, rhs);
+    overflow = builder.CreateOr(overflow, builder.CreateExtractValue(result, 1));
+    return builder.CreateExtractValue(result, 0);
+}
+
+/**
+ * @brief 列表推导式 [element for var in iterable if condition]。
+ *
+ * 生成单个循环，元素直接写入结果列表的缓冲区，不经过 py_list_append 的类型转换和扩容检查:
+ * - range(...) 来源用 i64 计数器，结果列表按 py_range_length 一次分配足够的容量；
+ * - 其他来源用 py_iter/py_next，按 py_object_length_hint 预分配，只有容量不足时才扩容。
+ * 元素推断为 int/float/bool 时结果列表使用对应的非装箱存储。range 来源且元素只由循环变量、
+ * 整数字面量和 + - * 组成时直接以 i64 计算并写入 INT64 存储，溢出时退回装箱计算。
+ * 循环变量只在推导式内可见，只有条件或装箱计算用到它时才装箱。
+ */
+llvm::Value* CodeGenExpr::handleListCompExpr(ListCompExprAST* expr)
+{
+    PyCodeGen* pyCodeGen = codeGen.asPyCodeGen();
+    if (!pyCodeGen) return nullptr;
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+    auto* runtime = codeGen.getRuntimeGen();
+    auto* typeGen = codeGen.getTypeGen();
+    auto& symTable = codeGen.getSymbolTable();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
+    llvm::Type* int32Type = builder.getInt32Ty();
+    llvm::Type* int64Type = builder.getInt64Ty();
+    llvm::StructType* listStructType = runtime->getPyListStructType();
+    const std::string& varName = expr->getVarName();
+    const ExprAST* condition = expr->getCondition();
+    int line = expr->line.value_or(0);
+
+    // --- 1. 类型 ---
+    std::shared_ptr<PyType> listType = typeGen->inferExprType(expr);
+    std::shared_ptr<PyType> elemType = PyType::getListElementType(listType);
+    std::shared_ptr<PyType> varType = typeGen->inferListCompVarType(expr);
+    ObjectType* varObjType = varType ? varType->getObjectType() : nullptr;
+    int elemTypeId = OperationCodeGenerator::getTypeId(elemType->getObjectType());
+    bool unboxedStorage = elemType->isInt() || elemType->isDouble() || elemType->isBool();
+    expr->setType(listType);
+
+    bool fromRange = typeGen->isBuiltinRangeCall(expr->getIterable());
+    bool nativeElement = fromRange && elemType->isInt() && isNativeIntElement(expr->getElement(), varName);
+    bool elementUsesVar = exprReferencesName(expr->getElement(), varName);
+    bool conditionUsesVar = condition && exprReferencesName(condition, varName);
+
+    auto boxIfNeeded = [&](llvm::Value* value, const ExprAST* source) -> llvm::Value*
+    {
+        if (!value || value->getType()->isPointerTy()) return value;
+        return OperationCodeGenerator::createObject(*pyCodeGen, value, OperationCodeGenerator::getTypeId(source->getType()->getObjectType()));
+    };
+    llvm::Function* exitFunc = codeGen.getOrCreateExternalFunction("exit", builder.getVoidTy(), {int32Type}, false);
+    auto exitWithError = [&](const char* errorKey)
+    {
+        if (errorKey) runtime->callRuntimeError(errorKey, line);
+        builder.CreateCall(exitFunc, {llvm::ConstantInt::get(int32Type, 1)});
+        builder.CreateUnreachable();
+    };
+
+    // --- 2. 来源与结果容量 ---
+    llvm::Value* start = nullptr;
+    llvm::Value* step = nullptr;
+    llvm::Value* count = nullptr;
+    llvm::Value* iterator = nullptr;
+    llvm::Value* capacity = nullptr;
+    llvm::AllocaInst* indexAlloc = nullptr;
+    if (fromRange)
+    {
+        std::vector<llvm::Value*> args;
+        for (const auto& arg : static_cast<const CallExprAST*>(expr->getIterable())->getArgs())
+        {
+            llvm::Value* argValue = boxIfNeeded(handleExpr(arg.get()), arg.get());
+            if (!argValue) return nullptr;
+            args.push_back(argValue);
+        }
+        while (args.size() < 3) args.push_back(llvm::ConstantPointerNull::get(ptrType));
+
+        llvm::AllocaInst* startAlloc = codeGen.createEntryBlockAlloca(int64Type, "comp.start");
+        llvm::AllocaInst* stopAlloc = codeGen.createEntryBlockAlloca(int64Type, "comp.stop");
+        llvm::AllocaInst* stepAlloc = codeGen.createEntryBlockAlloca(int64Type, "comp.step");
+        indexAlloc = codeGen.createEntryBlockAlloca(int64Type, "comp.index");
+        llvm::Function* unpackFunc = runtime->getRuntimeFunction(
+                "py_range_unpack", builder.getInt1Ty(),
+                {pyObjectPtrType, pyObjectPtrType, pyObjectPtrType, ptrType, ptrType, ptrType});
+        llvm::Value* unpackOk = builder.CreateCall(unpackFunc, {args[0], args[1], args[2], startAlloc, stopAlloc, stepAlloc}, "comp.range_ok");
+
+        llvm::BasicBlock* rangeErrorBB = llvm::BasicBlock::Create(context, "comp.range_error", currentFunction);
+        llvm::BasicBlock* rangeOkBB = llvm::BasicBlock::Create(context, "comp.range_init", currentFunction);
+        builder.CreateCondBr(unpackOk, rangeOkBB, rangeErrorBB);
+        builder.SetInsertPoint(rangeErrorBB);
+        exitWithError(nullptr);  // 运行时已打印错误信息
+
+        builder.SetInsertPoint(rangeOkBB);
+        start = builder.CreateLoad(int64Type, startAlloc, "start");
+        llvm::Value* stop = builder.CreateLoad(int64Type, stopAlloc, "stop");
+        step = builder.CreateLoad(int64Type, stepAlloc, "step");
+        llvm::Function* lengthFunc = runtime->getRuntimeFunction("py_range_length", int64Type, {int64Type, int64Type, int64Type});
+        count = builder.CreateCall(lengthFunc, {start, stop, step}, "comp.count");
+        builder.CreateStore(llvm::ConstantInt::get(int64Type, 0), indexAlloc);
+
+        // 列表长度为 int: 超出时报错，保证循环内的写入不会越过容量
+        llvm::BasicBlock* tooLargeBB = llvm::BasicBlock::Create(context, "comp.too_large", currentFunction);
+        llvm::BasicBlock* sizedBB = llvm::BasicBlock::Create(context, "comp.sized", currentFunction);
+        builder.CreateCondBr(builder.CreateICmpSGT(count, llvm::ConstantInt::get(int64Type, INT_MAX)), tooLargeBB, sizedBB,
+                             llvm::MDBuilder(context).createBranchWeights(1, 100));
+        builder.SetInsertPoint(tooLargeBB);
+        exitWithError("MemoryError_ListTooLarge");
+        builder.SetInsertPoint(sizedBB);
+        capacity = builder.CreateTrunc(count, int32Type, "comp.capacity");
+    }
+    else
+    {
+        llvm::Value* iterable = boxIfNeeded(handleExpr(expr->getIterable()), expr->getIterable());
+        if (!iterable) return nullptr;
+        llvm::Function* iterFunc = codeGen.getOrCreateExternalFunction("py_iter", pyObjectPtrType, {pyObjectPtrType}, false);
+        iterator = builder.CreateCall(iterFunc, {iterable}, "comp.iter");
+        llvm::BasicBlock* iterErrorBB = llvm::BasicBlock::Create(context, "comp.iter_error", currentFunction);
+        llvm::BasicBlock* iterOkBB = llvm::BasicBlock::Create(context, "comp.iter_ok", currentFunction);
+        builder.CreateCondBr(builder.CreateIsNull(iterator), iterErrorBB, iterOkBB);
+        builder.SetInsertPoint(iterErrorBB);
+        exitWithError("TypeError_NotIterable");
+        builder.SetInsertPoint(iterOkBB);
+        llvm::Function* hintFunc = runtime->getRuntimeFunction("py_object_length_hint", int32Type, {pyObjectPtrType});
+        capacity = builder.CreateCall(hintFunc, {iterable}, "comp.capacity");
+    }
+
+    llvm::Value* list = runtime->createList(capacity, llvm::ConstantInt::get(int32Type, elemTypeId));
+
+    // --- 3. 循环 ---
+    llvm::BasicBlock* headerBB = llvm::BasicBlock::Create(context, "comp.header", currentFunction);
+    llvm::BasicBlock* bodyBB = llvm::BasicBlock::Create(context, "comp.body", currentFunction);
+    llvm::BasicBlock* writeBB = llvm::BasicBlock::Create(context, "comp.write", currentFunction);
+    llvm::BasicBlock* doneBB = llvm::BasicBlock::Create(context, "comp.written", currentFunction);
+    llvm::BasicBlock* latchBB = llvm::BasicBlock::Create(context, "comp.latch", currentFunction);
+    llvm::BasicBlock* endBB = llvm::BasicBlock::Create(context, "comp.end", currentFunction);
+    builder.CreateBr(headerBB);
+
+    builder.SetInsertPoint(headerBB);
+    llvm::Value* item = nullptr;
+    if (fromRange)
+    {
+        llvm::Value* index = builder.CreateLoad(int64Type, indexAlloc, "index");
+        builder.CreateCondBr(builder.CreateICmpSLT(index, count, "has_next"), bodyBB, endBB);
+    }
+    else
+    {
+        llvm::Function* nextFunc = codeGen.getOrCreateExternalFunction("py_next", pyObjectPtrType, {pyObjectPtrType}, false);
+        item = builder.CreateCall(nextFunc, {iterator}, "item");
+        builder.CreateCondBr(builder.CreateIsNull(item, "is_stop_iteration"), endBB, bodyBB);
+    }
+
+    // comp.body: 绑定循环变量 (range 来源的值为 start + index * step)
+    builder.SetInsertPoint(bodyBB);
+    symTable.pushScope();
+    llvm::Value* varValue = nullptr;
+    llvm::Value* varBox = item;  // 每次迭代结束时释放
+    if (fromRange)
+    {
+        llvm::Value* index = builder.CreateLoad(int64Type, indexAlloc, "index");
+        builder.CreateStore(builder.CreateAdd(index, llvm::ConstantInt::get(int64Type, 1)), indexAlloc);
+        varValue = builder.CreateAdd(start, builder.CreateMul(index, step), varName + ".value");
+        if (conditionUsesVar) varBox = runtime->createIntObject(varValue);
+    }
+    if (varBox) symTable.setVariable(varName, varBox, varObjType);
+
+    if (condition)
+    {
+        llvm::Value* keep = codeGen.getStmtGen()->handleCondition(condition);
+        if (!keep)
+        {
+            symTable.popScope(codeGen);
+            return nullptr;
+        }
+        builder.CreateCondBr(keep, writeBB, latchBB);
+    }
+    else
+    {
+        builder.CreateBr(writeBB);
+    }
+
+    // comp.write: length 只在本循环内增长，容量已按来源长度预留
+    builder.SetInsertPoint(writeBB);
+    llvm::Value* lengthPtr = builder.CreateStructGEP(listStructType, list, 1, "length_ptr");
+    llvm::Value* length = builder.CreateLoad(int32Type, lengthPtr, "length");
+    if (!fromRange)
+    {
+        // 迭代器来源的长度只是提示，写满时扩容
+        llvm::Value* cap = builder.CreateLoad(int32Type, builder.CreateStructGEP(listStructType, list, 2), "capacity");
+        llvm::BasicBlock* growBB = llvm::BasicBlock::Create(context, "comp.grow", currentFunction);
+        llvm::BasicBlock* roomBB = llvm::BasicBlock::Create(context, "comp.room", currentFunction);
+        builder.CreateCondBr(builder.CreateICmpSGE(length, cap), growBB, roomBB, llvm::MDBuilder(context).createBranchWeights(1, 100));
+        builder.SetInsertPoint(growBB);
+        llvm::Function* reserveFunc = runtime->getRuntimeFunction("py_list_reserve", builder.getInt1Ty(), {pyObjectPtrType, int32Type});
+        builder.CreateCall(reserveFunc, {list, builder.CreateAdd(length, llvm::ConstantInt::get(int32Type, 1))});
+        builder.CreateBr(roomBB);
+        builder.SetInsertPoint(roomBB);
+    }
+
+    llvm::Function* storeFunc = runtime->getRuntimeFunction(
+            "py_list_store_reserved", builder.getInt1Ty(), {pyObjectPtrType, int32Type, pyObjectPtrType});
+    auto loadStorageIs = [&](int storageKind)
+    {
+        llvm::Value* storage = builder.CreateLoad(int32Type, builder.CreateStructGEP(listStructType, list, 4), "storage");
+        return builder.CreateICmpEQ(storage, llvm::ConstantInt::get(int32Type, storageKind));
+    };
+    // 装箱元素: 装箱存储直接写 data[length] 并持有引用，否则交给运行时按当前存储写入
+    auto storeBoxed = [&](llvm::Value* value)
+    {
+        llvm::BasicBlock* inlineBB = llvm::BasicBlock::Create(context, "comp.store_boxed", currentFunction);
+        llvm::BasicBlock* nextBB = llvm::BasicBlock::Create(context, "comp.stored", currentFunction);
+        if (unboxedStorage)
+        {
+            // 非装箱列表只会退化为装箱存储，不会反向转换
+            llvm::BasicBlock* runtimeBB = llvm::BasicBlock::Create(context, "comp.store_runtime", currentFunction);
+            builder.CreateCondBr(loadStorageIs(0), inlineBB, runtimeBB);  // PY_LIST_STORAGE_BOXED
+            builder.SetInsertPoint(runtimeBB);
+            builder.CreateCall(storeFunc, {list, length, value});
+            builder.CreateBr(nextBB);
+        }
+        else
+        {
+            builder.CreateBr(inlineBB);
+        }
+        builder.SetInsertPoint(inlineBB);
+        llvm::Value* data = builder.CreateLoad(ptrType, builder.CreateStructGEP(listStructType, list, 5), "data");
+        builder.CreateStore(value, builder.CreateInBoundsGEP(pyObjectPtrType, data, length, "slot_ptr"));
+        runtime->incRef(value);
+        builder.CreateBr(nextBB);
+        builder.SetInsertPoint(nextBB);
+    };
+
+    llvm::BasicBlock* genericBB = llvm::BasicBlock::Create(context, "comp.generic", currentFunction);
+    if (nativeElement)
+    {
+        llvm::Value* overflow = builder.getFalse();
+        llvm::Value* nativeValue = emitNativeIntElement(builder, expr->getElement(), varValue, overflow);
+        llvm::BasicBlock* nativeBB = llvm::BasicBlock::Create(context, "comp.native", currentFunction);
+        builder.CreateCondBr(overflow, genericBB, nativeBB, llvm::MDBuilder(context).createBranchWeights(1, 100));
+
+        // comp.native: INT64 存储直接写 ints[length]；已退化为装箱存储时装箱后写入
+        builder.SetInsertPoint(nativeBB);
+        llvm::BasicBlock* intStoreBB = llvm::BasicBlock::Create(context, "comp.store_int", currentFunction);
+        llvm::BasicBlock* boxStoreBB = llvm::BasicBlock::Create(context, "comp.store_box_int", currentFunction);
+        builder.CreateCondBr(loadStorageIs(1), intStoreBB, boxStoreBB);  // PY_LIST_STORAGE_INT64
+        builder.SetInsertPoint(intStoreBB);
+        llvm::Value* ints = builder.CreateLoad(ptrType, builder.CreateStructGEP(listStructType, list, 5), "ints");
+        builder.CreateStore(nativeValue, builder.CreateInBoundsGEP(int64Type, ints, length, "int_slot_ptr"));
+        builder.CreateBr(doneBB);
+        builder.SetInsertPoint(boxStoreBB);
+        llvm::Value* boxedValue = runtime->createIntObject(nativeValue);
+        builder.CreateCall(storeFunc, {list, length, boxedValue});
+        runtime->decRef(boxedValue);
+        builder.CreateBr(doneBB);
+    }
+    else
+    {
+        builder.CreateBr(genericBB);
+    }
+
+    // comp.generic: 装箱计算元素
+    builder.SetInsertPoint(genericBB);
+    llvm::Value* localBox = nullptr;
+    if (elementUsesVar && !varBox)
+    {
+        localBox = runtime->createIntObject(varValue);
+        symTable.setVariable(varName, localBox, varObjType);
+    }
+    llvm::Value* element = boxIfNeeded(handleExpr(expr->getElement()), expr->getElement());
+    if (!element)
+    {
+        symTable.popScope(codeGen);
+        return nullptr;
+    }
+    storeBoxed(element);
+    if (localBox) runtime->decRef(localBox);
+    builder.CreateBr(doneBB);
+
+    builder.SetInsertPoint(doneBB);
+    builder.CreateStore(builder.CreateAdd(length, llvm::ConstantInt::get(int32Type, 1)), lengthPtr);
+    builder.CreateBr(latchBB);
+
+    builder.SetInsertPoint(latchBB);
+    if (varBox) runtime->decRef(varBox);
+    builder.CreateBr(headerBB);
+    symTable.popScope(codeGen);
+
+    builder.SetInsertPoint(endBB);
+    if (iterator) runtime->decRef(iterator);
+
+    runtime->markObjectSource(list, ObjectLifecycleManager::ObjectSource::LITERAL);
+    return list;
+}
+
 // 二元操作处理函数
 llvm::Value* CodeGenExpr::handleBinOp(PyTokenType op, llvm::Value* L, llvm::Value* R,
                                       std::shared_ptr<PyType> leftType,
@@ -783,6 +1397,36 @@ llvm::Value* CodeGenExpr::handleBinOp(PyTokenType op, llvm::Value* L, llvm::Valu
     // 使用TypeOperations处理二元操作
     auto& registry = TypeOperationRegistry::getInstance();
 
+    // 成员测试只按右侧容器分派 ('x in c' 的左操作数可以是任意类型)，not in 对结果取反
+    if (op == TOK_IN || op == TOK_NOT_IN)
+    {
+        BinaryOpDescriptor* containsDesc = registry.getBinaryOpDescriptor(op, PY_TYPE_ANY, rightTypeId);
+        if (!containsDesc) containsDesc = registry.getBinaryOpDescriptor(op, PY_TYPE_ANY, PY_TYPE_ANY);
+        if (!containsDesc)
+        {
+            return codeGen.logError("Unsupported membership test on " + rightType->getObjectType()->getName());
+        }
+
+        PyCodeGen* pyCodeGen = codeGen.asPyCodeGen();
+        if (!L->getType()->isPointerTy() && pyCodeGen) L = OperationCodeGenerator::createObject(*pyCodeGen, L, leftTypeId);
+        if (!R->getType()->isPointerTy() && pyCodeGen) R = OperationCodeGenerator::createObject(*pyCodeGen, R, rightTypeId);
+
+        auto& builder = codeGen.getBuilder();
+        llvm::Type* pyObjectPtrType = llvm::PointerType::get(codeGen.getContext(), 0);
+        llvm::Function* containsFunc = runtime->getRuntimeFunction(
+                containsDesc->runtimeFunction, pyObjectPtrType, {pyObjectPtrType, pyObjectPtrType});
+        llvm::Value* result = builder.CreateCall(containsFunc, {L, R}, "contains_result");
+        if (op == TOK_NOT_IN)
+        {
+            llvm::Function* notFunc = runtime->getRuntimeFunction("py_object_not", pyObjectPtrType, {pyObjectPtrType});
+            llvm::Value* negated = builder.CreateCall(notFunc, {result}, "not_contains_result");
+            runtime->decRef(result);
+            result = negated;
+        }
+        runtime->markObjectSource(result, ObjectLifecycleManager::ObjectSource::BINARY_OP);
+        return result;
+    }
+
     // 查找操作描述符
     BinaryOpDescriptor* desc = registry.getBinaryOpDescriptor(op, leftTypeId, rightTypeId);
 
@@ -1044,16 +1688,198 @@ llvm::Value* CodeGenExpr::handleIndexOperation(llvm::Value* target, llvm::Value*
     return builder.CreateCall(indexFunc, {target, index}, "index_result");
 }
 
+//===----------------------------------------------------------------------===//
+// 列表下标内联访问
+//===----------------------------------------------------------------------===//
+
+/**
+ * @brief 生成 a[i] 的内联读取: 条件满足时直接按存储策略读取 PyListObject::data，
+ * 否则 (非列表、负数或多 limb 下标、越界) 退回 handleIndexOperation，由运行时处理负下标并报错。
+ *
+ * 循环条件已证明 0 <= i < len(a) 时 (ListBoundsFact)，复用条件块中的判断和 int64 下标。
+ */
+llvm::Value* CodeGenExpr::handleListIndexInline(IndexExprAST* expr, llvm::Value* list, llvm::Value* index)
+{
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+
+    llvm::Value* inRange = nullptr;
+    llvm::Value* index64 = nullptr;
+    const ListBoundsFact& fact = listBoundsFact;
+    auto* targetVar = dynamic_cast<const VariableExprAST*>(expr->getTarget());
+    auto* indexVar = dynamic_cast<const VariableExprAST*>(expr->getIndex());
+    if (fact.function == currentFunction && targetVar && indexVar
+        && codeGen.getSymbolTable().getVariable(targetVar->getName()) == fact.listStorage
+        && codeGen.getSymbolTable().getVariable(indexVar->getName()) == fact.indexStorage)
+    {
+        inRange = fact.inRange;
+        index64 = fact.index64;
+    }
+    else
+    {
+        std::tie(inRange, index64) = emitListIndexCheck(list, index);
+    }
+
+    llvm::BasicBlock* fastBB = llvm::BasicBlock::Create(context, "list_index.fast", currentFunction);
+    llvm::BasicBlock* slowBB = llvm::BasicBlock::Create(context, "list_index.slow", currentFunction);
+    llvm::BasicBlock* mergeBB = llvm::BasicBlock::Create(context, "list_index.done", currentFunction);
+    builder.CreateCondBr(inRange, fastBB, slowBB, llvm::MDBuilder(context).createBranchWeights(100, 1));
+
+    builder.SetInsertPoint(fastBB);
+    llvm::Value* fastItem = emitListItemLoad(list, index64);
+    llvm::BasicBlock* fastEndBB = builder.GetInsertBlock();
+    builder.CreateBr(mergeBB);
+
+    // 静态类型只是推断结果 (运行时可能是元组或字符串)，慢路径走原有的索引分派
+    builder.SetInsertPoint(slowBB);
+    llvm::Value* slowItem = handleIndexOperation(list, index, expr->getTarget()->getType(), expr->getIndex()->getType());
+    if (!slowItem) return nullptr;
+    llvm::BasicBlock* slowEndBB = builder.GetInsertBlock();
+    builder.CreateBr(mergeBB);
+
+    builder.SetInsertPoint(mergeBB);
+    llvm::PHINode* item = builder.CreatePHI(pyObjectPtrType, 2, "list_item");
+    item->addIncoming(fastItem, fastEndBB);
+    item->addIncoming(slowItem, slowEndBB);
+    return item;
+}
+
+// list 的运行时 typeId 为 LIST (或 LIST_BASE 派生 ID)，index 为 _mp_size 为 0 或 1 的 int，且值小于 length
+std::pair<llvm::Value*, llvm::Value*> CodeGenExpr::emitListIndexCheck(llvm::Value* list, llvm::Value* index)
+{
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    llvm::Type* int32Type = builder.getInt32Ty();
+    llvm::Type* int64Type = builder.getInt64Ty();
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
+    llvm::StructType* intObjType = runtime->getPyIntObjectType();
+    llvm::Constant* zero64 = llvm::ConstantInt::get(int64Type, 0);
+
+    llvm::BasicBlock* indexTypeBB = llvm::BasicBlock::Create(context, "list_index.check_int", currentFunction);
+    llvm::BasicBlock* decodeBB = llvm::BasicBlock::Create(context, "list_index.decode", currentFunction);
+    llvm::BasicBlock* limbBB = llvm::BasicBlock::Create(context, "list_index.limb", currentFunction);
+    llvm::BasicBlock* boundsBB = llvm::BasicBlock::Create(context, "list_index.bounds", currentFunction);
+    llvm::BasicBlock* doneBB = llvm::BasicBlock::Create(context, "list_index.checked", currentFunction);
+
+    // 1. 列表类型
+    llvm::Value* typeId = runtime->loadTypeId(list, "list_typeid");
+    llvm::Value* isPlainList = builder.CreateICmpEQ(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_LIST));
+    llvm::Value* isDerivedList = builder.CreateAnd(
+            builder.CreateICmpSGE(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_LIST_BASE)),
+            builder.CreateICmpSLT(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_DICT_BASE)));
+    llvm::BasicBlock* listCheckBB = builder.GetInsertBlock();
+    builder.CreateCondBr(builder.CreateOr(isPlainList, isDerivedList, "is_list"), indexTypeBB, doneBB);
+
+    // 2. 下标是 int (bool 等其他类型交给运行时)
+    builder.SetInsertPoint(indexTypeBB);
+    llvm::Value* indexTypeId = runtime->loadTypeId(index, "index_typeid");
+    builder.CreateCondBr(builder.CreateICmpEQ(indexTypeId, llvm::ConstantInt::get(int32Type, PY_TYPE_INT)), decodeBB, doneBB);
+
+    // 3. 解码 mpz: 0 个 limb 为 0，1 个 limb 为非负值；负数和大整数交给运行时
+    builder.SetInsertPoint(decodeBB);
+    llvm::Value* mpSize = builder.CreateLoad(int32Type, builder.CreateStructGEP(intObjType, index, 2), "index_mp_size");
+    llvm::SwitchInst* sizeSwitch = builder.CreateSwitch(mpSize, doneBB, 2);
+    sizeSwitch->addCase(llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(int32Type), 0), boundsBB);
+    sizeSwitch->addCase(llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(int32Type), 1), limbBB);
+
+    builder.SetInsertPoint(limbBB);
+    llvm::Value* limbs = builder.CreateLoad(ptrType, builder.CreateStructGEP(intObjType, index, 3), "index_mp_d");
+    llvm::Value* limb = builder.CreateLoad(int64Type, limbs, "index_limb");
+    builder.CreateBr(boundsBB);
+
+    // 4. 边界: 无符号比较 (limb 可能超过 INT64_MAX)
+    builder.SetInsertPoint(boundsBB);
+    llvm::PHINode* decoded = builder.CreatePHI(int64Type, 2, "index_i64");
+    decoded->addIncoming(zero64, decodeBB);
+    decoded->addIncoming(limb, limbBB);
+    llvm::Value* length = builder.CreateLoad(int32Type, builder.CreateStructGEP(runtime->getPyListStructType(), list, 1), "list_length");
+    llvm::Value* inBounds = builder.CreateICmpULT(decoded, builder.CreateZExt(length, int64Type), "index_in_bounds");
+    builder.CreateBr(doneBB);
+
+    builder.SetInsertPoint(doneBB);
+    llvm::PHINode* inRange = builder.CreatePHI(builder.getInt1Ty(), 4, "index_in_range");
+    llvm::PHINode* index64 = builder.CreatePHI(int64Type, 4, "index_value");
+    llvm::Constant* falseValue = builder.getFalse();
+    for (llvm::BasicBlock* pred : {listCheckBB, indexTypeBB, decodeBB})
+    {
+        inRange->addIncoming(falseValue, pred);
+        index64->addIncoming(zero64, pred);
+    }
+    inRange->addIncoming(inBounds, boundsBB);
+    index64->addIncoming(decoded, boundsBB);
+    return {inRange, index64};
+}
+
+llvm::Value* CodeGenExpr::emitListItemLoad(llvm::Value* list, llvm::Value* index64)
+{
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+    llvm::Type* int32Type = builder.getInt32Ty();
+    llvm::Type* int64Type = builder.getInt64Ty();
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
+    llvm::StructType* listStructType = runtime->getPyListStructType();
+
+    // 存储策略与缓冲区每次重新读取 (异构写入会使列表退化为装箱存储)
+    llvm::Value* storage = builder.CreateLoad(int32Type, builder.CreateStructGEP(listStructType, list, 4), "list_storage");
+    llvm::Value* data = builder.CreateLoad(ptrType, builder.CreateStructGEP(listStructType, list, 5), "list_data");
+
+    llvm::BasicBlock* boxedBB = llvm::BasicBlock::Create(context, "list_index.boxed", currentFunction);
+    llvm::BasicBlock* boxedHitBB = llvm::BasicBlock::Create(context, "list_index.boxed_hit", currentFunction);
+    llvm::BasicBlock* intBB = llvm::BasicBlock::Create(context, "list_index.int", currentFunction);
+    llvm::BasicBlock* boxItemBB = llvm::BasicBlock::Create(context, "list_index.box_item", currentFunction);
+    llvm::BasicBlock* loadedBB = llvm::BasicBlock::Create(context, "list_index.loaded", currentFunction);
+    llvm::SwitchInst* storageSwitch = builder.CreateSwitch(storage, boxItemBB, 2);
+    storageSwitch->addCase(llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(int32Type), 0), boxedBB);  // PY_LIST_STORAGE_BOXED
+    storageSwitch->addCase(llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(int32Type), 1), intBB);    // PY_LIST_STORAGE_INT64
+
+    // BOXED: 读槽位并 incref；空槽位交给 py_list_box_item (返回 None)
+    builder.SetInsertPoint(boxedBB);
+    llvm::Value* boxedItem = builder.CreateLoad(pyObjectPtrType, builder.CreateInBoundsGEP(pyObjectPtrType, data, index64), "boxed_item");
+    builder.CreateCondBr(builder.CreateIsNull(boxedItem), boxItemBB, boxedHitBB);
+    builder.SetInsertPoint(boxedHitBB);
+    runtime->incRef(boxedItem);
+    builder.CreateBr(loadedBB);
+
+    // INT64: 装箱 int64 值
+    builder.SetInsertPoint(intBB);
+    llvm::Value* intItem = runtime->createIntObject(builder.CreateLoad(int64Type, builder.CreateInBoundsGEP(int64Type, data, index64), "int_value"));
+    builder.CreateBr(loadedBB);
+
+    // 其余存储 (double/bool 位图) 以及空槽位
+    builder.SetInsertPoint(boxItemBB);
+    llvm::Function* boxItemFunc = runtime->getRuntimeFunction("py_list_box_item", pyObjectPtrType, {pyObjectPtrType, int32Type});
+    llvm::Value* slowItem = builder.CreateCall(boxItemFunc, {list, builder.CreateTrunc(index64, int32Type)}, "boxed_slow");
+    builder.CreateBr(loadedBB);
+
+    builder.SetInsertPoint(loadedBB);
+    llvm::PHINode* item = builder.CreatePHI(pyObjectPtrType, 3, "list_item_fast");
+    item->addIncoming(boxedItem, boxedHitBB);
+    item->addIncoming(intItem, intBB);
+    item->addIncoming(slowItem, boxItemBB);
+    return item;
+}
+
 // 在CodeGenRuntime类的public部分添加:
 
 // 代理对象创建方法
-llvm::Value* CodeGenRuntime::createIntObject(llvm::Value* value)  // Takes LLVM i32
+llvm::Value* CodeGenRuntime::createIntObject(llvm::Value* value)  // Takes LLVM integer (i32/i64)
 {
+    // py_create_int 的参数是 long long，较窄的整数先符号扩展
+    llvm::Type* int64Type = llvm::Type::getInt64Ty(codeGen.getContext());
     llvm::Function* createFunc = getRuntimeFunction(
             "py_create_int",
             llvm::PointerType::get(codeGen.getContext(), 0),
-            {llvm::Type::getInt32Ty(codeGen.getContext())});
-    return codeGen.getBuilder().CreateCall(createFunc, {value}, "int_obj");
+            {int64Type});
+    llvm::Value* arg = codeGen.getBuilder().CreateSExtOrTrunc(value, int64Type);
+    return codeGen.getBuilder().CreateCall(createFunc, {arg}, "int_obj");
 }
 
 llvm::Value* CodeGenRuntime::createDoubleObject(llvm::Value* value)  // Takes LLVM double
@@ -1095,6 +1921,21 @@ llvm::Value* CodeGenRuntime::createStringObject(llvm::Value* value)
     return codeGen.getBuilder().CreateCall(createFunc, {value}, "str_obj");
 }
 
+// 字面量常量: 每个字面量一个初始为 NULL 的内部全局槽位，由 runtimeFunc (py_const_*) 在第一次求值时填充。
+// 结果是永生对象，RefCountElision 会删掉对它的 incref / decref。
+llvm::Value* CodeGenRuntime::createConstantObject(const char* runtimeFunc, const std::string& text, const char* name)
+{
+    auto& context = codeGen.getContext();
+    auto& builder = codeGen.getBuilder();
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
+
+    llvm::Function* constFunc = getRuntimeFunction(runtimeFunc, ptrType, {ptrType, ptrType});
+    auto* slot = new llvm::GlobalVariable(*codeGen.getModule(), ptrType, false, llvm::GlobalValue::InternalLinkage,
+                                          llvm::ConstantPointerNull::get(ptrType), std::string(name) + ".slot");
+    llvm::Value* textPtr = builder.CreateGlobalString(text, std::string(name) + ".text");
+    return builder.CreateCall(constFunc, {slot, textPtr}, name);
+}
+
 // 创建整数字面量 (original, takes int)
 llvm::Value* CodeGenExpr::createIntLiteral(int value)
 {
@@ -1156,28 +1997,19 @@ llvm::Value* CodeGenExpr::createDoubleLiteral(double value)
 // 创建整数字面量
 llvm::Value* CodeGenExpr::createIntLiteralFromString(const std::string& value)
 {
-    auto& builder = codeGen.getBuilder();
     auto* runtime = codeGen.getRuntimeGen();
 
-    // 创建 C 字符串常量 (as global)
-    // Note: LLVM may optimize identical constants. Runtime function should copy if needed.
-    llvm::Value* strPtr = builder.CreateGlobalString(value, "int_str_const");
-
-    // 使用运行时从字符串创建整数对象
-    return runtime->createIntObjectFromString(strPtr);
+    // 字面量是模块级的永生常量，第一次求值时由运行时创建
+    return runtime->createConstantObject("py_const_int", value, "int_const");
 }
 
 // 创建浮点数字面量
 llvm::Value* CodeGenExpr::createDoubleLiteralFromString(const std::string& value)
 {
-    auto& builder = codeGen.getBuilder();
     auto* runtime = codeGen.getRuntimeGen();
 
-    // 创建 C 字符串常量 (as global)
-    llvm::Value* strPtr = builder.CreateGlobalString(value, "double_str_const");
-
-    // 使用运行时从字符串创建浮点数对象
-    return runtime->createDoubleObjectFromString(strPtr);
+    // 字面量是模块级的永生常量，第一次求值时由运行时创建
+    return runtime->createConstantObject("py_const_double", value, "double_const");
 }
 
 // 创建布尔字面量
@@ -1197,14 +2029,10 @@ llvm::Value* CodeGenExpr::createBoolLiteral(bool value)
 // 创建字符串字面量
 llvm::Value* CodeGenExpr::createStringLiteral(const std::string& value)
 {
-    auto& builder = codeGen.getBuilder();
     auto* runtime = codeGen.getRuntimeGen();
 
-    // 创建字符串常量
-    llvm::Value* strPtr = builder.CreateGlobalString(value, "str_const");
-
-    // 使用运行时创建字符串对象
-    return runtime->createStringObject(strPtr);
+    // 字符串字面量按内容驻留，每个字面量另有一个全局槽位缓存驻留的结果
+    return runtime->createConstantObject("py_const_string", value, "str_const");
 }
 
 // 创建None字面量
@@ -1235,49 +2063,100 @@ llvm::Value* CodeGenExpr::createDict(ObjectType* keyType, ObjectType* valueType)
     return dictObj;
 }
 
-// 创建带有初始键值对的字典
-// 创建带有初始键值对的字典
+// 创建带有初始键值对的字典: 运行时按键值对个数 (py_dict_capacity_for) 只分配一次条目表，
+// 插入时不再检查扩容
 llvm::Value* CodeGenExpr::createDictWithPairs(
         const std::vector<std::pair<llvm::Value*, llvm::Value*>>& pairs,
         ObjectType* keyType,
-        ObjectType* valueType)
+        bool stealValues)
 {
     auto* runtime = codeGen.getRuntimeGen();
+    auto& context = codeGen.getContext();
+    auto& builder = codeGen.getBuilder();
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
 
-    // 1. 创建空字典
-    llvm::Value* dictObj = createDict(keyType, valueType);
-    if (!dictObj)
-    {
-        return nullptr;  // 错误已在 createDict 中记录
-    }
-
-    // 2. 填充键值对
-    for (const auto& pair : pairs)
+    // 1. 键值交替写入栈上的指针数组
+    llvm::Value* itemsPtr = llvm::ConstantPointerNull::get(ptrType);
+    if (!pairs.empty())
     {
-        llvm::Value* key = pair.first;
-        llvm::Value* value = pair.second;
-
-        if (!key || !value)
+        llvm::ArrayType* bufType = llvm::ArrayType::get(ptrType, pairs.size() * 2);
+        llvm::AllocaInst* buf = codeGen.createEntryBlockAlloca(bufType, "dict.items");
+        for (size_t i = 0; i < pairs.size(); ++i)
         {
-            codeGen.logError("Invalid key or value provided to createDictWithPairs");
-            // 如果错误处理需要，考虑对 dictObj 进行 decref
-            return nullptr;
+            if (!pairs[i].first || !pairs[i].second)
+            {
+                codeGen.logError("Invalid key or value provided to createDictWithPairs");
+                return nullptr;
+            }
+            builder.CreateStore(pairs[i].first, builder.CreateConstInBoundsGEP2_32(bufType, buf, 0, 2 * i));
+            builder.CreateStore(pairs[i].second, builder.CreateConstInBoundsGEP2_32(bufType, buf, 0, 2 * i + 1));
         }
+        itemsPtr = buf;
+    }
 
-        // 3. 使用 CodeGenExpr 代理方法设置项
-        // 这里不容易获得整体的 dict PyType，传递 nullptr。
-        setDictItem(dictObj, key, value, nullptr);
+    // 2. 一次性构建 (steal 时直接接管键值的引用，否则由运行时增加引用)
+    llvm::Function* fromPairsFunc = runtime->getRuntimeFunction(
+            "py_create_dict_from_pairs", ptrType,
+            {ptrType, int32Type, int32Type, llvm::Type::getInt1Ty(context)});
+    return builder.CreateCall(fromPairsFunc,
+                              {itemsPtr,
+                               llvm::ConstantInt::get(int32Type, pairs.size()),
+                               llvm::ConstantInt::get(int32Type, OperationCodeGenerator::getTypeId(keyType)),
+                               builder.getInt1(stealValues)},
+                              "dict_obj");
+}
 
-        // 4. 引用计数:
-        // py_dict_set_item 在插入 *新* 项或替换现有项时内部处理 incref。
-        // 这里不需要显式的 incRef。
-        // runtime->incRef(key);   // 不需要 - 由 py_dict_set_item 处理
-        // runtime->incRef(value); // 不需要 - 由 py_dict_set_item 处理
+/**
+ * @brief 常量字典字面量: 每个字面量对应一个内部全局变量，首次求值时构建字典作为模板存入，
+ * 之后每次求值只调用 py_dict_clone: 副本借用模板的条目表，直到第一次写入副本时才复制出自己的表，
+ * 不再重新哈希。模板由全局变量持有、从不交给用户代码，因此永远不会被写入或释放。
+ */
+llvm::Value* CodeGenExpr::createDictFromTemplate(DictExprAST* expr, ObjectType* keyType)
+{
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& context = codeGen.getContext();
+    auto& builder = codeGen.getBuilder();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
+
+    auto* templateGV = new llvm::GlobalVariable(
+            *codeGen.getModule(),
+            ptrType,
+            false,  // isConstant
+            llvm::GlobalValue::InternalLinkage,
+            llvm::ConstantPointerNull::get(ptrType),
+            "dict_template");
+
+    llvm::BasicBlock* checkBB = builder.GetInsertBlock();
+    llvm::BasicBlock* buildBB = llvm::BasicBlock::Create(context, "dict_template.build", currentFunction);
+    llvm::BasicBlock* readyBB = llvm::BasicBlock::Create(context, "dict_template.ready", currentFunction);
+    llvm::Value* cached = builder.CreateLoad(ptrType, templateGV, "dict_template");
+    builder.CreateCondBr(builder.CreateIsNull(cached), buildBB, readyBB, llvm::MDBuilder(context).createBranchWeights(1, 100));
+
+    // 首次求值: 构建模板 (字典接管新建的常量对象)
+    builder.SetInsertPoint(buildBB);
+    std::vector<std::pair<llvm::Value*, llvm::Value*>> pairValues;
+    for (const auto& pair : expr->getPairs())
+    {
+        llvm::Value* keyVal = handleExpr(pair.first.get());
+        llvm::Value* valueVal = handleExpr(pair.second.get());
+        if (!keyVal || !valueVal) return nullptr;
+        pairValues.emplace_back(keyVal, valueVal);
     }
-
-    // 可选：如果 runtime->createDict 未处理，则标记来源
-    // runtime->markObjectSource(dictObj, ObjectLifecycleManager::ObjectSource::LITERAL);
-    return dictObj;
+    llvm::Value* built = createDictWithPairs(pairValues, keyType, true);
+    if (!built) return nullptr;
+    builder.CreateStore(built, templateGV);
+    llvm::BasicBlock* buildEndBB = builder.GetInsertBlock();
+    builder.CreateBr(readyBB);
+
+    builder.SetInsertPoint(readyBB);
+    llvm::PHINode* templateDict = builder.CreatePHI(ptrType, 2, "dict_template_obj");
+    templateDict->addIncoming(cached, checkBB);
+    templateDict->addIncoming(built, buildEndBB);
+
+    llvm::Function* cloneFunc = runtime->getRuntimeFunction("py_dict_clone", ptrType, {ptrType});
+    return builder.CreateCall(cloneFunc, {templateDict}, "dict_obj");
 }
 
 // 获取字典项 (如果需要，可以实现)
@@ -1345,15 +2224,15 @@ llvm::Value* CodeGenExpr::createList(int size, std::shared_ptr<PyType> elemType)
 
 // 创建带有初始值的列表
 llvm::Value* CodeGenExpr::createListWithValues(const std::vector<llvm::Value*>& values,
-                                               std::shared_ptr<PyType> elemType)
+                                               std::shared_ptr<PyType> elemType,
+                                               bool stealValues)
 {
     auto* runtime = codeGen.getRuntimeGen();
     auto& context = codeGen.getContext();
+    auto& builder = codeGen.getBuilder();
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
 
-    // 1. 创建一个初始为空的列表 (长度为0)，但可以指定初始容量
-    //    传递 values.size() 作为初始容量提示
-    llvm::Value* initialCapacity = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), values.size());
-    // --- FIX 1: Use getObjectType() ---
     int elemTypeIdInt = OperationCodeGenerator::getTypeId(elemType->getObjectType());  // 获取元素类型ID
 
 #ifdef DEBUG_CODEGEN_createListWithValues
@@ -1364,47 +2243,35 @@ llvm::Value* CodeGenExpr::createListWithValues(const std::vector<llvm::Value*>&
 // --- DEBUGGING END ---
 #endif
 
-    llvm::Value* elemTypeIdValue = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), elemTypeIdInt);
-    // --- 修改 CodeGenRuntime::createList 的调用签名以匹配 ---
-    // --- Call assumes createList now takes llvm::Value* for type ID ---
-    llvm::Value* list = runtime->createList(initialCapacity, elemTypeIdValue);  // createList 现在接收 i32 容量和 i32 类型ID
-
-    if (!list)
+    // 1. 元素写入栈上的指针数组
+    llvm::Value* itemsPtr = llvm::ConstantPointerNull::get(ptrType);
+    if (!values.empty())
     {
-        codeGen.logError("Failed to create list object");
-        return nullptr;
-    }
-
-    // 2. 循环调用 py_list_append 添加元素
-    llvm::Function* appendFunc = runtime->getRuntimeFunction(
-            "py_list_append",
-            llvm::PointerType::get(context, 0),   // Return: PyObject* (the list itself or NULL on error)
-            {llvm::PointerType::get(context, 0),  // Arg 1: PyObject* (list)
-             llvm::PointerType::get(context, 0)}  // Arg 2: PyObject* (item)
-    );
-
-    for (size_t i = 0; i < values.size(); ++i)
-    {
-        llvm::Value* item = values[i];
-        if (!item)
+        llvm::ArrayType* bufType = llvm::ArrayType::get(ptrType, values.size());
+        llvm::AllocaInst* buf = codeGen.createEntryBlockAlloca(bufType, "list.items");
+        for (size_t i = 0; i < values.size(); ++i)
         {
-            // Should not happen if previous codegen succeeded, but check defensively
-            codeGen.logError("NULL value encountered while creating list literal at index " + std::to_string(i));
-            // Cleanup: decref the partially built list and already appended items? Complex.
-            // For now, just return null.
-            runtime->decRef(list);  // Decref the list itself
-            return nullptr;
+            if (!values[i])
+            {
+                // Should not happen if previous codegen succeeded, but check defensively
+                codeGen.logError("NULL value encountered while creating list literal at index " + std::to_string(i));
+                return nullptr;
+            }
+            builder.CreateStore(values[i], builder.CreateConstInBoundsGEP2_32(bufType, buf, 0, i));
         }
-
-        // 调用 py_list_append
-        // py_list_append 内部会处理引用计数 (incref item)
-        codeGen.getBuilder().CreateCall(appendFunc, {list, item});
-
-        // 注意：不再需要创建和管理 Python 索引对象
-        // 注意：不再需要手动调用 runtime->incRef(item)，因为 py_list_append 会做
+        itemsPtr = buf;
     }
 
-    return list;  // 返回构建好的列表
+    // 2. 一次分配出列表并填入全部元素 (装箱存储时由运行时增加引用，steal 时直接接管)
+    llvm::Function* fromArrayFunc = runtime->getRuntimeFunction(
+            "py_create_list_from_array", ptrType,
+            {ptrType, int32Type, int32Type, llvm::Type::getInt1Ty(context)});
+    return builder.CreateCall(fromArrayFunc,
+                              {itemsPtr,
+                               llvm::ConstantInt::get(int32Type, values.size()),
+                               llvm::ConstantInt::get(int32Type, elemTypeIdInt),
+                               builder.getInt1(stealValues)},
+                              "list_obj");
 }
 
 // 获取列表元素
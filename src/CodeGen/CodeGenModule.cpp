@@ -693,7 +693,7 @@ void CodeGenModule::addRuntimeFunctions()
         codeGen.getOrCreateExternalFunction(
                 "py_create_int",
                 llvm::PointerType::get(codeGen.getContext(), 0),
-                {llvm::Type::getInt32Ty(codeGen.getContext())},
+                {llvm::Type::getInt64Ty(codeGen.getContext())},
                 false);
     }
 
@@ -1082,6 +1082,7 @@ llvm::Function* CodeGenModule::handleFunctionDef(const FunctionAST* funcAST)  //
 
     // Pass resolved paramTypes to handleFunctionParams
     handleFunctionParams(function, funcAST->getParams(), paramTypes);  // Handle params AFTER pushing scope
+    auto savedAppendFlags = stmtGen->beginStringAppendTracking(funcAST);
 
 #ifdef DEBUG_CODEGEN_handleFunctionDef
     DEBUG_LOG_DETAIL("HdlFuncDef", "Params handled. Generating body stmts...");
@@ -1093,6 +1094,7 @@ llvm::Function* CodeGenModule::handleFunctionDef(const FunctionAST* funcAST)  //
         {
             codeGen.logError("Builder left the current function '" + uniqueFuncName + "' unexpectedly during body generation.", stmt->line.value_or(0), stmt->column.value_or(0));
             stmtGen->endScope();                        // Pop scope before returning
+            stmtGen->endStringAppendTracking(std::move(savedAppendFlags));
             codeGen.setCurrentFunction(savedFunction);  // Restore context
             codeGen.setCurrentReturnType(savedReturnTypeCtx);
             if (savedIP.getBlock()) codeGen.getBuilder().restoreIP(savedIP);
@@ -1115,6 +1117,7 @@ llvm::Function* CodeGenModule::handleFunctionDef(const FunctionAST* funcAST)  //
     DEBUG_LOG_DETAIL("HdlFuncDef", "Finished handling body stmts. Popping scope...");
 #endif
     stmtGen->endScope();  // Pop function body scope
+    stmtGen->endStringAppendTracking(std::move(savedAppendFlags));
 
     // --- 添加默认返回 (如果需要) ---
     llvm::BasicBlock* lastBlock = codeGen.getBuilder().GetInsertBlock();
@@ -247,6 +247,9 @@ ObjectLifecycleManager::ObjectSource CodeGenRuntime::determineExprSource(const E
         case ASTKind::BoolExpr:
         case ASTKind::NoneExpr:
         case ASTKind::ListExpr:
+        case ASTKind::TupleExpr:
+        case ASTKind::SetExpr:
+        case ASTKind::ListCompExpr:
             return ObjectLifecycleManager::ObjectSource::LITERAL;
 
         case ASTKind::BinaryExpr:
@@ -256,6 +259,7 @@ ObjectLifecycleManager::ObjectSource CodeGenRuntime::determineExprSource(const E
             return ObjectLifecycleManager::ObjectSource::UNARY_OP;
 
         case ASTKind::CallExpr:
+        case ASTKind::SliceExpr:
             return ObjectLifecycleManager::ObjectSource::FUNCTION_RETURN;
 
         case ASTKind::VariableExpr:
@@ -790,6 +794,88 @@ llvm::Type* CodeGenRuntime::getPyObjectPtrType()
     return llvm::PointerType::getUnqual(llvm::Type::getInt8Ty(codeGen.getContext()));
 }
 
+llvm::StructType* CodeGenRuntime::getPyObjectHeaderType()
+{
+    auto& context = codeGen.getContext();
+    if (auto* existing = llvm::StructType::getTypeByName(context, "PyObject"))
+    {
+        return existing;
+    }
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    llvm::Type* int16Type = llvm::Type::getInt16Ty(context);
+    // {int32_t refCount; uint16_t typeId; uint16_t flags;}
+    return llvm::StructType::create(context, {int32Type, int16Type, int16Type}, "PyObject");
+}
+
+llvm::Value* CodeGenRuntime::loadTypeId(llvm::Value* obj, const llvm::Twine& name)
+{
+    auto& builder = codeGen.getBuilder();
+    llvm::Value* typeIdPtr = builder.CreateStructGEP(getPyObjectHeaderType(), obj, 1, "typeid_ptr");
+    llvm::Value* typeId = builder.CreateLoad(builder.getInt16Ty(), typeIdPtr);
+    return builder.CreateZExt(typeId, builder.getInt32Ty(), name);
+}
+
+llvm::StructType* CodeGenRuntime::getPyListStructType()
+{
+    auto& context = codeGen.getContext();
+    if (auto* existing = llvm::StructType::getTypeByName(context, "PyListObject"))
+    {
+        return existing;
+    }
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    // {PyObject header; int length; int capacity; int elemTypeId; int storage; void* data;}
+    return llvm::StructType::create(
+            context,
+            {getPyObjectHeaderType(), int32Type, int32Type, int32Type, int32Type, llvm::PointerType::get(context, 0)},
+            "PyListObject");
+}
+
+llvm::StructType* CodeGenRuntime::getPyDictStructType()
+{
+    auto& context = codeGen.getContext();
+    if (auto* existing = llvm::StructType::getTypeByName(context, "PyDictObject"))
+    {
+        return existing;
+    }
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    // {PyObject header; int size; int capacity; int keyTypeId; unsigned version; PyDictEntry* entries;}
+    return llvm::StructType::create(
+            context,
+            {getPyObjectHeaderType(), int32Type, int32Type, int32Type, int32Type, llvm::PointerType::get(context, 0)},
+            "PyDictObject");
+}
+
+llvm::StructType* CodeGenRuntime::getPyDictEntryType()
+{
+    auto& context = codeGen.getContext();
+    if (auto* existing = llvm::StructType::getTypeByName(context, "PyDictEntry"))
+    {
+        return existing;
+    }
+    llvm::Type* ptrType = llvm::PointerType::get(context, 0);
+    // {PyObject* key; PyObject* value; int hash; bool used;}
+    return llvm::StructType::create(
+            context,
+            {ptrType, ptrType, llvm::Type::getInt32Ty(context), llvm::Type::getInt8Ty(context)},
+            "PyDictEntry");
+}
+
+llvm::StructType* CodeGenRuntime::getPyIntObjectType()
+{
+    auto& context = codeGen.getContext();
+    if (auto* existing = llvm::StructType::getTypeByName(context, "PyIntObject"))
+    {
+        return existing;
+    }
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    // {PyObject header; mpz_t value = {int _mp_alloc; int _mp_size; mp_limb_t* _mp_d};}
+    // _mp_size 为带符号的 limb 个数 (0 表示值为 0)
+    return llvm::StructType::create(
+            context,
+            {getPyObjectHeaderType(), int32Type, int32Type, llvm::PointerType::get(context, 0)},
+            "PyIntObject");
+}
+
 void CodeGenRuntime::callRuntimeError(const std::string& errorType, int line)
 {
     auto& builder = codeGen.getBuilder();
@@ -810,4 +896,23 @@ void CodeGenRuntime::callRuntimeError(const std::string& errorType, int line)
     // builder.CreateUnreachable(); // 或者根据你的错误处理策略跳转到特定的错误处理块
 }
 
+void CodeGenRuntime::callFatalRuntimeError(const std::string& errorType, int line)
+{
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+
+    llvm::Function* errorFunc = getRuntimeFunction(
+        "py_runtime_fatal_error",
+        llvm::Type::getVoidTy(context),
+        {llvm::PointerType::getUnqual(context), llvm::Type::getInt32Ty(context)}
+    );
+    errorFunc->setDoesNotReturn();
+
+    llvm::Value* errorTypeStr = builder.CreateGlobalStringPtr(errorType, errorType + "_str");
+    llvm::Value* lineNum = llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), line);
+
+    builder.CreateCall(errorFunc, {errorTypeStr, lineNum});
+    builder.CreateUnreachable();
+}
+
 }  // namespace llvmpy
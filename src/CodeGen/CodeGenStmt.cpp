@@ -12,11 +12,13 @@
 #include "Debugdefine.h"
 
 #include <llvm/IR/Constants.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>  // 可能需要包含这个
 #include <llvm/Transforms/Utils/BasicBlockUtils.h>
 #include <llvm/Support/raw_ostream.h>  // 用于打印 LLVM 对象
 
 #include <set>
+#include <tuple>
 #include <iostream>  // 用于 std::cerr
 
 namespace llvmpy
@@ -102,6 +104,11 @@ void CodeGenStmt::initializeHandlers()
         static_cast<CodeGenStmt*>(cg.getStmtGen())->handleIndexAssignStmt(static_cast<IndexAssignStmtAST*>(stmt));
     };
 
+    stmtHandlers[ASTKind::UnpackAssignStmt] = [](CodeGenBase& cg, StmtAST* stmt)
+    {
+        static_cast<CodeGenStmt*>(cg.getStmtGen())->handleUnpackAssignStmt(static_cast<UnpackAssignStmtAST*>(stmt));
+    };
+
     stmtHandlers[ASTKind::PassStmt] = [](CodeGenBase& cg, StmtAST* stmt)
     {
         static_cast<CodeGenStmt*>(cg.getStmtGen())->handlePassStmt(static_cast<PassStmtAST*>(stmt));
@@ -407,6 +414,13 @@ void CodeGenStmt::handleFunctionDefStmt(FunctionDefStmtAST* stmt)
         }
         storage = funcObjAlloca;
 
+        if (isNewAlloca)
+        {
+            // 槽位在入口处置空: 其他分支上的同名定义会检查旧值是否为 NULL 再 decref
+            llvm::IRBuilder<> entryBuilder(funcObjAlloca->getNextNode());
+            entryBuilder.CreateStore(llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(pyObjectPtrType)), funcObjAlloca);
+        }
+
         llvm::BasicBlock* currentBlockForStore = builder.GetInsertBlock();
         if (currentBlockForStore)
         {
@@ -895,6 +909,105 @@ void CodeGenStmt::findAssignedVariablesInStmt(StmtAST* stmt, std::set<std::strin
     // }
 }
 
+// 语句是否可能重新绑定 names 中的变量 (保守判断: 函数/类定义与 import 一律视为可能)
+static bool stmtMayRebind(const StmtAST* stmt, const std::string& a, const std::string& b)
+{
+    if (!stmt) return false;
+    auto matches = [&](const std::string& name) { return name == a || name == b; };
+    auto anyMayRebind = [&](const std::vector<std::unique_ptr<StmtAST>>& stmts)
+    {
+        for (const auto& s : stmts)
+        {
+            if (stmtMayRebind(s.get(), a, b)) return true;
+        }
+        return false;
+    };
+
+    switch (stmt->kind())
+    {
+        case ASTKind::AssignStmt:
+            return matches(static_cast<const AssignStmtAST*>(stmt)->getName());
+        case ASTKind::UnpackAssignStmt:
+        {
+            const auto& targets = static_cast<const UnpackAssignStmtAST*>(stmt)->getTargets();
+            return std::any_of(targets.begin(), targets.end(), matches);
+        }
+        case ASTKind::IfStmt:
+        {
+            auto* ifStmt = static_cast<const IfStmtAST*>(stmt);
+            return anyMayRebind(ifStmt->getThenBody()) || stmtMayRebind(ifStmt->getElseStmt(), a, b);
+        }
+        case ASTKind::WhileStmt:
+        {
+            auto* whileStmt = static_cast<const WhileStmtAST*>(stmt);
+            return anyMayRebind(whileStmt->getBody()) || stmtMayRebind(whileStmt->getElseStmt(), a, b);
+        }
+        case ASTKind::ForStmt:
+        {
+            auto* forStmt = static_cast<const ForStmtAST*>(stmt);
+            return forStmt->bindsLoopVariable(a) || forStmt->bindsLoopVariable(b)
+                   || anyMayRebind(forStmt->getBody()) || stmtMayRebind(forStmt->getElseStmt(), a, b);
+        }
+        case ASTKind::BlockStmt:
+            return anyMayRebind(static_cast<const BlockStmtAST*>(stmt)->getStatements());
+        case ASTKind::FunctionDefStmt:
+        case ASTKind::ClassStmt:
+        case ASTKind::ImportStmt:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 识别 `while i < len(a)` (i、a 为局部变量，a 静态类型为列表，i 为 int)。
+ *
+ * 在条件块末尾检查一次 a 是列表且 0 <= i < len(a)，结果作为 ListBoundsFact 交给 CodeGenExpr，
+ * 循环体中 a[i] 不再逐次解码下标和检查边界。列表不会原地缩短，因此事实在 i、a
+ * 被重新赋值之前一直成立 (元素存储策略可能变化，每次访问仍重新读取 storage/data)。
+ */
+size_t CodeGenStmt::emitWhileListBoundsFact(WhileStmtAST* stmt)
+{
+    auto* cond = dynamic_cast<const BinaryExprAST*>(stmt->getCondition());
+    if (!cond || cond->getOpType() != TOK_LT) return 0;
+    auto* indexVar = dynamic_cast<const VariableExprAST*>(cond->getLHS());
+    auto* lenCall = dynamic_cast<const CallExprAST*>(cond->getRHS());
+    if (!indexVar || !lenCall || lenCall->getArgs().size() != 1) return 0;
+    auto* calleeExpr = dynamic_cast<const VariableExprAST*>(lenCall->getCalleeExpr());
+    auto* listVar = dynamic_cast<const VariableExprAST*>(lenCall->getArgs()[0].get());
+    if (!calleeExpr || calleeExpr->getName() != "len" || !listVar) return 0;
+
+    auto& symTable = codeGen.getSymbolTable();
+    if (symTable.hasVariable("len") || symTable.findFunctionAST("len")) return 0;
+    const std::string& indexName = indexVar->getName();
+    const std::string& listName = listVar->getName();
+    if (indexName == listName) return 0;
+    auto* indexStorage = llvm::dyn_cast_or_null<llvm::AllocaInst>(symTable.getVariable(indexName));
+    auto* listStorage = llvm::dyn_cast_or_null<llvm::AllocaInst>(symTable.getVariable(listName));
+    if (!indexStorage || !listStorage) return 0;
+    std::shared_ptr<PyType> indexType = codeGen.getTypeGen()->inferExprType(indexVar);
+    std::shared_ptr<PyType> listType = codeGen.getTypeGen()->inferExprType(listVar);
+    if (!indexType || !indexType->isInt() || !listType || !listType->isList()) return 0;
+
+    size_t prefix = 0;
+    const auto& bodyStmts = stmt->getBody();
+    while (prefix < bodyStmts.size() && !stmtMayRebind(bodyStmts[prefix].get(), indexName, listName)) ++prefix;
+    if (prefix == 0) return 0;
+
+    auto& builder = codeGen.getBuilder();
+    llvm::Type* pyObjectPtrType = codeGen.getRuntimeGen()->getPyObjectPtrType();
+    llvm::Value* listValue = builder.CreateLoad(pyObjectPtrType, listStorage, listName + "_bounds");
+    llvm::Value* indexValue = builder.CreateLoad(pyObjectPtrType, indexStorage, indexName + "_bounds");
+
+    CodeGenExpr::ListBoundsFact fact;
+    fact.listStorage = listStorage;
+    fact.indexStorage = indexStorage;
+    std::tie(fact.inRange, fact.index64) = codeGen.getExprGen()->emitListIndexCheck(listValue, indexValue);
+    fact.function = builder.GetInsertBlock()->getParent();
+    codeGen.getExprGen()->setListBoundsFact(fact);
+    return prefix;
+}
+
 // 修改现有方法
 
 void CodeGenStmt::handleBreakStmt(BreakStmtAST* stmt)
@@ -1233,6 +1346,10 @@ void CodeGenStmt::handleWhileStmt(WhileStmtAST* stmt)
         return;
     }
 
+    // while i < len(a): 条件块中计算一次 0 <= i < len(a)，循环体内的 a[i] 复用
+    CodeGenExpr::ListBoundsFact outerBoundsFact = codeGen.getExprGen()->getListBoundsFact();
+    size_t boundsFactPrefix = emitWhileListBoundsFact(stmt);
+
     // --- 7. 创建条件分支 ---
     llvm::BasicBlock* currentCondExitBlock = builder.GetInsertBlock();  // Should be condBB
     llvm::BasicBlock* falseTargetBB = elseBB ? elseBB : endBB;          // <-- Target if condition is false
@@ -1253,7 +1370,23 @@ void CodeGenStmt::handleWhileStmt(WhileStmtAST* stmt)
     // Process body statements. IMPORTANT: Pass 'false' for createNewScope
     // because the loop itself doesn't introduce a new Python scope level.
     // Scopes are managed by function defs, class defs, etc.
-    handleBlock(stmt->getBody(), false);
+    if (boundsFactPrefix == 0)
+    {
+        handleBlock(stmt->getBody(), false);
+    }
+    else
+    {
+        // 边界事实只覆盖 i / a 被重新赋值之前的语句
+        const auto& bodyStmts = stmt->getBody();
+        for (size_t k = 0; k < bodyStmts.size(); ++k)
+        {
+            if (k == boundsFactPrefix) codeGen.getExprGen()->setListBoundsFact(outerBoundsFact);
+            handleStmt(bodyStmts[k].get());
+            llvm::BasicBlock* currentBlock = builder.GetInsertBlock();
+            if (!currentBlock || currentBlock->getTerminator()) break;
+        }
+    }
+    codeGen.getExprGen()->setListBoundsFact(outerBoundsFact);
 
 #ifdef DEBUG_WhileSTmt
     DEBUG_LOG("      Finished processing loop body statements via handleBlock. Current block: " + llvmObjToString(builder.GetInsertBlock()));
@@ -1411,16 +1544,1012 @@ void CodeGenStmt::handleWhileStmt(WhileStmtAST* stmt)
 #endif
 }
 
+//===----------------------------------------------------------------------===//
+// for 循环辅助函数
+//===----------------------------------------------------------------------===//
+
+static bool stmtsReferenceName(const std::vector<std::unique_ptr<StmtAST>>& stmts, const std::string& name);
+
+// 表达式中是否读取了变量 name (未知表达式保守地返回 true)
+bool exprReferencesName(const ExprAST* expr, const std::string& name)
+{
+    if (!expr) return false;
+    switch (expr->kind())
+    {
+        case ASTKind::NumberExpr:
+        case ASTKind::StringExpr:
+        case ASTKind::BoolExpr:
+        case ASTKind::NoneExpr:
+            return false;
+        case ASTKind::VariableExpr:
+            return static_cast<const VariableExprAST*>(expr)->getName() == name;
+        case ASTKind::BinaryExpr:
+        {
+            auto* binExpr = static_cast<const BinaryExprAST*>(expr);
+            return exprReferencesName(binExpr->getLHS(), name) || exprReferencesName(binExpr->getRHS(), name);
+        }
+        case ASTKind::UnaryExpr:
+            return exprReferencesName(static_cast<const UnaryExprAST*>(expr)->getOperand(), name);
+        case ASTKind::CallExpr:
+        {
+            auto* callExpr = static_cast<const CallExprAST*>(expr);
+            if (exprReferencesName(callExpr->getCalleeExpr(), name)) return true;
+            for (const auto& arg : callExpr->getArgs())
+                if (exprReferencesName(arg.get(), name)) return true;
+            return false;
+        }
+        case ASTKind::ListExpr:
+            for (const auto& elem : static_cast<const ListExprAST*>(expr)->getElements())
+                if (exprReferencesName(elem.get(), name)) return true;
+            return false;
+        case ASTKind::TupleExpr:
+            for (const auto& elem : static_cast<const TupleExprAST*>(expr)->getElements())
+                if (exprReferencesName(elem.get(), name)) return true;
+            return false;
+        case ASTKind::SetExpr:
+            for (const auto& elem : static_cast<const SetExprAST*>(expr)->getElements())
+                if (exprReferencesName(elem.get(), name)) return true;
+            return false;
+        case ASTKind::DictExpr:
+            for (const auto& pair : static_cast<const DictExprAST*>(expr)->getPairs())
+                if (exprReferencesName(pair.first.get(), name) || exprReferencesName(pair.second.get(), name)) return true;
+            return false;
+        case ASTKind::IndexExpr:
+        {
+            auto* indexExpr = static_cast<const IndexExprAST*>(expr);
+            return exprReferencesName(indexExpr->getTarget(), name) || exprReferencesName(indexExpr->getIndex(), name);
+        }
+        case ASTKind::SliceExpr:
+        {
+            auto* sliceExpr = static_cast<const SliceExprAST*>(expr);
+            return exprReferencesName(sliceExpr->getTarget(), name) || exprReferencesName(sliceExpr->getStart(), name) ||
+                   exprReferencesName(sliceExpr->getStop(), name) || exprReferencesName(sliceExpr->getStep(), name);
+        }
+        case ASTKind::ListCompExpr:
+        {
+            // 推导式的循环变量遮蔽外层同名变量
+            auto* compExpr = static_cast<const ListCompExprAST*>(expr);
+            if (exprReferencesName(compExpr->getIterable(), name)) return true;
+            if (compExpr->getVarName() == name) return false;
+            return exprReferencesName(compExpr->getElement(), name) || exprReferencesName(compExpr->getCondition(), name);
+        }
+        default:
+            return true;  // 未知表达式: 保守地认为引用了
+    }
+}
+
+// 语句中是否读取或重新绑定了变量 name (嵌套的函数/类定义保守处理)
+static bool stmtReferencesName(const StmtAST* stmt, const std::string& name)
+{
+    if (!stmt) return false;
+    switch (stmt->kind())
+    {
+        case ASTKind::PassStmt:
+        case ASTKind::BreakStmt:
+        case ASTKind::ContinueStmt:
+            return false;
+        case ASTKind::ExprStmt:
+            return exprReferencesName(static_cast<const ExprStmtAST*>(stmt)->getExpr(), name);
+        case ASTKind::ReturnStmt:
+            return exprReferencesName(static_cast<const ReturnStmtAST*>(stmt)->getValue(), name);
+        case ASTKind::PrintStmt:
+            return exprReferencesName(static_cast<const PrintStmtAST*>(stmt)->getValue(), name);
+        case ASTKind::AssignStmt:
+        {
+            auto* assignStmt = static_cast<const AssignStmtAST*>(stmt);
+            return assignStmt->getName() == name || exprReferencesName(assignStmt->getValue(), name);
+        }
+        case ASTKind::UnpackAssignStmt:
+        {
+            auto* unpackStmt = static_cast<const UnpackAssignStmtAST*>(stmt);
+            for (const auto& target : unpackStmt->getTargets())
+                if (target == name) return true;
+            return exprReferencesName(unpackStmt->getValue(), name);
+        }
+        case ASTKind::IndexAssignStmt:
+        {
+            auto* assignStmt = static_cast<const IndexAssignStmtAST*>(stmt);
+            return exprReferencesName(assignStmt->getTarget(), name) || exprReferencesName(assignStmt->getIndex(), name)
+                   || exprReferencesName(assignStmt->getValue(), name);
+        }
+        case ASTKind::IfStmt:
+        {
+            auto* ifStmt = static_cast<const IfStmtAST*>(stmt);
+            return exprReferencesName(ifStmt->getCondition(), name) || stmtsReferenceName(ifStmt->getThenBody(), name)
+                   || stmtReferencesName(ifStmt->getElseStmt(), name);
+        }
+        case ASTKind::WhileStmt:
+        {
+            auto* whileStmt = static_cast<const WhileStmtAST*>(stmt);
+            return exprReferencesName(whileStmt->getCondition(), name) || stmtsReferenceName(whileStmt->getBody(), name)
+                   || stmtReferencesName(whileStmt->getElseStmt(), name);
+        }
+        case ASTKind::ForStmt:
+        {
+            auto* forStmt = static_cast<const ForStmtAST*>(stmt);
+            return forStmt->bindsLoopVariable(name) || exprReferencesName(forStmt->getIterableExpr(), name)
+                   || stmtsReferenceName(forStmt->getBody(), name) || stmtReferencesName(forStmt->getElseStmt(), name);
+        }
+        case ASTKind::BlockStmt:
+            return stmtsReferenceName(static_cast<const BlockStmtAST*>(stmt)->getStatements(), name);
+        default:
+            return true;  // 函数/类定义、import 等: 保守地认为引用了
+    }
+}
+
+static bool stmtsReferenceName(const std::vector<std::unique_ptr<StmtAST>>& stmts, const std::string& name)
+{
+    for (const auto& stmt : stmts)
+        if (stmtReferencesName(stmt.get(), name)) return true;
+    return false;
+}
+
+//===----------------------------------------------------------------------===//
+// 字符串原地追加的静态判定
+//===----------------------------------------------------------------------===//
+
+// 是否为 name = name + piece (x += piece 在解析时已展开为同样的形式)
+static const ExprAST* stringAppendPiece(const AssignStmtAST* stmt)
+{
+    const ExprAST* valueExpr = stmt->getValue();
+    if (!valueExpr || valueExpr->kind() != ASTKind::BinaryExpr) return nullptr;
+    auto* binExpr = static_cast<const BinaryExprAST*>(valueExpr);
+    if (binExpr->getOpType() != TOK_PLUS || binExpr->getLHS()->kind() != ASTKind::VariableExpr) return nullptr;
+    if (static_cast<const VariableExprAST*>(binExpr->getLHS())->getName() != stmt->getName()) return nullptr;
+    return binExpr->getRHS();
+}
+
+// 表达式求值后是否可能有别处持有变量 name 当前的值。
+// valueEscapes 表示表达式本身的结果会被保存 (赋值、容器元素、调用参数)。
+// 比较和 + 只读取操作数并产生新对象，下标读取得到新字符串，都不会保留原对象。
+static bool exprLetsNameEscape(const ExprAST* expr, const std::string& name, bool valueEscapes)
+{
+    if (!expr) return false;
+    switch (expr->kind())
+    {
+        case ASTKind::NumberExpr:
+        case ASTKind::StringExpr:
+        case ASTKind::BoolExpr:
+        case ASTKind::NoneExpr:
+            return false;
+        case ASTKind::VariableExpr:
+            return valueEscapes && static_cast<const VariableExprAST*>(expr)->getName() == name;
+        case ASTKind::BinaryExpr:
+        {
+            auto* binExpr = static_cast<const BinaryExprAST*>(expr);
+            switch (binExpr->getOpType())
+            {
+                case TOK_PLUS:
+                case TOK_LT:
+                case TOK_GT:
+                case TOK_LE:
+                case TOK_GE:
+                case TOK_EQ:
+                case TOK_NEQ:
+                case TOK_IN:
+                case TOK_NOT_IN:
+                case TOK_IS:
+                case TOK_IS_NOT:
+                    return exprLetsNameEscape(binExpr->getLHS(), name, false) || exprLetsNameEscape(binExpr->getRHS(), name, false);
+                default:
+                    // 其余运算 (如 s * 1、and/or) 可能原样返回操作数
+                    return exprLetsNameEscape(binExpr->getLHS(), name, valueEscapes) || exprLetsNameEscape(binExpr->getRHS(), name, valueEscapes);
+            }
+        }
+        case ASTKind::UnaryExpr:
+            return exprLetsNameEscape(static_cast<const UnaryExprAST*>(expr)->getOperand(), name, false);
+        case ASTKind::IndexExpr:
+        {
+            auto* indexExpr = static_cast<const IndexExprAST*>(expr);
+            return exprLetsNameEscape(indexExpr->getTarget(), name, false) || exprLetsNameEscape(indexExpr->getIndex(), name, false);
+        }
+        default:
+            // 调用参数、容器字面量、切片 (可能是共享缓冲区的视图) 等: 只要引用了就视为保留
+            return exprReferencesName(expr, name);
+    }
+}
+
+static bool stmtsLetNameEscape(const std::vector<std::unique_ptr<StmtAST>>& stmts, const std::string& name);
+
+// 语句是否可能让变量 name 的值被别处持有，或绕过 assignVariable 重新绑定 name
+static bool stmtLetsNameEscape(const StmtAST* stmt, const std::string& name)
+{
+    if (!stmt) return false;
+    switch (stmt->kind())
+    {
+        case ASTKind::PassStmt:
+        case ASTKind::BreakStmt:
+        case ASTKind::ContinueStmt:
+            return false;
+        case ASTKind::ExprStmt:
+            return exprLetsNameEscape(static_cast<const ExprStmtAST*>(stmt)->getExpr(), name, false);
+        case ASTKind::ReturnStmt:
+            // 返回后函数内不会再追加，调用者得到的值由其自己的标志管理
+            return exprLetsNameEscape(static_cast<const ReturnStmtAST*>(stmt)->getValue(), name, false);
+        case ASTKind::PrintStmt:
+            return exprLetsNameEscape(static_cast<const PrintStmtAST*>(stmt)->getValue(), name, false);
+        case ASTKind::AssignStmt:
+        {
+            auto* assignStmt = static_cast<const AssignStmtAST*>(stmt);
+            if (const ExprAST* piece = stringAppendPiece(assignStmt))
+                return exprLetsNameEscape(piece, name, false);  // 追加的内容被复制
+            return exprLetsNameEscape(assignStmt->getValue(), name, true);
+        }
+        case ASTKind::UnpackAssignStmt:
+        {
+            auto* unpackStmt = static_cast<const UnpackAssignStmtAST*>(stmt);
+            for (const auto& target : unpackStmt->getTargets())
+                if (target == name) return true;
+            return exprLetsNameEscape(unpackStmt->getValue(), name, true);
+        }
+        case ASTKind::IndexAssignStmt:
+        {
+            auto* assignStmt = static_cast<const IndexAssignStmtAST*>(stmt);
+            return exprLetsNameEscape(assignStmt->getTarget(), name, false) || exprLetsNameEscape(assignStmt->getIndex(), name, true)
+                   || exprLetsNameEscape(assignStmt->getValue(), name, true);
+        }
+        case ASTKind::IfStmt:
+        {
+            auto* ifStmt = static_cast<const IfStmtAST*>(stmt);
+            return exprLetsNameEscape(ifStmt->getCondition(), name, false) || stmtsLetNameEscape(ifStmt->getThenBody(), name)
+                   || stmtLetsNameEscape(ifStmt->getElseStmt(), name);
+        }
+        case ASTKind::WhileStmt:
+        {
+            auto* whileStmt = static_cast<const WhileStmtAST*>(stmt);
+            return exprLetsNameEscape(whileStmt->getCondition(), name, false) || stmtsLetNameEscape(whileStmt->getBody(), name)
+                   || stmtLetsNameEscape(whileStmt->getElseStmt(), name);
+        }
+        case ASTKind::ForStmt:
+        {
+            auto* forStmt = static_cast<const ForStmtAST*>(stmt);
+            return forStmt->bindsLoopVariable(name) || exprLetsNameEscape(forStmt->getIterableExpr(), name, true)
+                   || stmtsLetNameEscape(forStmt->getBody(), name) || stmtLetsNameEscape(forStmt->getElseStmt(), name);
+        }
+        case ASTKind::BlockStmt:
+            return stmtsLetNameEscape(static_cast<const BlockStmtAST*>(stmt)->getStatements(), name);
+        default:
+            return stmtReferencesName(stmt, name);
+    }
+}
+
+static bool stmtsLetNameEscape(const std::vector<std::unique_ptr<StmtAST>>& stmts, const std::string& name)
+{
+    for (const auto& stmt : stmts)
+        if (stmtLetsNameEscape(stmt.get(), name)) return true;
+    return false;
+}
+
+// 收集语句中形如 x = x + piece 的赋值目标
+static void collectStringAppendTargets(const StmtAST* stmt, std::set<std::string>& names)
+{
+    if (!stmt) return;
+    switch (stmt->kind())
+    {
+        case ASTKind::AssignStmt:
+            if (stringAppendPiece(static_cast<const AssignStmtAST*>(stmt)))
+                names.insert(static_cast<const AssignStmtAST*>(stmt)->getName());
+            break;
+        case ASTKind::IfStmt:
+        {
+            auto* ifStmt = static_cast<const IfStmtAST*>(stmt);
+            for (const auto& child : ifStmt->getThenBody()) collectStringAppendTargets(child.get(), names);
+            collectStringAppendTargets(ifStmt->getElseStmt(), names);
+            break;
+        }
+        case ASTKind::WhileStmt:
+        {
+            auto* whileStmt = static_cast<const WhileStmtAST*>(stmt);
+            for (const auto& child : whileStmt->getBody()) collectStringAppendTargets(child.get(), names);
+            collectStringAppendTargets(whileStmt->getElseStmt(), names);
+            break;
+        }
+        case ASTKind::ForStmt:
+        {
+            auto* forStmt = static_cast<const ForStmtAST*>(stmt);
+            for (const auto& child : forStmt->getBody()) collectStringAppendTargets(child.get(), names);
+            collectStringAppendTargets(forStmt->getElseStmt(), names);
+            break;
+        }
+        case ASTKind::BlockStmt:
+            for (const auto& child : static_cast<const BlockStmtAST*>(stmt)->getStatements())
+                collectStringAppendTargets(child.get(), names);
+            break;
+        default:
+            break;
+    }
+}
+
+// 变量的值只能在 py_string_append_to 为它新建、且之后没有被别处持有时原地追加。
+// 引用计数不能说明这一点 (内层作用域结束时也会对外层变量 decRef)，因此按函数体静态判定:
+// 变量不是参数，函数内对它的所有读取都不会保留其值。满足条件的变量获得一个 i1 标志，
+// 记录当前值是否为追加缓冲区，普通赋值时清除。
+std::map<std::string, llvm::AllocaInst*> CodeGenStmt::beginStringAppendTracking(const FunctionAST* funcAST)
+{
+    std::map<std::string, llvm::AllocaInst*> savedFlags = std::move(stringAppendFlags);
+    stringAppendFlags.clear();
+
+    std::set<std::string> candidates;
+    for (const auto& stmt : funcAST->getBody())
+        collectStringAppendTargets(stmt.get(), candidates);
+    for (const auto& param : funcAST->getParams())
+        candidates.erase(param.name);
+
+    auto& builder = codeGen.getBuilder();
+    for (const auto& name : candidates)
+    {
+        if (stmtsLetNameEscape(funcAST->getBody(), name)) continue;
+        llvm::AllocaInst* flag = codeGen.createEntryBlockAlloca(builder.getInt1Ty(), name + ".owns_buffer");
+        builder.CreateStore(builder.getFalse(), flag);
+        stringAppendFlags[name] = flag;
+    }
+    return savedFlags;
+}
+
+void CodeGenStmt::endStringAppendTracking(std::map<std::string, llvm::AllocaInst*> savedFlags)
+{
+    stringAppendFlags = std::move(savedFlags);
+}
+
+// 循环变量的 alloca。新建的槽位在入口块中紧随 alloca 初始化为 NULL:
+// 循环变量可能在多个出口块中首次赋值 (如 range 循环的 break/正常结束)，也可能一次都不赋值 (空循环)
+llvm::AllocaInst* CodeGenStmt::getForLoopVariableSlot(const std::string& loopVarName)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+
+    llvm::AllocaInst* loopVarAlloc = cg.getSymbolTable().lookupAlloca(loopVarName);
+    std::shared_ptr<PyType> loopVarPyType = PyType::fromObjectType(TypeRegistry::getInstance().getType("any"));
+    ObjectType* loopVarObjectType = loopVarPyType ? loopVarPyType->getObjectType() : nullptr;
+    llvm::Type* pyObjectPtrType_for_alloc = cg.getRuntimeGen()->getPyObjectPtrType();
+
+    if (!loopVarAlloc) {
+         loopVarAlloc = cg.createEntryBlockAlloca(pyObjectPtrType_for_alloc, loopVarName);
+         llvm::IRBuilder<> initBuilder(loopVarAlloc->getNextNode());
+         initBuilder.CreateStore(llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(pyObjectPtrType_for_alloc)), loopVarAlloc);
+    }
+    // If it already exists, assume it's managed correctly by outer scopes or previous logic.
+    // However, ensure it's correctly set in the current symbol table context if re-entering a scope.
+    cg.getSymbolTable().setVariable(loopVarName, loopVarAlloc, loopVarObjectType);
+    return loopVarAlloc;
+}
+
+// 以 value (新引用) 覆盖循环变量，必要时创建其 alloca。
+// 与通用路径一致再持有一次引用，循环变量所在作用域结束时会对其 decRef。
+void CodeGenStmt::storeForLoopVariable(const std::string& loopVarName, llvm::Value* value)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    llvm::IRBuilder<>& builder = cg.getBuilder();
+    llvm::Type* pyObjectPtrType_for_alloc = cg.getRuntimeGen()->getPyObjectPtrType();
+
+    llvm::AllocaInst* loopVarAlloc = getForLoopVariableSlot(loopVarName);
+    llvm::Value* oldLoopVarValue = builder.CreateLoad(pyObjectPtrType_for_alloc, loopVarAlloc, "old_" + loopVarName);
+    cg.getRuntimeGen()->decRef(oldLoopVarValue); // This is now safe if alloca was initialized or held a valid previous object.
+    builder.CreateStore(value, loopVarAlloc);
+    cg.getRuntimeGen()->incRef(value); // <<< ADDED: IncRef the new item being stored and now owned by loopVarAlloc
+}
+
+void CodeGenStmt::bindForLoopTargets(const ForStmtAST* stmt, llvm::Value* item)
+{
+    if (!stmt->isUnpacking()) {
+        storeForLoopVariable(stmt->getLoopVariable(), item);
+        return;
+    }
+
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    llvm::LLVMContext& context = cg.getContext();
+    llvm::IRBuilder<>& builder = cg.getBuilder();
+    auto* runtime = cg.getRuntimeGen();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    const auto& targets = stmt->getLoopVariables();
+    unsigned count = targets.size();
+
+    llvm::ArrayType* bufType = llvm::ArrayType::get(pyObjectPtrType, count);
+    llvm::AllocaInst* buf = cg.createEntryBlockAlloca(bufType, "for.unpack_buf");
+    llvm::Function* unpackFunc = runtime->getRuntimeFunction(
+        "py_unpack_sequence", llvm::Type::getInt1Ty(context),
+        {pyObjectPtrType, int32Type, llvm::PointerType::get(context, 0)});
+    llvm::Value* ok = builder.CreateCall(unpackFunc, {item, llvm::ConstantInt::get(int32Type, count), buf}, "for.unpack_ok");
+
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    llvm::BasicBlock* errorBB = llvm::BasicBlock::Create(context, "for.unpack_error", currentFunction);
+    llvm::BasicBlock* okBB = llvm::BasicBlock::Create(context, "for.unpack", currentFunction);
+    builder.CreateCondBr(ok, okBB, errorBB);
+
+    // 元素个数不符或不可迭代: 运行时已打印错误信息
+    builder.SetInsertPoint(errorBB);
+    llvm::Function* exitFunc = cg.getOrCreateExternalFunction(
+        "exit", llvm::Type::getVoidTy(context), {int32Type}, false);
+    builder.CreateCall(exitFunc, {llvm::ConstantInt::get(int32Type, 1)});
+    builder.CreateUnreachable();
+
+    builder.SetInsertPoint(okBB);
+    for (unsigned i = 0; i < count; ++i) {
+        llvm::Value* slot = builder.CreateConstInBoundsGEP2_32(bufType, buf, 0, i);
+        llvm::Value* part = builder.CreateLoad(pyObjectPtrType, slot, targets[i] + ".unpacked");
+        storeForLoopVariable(targets[i], part);
+        runtime->decRef(part);
+    }
+    runtime->decRef(item);
+}
+
+// 生成循环体: break 跳到 breakBB，continue 以及正常落空都跳到 continueBB
+void CodeGenStmt::emitForLoopBody(const ForStmtAST* stmt, llvm::BasicBlock* breakBB, llvm::BasicBlock* continueBB)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    llvm::IRBuilder<>& builder = cg.getBuilder();
+
+    cg.pushScope();  // Keep original scope management
+    // Set loop context for symbol table (if it uses it for other purposes)
+    cg.getSymbolTable().setLoopContext(breakBB, continueBB);
+
+    pushBreakTarget(breakBB);
+    pushContinueTarget(continueBB);
+
+    for (const auto& bodyStmt : stmt->getBody()) {
+        cg.codegenStmt(bodyStmt.get()); // Keep original call to PyCodeGen's dispatcher
+        if (builder.GetInsertBlock()->getTerminator() != nullptr) { 
+            break; 
+        }
+    }
+
+    popContinueTarget();
+    popBreakTarget();
+
+    cg.popScope(); // Keep original scope management
+
+    if (builder.GetInsertBlock()->getTerminator() == nullptr) { 
+        builder.CreateBr(continueBB); 
+    }
+}
+
+// 生成 else 子句 (仅在循环正常结束时执行)，之后跳到 endBB
+void CodeGenStmt::emitForElse(const ForStmtAST* stmt, llvm::BasicBlock* elseBB, llvm::BasicBlock* endBB)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    llvm::IRBuilder<>& builder = cg.getBuilder();
+
+    builder.SetInsertPoint(elseBB);
+    cg.pushScope(); // Keep original scope management for else
+    cg.getSymbolTable().clearLoopContext(); // Keep original symbol table context clearing
+
+    const auto* elseAstNode = stmt->getElseStmt(); // Use a more generic name
+    if (const auto* elseBlock = dynamic_cast<const BlockStmtAST*>(elseAstNode)) {
+        for (const auto& elseBodyStmt : elseBlock->getStatements()) {
+            cg.codegenStmt(elseBodyStmt.get()); // Keep original call
+             if (builder.GetInsertBlock()->getTerminator() != nullptr) break;
+        }
+    } else if (elseAstNode) { // If it's not a BlockStmt but still exists
+        cg.codegenStmt(const_cast<StmtAST*>(elseAstNode)); // Keep original call
+    }
+    cg.popScope(); // Keep original scope management for else
+    if (builder.GetInsertBlock()->getTerminator() == nullptr) {
+        builder.CreateBr(endBB); 
+    }
+}
+
+/**
+ * @brief `for i in range(...)` 的快速路径。
+ *
+ * 不创建 range/迭代器对象，直接用 i64 归纳变量计数: 第 k 次迭代的值为 start + k * step。
+ * 循环变量按循环体对它的使用分三种绑定方式:
+ * - 循环体不引用: 只在循环结束 (或 break) 时装箱一次最终值；
+ * - 引用但不逃逸 (只参与运算、比较、下标读取等): 用 py_range_bind_counter 原地改写
+ *   变量持有的私有整数对象，整个循环只分配一次；
+ * - 值可能被别处持有 (赋给其他变量、作为参数或容器元素): 每次迭代装箱新对象。
+ * range 未被同名变量或函数遮蔽时才生效，返回 false 表示走通用的 py_iter/py_next 路径。
+ */
+bool CodeGenStmt::tryHandleRangeForStmt(const ForStmtAST* stmt)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    if (stmt->isUnpacking()) return false;  // 整数不能解包，交给通用路径报错
+
+    auto* callExpr = dynamic_cast<const CallExprAST*>(stmt->getIterableExpr());
+    if (!callExpr) return false;
+    auto* calleeExpr = dynamic_cast<const VariableExprAST*>(callExpr->getCalleeExpr());
+    if (!calleeExpr || calleeExpr->getName() != "range") return false;
+    if (cg.getSymbolTable().hasVariable("range") || cg.getSymbolTable().findFunctionAST("range")) return false;
+    const auto& rangeArgs = callExpr->getArgs();
+    if (rangeArgs.empty() || rangeArgs.size() > 3) return false;
+
+    llvm::LLVMContext& context = cg.getContext();
+    llvm::IRBuilder<>& builder = cg.getBuilder();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    auto* runtime = cg.getRuntimeGen();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+    llvm::Type* int64Type = llvm::Type::getInt64Ty(context);
+    const std::string& loopVarName = stmt->getLoopVariable();
+
+    // --- 1. 求值 range 参数并解析为 start/stop/step ---
+    std::vector<llvm::Value*> args;
+    for (const auto& arg : rangeArgs) {
+        llvm::Value* argValue = cg.codegenExpr(arg.get());
+        if (!argValue) {
+            cg.logError("Failed to generate code for range() argument at line " + std::to_string(stmt->line.value_or(0)));
+            return true;
+        }
+        args.push_back(argValue);
+    }
+    while (args.size() < 3) {
+        args.push_back(llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(pyObjectPtrType)));
+    }
+
+    llvm::AllocaInst* startAlloc = cg.createEntryBlockAlloca(int64Type, "range.start");
+    llvm::AllocaInst* stopAlloc = cg.createEntryBlockAlloca(int64Type, "range.stop");
+    llvm::AllocaInst* stepAlloc = cg.createEntryBlockAlloca(int64Type, "range.step");
+    llvm::AllocaInst* indexAlloc = cg.createEntryBlockAlloca(int64Type, "range.index");
+
+    llvm::Type* ptrType = llvm::PointerType::get(context, 0);
+    llvm::Function* unpackFunc = runtime->getRuntimeFunction(
+        "py_range_unpack", llvm::Type::getInt1Ty(context),
+        {pyObjectPtrType, pyObjectPtrType, pyObjectPtrType, ptrType, ptrType, ptrType});
+    llvm::Value* unpackOk = builder.CreateCall(unpackFunc, {args[0], args[1], args[2], startAlloc, stopAlloc, stepAlloc}, "range.ok");
+
+    llvm::BasicBlock* rangeErrorBB = llvm::BasicBlock::Create(context, "range.error", currentFunction);
+    llvm::BasicBlock* rangeOkBB = llvm::BasicBlock::Create(context, "range.init", currentFunction);
+    builder.CreateCondBr(unpackOk, rangeOkBB, rangeErrorBB);
+
+    // 参数非法: 运行时已打印错误信息
+    builder.SetInsertPoint(rangeErrorBB);
+    runtime->callFatalRuntimeError("ErrorAlreadyReported", stmt->line.value_or(0));
+
+    builder.SetInsertPoint(rangeOkBB);
+    llvm::Value* start = builder.CreateLoad(int64Type, startAlloc, "start");
+    llvm::Value* stop = builder.CreateLoad(int64Type, stopAlloc, "stop");
+    llvm::Value* step = builder.CreateLoad(int64Type, stepAlloc, "step");
+    llvm::Function* lengthFunc = runtime->getRuntimeFunction(
+        "py_range_length", int64Type, {int64Type, int64Type, int64Type});
+    llvm::Value* count = builder.CreateCall(lengthFunc, {start, stop, step}, "range.count");
+    builder.CreateStore(llvm::ConstantInt::get(int64Type, 0), indexAlloc);
+    // 循环一次都不执行时变量保持原值，新建的槽位为 NULL
+    llvm::AllocaInst* loopVarAlloc = getForLoopVariableSlot(loopVarName);
+
+    // --- 2. 循环块 ---
+    llvm::BasicBlock* loopHeaderBB = llvm::BasicBlock::Create(context, "for.header", currentFunction); // Continue target
+    llvm::BasicBlock* loopBodyBB = llvm::BasicBlock::Create(context, "for.body", currentFunction);
+    llvm::BasicBlock* loopElseBB = stmt->getElseStmt() ? llvm::BasicBlock::Create(context, "for.else", currentFunction) : nullptr;
+    llvm::BasicBlock* loopEndBB = llvm::BasicBlock::Create(context, "for.end", currentFunction);
+    llvm::BasicBlock* stopIterationBB = llvm::BasicBlock::Create(context, "for.stop_iteration", currentFunction);
+
+    // 循环体内被引用时每次迭代都要绑定；值会逃逸时才需要每次装箱新对象
+    bool bindEachIteration = stmtsReferenceName(stmt->getBody(), loopVarName);
+    bool boxEachIteration = bindEachIteration && stmtsLetNameEscape(stmt->getBody(), loopVarName);
+    llvm::BasicBlock* breakBB = loopEndBB;
+    if (!bindEachIteration) {
+        breakBB = llvm::BasicBlock::Create(context, "for.break", currentFunction);
+    }
+
+    builder.CreateBr(loopHeaderBB);
+
+    // for.header: index < count
+    builder.SetInsertPoint(loopHeaderBB);
+    llvm::Value* index = builder.CreateLoad(int64Type, indexAlloc, "index");
+    llvm::Value* hasNext = builder.CreateICmpSLT(index, count, "has_next");
+    builder.CreateCondBr(hasNext, loopBodyBB, stopIterationBB);
+
+    // 把第 index - 1 次迭代的值 (即最后一次绑定的值) 装箱写入循环变量；index 为 0 时循环变量不变
+    auto materializeLastValue = [&](llvm::BasicBlock* nextBB) {
+        llvm::Value* executed = builder.CreateLoad(int64Type, indexAlloc, "executed");
+        llvm::Value* ranAny = builder.CreateICmpSGT(executed, llvm::ConstantInt::get(int64Type, 0), "ran_any");
+        llvm::BasicBlock* storeBB = llvm::BasicBlock::Create(context, "for.bind_last", currentFunction);
+        builder.CreateCondBr(ranAny, storeBB, nextBB);
+        builder.SetInsertPoint(storeBB);
+        llvm::Value* lastIndex = builder.CreateSub(executed, llvm::ConstantInt::get(int64Type, 1));
+        llvm::Value* lastValue = builder.CreateAdd(start, builder.CreateMul(lastIndex, step), "last_value");
+        storeForLoopVariable(loopVarName, runtime->createIntObject(lastValue));
+        builder.CreateBr(nextBB);
+    };
+
+    // for.stop_iteration: 正常结束
+    builder.SetInsertPoint(stopIterationBB);
+    llvm::BasicBlock* afterStopBB = loopElseBB ? loopElseBB : loopEndBB;
+    if (bindEachIteration) {
+        builder.CreateBr(afterStopBB);
+    } else {
+        materializeLastValue(afterStopBB);
+        builder.SetInsertPoint(breakBB);
+        materializeLastValue(loopEndBB);
+    }
+
+    // for.body: 值 = start + index * step (按 2 的补码回绕计算，真实值总在 int64 范围内)
+    builder.SetInsertPoint(loopBodyBB);
+    llvm::Value* bodyIndex = builder.CreateLoad(int64Type, indexAlloc, "index");
+    builder.CreateStore(builder.CreateAdd(bodyIndex, llvm::ConstantInt::get(int64Type, 1)), indexAlloc);
+    if (bindEachIteration) {
+        llvm::Value* value = builder.CreateAdd(start, builder.CreateMul(bodyIndex, step), loopVarName + ".value");
+        if (boxEachIteration) {
+            storeForLoopVariable(loopVarName, runtime->createIntObject(value));
+        } else {
+            llvm::Function* bindFunc = runtime->getRuntimeFunction(
+                "py_range_bind_counter", llvm::Type::getVoidTy(context), {ptrType, int64Type});
+            builder.CreateCall(bindFunc, {loopVarAlloc, value});
+        }
+    }
+
+    emitForLoopBody(stmt, breakBB, loopHeaderBB);
+
+    if (loopElseBB) {
+        emitForElse(stmt, loopElseBB, loopEndBB);
+    }
+
+    builder.SetInsertPoint(loopEndBB);
+    cg.getSymbolTable().restoreOuterLoopContext();
+    return true;
+}
+
+/**
+ * @brief 静态类型为列表的 `for x in lst` 循环。
+ *
+ * 直接在 IR 中按下标遍历: 每次迭代重新读取 PyListObject 的 length/storage/data
+ * (循环体可能修改列表)，不创建迭代器对象，也不调用 py_next。
+ * 静态类型只是推断结果，因此入口处检查一次运行时 typeId，不是列表时退回 py_iter/py_next
+ * (循环不变的分支，两条路径共用同一份循环体)。
+ */
+void CodeGenStmt::handleListForStmt(const ForStmtAST* stmt, llvm::Value* listValue)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    llvm::LLVMContext& context = cg.getContext();
+    llvm::IRBuilder<>& builder = cg.getBuilder();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    auto* runtime = cg.getRuntimeGen();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    llvm::Type* int64Type = llvm::Type::getInt64Ty(context);
+    llvm::StructType* listStructType = runtime->getPyListStructType();
+
+    llvm::AllocaInst* indexAlloc = cg.createEntryBlockAlloca(int32Type, "list.index");
+    llvm::AllocaInst* iterAlloc = cg.createEntryBlockAlloca(pyObjectPtrType, "list.fallback_iter");
+
+    // --- 1. 运行时确认是列表 (LIST 或 LIST_BASE 派生 ID) ---
+    llvm::Value* typeId = runtime->loadTypeId(listValue);
+    llvm::Value* isPlainList = builder.CreateICmpEQ(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_LIST));
+    llvm::Value* isDerivedList = builder.CreateAnd(
+        builder.CreateICmpSGE(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_LIST_BASE)),
+        builder.CreateICmpSLT(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_DICT_BASE)));
+    llvm::Value* isList = builder.CreateOr(isPlainList, isDerivedList, "is_list");
+
+    llvm::BasicBlock* listInitBB = llvm::BasicBlock::Create(context, "for.list_init", currentFunction);
+    llvm::BasicBlock* iterInitBB = llvm::BasicBlock::Create(context, "for.iter_init", currentFunction);
+    builder.CreateCondBr(isList, listInitBB, iterInitBB, llvm::MDBuilder(context).createBranchWeights(100, 1));
+
+    // --- 2. 循环块 ---
+    llvm::BasicBlock* loopHeaderBB = llvm::BasicBlock::Create(context, "for.header", currentFunction); // Continue target
+    llvm::BasicBlock* listNextBB = llvm::BasicBlock::Create(context, "for.list_next", currentFunction);
+    llvm::BasicBlock* listFetchBB = llvm::BasicBlock::Create(context, "for.list_fetch", currentFunction);
+    llvm::BasicBlock* iterNextBB = llvm::BasicBlock::Create(context, "for.iter_next", currentFunction);
+    llvm::BasicBlock* itemReadyBB = llvm::BasicBlock::Create(context, "for.body", currentFunction);
+    llvm::BasicBlock* loopElseBB = stmt->getElseStmt() ? llvm::BasicBlock::Create(context, "for.else", currentFunction) : nullptr;
+    llvm::BasicBlock* loopEndBB = llvm::BasicBlock::Create(context, "for.end", currentFunction);
+    llvm::BasicBlock* stopIterationBB = llvm::BasicBlock::Create(context, "for.stop_iteration", currentFunction);
+    llvm::BasicBlock* breakBB = llvm::BasicBlock::Create(context, "for.break", currentFunction);
+
+    // 列表路径: 与迭代器一样持有列表的一个引用
+    builder.SetInsertPoint(listInitBB);
+    runtime->incRef(listValue);
+    builder.CreateStore(llvm::ConstantInt::get(int32Type, 0), indexAlloc);
+    builder.CreateStore(llvm::ConstantPointerNull::get(ptrType), iterAlloc);
+    builder.CreateBr(loopHeaderBB);
+
+    // 退回路径: 通用迭代器
+    builder.SetInsertPoint(iterInitBB);
+    llvm::Function* pyIterFunc = cg.getOrCreateExternalFunction("py_iter", pyObjectPtrType, {pyObjectPtrType}, false);
+    llvm::Value* iteratorObj = builder.CreateCall(pyIterFunc, {listValue}, "iterator");
+    llvm::BasicBlock* iterErrorBB = llvm::BasicBlock::Create(context, "iter.error", currentFunction);
+    llvm::BasicBlock* iterOkBB = llvm::BasicBlock::Create(context, "iter.ok", currentFunction);
+    builder.CreateCondBr(builder.CreateIsNull(iteratorObj, "is_iter_null"), iterErrorBB, iterOkBB);
+    builder.SetInsertPoint(iterErrorBB);
+    runtime->callRuntimeError("TypeError_NotIterable", stmt->line.value_or(0));
+    builder.CreateUnreachable();
+    builder.SetInsertPoint(iterOkBB);
+    builder.CreateStore(iteratorObj, iterAlloc);
+    builder.CreateBr(loopHeaderBB);
+
+    // for.header: 按路径取下一个元素
+    builder.SetInsertPoint(loopHeaderBB);
+    builder.CreateCondBr(isList, listNextBB, iterNextBB);
+
+    // for.list_next: index < length (每次迭代重新读取 length)
+    builder.SetInsertPoint(listNextBB);
+    llvm::Value* index = builder.CreateLoad(int32Type, indexAlloc, "index");
+    llvm::Value* lengthPtr = builder.CreateStructGEP(listStructType, listValue, 1, "length_ptr");
+    llvm::Value* length = builder.CreateLoad(int32Type, lengthPtr, "length");
+    builder.CreateCondBr(builder.CreateICmpSLT(index, length, "has_next"), listFetchBB, stopIterationBB);
+
+    // for.list_fetch: 按存储策略取出元素 (新引用)
+    builder.SetInsertPoint(listFetchBB);
+    builder.CreateStore(builder.CreateAdd(index, llvm::ConstantInt::get(int32Type, 1)), indexAlloc);
+    llvm::Value* storage = builder.CreateLoad(int32Type, builder.CreateStructGEP(listStructType, listValue, 4), "storage");
+    llvm::Value* data = builder.CreateLoad(ptrType, builder.CreateStructGEP(listStructType, listValue, 5), "data");
+
+    llvm::BasicBlock* boxedBB = llvm::BasicBlock::Create(context, "for.list_boxed", currentFunction);
+    llvm::BasicBlock* boxedHitBB = llvm::BasicBlock::Create(context, "for.list_boxed_hit", currentFunction);
+    llvm::BasicBlock* intBB = llvm::BasicBlock::Create(context, "for.list_int", currentFunction);
+    llvm::BasicBlock* slowBB = llvm::BasicBlock::Create(context, "for.list_box_item", currentFunction);
+    llvm::SwitchInst* storageSwitch = builder.CreateSwitch(storage, slowBB, 2);
+    storageSwitch->addCase(llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(int32Type), 0), boxedBB);  // PY_LIST_STORAGE_BOXED
+    storageSwitch->addCase(llvm::ConstantInt::get(llvm::cast<llvm::IntegerType>(int32Type), 1), intBB);    // PY_LIST_STORAGE_INT64
+
+    // BOXED: 直接读槽位并 incref；空槽位交给 py_list_box_item (返回 None)
+    builder.SetInsertPoint(boxedBB);
+    llvm::Value* slotPtr = builder.CreateInBoundsGEP(pyObjectPtrType, data, index, "slot_ptr");
+    llvm::Value* boxedItem = builder.CreateLoad(pyObjectPtrType, slotPtr, "boxed_item");
+    builder.CreateCondBr(builder.CreateIsNull(boxedItem), slowBB, boxedHitBB);
+    builder.SetInsertPoint(boxedHitBB);
+    runtime->incRef(boxedItem);
+    builder.CreateBr(itemReadyBB);
+
+    // INT64: 装箱 int64 值
+    builder.SetInsertPoint(intBB);
+    llvm::Value* intSlotPtr = builder.CreateInBoundsGEP(int64Type, data, index, "int_slot_ptr");
+    llvm::Value* intItem = runtime->createIntObject(builder.CreateLoad(int64Type, intSlotPtr, "int_value"));
+    builder.CreateBr(itemReadyBB);
+
+    // 其余存储 (double/bool 位图) 以及空槽位
+    builder.SetInsertPoint(slowBB);
+    llvm::Function* boxItemFunc = runtime->getRuntimeFunction("py_list_box_item", pyObjectPtrType, {pyObjectPtrType, int32Type});
+    llvm::Value* slowItem = builder.CreateCall(boxItemFunc, {listValue, index}, "boxed_slow");
+    builder.CreateBr(itemReadyBB);
+
+    // for.iter_next: 非列表时的 py_next 路径
+    builder.SetInsertPoint(iterNextBB);
+    llvm::Function* pyNextFunc = cg.getOrCreateExternalFunction("py_next", pyObjectPtrType, {pyObjectPtrType}, false);
+    llvm::Value* iterValue = builder.CreateLoad(pyObjectPtrType, iterAlloc, "iter");
+    llvm::Value* nextItem = builder.CreateCall(pyNextFunc, {iterValue}, "next_item_or_stop");
+    builder.CreateCondBr(builder.CreateIsNull(nextItem, "is_stop_iteration"), stopIterationBB, itemReadyBB);
+
+    // 循环结束时释放持有的列表引用或迭代器
+    auto releaseIterable = [&]() {
+        llvm::Value* iterHeld = builder.CreateLoad(pyObjectPtrType, iterAlloc, "iter_held");
+        runtime->decRef(builder.CreateSelect(isList, listValue, iterHeld, "iterable_held"));
+    };
+
+    builder.SetInsertPoint(stopIterationBB);
+    releaseIterable();
+    builder.CreateBr(loopElseBB ? loopElseBB : loopEndBB);
+
+    builder.SetInsertPoint(breakBB);
+    releaseIterable();
+    builder.CreateBr(loopEndBB);
+
+    // for.body: 绑定循环变量并生成循环体
+    builder.SetInsertPoint(itemReadyBB);
+    llvm::PHINode* item = builder.CreatePHI(pyObjectPtrType, 4, "item");
+    item->addIncoming(boxedItem, boxedHitBB);
+    item->addIncoming(intItem, intBB);
+    item->addIncoming(slowItem, slowBB);
+    item->addIncoming(nextItem, iterNextBB);
+    bindForLoopTargets(stmt, item);
+
+    emitForLoopBody(stmt, breakBB, loopHeaderBB);
+
+    if (loopElseBB) {
+        emitForElse(stmt, loopElseBB, loopEndBB);
+    }
+
+    builder.SetInsertPoint(loopEndBB);
+    cg.getSymbolTable().restoreOuterLoopContext();
+}
+
+/**
+ * @brief 字典的 for 循环: `for k in d`、`for k in keys(d)`、`for v in values(d)`、`for k, v in items(d)`。
+ *
+ * 直接在 IR 中按槽位扫描 PyDictObject 的条目数组，键和值从槽位借用后绑定到循环变量，
+ * 不创建迭代器，items 也不创建 (key, value) 元组。每次取下一项前比较字典的 version，
+ * 循环体插入新键或触发扩容时报 RuntimeError 并结束循环。
+ * 运行时 typeId 不是字典时退回 py_iter/py_next (与列表路径相同的循环不变分支)。
+ */
+bool CodeGenStmt::tryHandleDictForStmt(const ForStmtAST* stmt)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    const ExprAST* iterableExpr = stmt->getIterableExpr();
+
+    // --- 0. 识别字典来源与产出内容 ---
+    const ExprAST* dictExpr = nullptr;
+    enum class DictLoopKind { Keys, Values, Items };  // 对应运行时的 PyDictIterKind
+    DictLoopKind kind = DictLoopKind::Keys;
+    std::string viewRuntimeName;
+    if (auto* callExpr = dynamic_cast<const CallExprAST*>(iterableExpr)) {
+        auto* calleeExpr = dynamic_cast<const VariableExprAST*>(callExpr->getCalleeExpr());
+        if (!calleeExpr || callExpr->getArgs().size() != 1) return false;
+        const std::string& callee = calleeExpr->getName();
+        if (callee == "keys") {
+            kind = DictLoopKind::Keys;
+        } else if (callee == "values") {
+            kind = DictLoopKind::Values;
+        } else if (callee == "items") {
+            kind = DictLoopKind::Items;
+        } else {
+            return false;
+        }
+        if (cg.getSymbolTable().hasVariable(callee) || cg.getSymbolTable().findFunctionAST(callee)) return false;
+        dictExpr = callExpr->getArgs()[0].get();
+        viewRuntimeName = "py_builtin_dict_" + callee;
+    } else {
+        std::shared_ptr<PyType> iterableType = cg.getTypeGen()->inferExprType(iterableExpr);
+        if (!iterableType || !iterableType->isDict()) return false;
+        dictExpr = iterableExpr;
+    }
+    // items 只在解包为两个变量时走快速路径 (否则需要真正的元组)
+    size_t targetCount = stmt->getLoopVariables().size();
+    if (kind == DictLoopKind::Items ? targetCount != 2 : targetCount != 1) return false;
+
+    llvm::LLVMContext& context = cg.getContext();
+    llvm::IRBuilder<>& builder = cg.getBuilder();
+    llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+    auto* runtime = cg.getRuntimeGen();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+    llvm::PointerType* ptrType = llvm::PointerType::get(context, 0);
+    llvm::Type* int8Type = llvm::Type::getInt8Ty(context);
+    llvm::Type* int32Type = llvm::Type::getInt32Ty(context);
+    llvm::StructType* dictStructType = runtime->getPyDictStructType();
+    llvm::StructType* entryType = runtime->getPyDictEntryType();
+
+    llvm::Value* dictValue = cg.codegenExpr(dictExpr);
+    if (!dictValue) {
+        cg.logError("Failed to generate code for iterable in for loop at line " + std::to_string(stmt->line.value_or(0)));
+        return true;
+    }
+
+    llvm::AllocaInst* slotAlloc = cg.createEntryBlockAlloca(int32Type, "dict.slot");
+    llvm::AllocaInst* versionAlloc = cg.createEntryBlockAlloca(int32Type, "dict.version");
+    llvm::AllocaInst* iterAlloc = cg.createEntryBlockAlloca(pyObjectPtrType, "dict.fallback_iter");
+
+    // --- 1. 运行时确认是字典 (DICT 或 DICT_BASE 派生 ID) ---
+    llvm::Value* typeId = runtime->loadTypeId(dictValue);
+    llvm::Value* isPlainDict = builder.CreateICmpEQ(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_DICT));
+    llvm::Value* isDerivedDict = builder.CreateAnd(
+        builder.CreateICmpSGE(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_DICT_BASE)),
+        builder.CreateICmpSLT(typeId, llvm::ConstantInt::get(int32Type, PY_TYPE_FUNC_BASE)));
+    llvm::Value* isDict = builder.CreateOr(isPlainDict, isDerivedDict, "is_dict");
+
+    llvm::BasicBlock* dictInitBB = llvm::BasicBlock::Create(context, "for.dict_init", currentFunction);
+    llvm::BasicBlock* iterInitBB = llvm::BasicBlock::Create(context, "for.iter_init", currentFunction);
+    builder.CreateCondBr(isDict, dictInitBB, iterInitBB, llvm::MDBuilder(context).createBranchWeights(100, 1));
+
+    // --- 2. 循环块 ---
+    llvm::BasicBlock* loopHeaderBB = llvm::BasicBlock::Create(context, "for.header", currentFunction); // Continue target
+    llvm::BasicBlock* dictNextBB = llvm::BasicBlock::Create(context, "for.dict_next", currentFunction);
+    llvm::BasicBlock* dictScanBB = llvm::BasicBlock::Create(context, "for.dict_scan", currentFunction);
+    llvm::BasicBlock* dictProbeBB = llvm::BasicBlock::Create(context, "for.dict_probe", currentFunction);
+    llvm::BasicBlock* dictHitBB = llvm::BasicBlock::Create(context, "for.dict_hit", currentFunction);
+    llvm::BasicBlock* dictChangedBB = llvm::BasicBlock::Create(context, "for.dict_changed", currentFunction);
+    llvm::BasicBlock* iterNextBB = llvm::BasicBlock::Create(context, "for.iter_next", currentFunction);
+    llvm::BasicBlock* iterBindBB = llvm::BasicBlock::Create(context, "for.iter_bind", currentFunction);
+    llvm::BasicBlock* loopBodyBB = llvm::BasicBlock::Create(context, "for.body", currentFunction);
+    llvm::BasicBlock* loopElseBB = stmt->getElseStmt() ? llvm::BasicBlock::Create(context, "for.else", currentFunction) : nullptr;
+    llvm::BasicBlock* loopEndBB = llvm::BasicBlock::Create(context, "for.end", currentFunction);
+    llvm::BasicBlock* stopIterationBB = llvm::BasicBlock::Create(context, "for.stop_iteration", currentFunction);
+    llvm::BasicBlock* breakBB = llvm::BasicBlock::Create(context, "for.break", currentFunction);
+
+    // 字典路径: 与迭代器一样持有字典的一个引用，并记录开始时的 version
+    builder.SetInsertPoint(dictInitBB);
+    runtime->incRef(dictValue);
+    builder.CreateStore(llvm::ConstantInt::get(int32Type, 0), slotAlloc);
+    llvm::Value* startVersion = builder.CreateLoad(int32Type, builder.CreateStructGEP(dictStructType, dictValue, 4), "start_version");
+    builder.CreateStore(startVersion, versionAlloc);
+    builder.CreateStore(llvm::ConstantPointerNull::get(ptrType), iterAlloc);
+    builder.CreateBr(loopHeaderBB);
+
+    // 退回路径: 通用迭代器 (keys/values/items 调用对应的运行时函数，其余用 py_iter)
+    builder.SetInsertPoint(iterInitBB);
+    llvm::Function* makeIterFunc = viewRuntimeName.empty()
+            ? cg.getOrCreateExternalFunction("py_iter", pyObjectPtrType, {pyObjectPtrType}, false)
+            : runtime->getRuntimeFunction(viewRuntimeName, pyObjectPtrType, {pyObjectPtrType});
+    llvm::Value* iteratorObj = builder.CreateCall(makeIterFunc, {dictValue}, "iterator");
+    llvm::BasicBlock* iterErrorBB = llvm::BasicBlock::Create(context, "iter.error", currentFunction);
+    llvm::BasicBlock* iterOkBB = llvm::BasicBlock::Create(context, "iter.ok", currentFunction);
+    builder.CreateCondBr(builder.CreateIsNull(iteratorObj, "is_iter_null"), iterErrorBB, iterOkBB);
+    builder.SetInsertPoint(iterErrorBB);
+    runtime->callRuntimeError("TypeError_NotIterable", stmt->line.value_or(0));
+    builder.CreateUnreachable();
+    builder.SetInsertPoint(iterOkBB);
+    builder.CreateStore(iteratorObj, iterAlloc);
+    builder.CreateBr(loopHeaderBB);
+
+    // for.header: 按路径取下一项
+    builder.SetInsertPoint(loopHeaderBB);
+    builder.CreateCondBr(isDict, dictNextBB, iterNextBB);
+
+    // for.dict_next: 字典结构未被修改
+    builder.SetInsertPoint(dictNextBB);
+    llvm::Value* version = builder.CreateLoad(int32Type, builder.CreateStructGEP(dictStructType, dictValue, 4), "version");
+    llvm::Value* savedVersion = builder.CreateLoad(int32Type, versionAlloc, "saved_version");
+    // 循环体可能让写时复制的字典换上新的条目表 (槽位位置不变)，每次取下一项时重新读取；
+    // 扫描过程中不会写字典，探测循环直接使用这里读到的表
+    llvm::Value* capacity = builder.CreateLoad(int32Type, builder.CreateStructGEP(dictStructType, dictValue, 2), "capacity");
+    llvm::Value* entries = builder.CreateLoad(ptrType, builder.CreateStructGEP(dictStructType, dictValue, 5), "entries");
+    builder.CreateCondBr(builder.CreateICmpEQ(version, savedVersion, "unchanged"), dictScanBB, dictChangedBB,
+                         llvm::MDBuilder(context).createBranchWeights(100, 1));
+
+    builder.SetInsertPoint(dictChangedBB);
+    runtime->callRuntimeError("RuntimeError_DictChangedSize", stmt->line.value_or(0));
+    builder.CreateBr(breakBB);
+
+    // for.dict_scan: 跳过空槽和墓碑，直到找到下一个条目或扫描完整个表
+    builder.SetInsertPoint(dictScanBB);
+    llvm::Value* slot = builder.CreateLoad(int32Type, slotAlloc, "slot");
+    builder.CreateCondBr(builder.CreateICmpSLT(slot, capacity, "has_slot"), dictProbeBB, stopIterationBB);
+
+    builder.SetInsertPoint(dictProbeBB);
+    builder.CreateStore(builder.CreateAdd(slot, llvm::ConstantInt::get(int32Type, 1)), slotAlloc);
+    llvm::Value* entryPtr = builder.CreateInBoundsGEP(entryType, entries, slot, "entry");
+    llvm::Value* key = builder.CreateLoad(pyObjectPtrType, builder.CreateStructGEP(entryType, entryPtr, 0), "key");
+    llvm::Value* used = builder.CreateLoad(int8Type, builder.CreateStructGEP(entryType, entryPtr, 3), "used");
+    llvm::Value* occupied = builder.CreateAnd(builder.CreateIsNotNull(key), builder.CreateICmpNE(used, llvm::ConstantInt::get(int8Type, 0)), "occupied");
+    builder.CreateCondBr(occupied, dictHitBB, dictScanBB);
+
+    // for.dict_hit: 键/值从槽位借用，storeForLoopVariable 会为循环变量持有自己的引用
+    builder.SetInsertPoint(dictHitBB);
+    auto loadValue = [&]() {
+        llvm::Value* value = builder.CreateLoad(pyObjectPtrType, builder.CreateStructGEP(entryType, entryPtr, 1), "value");
+        // 值为 NULL 表示 None
+        llvm::Function* noneFunc = runtime->getRuntimeFunction("py_get_none", pyObjectPtrType, {});
+        llvm::Value* noneValue = builder.CreateCall(noneFunc, {}, "none");
+        return builder.CreateSelect(builder.CreateIsNull(value), noneValue, value, "value_or_none");
+    };
+    const auto& targets = stmt->getLoopVariables();
+    if (kind == DictLoopKind::Keys) {
+        storeForLoopVariable(targets[0], key);
+    } else if (kind == DictLoopKind::Values) {
+        storeForLoopVariable(targets[0], loadValue());
+    } else {
+        llvm::Value* value = loadValue();
+        storeForLoopVariable(targets[0], key);
+        storeForLoopVariable(targets[1], value);
+    }
+    builder.CreateBr(loopBodyBB);
+
+    // for.iter_next: 非字典时的 py_next 路径
+    builder.SetInsertPoint(iterNextBB);
+    llvm::Function* pyNextFunc = cg.getOrCreateExternalFunction("py_next", pyObjectPtrType, {pyObjectPtrType}, false);
+    llvm::Value* iterValue = builder.CreateLoad(pyObjectPtrType, iterAlloc, "iter");
+    llvm::Value* nextItem = builder.CreateCall(pyNextFunc, {iterValue}, "next_item_or_stop");
+    builder.CreateCondBr(builder.CreateIsNull(nextItem, "is_stop_iteration"), stopIterationBB, iterBindBB);
+
+    builder.SetInsertPoint(iterBindBB);
+    bindForLoopTargets(stmt, nextItem);
+    builder.CreateBr(loopBodyBB);
+
+    // 循环结束时释放持有的字典引用或迭代器
+    auto releaseIterable = [&]() {
+        llvm::Value* iterHeld = builder.CreateLoad(pyObjectPtrType, iterAlloc, "iter_held");
+        runtime->decRef(builder.CreateSelect(isDict, dictValue, iterHeld, "iterable_held"));
+    };
+
+    builder.SetInsertPoint(stopIterationBB);
+    releaseIterable();
+    builder.CreateBr(loopElseBB ? loopElseBB : loopEndBB);
+
+    builder.SetInsertPoint(breakBB);
+    releaseIterable();
+    builder.CreateBr(loopEndBB);
+
+    // for.body
+    builder.SetInsertPoint(loopBodyBB);
+    emitForLoopBody(stmt, breakBB, loopHeaderBB);
+
+    if (loopElseBB) {
+        emitForElse(stmt, loopElseBB, loopEndBB);
+    }
+
+    builder.SetInsertPoint(loopEndBB);
+    cg.getSymbolTable().restoreOuterLoopContext();
+    return true;
+}
+
 // 处理for语句
 void CodeGenStmt::handleForStmt(const ForStmtAST* stmt)
 {
+    if (tryHandleRangeForStmt(stmt)) return;
+    if (tryHandleDictForStmt(stmt)) return;
+
     PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
     llvm::LLVMContext& context = cg.getContext();
     llvm::IRBuilder<>& builder = cg.getBuilder();
     llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
 
     // --- 0. 获取循环变量名和可迭代对象表达式 ---
-    const std::string& loopVarName = stmt->getLoopVariable();
     const ExprAST* iterableExpr = stmt->getIterableExpr();
 
     // --- 1. 生成可迭代对象的代码 ---
@@ -1434,6 +2563,13 @@ void CodeGenStmt::handleForStmt(const ForStmtAST* stmt)
         return;
     }
 
+    // 静态类型为列表: 直接在 IR 中按下标遍历
+    std::shared_ptr<PyType> iterableType = cg.getTypeGen()->inferExprType(iterableExpr);
+    if (iterableType && iterableType->isList()) {
+        handleListForStmt(stmt, iterableValue);
+        return;
+    }
+
     // --- 2. 获取迭代器对象 ---
     llvm::Type* pyObjectPtrType_for_iter = cg.getRuntimeGen()->getPyObjectPtrType();
     llvm::Function* pyIterFunc = cg.getOrCreateExternalFunction(
@@ -1497,77 +2633,16 @@ void CodeGenStmt::handleForStmt(const ForStmtAST* stmt)
     // --- 5. 循环体 (loopBodyBB) ---
     builder.SetInsertPoint(loopBodyBB);
     
-    // 5.1 将 nextItem 赋值给循环变量
-    llvm::AllocaInst* loopVarAlloc = cg.getSymbolTable().lookupAlloca(loopVarName);
-    std::shared_ptr<PyType> loopVarPyType = PyType::fromObjectType(TypeRegistry::getInstance().getType("any"));
-    ObjectType* loopVarObjectType = loopVarPyType ? loopVarPyType->getObjectType() : nullptr;
-    llvm::Type* pyObjectPtrType_for_alloc = cg.getRuntimeGen()->getPyObjectPtrType();
-
-    if (!loopVarAlloc) {
-         loopVarAlloc = cg.createEntryBlockAlloca(pyObjectPtrType_for_alloc, loopVarName);
-         // +++ FIX: Initialize the newly created alloca with nullptr +++
-         builder.CreateStore(llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(pyObjectPtrType_for_alloc)), loopVarAlloc);
-         // +++ END FIX +++
-         cg.getSymbolTable().setVariable(loopVarName, loopVarAlloc, loopVarObjectType);
-    } else {
-        // If it already exists, assume it's managed correctly by outer scopes or previous logic.
-        // However, ensure it's correctly set in the current symbol table context if re-entering a scope.
-        cg.getSymbolTable().setVariable(loopVarName, loopVarAlloc, loopVarObjectType);
-    }
-    llvm::Value* oldLoopVarValue = builder.CreateLoad(pyObjectPtrType_for_alloc, loopVarAlloc, "old_" + loopVarName);
-    cg.getRuntimeGen()->decRef(oldLoopVarValue); // This is now safe if alloca was initialized or held a valid previous object.
-    builder.CreateStore(nextItem, loopVarAlloc);
-    cg.getRuntimeGen()->incRef(nextItem); // <<< ADDED: IncRef the new item being stored and now owned by loopVarAlloc
+    // 5.1 将 nextItem 赋值给循环变量 (解包形式时逐项拆开)
+    bindForLoopTargets(stmt, nextItem);
 
     // 5.2 生成循环体代码
-    cg.pushScope();  // Keep original scope management
-    // Set loop context for symbol table (if it uses it for other purposes)
     // loopEndBB is the break target, loopHeaderBB is the continue target.
-    cg.getSymbolTable().setLoopContext(loopEndBB, loopHeaderBB); 
-
-    // --- MODIFICATION START: Push targets for CodeGenStmt's break/continue handlers ---
-    pushBreakTarget(loopEndBB);       // Break jumps to loopEndBB (after else)
-    pushContinueTarget(loopHeaderBB); // Continue jumps to loopHeaderBB
-    // --- MODIFICATION END ---
-
-    for (const auto& bodyStmt : stmt->getBody()) {
-        cg.codegenStmt(bodyStmt.get()); // Keep original call to PyCodeGen's dispatcher
-        if (builder.GetInsertBlock()->getTerminator() != nullptr) { 
-            break; 
-        }
-    }
-
-    // --- MODIFICATION START: Pop targets ---
-    popContinueTarget();
-    popBreakTarget();
-    // --- MODIFICATION END ---
-
-    cg.popScope(); // Keep original scope management
-
-    if (builder.GetInsertBlock()->getTerminator() == nullptr) { 
-        // cg.getRuntimeGen()->decRef(nextItem); // This was commented out, likely correct.
-        builder.CreateBr(loopHeaderBB); 
-    }
+    emitForLoopBody(stmt, loopEndBB, loopHeaderBB);
 
     // --- 6. Else 子句 (loopElseBB) ---
     if (loopElseBB) {
-        builder.SetInsertPoint(loopElseBB);
-        cg.pushScope(); // Keep original scope management for else
-        cg.getSymbolTable().clearLoopContext(); // Keep original symbol table context clearing
-
-        const auto* elseAstNode = stmt->getElseStmt(); // Use a more generic name
-        if (const auto* elseBlock = dynamic_cast<const BlockStmtAST*>(elseAstNode)) {
-            for (const auto& elseBodyStmt : elseBlock->getStatements()) {
-                cg.codegenStmt(elseBodyStmt.get()); // Keep original call
-                 if (builder.GetInsertBlock()->getTerminator() != nullptr) break;
-            }
-        } else if (elseAstNode) { // If it's not a BlockStmt but still exists
-            cg.codegenStmt(const_cast<StmtAST*>(elseAstNode)); // Keep original call
-        }
-        cg.popScope(); // Keep original scope management for else
-        if (builder.GetInsertBlock()->getTerminator() == nullptr) {
-            builder.CreateBr(loopEndBB); 
-        }
+        emitForElse(stmt, loopElseBB, loopEndBB);
     }
 
     // --- 7. 循环结束 (loopEndBB) ---
@@ -1621,19 +2696,17 @@ void CodeGenStmt::handlePrintStmt(PrintStmtAST* stmt)
 
 void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
 {
-    auto& builder = codeGen.getBuilder();
     auto* exprGen = codeGen.getExprGen();
     auto* typeGen = codeGen.getTypeGen();
     auto* runtime = codeGen.getRuntimeGen();
-    auto& symTable = codeGen.getSymbolTable();
-    auto& context = codeGen.getContext();
-    llvm::Type* pyObjectPtrType = llvm::PointerType::get(context, 0);  // PyObject*
 
     const std::string& varName = stmt->getName();
     const ExprAST* valueExpr = stmt->getValue();
     int line = stmt->line.value_or(0);
     int col = stmt->column.value_or(0);
 
+    if (tryHandleStringAppendAssign(stmt)) return;
+
     // 1. 生成 RHS 的 PyObject* 值
     llvm::Value* rhsRawValue = exprGen->handleExpr(valueExpr);
     if (!rhsRawValue) return;  // Error logged by handleExpr
@@ -1665,6 +2738,79 @@ void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
     }
 
     // 4. 处理赋值目标 (LHS)
+    if (!assignVariable(varName, valueToStore, rhsObjType, line, col))
+    {
+        runtime->cleanupTemporaryObjects();
+        return;
+    }
+
+    // 5. Mark last computed expression (optional)
+    codeGen.setLastExprValue(valueToStore);  // 使用实际存储的 PyObject*
+    codeGen.setLastExprType(rhsPyType);
+
+    // 6. Cleanup temporary objects created during RHS evaluation
+    runtime->cleanupTemporaryObjects();
+}
+
+// 字符串变量的自拼接 (x = x + piece)，仅用于 beginStringAppendTracking 选出的变量。
+// 变量的存储位置和所有权标志交给 py_string_append_to，由运行时决定原地追加还是复制出新的缓冲区。
+bool CodeGenStmt::tryHandleStringAppendAssign(AssignStmtAST* stmt)
+{
+    const std::string& varName = stmt->getName();
+    auto flagIt = stringAppendFlags.find(varName);
+    if (flagIt == stringAppendFlags.end()) return false;
+    const ExprAST* pieceExpr = stringAppendPiece(stmt);
+    if (!pieceExpr) return false;
+
+    auto& symTable = codeGen.getSymbolTable();
+    if (!symTable.hasVariable(varName)) return false;
+    llvm::Value* storage = symTable.getVariable(varName);
+    if (!llvm::isa<llvm::AllocaInst>(storage)) return false;
+
+    // 至少一侧静态类型为字符串才走追加路径 (非字符串时运行时退回普通加法)
+    ObjectType* varType = symTable.getVariableType(varName);
+    auto pieceType = pieceExpr->getType();
+    bool varIsString = varType && OperationCodeGenerator::getTypeId(varType) == PY_TYPE_STRING;
+    bool pieceIsString = pieceType && OperationCodeGenerator::getTypeId(pieceType->getObjectType()) == PY_TYPE_STRING;
+    if (!varIsString && !pieceIsString) return false;
+
+    auto& builder = codeGen.getBuilder();
+    auto* runtime = codeGen.getRuntimeGen();
+    llvm::Type* pyObjectPtrType = llvm::PointerType::get(codeGen.getContext(), 0);
+
+    llvm::Value* piece = codeGen.getExprGen()->handleExpr(pieceExpr);
+    if (!piece) return true;  // 错误已记录
+    if (!piece->getType()->isPointerTy())
+    {
+        int pieceTypeId = OperationCodeGenerator::getTypeId(pieceExpr->getType()->getObjectType());
+        piece = OperationCodeGenerator::createObject(static_cast<PyCodeGen&>(codeGen), piece, pieceTypeId);
+    }
+
+    llvm::Function* appendFunc = runtime->getRuntimeFunction(
+            "py_string_append_to", builder.getInt1Ty(), {pyObjectPtrType, pyObjectPtrType, builder.getInt1Ty()});
+    llvm::Value* ownsBuffer = builder.CreateLoad(builder.getInt1Ty(), flagIt->second, varName + "_owns");
+    llvm::Value* stillOwns = builder.CreateCall(appendFunc, {storage, piece, ownsBuffer}, varName + "_append");
+    builder.CreateStore(stillOwns, flagIt->second);
+
+    codeGen.setLastExprValue(builder.CreateLoad(pyObjectPtrType, storage, varName + "_val"));
+    codeGen.setLastExprType(varIsString ? PyType::getString() : PyType::getAny());
+    runtime->cleanupTemporaryObjects();
+    return true;
+}
+
+// 把 valueToStore 绑定到变量 varName (局部变量用 alloca，模块级变量用全局变量)。
+// 旧值 decRef，新值 incRef，并更新符号表中的类型。出错时记录错误并返回 false。
+bool CodeGenStmt::assignVariable(const std::string& varName, llvm::Value* valueToStore, ObjectType* valueObjType, int line, int col)
+{
+    auto& builder = codeGen.getBuilder();
+    auto* runtime = codeGen.getRuntimeGen();
+    auto& symTable = codeGen.getSymbolTable();
+    llvm::Type* pyObjectPtrType = llvm::PointerType::get(codeGen.getContext(), 0);  // PyObject*
+
+    // 普通赋值后变量的值不再是它独占的追加缓冲区
+    auto flagIt = stringAppendFlags.find(varName);
+    if (flagIt != stringAppendFlags.end()) builder.CreateStore(builder.getFalse(), flagIt->second);
+
     size_t scopeDepth = symTable.getCurrentScopeDepth();
     bool isLocalVar = scopeDepth > 1;  // 假设 depth 1 是全局/模块
 
@@ -1683,8 +2829,7 @@ void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
                 if (allocaInst->getAllocatedType() != pyObjectPtrType)
                 {
                     codeGen.logError("Internal error: Storage for local variable '" + varName + "' is not PyObject**.", line, col);
-                    runtime->cleanupTemporaryObjects();
-                    return;
+                    return false;
                 }
                 // 1. Load old value
                 llvm::Value* oldPyObject = builder.CreateLoad(pyObjectPtrType, allocaInst, varName + "_old");
@@ -1695,14 +2840,13 @@ void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
                 // 4. IncRef new value
                 runtime->incRef(valueToStore);
                 // 5. Update type in symbol table
-                symTable.setVariable(varName, storage, rhsObjType);  // storage 不变, 更新类型
+                symTable.setVariable(varName, storage, valueObjType);  // storage 不变, 更新类型
             }
             else
             {
                 // 符号表中有，但不是 AllocaInst*，这在函数作用域内不应该发生
                 codeGen.logError("Internal error: Expected AllocaInst* for existing local variable '" + varName + "' but found different value type.", line, col);
-                runtime->cleanupTemporaryObjects();
-                return;
+                return false;
             }
         }
         else
@@ -1713,8 +2857,7 @@ void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
                 if (gv->getValueType() != pyObjectPtrType)
                 {
                     codeGen.logError("Internal error: Storage for global variable '" + varName + "' is not PyObject**.", line, col);
-                    runtime->cleanupTemporaryObjects();
-                    return;
+                    return false;
                 }
                 // 1. Load old value
                 llvm::Value* oldPyObject = builder.CreateLoad(pyObjectPtrType, gv, varName + "_old_global");
@@ -1725,14 +2868,13 @@ void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
                 // 4. IncRef new value
                 runtime->incRef(valueToStore);
                 // 5. Update type in symbol table
-                symTable.setVariable(varName, storage, rhsObjType);  // storage 不变, 更新类型
+                symTable.setVariable(varName, storage, valueObjType);  // storage 不变, 更新类型
             }
             else
             {
                 // 符号表中有，但不是 GlobalVariable*，这在全局作用域内可能表示其他错误
                 codeGen.logError("Internal error: Expected GlobalVariable* for existing global variable '" + varName + "' but found different value type.", line, col);
-                runtime->cleanupTemporaryObjects();
-                return;
+                return false;
             }
         }
     }
@@ -1746,14 +2888,13 @@ void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
             llvm::AllocaInst* allocaInst = codeGen.createEntryBlockAlloca(pyObjectPtrType, varName);
             if (!allocaInst)
             {  // createEntryBlockAlloca 内部会 logError
-                runtime->cleanupTemporaryObjects();
-                return;
+                return false;
             }
             storage = allocaInst;
             // 2. Store initial value
             builder.CreateStore(valueToStore, allocaInst);
             // 3. Add entry to symbol table
-            symTable.setVariable(varName, storage, rhsObjType);  // 存储 AllocaInst*
+            symTable.setVariable(varName, storage, valueObjType);  // 存储 AllocaInst*
             // 4. IncRef initial value
             runtime->incRef(valueToStore);
         }
@@ -1779,17 +2920,105 @@ void CodeGenStmt::handleAssignStmt(AssignStmtAST* stmt)
             // 2. Store initial value (覆盖 null)
             builder.CreateStore(valueToStore, gv);
             // 3. Add entry to symbol table
-            symTable.setVariable(varName, storage, rhsObjType);  // 存储 GlobalVariable*
+            symTable.setVariable(varName, storage, valueObjType);  // 存储 GlobalVariable*
             // 4. IncRef initial value
             runtime->incRef(valueToStore);
         }
     }
 
-    // 5. Mark last computed expression (optional)
-    codeGen.setLastExprValue(valueToStore);  // 使用实际存储的 PyObject*
-    codeGen.setLastExprType(rhsPyType);
+    return true;
+}
+
+// 解包赋值 x, y = value
+void CodeGenStmt::handleUnpackAssignStmt(UnpackAssignStmtAST* stmt)
+{
+    PyCodeGen& cg = static_cast<PyCodeGen&>(codeGen);
+    auto& builder = codeGen.getBuilder();
+    auto& context = codeGen.getContext();
+    auto* exprGen = codeGen.getExprGen();
+    auto* runtime = codeGen.getRuntimeGen();
+    llvm::Type* pyObjectPtrType = runtime->getPyObjectPtrType();
+
+    const std::vector<std::string>& targets = stmt->getTargets();
+    const ExprAST* valueExpr = stmt->getValue();
+    int line = stmt->line.value_or(0);
+    int col = stmt->column.value_or(0);
+    ObjectType* anyObjType = PyType::getAny()->getObjectType();
+    size_t count = targets.size();
+
+    std::vector<llvm::Value*> items;
+
+    if (valueExpr->kind() == ASTKind::TupleExpr)
+    {
+        // 右侧是元组字面量 (如 a, b = b, a): 逐个求值后直接赋值，不创建元组对象
+        const auto& elements = static_cast<const TupleExprAST*>(valueExpr)->getElements();
+        if (elements.size() != count)
+        {
+            codeGen.logError(std::string(elements.size() > count ? "too many" : "not enough")
+                                     + " values to unpack (expected " + std::to_string(count) + ", got "
+                                     + std::to_string(elements.size()) + ")",
+                             line, col);
+            return;
+        }
+        for (const auto& elem : elements)
+        {
+            llvm::Value* value = exprGen->handleExpr(elem.get());
+            if (!value)
+            {
+                runtime->cleanupTemporaryObjects();
+                return;
+            }
+            items.push_back(value);
+        }
+        // 先持有全部右值，避免前面的赋值释放了后面要用的对象
+        for (llvm::Value* item : items)
+            runtime->incRef(item);
+    }
+    else
+    {
+        llvm::Value* value = exprGen->handleExpr(valueExpr);
+        if (!value) return;
+
+        llvm::ArrayType* bufType = llvm::ArrayType::get(pyObjectPtrType, count);
+        llvm::AllocaInst* buf = cg.createEntryBlockAlloca(bufType, "unpack.buf");
+        llvm::Function* unpackFunc = runtime->getRuntimeFunction(
+            "py_unpack_sequence", llvm::Type::getInt1Ty(context),
+            {pyObjectPtrType, llvm::Type::getInt32Ty(context), llvm::PointerType::get(context, 0)});
+        llvm::Value* ok = builder.CreateCall(
+            unpackFunc, {value, llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), count), buf}, "unpack.ok");
+
+        llvm::Function* currentFunction = builder.GetInsertBlock()->getParent();
+        llvm::BasicBlock* errorBB = llvm::BasicBlock::Create(context, "unpack.error", currentFunction);
+        llvm::BasicBlock* okBB = llvm::BasicBlock::Create(context, "unpack.ok", currentFunction);
+        builder.CreateCondBr(ok, okBB, errorBB);
+
+        // 元素个数不符或不可迭代: 运行时已打印错误信息
+        builder.SetInsertPoint(errorBB);
+        llvm::Function* exitFunc = cg.getOrCreateExternalFunction(
+            "exit", llvm::Type::getVoidTy(context), {llvm::Type::getInt32Ty(context)}, false);
+        builder.CreateCall(exitFunc, {llvm::ConstantInt::get(llvm::Type::getInt32Ty(context), 1)});
+        builder.CreateUnreachable();
+
+        builder.SetInsertPoint(okBB);
+        for (size_t i = 0; i < count; ++i)
+        {
+            llvm::Value* slot = builder.CreateConstInBoundsGEP2_32(bufType, buf, 0, i);
+            items.push_back(builder.CreateLoad(pyObjectPtrType, slot, targets[i] + ".unpacked"));
+        }
+    }
+
+    // items 中每个元素都持有一个引用，赋值后释放
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!assignVariable(targets[i], items[i], anyObjType, line, col))
+        {
+            runtime->cleanupTemporaryObjects();
+            return;
+        }
+    }
+    for (llvm::Value* item : items)
+        runtime->decRef(item);
 
-    // 6. Cleanup temporary objects created during RHS evaluation
     runtime->cleanupTemporaryObjects();
 }
 
@@ -207,6 +207,21 @@ std::shared_ptr<PyType> CodeGenType::inferExprType(const ExprAST* expr)
             resultType = inferIndexExprType(targetType, indexType);
             break;
         }
+        case ASTKind::ListCompExpr:
+        {
+            // 只有可以非装箱存储的元素类型才体现在列表类型中，与运行时的 elemTypeId 一致
+            std::shared_ptr<PyType> elemType = inferListCompElementType(static_cast<const ListCompExprAST*>(expr));
+            bool unboxed = elemType && (elemType->isInt() || elemType->isDouble() || elemType->isBool());
+            resultType = PyType::getList(unboxed ? elemType : PyType::getAny());
+            break;
+        }
+        case ASTKind::SliceExpr:
+        {
+            // 切片保持序列类型 (list[T] -> list[T]，str -> str)
+            std::shared_ptr<PyType> targetType = inferExprType(static_cast<const SliceExprAST*>(expr)->getTarget());
+            resultType = (targetType && (targetType->isList() || targetType->isString())) ? targetType : PyType::getAny();
+            break;
+        }
 
         default:
             // 默认情况下使用Any类型
@@ -653,6 +668,91 @@ std::shared_ptr<PyType> CodeGenType::inferCallExprType(
             return PyType::getList(PyType::getAny());
         }
     }
+    else if (funcName == "any" || funcName == "all")
+    {
+        return PyType::getBool();
+    }
+    else if (funcName == "len")
+    {
+        return PyType::getInt();
+    }
+    else if (funcName == "sum" || funcName == "min" || funcName == "max")
+    {
+        // 单个参数: 取可迭代对象的元素类型；min/max 多参数: 参数类型一致时取该类型
+        std::shared_ptr<PyType> elemType;
+        if (argTypes.size() == 1 && argTypes[0] && argTypes[0]->isList())
+        {
+            elemType = PyType::getListElementType(argTypes[0]);
+        }
+        else if (argTypes.size() > 1 && funcName != "sum")
+        {
+            elemType = argTypes[0];
+            for (const auto& argType : argTypes)
+            {
+                if (!argType || !elemType || argType->toString() != elemType->toString())
+                {
+                    elemType = nullptr;
+                    break;
+                }
+            }
+        }
+
+        if (!elemType)
+        {
+            return PyType::getAny();
+        }
+        if (funcName == "sum")
+        {
+            // sum 从 int 0 开始累加，bool 元素求和得到 int
+            if (elemType->isInt() || elemType->isBool()) return PyType::getInt();
+            if (elemType->isDouble()) return PyType::getDouble();
+            return PyType::getAny();
+        }
+        return elemType;
+    }
+    else if (funcName == "vec_add" || funcName == "vec_sub" || funcName == "vec_mul" || funcName == "vec_div")
+    {
+        // 逐元素运算: 结果为列表，元素类型由两侧的元素 (或标量) 类型决定
+        auto elementOf = [](const std::shared_ptr<PyType>& t) -> std::shared_ptr<PyType>
+        {
+            if (!t) return nullptr;
+            return t->isList() ? PyType::getListElementType(t) : t;
+        };
+        std::shared_ptr<PyType> lhs = argTypes.size() > 0 ? elementOf(argTypes[0]) : nullptr;
+        std::shared_ptr<PyType> rhs = argTypes.size() > 1 ? elementOf(argTypes[1]) : nullptr;
+        if (lhs && rhs && lhs->isNumeric() && rhs->isNumeric())
+        {
+            if (funcName == "vec_div" || lhs->isDouble() || rhs->isDouble())
+            {
+                return PyType::getList(PyType::getDouble());
+            }
+            return PyType::getList(PyType::getInt());
+        }
+        return PyType::getList(PyType::getAny());
+    }
+    else if (funcName == "range")
+    {
+        // 惰性 range 对象，暂无对应的编译期类型
+        return PyType::getAny();
+    }
+    else if (funcName == "set" || funcName == "set_add" || funcName == "set_discard" || funcName == "set_union" || funcName == "set_intersection" || funcName == "set_difference")
+    {
+        // 集合没有对应的编译期类型，set_add/set_discard 返回 None
+        return PyType::getAny();
+    }
+    else if (funcName == "keys" || funcName == "values" || funcName == "items")
+    {
+        // 字典迭代器，暂无对应的编译期类型
+        return PyType::getAny();
+    }
+    else if (funcName == "gc_collect")
+    {
+        return PyType::getInt();
+    }
+    else if (funcName == "gc_set_threshold")
+    {
+        return PyType::getAny();
+    }
     // 也许这里可能兼容更多内置函数? TODO
 
     // 通用函数类型推导 - 根据函数体分析
@@ -892,6 +992,12 @@ std::shared_ptr<PyType> CodeGenType::analyzeReturnExpr(
             // 使用索引操作类型推导规则
             return inferIndexExprType(targetType, indexType);
         }
+        case ASTKind::SliceExpr:
+        {
+            std::shared_ptr<PyType> targetType = inferExprType(static_cast<const SliceExprAST*>(expr)->getTarget());
+            if (targetType && (targetType->isList() || targetType->isString())) return targetType;
+            return PyType::getAny();
+        }
 
         // 处理其他类型的表达式...
         default:
@@ -1043,6 +1149,43 @@ std::shared_ptr<PyType> CodeGenType::inferListElementType(
 
     return PyType::getAny();  // 这里显然还是感觉有问题，因为没有正确推断而是把这些全留给了RT
 }
+bool CodeGenType::isBuiltinRangeCall(const ExprAST* expr)
+{
+    if (!expr || expr->kind() != ASTKind::CallExpr) return false;
+    auto* callExpr = static_cast<const CallExprAST*>(expr);
+    auto* calleeExpr = dynamic_cast<const VariableExprAST*>(callExpr->getCalleeExpr());
+    if (!calleeExpr || calleeExpr->getName() != "range") return false;
+    auto& symTable = codeGen.getSymbolTable();
+    if (symTable.hasVariable("range") || symTable.findFunctionAST("range")) return false;
+    size_t argCount = callExpr->getArgs().size();
+    return argCount >= 1 && argCount <= 3;
+}
+
+std::shared_ptr<PyType> CodeGenType::inferListCompVarType(const ListCompExprAST* expr)
+{
+    if (isBuiltinRangeCall(expr->getIterable())) return PyType::getInt();
+
+    std::shared_ptr<PyType> iterableType = inferExprType(expr->getIterable());
+    if (iterableType && iterableType->isList()) return PyType::getListElementType(iterableType);
+    if (iterableType && iterableType->isString()) return PyType::getString();
+    return PyType::getAny();
+}
+
+std::shared_ptr<PyType> CodeGenType::inferListCompElementType(const ListCompExprAST* expr)
+{
+    std::shared_ptr<PyType> varType = inferListCompVarType(expr);
+
+    // 循环变量只在推导式内可见: 用占位值在临时作用域中声明它 (非 alloca，弹出时不生成清理代码)
+    auto& symTable = codeGen.getSymbolTable();
+    symTable.pushScope();
+    symTable.setVariable(expr->getVarName(),
+                         llvm::ConstantPointerNull::get(llvm::PointerType::get(codeGen.getContext(), 0)),
+                         varType ? varType->getObjectType() : nullptr);
+    std::shared_ptr<PyType> elemType = inferExprType(expr->getElement());
+    symTable.popScope(codeGen);
+    return elemType ? elemType : PyType::getAny();
+}
+
 std::shared_ptr<PyType> CodeGenType::getCommonType(
         std::shared_ptr<PyType> typeA,
         std::shared_ptr<PyType> typeB)
@@ -0,0 +1,317 @@
+#include "CodeGen/RefCountElision.h"
+#include "RunTime/runtime_level.h"  // _PY_SMALL_INT_MIN / _PY_SMALL_INT_MAX
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/IntrinsicInst.h>
+
+namespace llvmpy
+{
+
+namespace
+{
+
+enum class RefCountOp
+{
+    None,
+    Incref,
+    Decref
+};
+
+// 不会释放任何对象、也不读取引用计数的运行时函数。调用它们不影响 incref/decref 配对。
+// 算术与比较只读取操作数并返回新对象，创建函数只分配新对象。
+const llvm::StringSet<>& refCountNeutralCallees()
+{
+    static const llvm::StringSet<> callees = {
+            "py_incref",
+            "py_get_none",
+            "py_create_int",
+            "py_create_int_bystring",
+            "py_create_double",
+            "py_create_bool",
+            "py_create_string",
+            "py_const_int",
+            "py_const_double",
+            "py_const_string",
+            "py_intern_string",
+            "py_check_type",
+            "py_get_safe_type_id",
+            "py_object_to_bool",
+            "py_object_add",
+            "py_object_subtract",
+            "py_object_multiply",
+            "py_object_divide",
+            "py_object_modulo",
+            "py_object_power",
+            "py_object_negate",
+            "py_object_compare",
+            "py_object_index",
+            "py_list_box_item",
+    };
+    return callees;
+}
+
+// 返回永生对象的运行时函数 (PY_OBJECT_FLAG_IMMORTAL，对象的引用计数被运行时忽略)
+const llvm::StringSet<>& immortalProducers()
+{
+    static const llvm::StringSet<> producers = {
+            "py_get_none",
+            "py_create_bool",
+            "py_const_int",
+            "py_const_double",
+            "py_const_string",
+            "py_intern_string",
+    };
+    return producers;
+}
+
+// py_create_int 的参数是小整数缓存范围内的常量时，结果也是永生的共享对象
+bool isSmallIntConstant(const llvm::CallInst* call)
+{
+    const llvm::Function* callee = call->getCalledFunction();
+    if (!callee || callee->getName() != "py_create_int" || call->arg_size() != 1) return false;
+    const auto* value = llvm::dyn_cast<llvm::ConstantInt>(call->getArgOperand(0));
+    if (!value) return false;
+    int64_t v = value->getSExtValue();
+    return v >= _PY_SMALL_INT_MIN && v <= _PY_SMALL_INT_MAX;
+}
+
+llvm::StringRef calleeName(const llvm::CallInst* call)
+{
+    const llvm::Function* callee = call->getCalledFunction();
+    return callee ? callee->getName() : llvm::StringRef();
+}
+
+RefCountOp classify(const llvm::Instruction& inst, llvm::Value*& operand)
+{
+    const auto* call = llvm::dyn_cast<llvm::CallInst>(&inst);
+    if (!call || call->arg_size() != 1) return RefCountOp::None;
+
+    llvm::StringRef name = calleeName(call);
+    operand = call->getArgOperand(0);
+    if (name == "py_incref") return RefCountOp::Incref;
+    if (name == "py_decref") return RefCountOp::Decref;
+    return RefCountOp::None;
+}
+
+// 调用是否可能释放对象 (或观察引用计数)，即 incref ... decref 之间的屏障
+bool mayReleaseObjects(const llvm::CallInst* call)
+{
+    if (llvm::isa<llvm::IntrinsicInst>(call)) return false;
+    llvm::StringRef name = calleeName(call);
+    if (name.empty()) return true;
+    if (name.startswith("py_print_")) return false;
+    return !refCountNeutralCallees().contains(name);
+}
+
+// 变量槽位: 只被直接 load / store 的 alloca (地址没有传给任何调用)，其内容可以在直线代码中追踪
+bool isTrackableSlot(const llvm::AllocaInst* slot)
+{
+    for (const llvm::User* user : slot->users())
+    {
+        if (const auto* store = llvm::dyn_cast<llvm::StoreInst>(user))
+        {
+            if (store->getValueOperand() == slot) return false;
+            continue;
+        }
+        if (!llvm::isa<llvm::LoadInst>(user)) return false;
+    }
+    return true;
+}
+
+class RegionScanner
+{
+public:
+    explicit RegionScanner(llvm::SmallVectorImpl<llvm::Instruction*>& dead) : dead(dead) {}
+
+    void scan(llvm::BasicBlock& block)
+    {
+        for (llvm::Instruction& inst : block)
+        {
+            visit(inst);
+        }
+    }
+
+private:
+    llvm::SmallVectorImpl<llvm::Instruction*>& dead;
+    llvm::DenseMap<llvm::AllocaInst*, bool> trackable;
+    llvm::DenseMap<llvm::AllocaInst*, llvm::Value*> slotValue;  // 槽位中最近一次 store 的值
+    llvm::DenseMap<llvm::Value*, llvm::Value*> forwarded;       // load -> 读到的值
+    // 尚未配对的 incref (之后没有屏障) 与可继续下沉的 decref，按对象分组
+    llvm::DenseMap<llvm::Value*, llvm::SmallVector<llvm::CallInst*, 2>> openIncref;
+    llvm::DenseMap<llvm::Value*, llvm::SmallVector<llvm::CallInst*, 2>> sinkingDecref;
+
+    bool isTrackable(llvm::AllocaInst* slot)
+    {
+        auto it = trackable.find(slot);
+        if (it != trackable.end()) return it->second;
+        bool result = isTrackableSlot(slot);
+        trackable[slot] = result;
+        return result;
+    }
+
+    // 追溯对象的来源值: 去掉指针转换、单入边 PHI，以及可追踪槽位的 load
+    llvm::Value* resolve(llvm::Value* value)
+    {
+        for (;;)
+        {
+            value = value->stripPointerCasts();
+            if (auto* phi = llvm::dyn_cast<llvm::PHINode>(value))
+            {
+                if (phi->getNumIncomingValues() != 1) return value;
+                value = phi->getIncomingValue(0);
+                continue;
+            }
+            auto it = forwarded.find(value);
+            if (it == forwarded.end()) return value;
+            value = it->second;
+        }
+    }
+
+    static bool isImmortal(llvm::Value* value)
+    {
+        if (llvm::isa<llvm::ConstantPointerNull>(value)) return true;
+        auto* call = llvm::dyn_cast<llvm::CallInst>(value);
+        return call && (immortalProducers().contains(calleeName(call)) || isSmallIntConstant(call));
+    }
+
+    static bool takeLast(llvm::DenseMap<llvm::Value*, llvm::SmallVector<llvm::CallInst*, 2>>& pending,
+                         llvm::Value* object, llvm::CallInst*& out)
+    {
+        auto it = pending.find(object);
+        if (it == pending.end() || it->second.empty()) return false;
+        out = it->second.pop_back_val();
+        return true;
+    }
+
+    void visit(llvm::Instruction& inst)
+    {
+        if (auto* store = llvm::dyn_cast<llvm::StoreInst>(&inst))
+        {
+            if (auto* slot = llvm::dyn_cast<llvm::AllocaInst>(store->getPointerOperand()))
+            {
+                if (isTrackable(slot)) slotValue[slot] = resolve(store->getValueOperand());
+            }
+            return;
+        }
+        if (auto* load = llvm::dyn_cast<llvm::LoadInst>(&inst))
+        {
+            auto* slot = llvm::dyn_cast<llvm::AllocaInst>(load->getPointerOperand());
+            if (slot && isTrackable(slot))
+            {
+                auto it = slotValue.find(slot);
+                if (it == slotValue.end())
+                    slotValue[slot] = load;  // 区域内第一次读取: 之后的 load 都读到同一个值
+                else if (it->second->getType() == load->getType())
+                    forwarded[load] = it->second;
+            }
+            return;
+        }
+
+        auto* call = llvm::dyn_cast<llvm::CallInst>(&inst);
+        if (!call) return;
+
+        llvm::Value* operand = nullptr;
+        RefCountOp op = classify(inst, operand);
+        if (op == RefCountOp::None)
+        {
+            if (mayReleaseObjects(call)) openIncref.clear();
+            return;
+        }
+
+        llvm::Value* object = resolve(operand);
+        if (isImmortal(object))
+        {
+            dead.push_back(call);
+            return;
+        }
+
+        llvm::CallInst* partner = nullptr;
+        if (op == RefCountOp::Incref)
+        {
+            // 之前的 decref 下沉到这里与本次 incref 抵消
+            if (takeLast(sinkingDecref, object, partner))
+            {
+                dead.push_back(partner);
+                dead.push_back(call);
+                return;
+            }
+            openIncref[object].push_back(call);
+            return;
+        }
+
+        if (takeLast(openIncref, object, partner))
+        {
+            dead.push_back(partner);
+            dead.push_back(call);
+            return;
+        }
+        // 其他对象的 decref 可能释放持有未配对对象的容器，之前的 incref 不能再越过它
+        openIncref.clear();
+        sinkingDecref[object].push_back(call);
+    }
+};
+
+// 直线区域的下一个块: 唯一后继且该后继只有这一个前驱
+llvm::BasicBlock* straightLineSuccessor(llvm::BasicBlock* block)
+{
+    llvm::BasicBlock* next = block->getUniqueSuccessor();
+    if (!next || next == block || next->getSinglePredecessor() != block) return nullptr;
+    return next;
+}
+
+}  // namespace
+
+char RefCountElisionPass::ID = 0;
+
+RefCountElisionPass::RefCountElisionPass()
+    : llvm::FunctionPass(ID)
+{
+}
+
+llvm::StringRef RefCountElisionPass::getPassName() const
+{
+    return "llvmpy reference count elision";
+}
+
+void RefCountElisionPass::getAnalysisUsage(llvm::AnalysisUsage& AU) const
+{
+    AU.setPreservesCFG();
+}
+
+bool RefCountElisionPass::runOnFunction(llvm::Function& F)
+{
+    llvm::SmallVector<llvm::Instruction*, 32> dead;
+    llvm::DenseSet<llvm::BasicBlock*> visited;
+
+    for (llvm::BasicBlock& head : F)
+    {
+        // 区域从不能并入前驱的块开始
+        llvm::BasicBlock* pred = head.getSinglePredecessor();
+        if (pred && straightLineSuccessor(pred) == &head && pred != &head) continue;
+
+        RegionScanner scanner(dead);
+        for (llvm::BasicBlock* block = &head; block && visited.insert(block).second;
+             block = straightLineSuccessor(block))
+        {
+            scanner.scan(*block);
+        }
+    }
+
+    for (llvm::Instruction* inst : dead)
+    {
+        inst->eraseFromParent();
+    }
+    return !dead.empty();
+}
+
+llvm::FunctionPass* createRefCountElisionPass()
+{
+    return new RefCountElisionPass();
+}
+
+}  // namespace llvmpy
@@ -0,0 +1,404 @@
+#include "CodeGen/StackPromotion.h"
+
+#include "RunTime/runtime.h"
+
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/SCCIterator.h>
+#include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/StringSet.h>
+#include <llvm/Analysis/PostDominators.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+namespace llvmpy
+{
+
+namespace
+{
+
+// 返回新对象且有 *_into 版本的运行时函数
+struct PromotableProducer
+{
+    const char* callee;
+    const char* intoCallee;
+    bool storageFirst;  // py_init_*_into 的 storage 是第一个参数，运算符版本是最后一个
+    bool needsRelease;  // bool 结果没有 GMP 数据，也不会回退到堆上，不必释放
+};
+
+const PromotableProducer kProducers[] = {
+        {"py_object_compare", "py_object_compare_into", false, false},
+        {"py_object_add", "py_object_add_into", false, true},
+        {"py_object_subtract", "py_object_subtract_into", false, true},
+        {"py_object_multiply", "py_object_multiply_into", false, true},
+        {"py_create_int", "py_init_int_into", true, true},
+        {"py_create_int_bystring", "py_init_int_bystring_into", true, true},
+};
+
+const PromotableProducer* findProducer(const llvm::CallInst* call)
+{
+    const llvm::Function* callee = call->getCalledFunction();
+    if (!callee) return nullptr;
+    for (const PromotableProducer& producer : kProducers)
+    {
+        if (callee->getName() == producer.callee) return &producer;
+    }
+    return nullptr;
+}
+
+// 只读取参数、不保留参数也不把参数作为结果返回的运行时函数
+// (py_object_power 在指数为 1 时返回底数本身，因此不在其中)
+const llvm::StringSet<>& nonCapturingCallees()
+{
+    static const llvm::StringSet<> callees = {
+            "py_object_to_bool",
+            "py_print_object",
+            "py_check_type",
+            "py_get_safe_type_id",
+            "py_object_compare",
+            "py_object_compare_into",
+            "py_object_add",
+            "py_object_add_into",
+            "py_object_subtract",
+            "py_object_subtract_into",
+            "py_object_multiply",
+            "py_object_multiply_into",
+            "py_object_divide",
+            "py_object_modulo",
+            "py_object_negate",
+            "py_object_not",
+    };
+    return callees;
+}
+
+bool isNonCapturingUse(const llvm::CallInst* call, const llvm::Use& use)
+{
+    const llvm::Function* callee = call->getCalledFunction();
+    if (!callee || !call->isArgOperand(&use)) return false;
+
+    llvm::StringRef name = callee->getName();
+    if (name.startswith("py_print_") || nonCapturingCallees().contains(name)) return true;
+    // 索引值只用于查找，容器本身可能被结果 (切片视图等) 引用
+    return name == "py_object_index" && call->getArgOperandNo(&use) == 1;
+}
+
+// 结果的所有使用者都在同一基本块内，且都不会保留它
+bool usesAreLocal(const llvm::CallInst* call)
+{
+    if (call->use_empty()) return false;
+    for (const llvm::Use& use : call->uses())
+    {
+        const auto* user = llvm::dyn_cast<llvm::CallInst>(use.getUser());
+        if (!user || user->getParent() != call->getParent() || !isNonCapturingUse(user, use)) return false;
+    }
+    return true;
+}
+
+// 同一基本块内最后一个使用 value 的指令
+llvm::Instruction* lastLocalUser(llvm::Instruction* value)
+{
+    llvm::Instruction* last = nullptr;
+    for (llvm::Instruction* inst = value->getNextNode(); inst; inst = inst->getNextNode())
+    {
+        if (llvm::is_contained(inst->operands(), value)) last = inst;
+    }
+    return last;
+}
+
+// 把生产者调用替换为在 storage 上初始化的 *_into 调用
+llvm::CallInst* rewriteIntoCall(llvm::CallInst* call, const PromotableProducer& producer, llvm::Value* storage)
+{
+    llvm::SmallVector<llvm::Value*, 4> args(call->arg_begin(), call->arg_end());
+    args.insert(producer.storageFirst ? args.begin() : args.end(), storage);
+    llvm::SmallVector<llvm::Type*, 4> paramTypes;
+    for (llvm::Value* arg : args) paramTypes.push_back(arg->getType());
+    llvm::FunctionCallee intoFunc = call->getModule()->getOrInsertFunction(
+            producer.intoCallee, llvm::FunctionType::get(call->getType(), paramTypes, false));
+
+    llvm::IRBuilder<> builder(call);
+    llvm::CallInst* promoted = builder.CreateCall(intoFunc, args);
+    promoted->copyMetadata(*call);
+    promoted->takeName(call);
+    call->replaceAllUsesWith(promoted);
+    call->eraseFromParent();
+    return promoted;
+}
+
+//===----------------------------------------------------------------------===//
+// 区域分配的逃逸分析
+//===----------------------------------------------------------------------===//
+
+// 变量槽位: 只被直接 load / store 的 alloca
+bool isLocalSlot(const llvm::Value* pointer)
+{
+    const auto* slot = llvm::dyn_cast<llvm::AllocaInst>(pointer);
+    if (!slot) return false;
+    for (const llvm::User* user : slot->users())
+    {
+        if (const auto* store = llvm::dyn_cast<llvm::StoreInst>(user))
+        {
+            if (store->getValueOperand() == slot) return false;
+            continue;
+        }
+        if (!llvm::isa<llvm::LoadInst>(user)) return false;
+    }
+    return true;
+}
+
+// 从一个对象出发，经由变量槽位、PHI、select 能到达的所有值及其逃逸点
+struct EscapeClosure
+{
+    bool supported = true;  // 出现无法分析的使用 (如作为指针解引用) 时为 false
+    llvm::SmallPtrSet<llvm::Value*, 16> values;
+    llvm::SmallVector<llvm::Use*, 8> escapes;
+
+    void collect(llvm::Value* root)
+    {
+        llvm::SmallVector<llvm::Value*, 16> worklist;
+        if (values.insert(root).second) worklist.push_back(root);
+        while (!worklist.empty())
+        {
+            llvm::Value* value = worklist.pop_back_val();
+            for (llvm::Use& use : value->uses())
+            {
+                visitUse(use, worklist);
+            }
+        }
+    }
+
+private:
+    void reach(llvm::Value* value, llvm::SmallVectorImpl<llvm::Value*>& worklist)
+    {
+        if (values.insert(value).second) worklist.push_back(value);
+    }
+
+    void visitUse(llvm::Use& use, llvm::SmallVectorImpl<llvm::Value*>& worklist)
+    {
+        llvm::User* user = use.getUser();
+        if (auto* call = llvm::dyn_cast<llvm::CallInst>(user))
+        {
+            const llvm::Function* callee = call->getCalledFunction();
+            llvm::StringRef name = callee ? callee->getName() : llvm::StringRef();
+            // 区域对象的引用计数为 INT_MAX，incref / decref 不影响它们
+            if (name == "py_incref" || name == "py_decref" || isNonCapturingUse(call, use)) return;
+            escapes.push_back(&use);
+            return;
+        }
+        if (auto* store = llvm::dyn_cast<llvm::StoreInst>(user))
+        {
+            if (use.getOperandNo() != 0)
+            {
+                supported = false;
+                return;
+            }
+            if (!isLocalSlot(store->getPointerOperand()))
+            {
+                escapes.push_back(&use);
+                return;
+            }
+            // 槽位中的值可能被任意一次 load 读到
+            for (llvm::User* slotUser : store->getPointerOperand()->users())
+            {
+                if (auto* load = llvm::dyn_cast<llvm::LoadInst>(slotUser)) reach(load, worklist);
+            }
+            return;
+        }
+        if (llvm::isa<llvm::ReturnInst>(user))
+        {
+            escapes.push_back(&use);
+            return;
+        }
+        if (llvm::isa<llvm::PHINode>(user) || llvm::isa<llvm::SelectInst>(user))
+        {
+            reach(user, worklist);
+            return;
+        }
+        if (llvm::isa<llvm::ICmpInst>(user)) return;
+        supported = false;
+    }
+};
+
+// 位于某个环 (循环) 中的基本块: 区域在函数返回时才整体释放，循环中的分配会不断累积
+llvm::DenseSet<const llvm::BasicBlock*> blocksInCycles(llvm::Function& F)
+{
+    llvm::DenseSet<const llvm::BasicBlock*> result;
+    for (auto scc = llvm::scc_begin(&F); !scc.isAtEnd(); ++scc)
+    {
+        if (!scc.hasCycle()) continue;
+        for (const llvm::BasicBlock* block : *scc)
+        {
+            result.insert(block);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+char TempStackPromotionPass::ID = 0;
+
+TempStackPromotionPass::TempStackPromotionPass()
+    : llvm::FunctionPass(ID)
+{
+}
+
+llvm::StringRef TempStackPromotionPass::getPassName() const
+{
+    return "llvmpy stack promotion of non-escaping temporaries";
+}
+
+void TempStackPromotionPass::getAnalysisUsage(llvm::AnalysisUsage& AU) const
+{
+    AU.setPreservesCFG();
+}
+
+bool TempStackPromotionPass::runOnFunction(llvm::Function& F)
+{
+    llvm::SmallVector<std::pair<llvm::CallInst*, const PromotableProducer*>, 16> candidates;
+    for (llvm::BasicBlock& block : F)
+    {
+        for (llvm::Instruction& inst : block)
+        {
+            auto* call = llvm::dyn_cast<llvm::CallInst>(&inst);
+            const PromotableProducer* producer = call ? findProducer(call) : nullptr;
+            if (producer && usesAreLocal(call))
+            {
+                candidates.push_back({call, producer});
+            }
+        }
+    }
+    if (candidates.empty()) return false;
+
+    llvm::Module* module = F.getParent();
+    llvm::LLVMContext& context = F.getContext();
+    llvm::Type* ptrType = candidates.front().first->getType();
+    llvm::Type* storageType = llvm::ArrayType::get(llvm::Type::getInt64Ty(context),
+                                                   (sizeof(PyPrimitiveObject) + 7) / 8);
+    llvm::FunctionCallee releaseFunc = module->getOrInsertFunction(
+            "py_release_into", llvm::Type::getVoidTy(context), ptrType, ptrType);
+
+    llvm::BasicBlock& entry = F.getEntryBlock();
+    llvm::IRBuilder<> entryBuilder(&entry, entry.getFirstInsertionPt());
+
+    // 先全部替换为 *_into 调用 (临时对象可能是另一个被替换调用的操作数)，再插入释放
+    llvm::SmallVector<std::pair<llvm::CallInst*, llvm::AllocaInst*>, 16> toRelease;
+    for (const auto& [call, producer] : candidates)
+    {
+        llvm::AllocaInst* storage = entryBuilder.CreateAlloca(storageType, nullptr, "tmp.storage");
+        llvm::CallInst* promoted = rewriteIntoCall(call, *producer, storage);
+        if (producer->needsRelease) toRelease.push_back({promoted, storage});
+    }
+
+    for (const auto& [promoted, storage] : toRelease)
+    {
+        llvm::IRBuilder<> builder(lastLocalUser(promoted)->getNextNode());
+        builder.CreateCall(releaseFunc, {promoted, storage});
+    }
+    return true;
+}
+
+llvm::FunctionPass* createTempStackPromotionPass()
+{
+    return new TempStackPromotionPass();
+}
+
+char RegionAllocationPass::ID = 0;
+
+RegionAllocationPass::RegionAllocationPass()
+    : llvm::FunctionPass(ID)
+{
+}
+
+llvm::StringRef RegionAllocationPass::getPassName() const
+{
+    return "llvmpy function-scoped region allocation";
+}
+
+void RegionAllocationPass::getAnalysisUsage(llvm::AnalysisUsage& AU) const
+{
+    AU.setPreservesCFG();
+}
+
+bool RegionAllocationPass::runOnFunction(llvm::Function& F)
+{
+    llvm::DenseSet<const llvm::BasicBlock*> inCycle = blocksInCycles(F);
+    llvm::PostDominatorTree postDom(F);
+
+    llvm::SmallVector<std::pair<llvm::CallInst*, const PromotableProducer*>, 16> candidates;
+    for (llvm::BasicBlock& block : F)
+    {
+        if (inCycle.contains(&block)) continue;
+        for (llvm::Instruction& inst : block)
+        {
+            auto* call = llvm::dyn_cast<llvm::CallInst>(&inst);
+            const PromotableProducer* producer = call ? findProducer(call) : nullptr;
+            if (!producer || call->use_empty()) continue;
+
+            EscapeClosure closure;
+            closure.collect(call);
+            if (!closure.supported) continue;
+            // 必然逃逸的对象提升反而多一次复制，直接留在堆上
+            bool alwaysEscapes = llvm::any_of(closure.escapes, [&](const llvm::Use* use) {
+                auto* user = llvm::cast<llvm::Instruction>(use->getUser());
+                return postDom.dominates(user->getParent(), &block);
+            });
+            // 循环中的逃逸点每次迭代都复制出一个新的堆对象，旧副本没有人释放，同样留在堆上
+            bool escapesInLoop = llvm::any_of(closure.escapes, [&](const llvm::Use* use) {
+                return inCycle.contains(llvm::cast<llvm::Instruction>(use->getUser())->getParent());
+            });
+            if (!alwaysEscapes && !escapesInLoop) candidates.push_back({call, producer});
+        }
+    }
+    if (candidates.empty()) return false;
+
+    llvm::Module* module = F.getParent();
+    llvm::LLVMContext& context = F.getContext();
+    llvm::Type* ptrType = candidates.front().first->getType();
+    llvm::Type* voidType = llvm::Type::getVoidTy(context);
+    llvm::FunctionCallee pushFunc = module->getOrInsertFunction("py_region_push", voidType);
+    llvm::FunctionCallee popFunc = module->getOrInsertFunction("py_region_pop", voidType);
+    llvm::FunctionCallee allocFunc = module->getOrInsertFunction("py_region_alloc_object", ptrType);
+    llvm::FunctionCallee promoteFunc = module->getOrInsertFunction("py_region_promote", ptrType, ptrType);
+
+    // 入口处 (alloca 之后) 打开本次调用的区域
+    llvm::BasicBlock& entry = F.getEntryBlock();
+    llvm::BasicBlock::iterator pushPoint = entry.getFirstInsertionPt();
+    while (llvm::isa<llvm::AllocaInst>(*pushPoint)) ++pushPoint;
+    llvm::IRBuilder<>(&entry, pushPoint).CreateCall(pushFunc);
+
+    EscapeClosure closure;
+    for (const auto& [call, producer] : candidates)
+    {
+        llvm::IRBuilder<> builder(call);
+        llvm::CallInst* storage = builder.CreateCall(allocFunc, {}, "region.storage");
+        closure.collect(rewriteIntoCall(call, *producer, storage));
+    }
+
+    // 可能到达逃逸点的值 (也可能是堆对象，由 py_region_promote 在运行时区分) 先提升到堆上
+    llvm::SmallPtrSet<llvm::Use*, 16> promotedUses;
+    for (llvm::Use* use : closure.escapes)
+    {
+        if (!promotedUses.insert(use).second) continue;
+        llvm::IRBuilder<> builder(llvm::cast<llvm::Instruction>(use->getUser()));
+        use->set(builder.CreateCall(promoteFunc, {use->get()}, "region.promoted"));
+    }
+
+    for (llvm::BasicBlock& block : F)
+    {
+        if (auto* ret = llvm::dyn_cast<llvm::ReturnInst>(block.getTerminator()))
+        {
+            llvm::IRBuilder<>(ret).CreateCall(popFunc);
+        }
+    }
+    return true;
+}
+
+llvm::FunctionPass* createRegionAllocationPass()
+{
+    return new RegionAllocationPass();
+}
+
+}  // namespace llvmpy
@@ -261,6 +261,9 @@ ObjectLifecycleManager::ObjectSource ObjectLifecycleManager::determineExprSource
         case ASTKind::BoolExpr:
         case ASTKind::NoneExpr:
         case ASTKind::ListExpr:
+        case ASTKind::TupleExpr:
+        case ASTKind::SetExpr:
+        case ASTKind::ListCompExpr:
             return ObjectLifecycleManager::ObjectSource::LITERAL;
 
         case ASTKind::BinaryExpr:
@@ -270,6 +273,7 @@ ObjectLifecycleManager::ObjectSource ObjectLifecycleManager::determineExprSource
             return ObjectLifecycleManager::ObjectSource::UNARY_OP;
 
         case ASTKind::CallExpr:
+        case ASTKind::SliceExpr:
             return ObjectLifecycleManager::ObjectSource::FUNCTION_RETURN;
 
         case ASTKind::VariableExpr:
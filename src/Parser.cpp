@@ -156,12 +156,19 @@ void PyParser::initializeRegistries()
             p.nextToken(); // Consume '='
     
             // Parse the Right-Hand Side (RHS)
+            int rhsLine = p.getCurrentToken().line;
+            int rhsCol = p.getCurrentToken().column;
             auto rhsExpr = p.parseExpression();
             if (!rhsExpr) {
                 // Error should have been logged by parseExpression
                 // Return specific error message for context
                 return p.logParseError<StmtAST>("Expected expression after '=' in assignment");
             }
+            // x = a, b  =>  RHS is a tuple
+            if (p.getCurrentToken().type == TOK_COMMA) {
+                rhsExpr = p.parseTupleTail(std::move(rhsExpr), rhsLine, rhsCol);
+                if (!rhsExpr) return nullptr;
+            }
     
             // Validate LHS is assignable and create appropriate AST node
             // Check the runtime type of lhsExpr
@@ -204,6 +211,51 @@ void PyParser::initializeRegistries()
                 }
             }
         }
+        // Case A2: Unpacking Assignment (x, y = RHS)
+        else if (currentType == TOK_COMMA) {
+            std::vector<std::string> targets;
+            auto* firstVar = dynamic_cast<VariableExprAST*>(lhsExpr.get());
+            if (!firstVar) {
+                return p.logParseError<StmtAST>("Unpacking assignment targets must be variable names");
+            }
+            targets.push_back(firstVar->getName());
+
+            while (p.getCurrentToken().type == TOK_COMMA) {
+                p.nextToken(); // Consume ','
+                if (p.getCurrentToken().type == TOK_ASSIGN) break; // Trailing comma: x, = t
+                auto target = p.parseExpression();
+                if (!target) return nullptr;
+                auto* var = dynamic_cast<VariableExprAST*>(target.get());
+                if (!var) {
+                    return p.logParseError<StmtAST>("Unpacking assignment targets must be variable names");
+                }
+                targets.push_back(var->getName());
+            }
+
+            if (p.getCurrentToken().type != TOK_ASSIGN) {
+                return p.logParseError<StmtAST>("Expected '=' after unpacking targets");
+            }
+            p.nextToken(); // Consume '='
+
+            int rhsLine = p.getCurrentToken().line;
+            int rhsCol = p.getCurrentToken().column;
+            auto rhsExpr = p.parseExpression();
+            if (!rhsExpr) {
+                return p.logParseError<StmtAST>("Expected expression after '=' in unpacking assignment");
+            }
+            // a, b = b, a  =>  RHS is a tuple
+            if (p.getCurrentToken().type == TOK_COMMA) {
+                rhsExpr = p.parseTupleTail(std::move(rhsExpr), rhsLine, rhsCol);
+                if (!rhsExpr) return nullptr;
+            }
+
+            auto unpackStmt = std::make_unique<UnpackAssignStmtAST>(std::move(targets), std::move(rhsExpr));
+            unpackStmt->setLocation(lhsLine, lhsCol);
+            if (!p.expectStatementEnd("unpacking assignment")) {
+                return nullptr;
+            }
+            return unpackStmt;
+        }
         // Case B: Compound Assignment (LHS op= RHS)
         else if (currentType == TOK_PLUS_ASSIGN || currentType == TOK_MINUS_ASSIGN ||
                  currentType == TOK_MUL_ASSIGN || currentType == TOK_DIV_ASSIGN ||
@@ -581,10 +633,27 @@ std::unique_ptr<ExprAST> PyParser::parseParenExpr()
 
     nextToken();  // 消费'('
 
+    // 空元组 ()
+    if (currentToken.type == TOK_RPAREN)
+    {
+        nextToken();  // 消费')'
+        auto tupleExpr = makeExpr<TupleExprAST>(std::vector<std::unique_ptr<ExprAST>>());
+        tupleExpr->setLocation(line, column);
+        return tupleExpr;
+    }
+
     auto expr = parseExpression();
     if (!expr)
         return nullptr;
 
+    // (a,) 或 (a, b, ...) 是元组，(a) 只是加括号的表达式
+    if (currentToken.type == TOK_COMMA)
+    {
+        expr = parseTupleTail(std::move(expr), line, column);
+        if (!expr)
+            return nullptr;
+    }
+
     if (!expectToken(TOK_RPAREN, "Expected ')'"))
         return nullptr;
 
@@ -592,17 +661,106 @@ std::unique_ptr<ExprAST> PyParser::parseParenExpr()
     return expr;
 }
 
+// 解析元组的剩余元素: 当前 token 为第一个元素之后的 ','。
+// 遇到 ')'、'='、换行等不能开始表达式的 token 时结束 (允许尾随逗号)。
+std::unique_ptr<ExprAST> PyParser::parseTupleTail(std::unique_ptr<ExprAST> first, int line, int column)
+{
+    std::vector<std::unique_ptr<ExprAST>> elements;
+    elements.push_back(std::move(first));
+
+    while (currentToken.type == TOK_COMMA)
+    {
+        nextToken();  // 消费','
+
+        PyTokenType type = currentToken.type;
+        if (type == TOK_RPAREN || type == TOK_ASSIGN || type == TOK_NEWLINE ||
+            type == TOK_EOF || type == TOK_DEDENT)
+            break;
+
+        auto element = parseExpression();
+        if (!element)
+            return nullptr;
+        elements.push_back(std::move(element));
+    }
+
+    auto tupleExpr = makeExpr<TupleExprAST>(std::move(elements));
+    tupleExpr->setLocation(line, column);
+    return tupleExpr;
+}
+
+// 解析集合字面量的剩余部分: 已消费 '{' 和第一个元素，当前 token 为 ',' 或 '}'
+std::unique_ptr<ExprAST> PyParser::parseSetTail(std::unique_ptr<ExprAST> first, int line, int column)
+{
+    std::vector<std::unique_ptr<ExprAST>> elements;
+    elements.push_back(std::move(first));
+
+    while (currentToken.type == TOK_COMMA)
+    {
+        nextToken();  // 消费','
+        if (currentToken.type == TOK_RBRACE)
+            break;  // 尾随逗号
+
+        auto element = parseExpression();
+        if (!element)
+            return nullptr;
+        elements.push_back(std::move(element));
+    }
+
+    if (!expectToken(TOK_RBRACE, "Expected ',' or '}' in set literal"))
+    {
+        return nullptr;
+    }
+
+    auto setExpr = makeExpr<SetExprAST>(std::move(elements));
+    setExpr->setLocation(line, column);
+    return setExpr;
+}
+
 std::unique_ptr<ExprAST> PyParser::parseIndexSuffix(std::unique_ptr<ExprAST> target)
 {
     int line = currentToken.line;
     int column = currentToken.column;
     nextToken();  // Consume '['
 
-    auto index = parseExpression();
-    if (!index)
+    // 切片: a[start:stop:step]，三部分都可以省略
+    std::unique_ptr<ExprAST> index;
+    if (currentToken.type != TOK_COLON)
     {
-        // Error already logged by parseExpression
-        return nullptr;
+        index = parseExpression();
+        if (!index)
+        {
+            // Error already logged by parseExpression
+            return nullptr;
+        }
+    }
+
+    if (currentToken.type == TOK_COLON)
+    {
+        std::unique_ptr<ExprAST> stop;
+        std::unique_ptr<ExprAST> step;
+        nextToken();  // Consume ':'
+        if (currentToken.type != TOK_COLON && currentToken.type != TOK_RBRACK)
+        {
+            stop = parseExpression();
+            if (!stop) return nullptr;
+        }
+        if (currentToken.type == TOK_COLON)
+        {
+            nextToken();  // Consume second ':'
+            if (currentToken.type != TOK_RBRACK)
+            {
+                step = parseExpression();
+                if (!step) return nullptr;
+            }
+        }
+        if (!expectToken(TOK_RBRACK, "Expected ']' after slice"))
+        {
+            return nullptr;
+        }
+
+        auto sliceExpr = makeExpr<SliceExprAST>(std::move(target), std::move(index), std::move(stop), std::move(step));
+        sliceExpr->setLocation(line, column);
+        return sliceExpr;
     }
 
     if (!expectToken(TOK_RBRACK, "Expected ']' after index expression"))
@@ -782,6 +940,13 @@ std::unique_ptr<ExprAST> PyParser::parseExpressionPrecedence(int minPrecedence)
         }
         // --- END ADDED ---
 
+        // 'not in' 由两个 token 组成，在此合并为 TOK_NOT_IN
+        if (currentToken.type == TOK_NOT && lexer.peekToken().type == TOK_IN)
+        {
+            nextToken();  // 消费 'not'，当前 token 为 'in'
+            currentToken.type = TOK_NOT_IN;
+        }
+
         // Check for binary operators (existing logic)
         auto it = operatorRegistry.find(currentToken.type);
         if (it == operatorRegistry.end())
@@ -960,6 +1125,12 @@ std::unique_ptr<ExprAST> PyParser::parseDictExpr()
             return nullptr;  // Error already logged by parseExpression
         }
 
+        // 第一个元素后面没有 ':' 时是集合字面量 {a, b}
+        if (pairs.empty() && (currentToken.type == TOK_COMMA || currentToken.type == TOK_RBRACE))
+        {
+            return parseSetTail(std::move(key), line, column);
+        }
+
         // Expect ':'
         if (!expectToken(TOK_COLON, "Expected ':' after dictionary key"))
         {
@@ -1051,6 +1222,10 @@ std::unique_ptr<ExprAST> PyParser::parseListExpr()
         if (!element)
             return nullptr;
 
+        // [element for var in iterable if condition]
+        if (elements.empty() && currentToken.type == TOK_FOR)
+            return parseListCompTail(std::move(element), line, column);
+
         elements.push_back(std::move(element));
 
         if (currentToken.type == TOK_RBRACK)
@@ -1071,6 +1246,42 @@ std::unique_ptr<ExprAST> PyParser::parseListExpr()
     return listExpr;
 }
 
+// 解析列表推导式第一个元素之后的部分: for var in iterable [if condition] ]
+std::unique_ptr<ExprAST> PyParser::parseListCompTail(std::unique_ptr<ExprAST> element, int line, int column)
+{
+    nextToken();  // 消费'for'
+
+    if (currentToken.type != TOK_IDENTIFIER)
+    {
+        return logParseError<ExprAST>("Expected identifier for loop variable in list comprehension");
+    }
+    std::string varName = currentToken.value;
+    nextToken();  // 消费循环变量名
+
+    if (!expectToken(TOK_IN, "Expected 'in' after loop variable in list comprehension"))
+        return nullptr;
+
+    auto iterable = parseExpression();
+    if (!iterable)
+        return nullptr;
+
+    std::unique_ptr<ExprAST> condition;
+    if (currentToken.type == TOK_IF)
+    {
+        nextToken();  // 消费'if'
+        condition = parseExpression();
+        if (!condition)
+            return nullptr;
+    }
+
+    if (!expectToken(TOK_RBRACK, "Expected ']' at end of list comprehension"))
+        return nullptr;
+
+    auto compExpr = makeExpr<ListCompExprAST>(std::move(element), std::move(varName), std::move(iterable), std::move(condition));
+    compExpr->setLocation(line, column);
+    return compExpr;
+}
+
 // 解析索引表达式
 std::unique_ptr<ExprAST> PyParser::parseIndexExpr(std::unique_ptr<ExprAST> target)
 {
@@ -1191,10 +1402,20 @@ std::unique_ptr<StmtAST> PyParser::parseReturnStmt()
         return stmt;
     }
 
+    int valueLine = currentToken.line;
+    int valueColumn = currentToken.column;
     auto value = parseExpression();
     if (!value)
         return nullptr;
 
+    // return a, b 返回一个元组
+    if (currentToken.type == TOK_COMMA)
+    {
+        value = parseTupleTail(std::move(value), valueLine, valueColumn);
+        if (!value)
+            return nullptr;
+    }
+
     // 确保语句后有NEWLINE，并消费它
     if (currentToken.type == TOK_NEWLINE)
         nextToken();  // 消费换行
@@ -1472,9 +1693,21 @@ std::unique_ptr<StmtAST> PyParser::parseForStmt()
     {
         return logParseError<StmtAST>("Expected identifier for loop variable after 'for'");
     }
-    std::string loopVarName = currentToken.value;
+    std::vector<std::string> loopVarNames = {currentToken.value};
     nextToken(); // 消费循环变量名
 
+    // for k, v in ...: 逐项解包到多个循环变量
+    while (currentToken.type == TOK_COMMA)
+    {
+        nextToken(); // 消费 ','
+        if (currentToken.type != TOK_IDENTIFIER)
+        {
+            return logParseError<StmtAST>("Expected identifier after ',' in for loop target");
+        }
+        loopVarNames.push_back(currentToken.value);
+        nextToken();
+    }
+
     // 2. 期望 'in' 关键字
     if (!expectToken(TOK_IN, "Expected 'in' after loop variable in for statement"))
     {
@@ -1527,7 +1760,7 @@ std::unique_ptr<StmtAST> PyParser::parseForStmt()
         elseNode->setLocation(elseLine, elseCol);
     }
 
-    auto forStmt = makeStmt<ForStmtAST>(loopVarName, std::move(iterableExpr), std::move(body), std::move(elseNode));
+    auto forStmt = makeStmt<ForStmtAST>(std::move(loopVarNames), std::move(iterableExpr), std::move(body), std::move(elseNode));
     forStmt->setLocation(line, col);
     return forStmt;
 }
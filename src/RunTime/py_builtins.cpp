@@ -0,0 +1,632 @@
+#include "RunTime/runtime.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+//===----------------------------------------------------------------------===//
+// 辅助函数
+//===----------------------------------------------------------------------===//
+
+// 非装箱存储的列表 (其余情况返回 NULL，走通用迭代路径)
+static PyListObject* py_builtin_unboxed_list(PyObject* obj)
+{
+    if (!obj || llvmpy::getBaseTypeId(obj->typeId) != llvmpy::PY_TYPE_LIST) return NULL;
+    PyListObject* list = (PyListObject*)obj;
+    return list->storage != PY_LIST_STORAGE_BOXED ? list : NULL;
+}
+
+// 位图中前 n 位里置位的个数
+static long py_bitset_count(const uint64_t* bits, int n)
+{
+    long count = 0;
+    int words = n / 64;
+    for (int w = 0; w < words; w++) count += __builtin_popcountll(bits[w]);
+    if (n % 64) count += __builtin_popcountll(bits[words] & (((uint64_t)1 << (n % 64)) - 1));
+    return count;
+}
+
+// 由 128 位整数创建 int 对象
+// (小整数是共享的永生对象，不能在 py_create_int 的结果上原地修改)
+static PyObject* py_create_int_from_i128(__int128 value)
+{
+    if (value >= INT64_MIN && value <= INT64_MAX) return py_create_int((long long)value);
+
+    mpz_t z;
+    mpz_init(z);
+    bool negative = value < 0;
+    unsigned __int128 magnitude = negative ? -(unsigned __int128)value : (unsigned __int128)value;
+    mpz_set_ui(z, (unsigned long)(magnitude >> 64));
+    mpz_mul_2exp(z, z, 64);
+    mpz_add_ui(z, z, (unsigned long)(uint64_t)magnitude);
+    if (negative) mpz_neg(z, z);
+    PyObject* result = py_create_int_from_mpz(z);
+    mpz_clear(z);
+    return result;
+}
+
+// 对可迭代对象做通用遍历，对每个元素调用 visit (返回 false 时提前结束)。
+// 返回 false 表示对象不可迭代。
+template <typename Visitor>
+static bool py_builtin_for_each(PyObject* iterable, Visitor visit)
+{
+    PyObject* iter = py_iter(iterable);
+    if (!iter) return false;
+
+    PyObject* item;
+    while ((item = py_next(iter)) != NULL)
+    {
+        bool keepGoing = visit(item);
+        py_decref(item);
+        if (!keepGoing) break;
+    }
+    py_decref(iter);
+    return true;
+}
+
+//===----------------------------------------------------------------------===//
+// sum
+//===----------------------------------------------------------------------===//
+
+PyObject* py_builtin_sum(PyObject* iterable)
+{
+    if (PyListObject* list = py_builtin_unboxed_list(iterable))
+    {
+        switch (list->storage)
+        {
+            case PY_LIST_STORAGE_INT64:
+                return py_create_int_from_i128(py_simd_sum_i64(list->ints, list->length));
+
+            case PY_LIST_STORAGE_BOOL:
+                return py_create_int(py_bitset_count(list->bits, list->length));
+
+            case PY_LIST_STORAGE_DOUBLE:
+            {
+                // 与装箱加法一致，在 GMP 精度下按顺序累加 (重排的向量求和会改变舍入结果)
+                if (list->length == 0) return py_create_int(0);
+                PyObject* result = py_create_double(0.0);
+                if (!result) return NULL;
+                mpf_ptr acc = ((PyPrimitiveObject*)result)->value.doubleValue;
+                mpf_t term;
+                mpf_init2(term, RUNTIME_FLOATE_PRECISION);
+                for (int i = 0; i < list->length; i++)
+                {
+                    mpf_set_d(term, list->doubles[i]);
+                    mpf_add(acc, acc, term);
+                }
+                mpf_clear(term);
+                return result;
+            }
+        }
+    }
+
+    // 通用路径: 从 int 0 开始逐个 py_object_add
+    PyObject* acc = py_create_int(0);
+    bool failed = false;
+    bool iterable_ok = py_builtin_for_each(iterable, [&](PyObject* item)
+    {
+        PyObject* next = py_object_add(acc, item);
+        py_decref(acc);
+        acc = next;
+        failed = (next == NULL);
+        return !failed;
+    });
+
+    if (!iterable_ok || failed)
+    {
+        if (acc) py_decref(acc);
+        return NULL;
+    }
+    return acc;
+}
+
+//===----------------------------------------------------------------------===//
+// min / max
+//===----------------------------------------------------------------------===//
+
+static PyObject* py_builtin_minmax(PyObject* iterable, bool isMax)
+{
+    const char* name = isMax ? "max" : "min";
+
+    if (PyListObject* list = py_builtin_unboxed_list(iterable))
+    {
+        if (list->length == 0)
+        {
+            fprintf(stderr, "ValueError: %s() arg is an empty sequence\n", name);
+            return NULL;
+        }
+        switch (list->storage)
+        {
+            case PY_LIST_STORAGE_INT64:
+                return py_create_int(isMax ? py_simd_max_i64(list->ints, list->length)
+                                           : py_simd_min_i64(list->ints, list->length));
+
+            case PY_LIST_STORAGE_DOUBLE:
+                return py_create_double(isMax ? py_simd_max_f64(list->doubles, list->length)
+                                              : py_simd_min_f64(list->doubles, list->length));
+
+            case PY_LIST_STORAGE_BOOL:
+            {
+                long ones = py_bitset_count(list->bits, list->length);
+                return py_create_bool(isMax ? ones > 0 : ones == list->length);
+            }
+        }
+    }
+
+    // 通用路径: 保留第一个最小 (最大) 的元素
+    PyObject* best = NULL;
+    bool failed = false;
+    bool iterable_ok = py_builtin_for_each(iterable, [&](PyObject* item)
+    {
+        if (!best)
+        {
+            py_incref(item);
+            best = item;
+            return true;
+        }
+        PyObject* cmp = py_object_compare(item, best, isMax ? PY_CMP_GT : PY_CMP_LT);
+        if (!cmp)
+        {
+            failed = true;
+            return false;
+        }
+        if (py_object_to_bool(cmp))
+        {
+            py_incref(item);
+            py_decref(best);
+            best = item;
+        }
+        py_decref(cmp);
+        return true;
+    });
+
+    if (!iterable_ok || failed)
+    {
+        if (best) py_decref(best);
+        return NULL;
+    }
+    if (!best)
+    {
+        fprintf(stderr, "ValueError: %s() arg is an empty sequence\n", name);
+        return NULL;
+    }
+    return best;
+}
+
+PyObject* py_builtin_min(PyObject* iterable)
+{
+    return py_builtin_minmax(iterable, false);
+}
+
+PyObject* py_builtin_max(PyObject* iterable)
+{
+    return py_builtin_minmax(iterable, true);
+}
+
+//===----------------------------------------------------------------------===//
+// any / all
+//===----------------------------------------------------------------------===//
+
+static PyObject* py_builtin_truth(PyObject* iterable, bool wantAll)
+{
+    if (PyListObject* list = py_builtin_unboxed_list(iterable))
+    {
+        switch (list->storage)
+        {
+            case PY_LIST_STORAGE_INT64:
+                return py_create_bool(wantAll ? py_simd_all_i64(list->ints, list->length)
+                                              : py_simd_any_i64(list->ints, list->length));
+
+            case PY_LIST_STORAGE_DOUBLE:
+                return py_create_bool(wantAll ? py_simd_all_f64(list->doubles, list->length)
+                                              : py_simd_any_f64(list->doubles, list->length));
+
+            case PY_LIST_STORAGE_BOOL:
+            {
+                long ones = py_bitset_count(list->bits, list->length);
+                return py_create_bool(wantAll ? ones == list->length : ones > 0);
+            }
+        }
+    }
+
+    // 通用路径: 遇到第一个决定结果的元素即停止
+    bool result = wantAll;
+    bool iterable_ok = py_builtin_for_each(iterable, [&](PyObject* item)
+    {
+        if (py_object_to_bool(item) != wantAll)
+        {
+            result = !wantAll;
+            return false;
+        }
+        return true;
+    });
+
+    if (!iterable_ok) return NULL;
+    return py_create_bool(result);
+}
+
+PyObject* py_builtin_any(PyObject* iterable)
+{
+    return py_builtin_truth(iterable, false);
+}
+
+PyObject* py_builtin_all(PyObject* iterable)
+{
+    return py_builtin_truth(iterable, true);
+}
+
+//===----------------------------------------------------------------------===//
+// 逐元素运算 (vec_add / vec_sub / vec_mul / vec_div)
+//===----------------------------------------------------------------------===//
+
+// 操作数的非装箱视图: 列表 (步长 1) 或广播标量 (步长 0)
+struct PyVecOperand
+{
+    PyListObject* list;  // 非 NULL 表示列表操作数
+    int storage;         // INT64 / DOUBLE，其余视为无法走快速路径
+    int64_t scalarInt;
+    double scalarDouble;
+};
+
+static PyVecOperand py_vec_operand(PyObject* obj)
+{
+    PyVecOperand op = {NULL, PY_LIST_STORAGE_BOXED, 0, 0.0};
+    if (llvmpy::getBaseTypeId(obj->typeId) == llvmpy::PY_TYPE_LIST)
+    {
+        op.list = (PyListObject*)obj;
+        op.storage = op.list->storage;
+    }
+    else if (obj->typeId == llvmpy::PY_TYPE_INT)
+    {
+        mpz_ptr value = ((PyPrimitiveObject*)obj)->value.intValue;
+        if (mpz_fits_slong_p(value))
+        {
+            op.storage = PY_LIST_STORAGE_INT64;
+            op.scalarInt = (int64_t)mpz_get_si(value);
+        }
+    }
+    else if (obj->typeId == llvmpy::PY_TYPE_DOUBLE)
+    {
+        op.storage = PY_LIST_STORAGE_DOUBLE;
+        op.scalarDouble = mpf_get_d(((PyPrimitiveObject*)obj)->value.doubleValue);
+    }
+    return op;
+}
+
+// 取得操作数的 double 数组 (int64 会转换到 scratch，无法精确转换时返回 NULL)
+static const double* py_vec_as_f64(const PyVecOperand& op, int n, double* scratch)
+{
+    if (op.storage == PY_LIST_STORAGE_DOUBLE)
+    {
+        return op.list ? op.list->doubles : &op.scalarDouble;
+    }
+    const int64_t* ints = op.list ? op.list->ints : &op.scalarInt;
+    int count = op.list ? n : 1;
+    for (int i = 0; i < count; i++)
+    {
+        scratch[i] = (double)ints[i];
+        // 超出 2^53 的整数保留给 GMP 路径; 接近 INT64_MAX 的值会舍入到 2^63，须先判范围再转回 int64
+        if (scratch[i] >= 9223372036854775808.0 || (int64_t)scratch[i] != ints[i]) return NULL;
+    }
+    return scratch;
+}
+
+// 快速路径: 两个操作数都是 int64/double 视图。返回 NULL 表示需要走通用路径，
+// *error 为 true 表示已报告错误。
+static PyObject* py_vec_fast_binop(PyVecOperand& a, PyVecOperand& b, int n, PySimdBinOp op, bool* error)
+{
+    *error = false;
+    bool numericA = a.storage == PY_LIST_STORAGE_INT64 || a.storage == PY_LIST_STORAGE_DOUBLE;
+    bool numericB = b.storage == PY_LIST_STORAGE_INT64 || b.storage == PY_LIST_STORAGE_DOUBLE;
+    if (!numericA || !numericB) return NULL;
+
+    int strideA = a.list ? 1 : 0;
+    int strideB = b.list ? 1 : 0;
+
+    if (a.storage == PY_LIST_STORAGE_INT64 && b.storage == PY_LIST_STORAGE_INT64 && op != PY_SIMD_DIV)
+    {
+        PyObject* resultObj = py_create_list(n, llvmpy::PY_TYPE_INT);
+        if (!resultObj) return NULL;
+        PyListObject* result = (PyListObject*)resultObj;
+        const int64_t* x = a.list ? a.list->ints : &a.scalarInt;
+        const int64_t* y = b.list ? b.list->ints : &b.scalarInt;
+        if (!py_simd_binop_i64(op, x, strideA, y, strideB, result->ints, n))
+        {
+            py_decref(resultObj);  // 溢出: 交给 GMP 路径
+            return NULL;
+        }
+        result->length = n;
+        return resultObj;
+    }
+
+    double* scratchA = (a.storage == PY_LIST_STORAGE_INT64) ? (double*)malloc(sizeof(double) * (a.list ? n : 1)) : NULL;
+    double* scratchB = (b.storage == PY_LIST_STORAGE_INT64) ? (double*)malloc(sizeof(double) * (b.list ? n : 1)) : NULL;
+    const double* x = py_vec_as_f64(a, n, scratchA);
+    const double* y = py_vec_as_f64(b, n, scratchB);
+
+    PyObject* resultObj = NULL;
+    if (x && y)
+    {
+        if (op == PY_SIMD_DIV && !(strideB ? py_simd_all_f64(y, n) : y[0] != 0.0))
+        {
+            fprintf(stderr, "ZeroDivisionError: float division by zero\n");
+            *error = true;
+        }
+        else if ((resultObj = py_create_list(n, llvmpy::PY_TYPE_DOUBLE)) != NULL)
+        {
+            PyListObject* result = (PyListObject*)resultObj;
+            py_simd_binop_f64(op, x, strideA, y, strideB, result->doubles, n);
+            result->length = n;
+            // GMP 浮点数无法表示 inf
+            for (int i = 0; i < n; i++)
+            {
+                if (!__builtin_isfinite(result->doubles[i]))
+                {
+                    fprintf(stderr, "OverflowError: float result out of range in elementwise operation\n");
+                    py_decref(resultObj);
+                    resultObj = NULL;
+                    *error = true;
+                    break;
+                }
+            }
+        }
+    }
+    free(scratchA);
+    free(scratchB);
+    return resultObj;
+}
+
+static PyObject* py_builtin_elementwise(PyObject* a, PyObject* b, PySimdBinOp op)
+{
+    static const char* names[] = {"vec_add", "vec_sub", "vec_mul", "vec_div"};
+    if (!a || !b)
+    {
+        fprintf(stderr, "TypeError: %s() operands cannot be None\n", names[op]);
+        return NULL;
+    }
+
+    PyVecOperand va = py_vec_operand(a);
+    PyVecOperand vb = py_vec_operand(b);
+    if (!va.list && !vb.list)
+    {
+        fprintf(stderr, "TypeError: %s() requires at least one list operand\n", names[op]);
+        return NULL;
+    }
+    if (va.list && vb.list && va.list->length != vb.list->length)
+    {
+        fprintf(stderr, "ValueError: %s() operands have different lengths (%d and %d)\n",
+                names[op], va.list->length, vb.list->length);
+        return NULL;
+    }
+    int n = va.list ? va.list->length : vb.list->length;
+
+    bool error = false;
+    PyObject* fast = py_vec_fast_binop(va, vb, n, op, &error);
+    if (fast || error) return fast;
+
+    // 通用路径: 逐元素调用 py_object_* 运算
+    int elemTypeId = llvmpy::PY_TYPE_ANY;
+    if (va.list && vb.list && va.list->elemTypeId == vb.list->elemTypeId && op != PY_SIMD_DIV)
+    {
+        elemTypeId = va.list->elemTypeId;
+    }
+    PyObject* resultObj = py_create_list(n, elemTypeId);
+    if (!resultObj) return NULL;
+
+    for (int i = 0; i < n; i++)
+    {
+        PyObject* x = va.list ? py_list_box_item(va.list, i) : a;
+        PyObject* y = vb.list ? py_list_box_item(vb.list, i) : b;
+        PyObject* r = NULL;
+        switch (op)
+        {
+            case PY_SIMD_ADD: r = py_object_add(x, y); break;
+            case PY_SIMD_SUB: r = py_object_subtract(x, y); break;
+            case PY_SIMD_MUL: r = py_object_multiply(x, y); break;
+            case PY_SIMD_DIV: r = py_object_divide(x, y); break;
+        }
+        if (va.list) py_decref(x);
+        if (vb.list) py_decref(y);
+        if (!r || !py_list_append(resultObj, r))
+        {
+            if (r) py_decref(r);
+            py_decref(resultObj);
+            return NULL;
+        }
+        py_decref(r);
+    }
+    return resultObj;
+}
+
+PyObject* py_builtin_vec_add(PyObject* a, PyObject* b)
+{
+    return py_builtin_elementwise(a, b, PY_SIMD_ADD);
+}
+
+PyObject* py_builtin_vec_sub(PyObject* a, PyObject* b)
+{
+    return py_builtin_elementwise(a, b, PY_SIMD_SUB);
+}
+
+PyObject* py_builtin_vec_mul(PyObject* a, PyObject* b)
+{
+    return py_builtin_elementwise(a, b, PY_SIMD_MUL);
+}
+
+PyObject* py_builtin_vec_div(PyObject* a, PyObject* b)
+{
+    return py_builtin_elementwise(a, b, PY_SIMD_DIV);
+}
+
+//===----------------------------------------------------------------------===//
+// range
+//===----------------------------------------------------------------------===//
+
+// range 参数必须是能放进 int64 的整数 (bool 视为整数)
+static bool py_range_arg(PyObject* obj, int64_t* out)
+{
+    if (obj && obj->typeId == llvmpy::PY_TYPE_BOOL)
+    {
+        *out = ((PyPrimitiveObject*)obj)->value.boolValue ? 1 : 0;
+        return true;
+    }
+    if (!obj || obj->typeId != llvmpy::PY_TYPE_INT)
+    {
+        fprintf(stderr, "TypeError: '%s' object cannot be interpreted as an integer\n",
+                obj ? py_type_name(obj->typeId) : "NoneType");
+        return false;
+    }
+    mpz_ptr value = ((PyPrimitiveObject*)obj)->value.intValue;
+    if (!mpz_fits_slong_p(value))
+    {
+        fprintf(stderr, "OverflowError: range() argument does not fit in a 64-bit integer\n");
+        return false;
+    }
+    *out = (int64_t)mpz_get_si(value);
+    return true;
+}
+
+bool py_range_unpack(PyObject* a, PyObject* b, PyObject* c, int64_t* start, int64_t* stop, int64_t* step)
+{
+    *start = 0;
+    *step = 1;
+    if (!b)
+    {
+        // range(stop)
+        if (!py_range_arg(a, stop)) return false;
+    }
+    else
+    {
+        if (!py_range_arg(a, start) || !py_range_arg(b, stop)) return false;
+        if (c && !py_range_arg(c, step)) return false;
+    }
+    if (*step == 0)
+    {
+        fprintf(stderr, "ValueError: range() arg 3 must not be zero\n");
+        return false;
+    }
+    return true;
+}
+
+PyObject* py_builtin_range(PyObject* a, PyObject* b, PyObject* c)
+{
+    int64_t start, stop, step;
+    if (!py_range_unpack(a, b, c, &start, &stop, &step)) return NULL;
+    return py_create_range(start, stop, step);
+}
+
+//===----------------------------------------------------------------------===//
+// len
+//===----------------------------------------------------------------------===//
+
+PyObject* py_builtin_len(PyObject* obj)
+{
+    switch (llvmpy::getBaseTypeId(py_get_safe_type_id(obj)))
+    {
+        case llvmpy::PY_TYPE_STRING:
+        case llvmpy::PY_TYPE_LIST:
+        case llvmpy::PY_TYPE_TUPLE:
+        case llvmpy::PY_TYPE_DICT:
+        case llvmpy::PY_TYPE_SET:
+            return py_create_int(py_object_len(obj));
+        default:
+            fprintf(stderr, "TypeError: object of type '%s' has no len()\n", py_type_name(py_get_safe_type_id(obj)));
+            return NULL;
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// 集合
+//===----------------------------------------------------------------------===//
+
+// set_add(s, x) / set_discard(s, x): 原地修改集合，返回 None
+PyObject* py_builtin_set_add(PyObject* set, PyObject* item)
+{
+    if (py_get_safe_type_id(set) != llvmpy::PY_TYPE_SET)
+    {
+        fprintf(stderr, "TypeError: set_add() argument 1 must be set, not %s\n", py_type_name(py_get_safe_type_id(set)));
+        return NULL;
+    }
+    py_set_add(set, item);
+    return py_get_none();
+}
+
+PyObject* py_builtin_set_discard(PyObject* set, PyObject* item)
+{
+    if (py_get_safe_type_id(set) != llvmpy::PY_TYPE_SET)
+    {
+        fprintf(stderr, "TypeError: set_discard() argument 1 must be set, not %s\n", py_type_name(py_get_safe_type_id(set)));
+        return NULL;
+    }
+    py_set_discard(set, item);
+    return py_get_none();
+}
+
+//===----------------------------------------------------------------------===//
+// 字典视图
+//===----------------------------------------------------------------------===//
+
+static PyObject* py_builtin_dict_view(PyObject* dict, int kind, const char* name)
+{
+    if (llvmpy::getBaseTypeId(py_get_safe_type_id(dict)) != llvmpy::PY_TYPE_DICT)
+    {
+        fprintf(stderr, "TypeError: %s() argument must be dict, not %s\n", name, py_type_name(py_get_safe_type_id(dict)));
+        return NULL;
+    }
+    return py_dict_iter(dict, kind);
+}
+
+PyObject* py_builtin_dict_keys(PyObject* dict)
+{
+    return py_builtin_dict_view(dict, PY_DICT_ITER_KEYS, "keys");
+}
+
+PyObject* py_builtin_dict_values(PyObject* dict)
+{
+    return py_builtin_dict_view(dict, PY_DICT_ITER_VALUES, "values");
+}
+
+PyObject* py_builtin_dict_items(PyObject* dict)
+{
+    return py_builtin_dict_view(dict, PY_DICT_ITER_ITEMS, "items");
+}
+
+//===----------------------------------------------------------------------===//
+// 循环垃圾收集
+//===----------------------------------------------------------------------===//
+
+static bool py_gc_int_arg(PyObject* obj, const char* func, int* out)
+{
+    if (!obj || obj->typeId != llvmpy::PY_TYPE_INT || !mpz_fits_sint_p(((PyPrimitiveObject*)obj)->value.intValue))
+    {
+        fprintf(stderr, "TypeError: %s() argument must be an int, not %s\n", func,
+                obj ? py_type_name(obj->typeId) : "NoneType");
+        return false;
+    }
+    *out = (int)mpz_get_si(((PyPrimitiveObject*)obj)->value.intValue);
+    return true;
+}
+
+PyObject* py_builtin_gc_collect(PyObject* generation)
+{
+    int gen = PY_GC_GENERATIONS - 1;
+    if (generation && !py_gc_int_arg(generation, "gc_collect", &gen)) return NULL;
+    if (gen < 0 || gen >= PY_GC_GENERATIONS)
+    {
+        fprintf(stderr, "ValueError: invalid generation %d\n", gen);
+        return NULL;
+    }
+    return py_create_int(py_gc_collect(gen));
+}
+
+PyObject* py_builtin_gc_set_threshold(PyObject* threshold0, PyObject* threshold1, PyObject* threshold2)
+{
+    // 缺省的阈值保持默认值
+    int thresholds[PY_GC_GENERATIONS] = {700, 10, 10};
+    PyObject* args[PY_GC_GENERATIONS] = {threshold0, threshold1, threshold2};
+    for (int i = 0; i < PY_GC_GENERATIONS; i++)
+    {
+        if (args[i] && !py_gc_int_arg(args[i], "gc_set_threshold", &thresholds[i])) return NULL;
+    }
+    py_gc_set_threshold(thresholds[0], thresholds[1], thresholds[2]);
+    return py_get_none();
+}
@@ -19,7 +19,7 @@ PyObject* py_iter(PyObject* iterable_obj) {
     int type_id = llvmpy::getBaseTypeId(iterable_obj->typeId);
 
     if (type_id == llvmpy::PY_TYPE_LIST) {
-        PyListIteratorObject* iter = (PyListIteratorObject*)malloc(sizeof(PyListIteratorObject));
+        PyListIteratorObject* iter = (PyListIteratorObject*)py_mem_alloc(sizeof(PyListIteratorObject));
         if (!iter) {
             LOG_ERROR("MemoryError: failed to allocate list iterator");
             // fprintf(stderr, "MemoryError: failed to allocate list iterator\n"); // Replaced
@@ -27,13 +27,15 @@ PyObject* py_iter(PyObject* iterable_obj) {
         }
         iter->header.refCount = 1;
         iter->header.typeId = llvmpy::PY_TYPE_LIST_ITERATOR;
+        iter->header.flags = 0;
         iter->iterable = iterable_obj;
         py_incref(iterable_obj);
         iter->current_index = 0;
         LOG_DEBUG("py_iter created PyListIteratorObject: %p, typeId: %d, for iterable: %p", (void*)iter, iter->header.typeId, (void*)iterable_obj);
+        PY_MEMSTATS_OBJECT_ALLOC(iter);
         return (PyObject*)iter;
     } else if (type_id == llvmpy::PY_TYPE_STRING) {
-        PyStringIteratorObject* iter = (PyStringIteratorObject*)malloc(sizeof(PyStringIteratorObject));
+        PyStringIteratorObject* iter = (PyStringIteratorObject*)py_mem_alloc(sizeof(PyStringIteratorObject));
         if (!iter) {
             LOG_ERROR("MemoryError: failed to allocate string iterator");
             // fprintf(stderr, "MemoryError: failed to allocate string iterator\n"); // Replaced
@@ -41,11 +43,65 @@ PyObject* py_iter(PyObject* iterable_obj) {
         }
         iter->header.refCount = 1;
         iter->header.typeId = llvmpy::PY_TYPE_STRING_ITERATOR;
+        iter->header.flags = 0;
         iter->iterable = iterable_obj;
         py_incref(iterable_obj);
         iter->current_char_index = 0;
         LOG_DEBUG("py_iter created PyStringIteratorObject: %p, typeId: %d, for iterable: %p", (void*)iter, iter->header.typeId, (void*)iterable_obj);
+        PY_MEMSTATS_OBJECT_ALLOC(iter);
         return (PyObject*)iter;
+    } else if (type_id == llvmpy::PY_TYPE_RANGE) {
+        PyRangeObject* range = (PyRangeObject*)iterable_obj;
+        PyRangeIteratorObject* iter = (PyRangeIteratorObject*)py_mem_alloc(sizeof(PyRangeIteratorObject));
+        if (!iter) {
+            LOG_ERROR("MemoryError: failed to allocate range iterator");
+            return NULL;
+        }
+        iter->header.refCount = 1;
+        iter->header.typeId = llvmpy::PY_TYPE_RANGE_ITERATOR;
+        iter->header.flags = 0;
+        iter->next = range->start;
+        iter->step = range->step;
+        iter->remaining = range->length;
+        LOG_DEBUG("py_iter created PyRangeIteratorObject: %p, for range: %p", (void*)iter, (void*)iterable_obj);
+        PY_MEMSTATS_OBJECT_ALLOC(iter);
+        return (PyObject*)iter;
+    } else if (type_id == llvmpy::PY_TYPE_TUPLE) {
+        PyTupleIteratorObject* iter = (PyTupleIteratorObject*)py_mem_alloc(sizeof(PyTupleIteratorObject));
+        if (!iter) {
+            LOG_ERROR("MemoryError: failed to allocate tuple iterator");
+            return NULL;
+        }
+        iter->header.refCount = 1;
+        iter->header.typeId = llvmpy::PY_TYPE_TUPLE_ITERATOR;
+        iter->header.flags = 0;
+        iter->iterable = iterable_obj;
+        py_incref(iterable_obj);
+        iter->current_index = 0;
+        LOG_DEBUG("py_iter created PyTupleIteratorObject: %p, for tuple: %p", (void*)iter, (void*)iterable_obj);
+        PY_MEMSTATS_OBJECT_ALLOC(iter);
+        return (PyObject*)iter;
+    } else if (type_id == llvmpy::PY_TYPE_SET) {
+        PySetIteratorObject* iter = (PySetIteratorObject*)py_mem_alloc(sizeof(PySetIteratorObject));
+        if (!iter) {
+            LOG_ERROR("MemoryError: failed to allocate set iterator");
+            return NULL;
+        }
+        iter->header.refCount = 1;
+        iter->header.typeId = llvmpy::PY_TYPE_SET_ITERATOR;
+        iter->header.flags = 0;
+        iter->iterable = iterable_obj;
+        py_incref(iterable_obj);
+        iter->current_slot = 0;
+        LOG_DEBUG("py_iter created PySetIteratorObject: %p, for set: %p", (void*)iter, (void*)iterable_obj);
+        PY_MEMSTATS_OBJECT_ALLOC(iter);
+        return (PyObject*)iter;
+    } else if (type_id == llvmpy::PY_TYPE_DICT) {
+        return py_dict_iter(iterable_obj, PY_DICT_ITER_KEYS);
+    } else if (type_id == llvmpy::PY_TYPE_ITERATOR_BASE) {
+        // 迭代器本身可迭代 (如 keys(d) / items(d) 的结果)
+        py_incref(iterable_obj);
+        return iterable_obj;
     }
     
     LOG_WARN("py_iter: Object of type %s (%d) is not iterable.", py_type_name(iterable_obj->typeId), iterable_obj->typeId);
@@ -70,18 +126,10 @@ PyObject* py_next(PyObject* iterator_obj) {
         PyListObject* list = (PyListObject*)iter->iterable; 
 
         if (iter->current_index < list->length) {
-            PyObject* item = list->data[iter->current_index];
+            PyObject* item = py_list_box_item(list, iter->current_index);
             iter->current_index++;
-            if (item) {
-                py_incref(item); 
-                LOG_DEBUG("py_next (list) returning item: %p, typeId: %d (%s)", (void*)item, item->typeId, py_type_name(item->typeId));
-                return item;
-            } else {
-                PyObject* none_val = py_get_none();
-                py_incref(none_val); 
-                LOG_DEBUG("py_next (list) returning None (original item was NULL) for iterator: %p", (void*)iterator_obj);
-                return none_val;
-            }
+            LOG_DEBUG("py_next (list) returning item: %p, typeId: %d (%s)", (void*)item, item->typeId, py_type_name(item->typeId));
+            return item;
         } else {
             LOG_DEBUG("py_next (list) StopIteration for iterator: %p", (void*)iterator_obj);
             return NULL;
@@ -107,6 +155,72 @@ PyObject* py_next(PyObject* iterator_obj) {
             LOG_DEBUG("py_next (string) StopIteration for iterator: %p", (void*)iterator_obj);
             return NULL;
         }
+    } else if (iterator_type_id == llvmpy::PY_TYPE_RANGE_ITERATOR) {
+        PyRangeIteratorObject* iter = (PyRangeIteratorObject*)iterator_obj;
+        if (iter->remaining <= 0) {
+            LOG_DEBUG("py_next (range) StopIteration for iterator: %p", (void*)iterator_obj);
+            return NULL;
+        }
+        int64_t value = iter->next;
+        iter->remaining--;
+        // 最后一个元素之后不再前进，避免 next 溢出
+        if (iter->remaining > 0) iter->next += iter->step;
+        return py_create_int(value);
+    } else if (iterator_type_id == llvmpy::PY_TYPE_TUPLE_ITERATOR) {
+        PyTupleIteratorObject* iter = (PyTupleIteratorObject*)iterator_obj;
+        PyTupleObject* tuple = (PyTupleObject*)iter->iterable;
+        if (iter->current_index >= tuple->length) {
+            LOG_DEBUG("py_next (tuple) StopIteration for iterator: %p", (void*)iterator_obj);
+            return NULL;
+        }
+        PyObject* item = tuple->items[iter->current_index++];
+        if (!item) item = py_get_none();
+        py_incref(item);
+        return item;
+    } else if (iterator_type_id == llvmpy::PY_TYPE_SET_ITERATOR) {
+        PySetIteratorObject* iter = (PySetIteratorObject*)iterator_obj;
+        PySetObject* set = (PySetObject*)iter->iterable;
+        // 跳过空槽和墓碑
+        while (iter->current_slot < set->capacity) {
+            PyObject* key = set->entries[iter->current_slot++].key;
+            if (key) {
+                py_incref(key);
+                return key;
+            }
+        }
+        LOG_DEBUG("py_next (set) StopIteration for iterator: %p", (void*)iterator_obj);
+        return NULL;
+    } else if (iterator_type_id == llvmpy::PY_TYPE_DICT_ITERATOR) {
+        PyDictIteratorObject* iter = (PyDictIteratorObject*)iterator_obj;
+        PyDictObject* dict = (PyDictObject*)iter->iterable;
+        if (dict->version != iter->version) {
+            py_runtime_error("RuntimeError_DictChangedSize", 0);
+            // 之后的调用一律视为结束，避免重复报错
+            iter->current_slot = dict->capacity;
+            iter->version = dict->version;
+            return NULL;
+        }
+        while (iter->current_slot < dict->capacity) {
+            PyDictEntry* entry = &dict->entries[iter->current_slot++];
+            if (!entry->used || !entry->key) continue;
+
+            PyObject* value = entry->value ? entry->value : py_get_none();
+            if (iter->kind == PY_DICT_ITER_KEYS) {
+                py_incref(entry->key);
+                return entry->key;
+            }
+            if (iter->kind == PY_DICT_ITER_VALUES) {
+                py_incref(value);
+                return value;
+            }
+            PyObject* pair = py_create_tuple(2);
+            if (!pair) return NULL;
+            py_tuple_set_item(pair, 0, entry->key);
+            py_tuple_set_item(pair, 1, value);
+            return pair;
+        }
+        LOG_DEBUG("py_next (dict) StopIteration for iterator: %p", (void*)iterator_obj);
+        return NULL;
     }
     
     LOG_ERROR("py_next: Object %p is not a known iterator type (typeId: %d, %s)", (void*)iterator_obj, iterator_obj->typeId, py_type_name(iterator_obj->typeId));
@@ -119,413 +233,657 @@ PyObject* py_next(PyObject* iterator_obj) {
 // 列表操作函数
 //===----------------------------------------------------------------------===//
 
-// 获取列表长度
-int py_list_len(PyObject* obj)
+//===----------------------------------------------------------------------===//
+// 列表存储策略 (非装箱存储)
+//===----------------------------------------------------------------------===//
+
+// 根据元素类型选择存储策略
+int py_list_storage_for_type(int elemTypeId)
 {
-    if (!py_check_type(obj, llvmpy::PY_TYPE_LIST))
-    {
-        py_type_error(obj, llvmpy::PY_TYPE_LIST);
-        return 0;
+    switch (elemTypeId)
+    {
+        case llvmpy::PY_TYPE_INT:
+            return PY_LIST_STORAGE_INT64;
+        case llvmpy::PY_TYPE_DOUBLE:
+            return PY_LIST_STORAGE_DOUBLE;
+        case llvmpy::PY_TYPE_BOOL:
+            return PY_LIST_STORAGE_BOOL;
+        default:
+            return PY_LIST_STORAGE_BOXED;
     }
+}
 
-    PyListObject* list = (PyListObject*)obj;
-    return list->length;
+// 容纳 count 个元素所需的缓冲区字节数
+size_t py_list_storage_bytes(int storage, int count)
+{
+    size_t n = count > 0 ? (size_t)count : 0;
+    switch (storage)
+    {
+        case PY_LIST_STORAGE_INT64:
+            return n * sizeof(int64_t);
+        case PY_LIST_STORAGE_DOUBLE:
+            return n * sizeof(double);
+        case PY_LIST_STORAGE_BOOL:
+            return ((n + 63) / 64) * sizeof(uint64_t);
+        default:
+            return n * sizeof(PyObject*);
+    }
 }
 
-// 获取列表元素
-PyObject* py_list_get_item(PyObject* listObj, PyObject* indexObj)
+//===----------------------------------------------------------------------===//
+// 列表切片视图 (共享缓冲区，写时复制)
+//===----------------------------------------------------------------------===//
+
+// 被视图引用时替换下来的旧缓冲区。装箱存储的旧缓冲区仍持有元素引用，释放时一并减少。
+struct PyListRetiredBuffer_t
 {
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_get_item called.\n");
-#endif
-    if (!listObj)
+    struct PyListRetiredBuffer_t* next;
+    void* data;
+    int length;
+    int capacity;
+    int storage;
+    int exports;  // 仍指向该缓冲区的视图个数，归零时立即释放
+};
+
+static bool py_buffer_contains(const void* data, int storage, int capacity, const void* ptr)
+{
+    const char* begin = (const char*)data;
+    const char* end = begin + py_list_storage_bytes(storage, capacity);
+    return (const char*)ptr >= begin && (const char*)ptr < end;
+}
+
+// ptr 是否指向 list 当前缓冲区内
+static bool py_list_buffer_contains(PyListObject* list, const void* ptr)
+{
+    return py_buffer_contains(list->data, list->storage, list->capacity, ptr);
+}
+
+static void py_list_free_retired(PyListRetiredBuffer_t* retired)
+{
+    if (retired->storage == PY_LIST_STORAGE_BOXED)
     {
-        fprintf(stderr, "RuntimeError: Attempting to get item from NULL list\n");
-        // In Python, this would likely be a crash or earlier error.
-        // Returning None might hide issues. Consider returning NULL.
-        return NULL;  // Indicate error more strongly
+        PyObject** items = (PyObject**)retired->data;
+        for (int i = 0; i < retired->length; i++)
+        {
+            py_decref(items[i]);
+        }
     }
+    py_mem_free(retired->data);
+    py_mem_free(retired);
+}
 
-    // 确保是列表类型
-    if (!py_check_type(listObj, llvmpy::PY_TYPE_LIST))
+// 视图在释放或复制前调用: 减少其所指缓冲区 (根列表当前缓冲区或某个旧缓冲区) 的导出计数
+static void py_list_unexport(PyListObject* view)
+{
+    PyListObject* root = (PyListObject*)view->base;
+    if (root->exports > 0 && py_list_buffer_contains(root, view->data))
     {
-        py_type_error(listObj, llvmpy::PY_TYPE_LIST);
-        return NULL;  // Indicate error
+        root->exports--;
+        return;
     }
 
-    PyListObject* list = (PyListObject*)listObj;
-
-    // 提取 GMP 整数索引
-    mpz_ptr idx_mpz = py_extract_int(indexObj);
-    long c_index;
-
-    if (!idx_mpz)
+    PyListRetiredBuffer_t** link = &root->retired;
+    while (*link)
     {
-        // 尝试布尔值? Python 允许 bool 作为索引 (0 或 1)
-        if (py_get_safe_type_id(indexObj) == llvmpy::PY_TYPE_BOOL)
+        PyListRetiredBuffer_t* retired = *link;
+        if (py_buffer_contains(retired->data, retired->storage, retired->capacity, view->data))
         {
-            c_index = py_extract_bool(indexObj) ? 1 : 0;
+            if (--retired->exports == 0)
+            {
+                *link = retired->next;
+                py_list_free_retired(retired);
+            }
+            return;
         }
-        else
+        link = &retired->next;
+    }
+}
+
+// 视图被写入: 复制借用的元素到自己的缓冲区，之后与根列表无关
+static bool py_list_materialize(PyListObject* list)
+{
+    int capacity = list->length > 0 ? list->length : 8;
+    void* data = py_mem_calloc(1, py_list_storage_bytes(list->storage, capacity));
+    if (!data)
+    {
+        fprintf(stderr, "MemoryError: Failed to materialize list slice (%d items)\n", list->length);
+        return false;
+    }
+    memcpy(data, list->data, py_list_storage_bytes(list->storage, list->length));
+    if (list->storage == PY_LIST_STORAGE_BOXED)
+    {
+        PyObject** items = (PyObject**)data;
+        for (int i = 0; i < list->length; i++)
         {
-            fprintf(stderr, "TypeError: list indices must be integers or slices, not '%s'\n",
-                    py_type_name(py_get_safe_type_id(indexObj)));
-            return NULL;  // Indicate error
+            py_incref(items[i]);
         }
     }
-    else
+
+    PyObject* root = list->base;
+    py_list_unexport(list);
+    list->data = (PyObject**)data;
+    list->capacity = capacity;
+    list->base = NULL;
+    py_decref(root);
+    return true;
+}
+
+// 有视图的根列表被写入: 换用一份新缓冲区，旧缓冲区留给视图继续读取
+static bool py_list_detach_exports(PyListObject* list)
+{
+    size_t bytes = py_list_storage_bytes(list->storage, list->capacity);
+    void* data = py_mem_alloc(bytes);
+    PyListRetiredBuffer_t* retired = (PyListRetiredBuffer_t*)py_mem_alloc(sizeof(PyListRetiredBuffer_t));
+    if (!data || !retired)
+    {
+        fprintf(stderr, "MemoryError: Failed to copy list buffer shared with slices\n");
+        py_mem_free(data);
+        py_mem_free(retired);
+        return false;
+    }
+    memcpy(data, list->data, bytes);
+    if (list->storage == PY_LIST_STORAGE_BOXED)
     {
-        // 检查 GMP 整数是否适合 C long
-        if (!mpz_fits_slong_p(idx_mpz))
+        // 新旧缓冲区各持有一份元素引用
+        PyObject** items = (PyObject**)data;
+        for (int i = 0; i < list->length; i++)
         {
-            fprintf(stderr, "IndexError: cannot fit 'int' index into C long\n");
-            return NULL;  // Indicate error
+            py_incref(items[i]);
         }
-        c_index = mpz_get_si(idx_mpz);
     }
 
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_get_item: Extracted C index: %ld\n", c_index);
-#endif
+    retired->next = list->retired;
+    retired->data = list->data;
+    retired->length = list->length;
+    retired->capacity = list->capacity;
+    retired->storage = list->storage;
+    retired->exports = list->exports;
+    list->retired = retired;
+    list->data = (PyObject**)data;
+    list->exports = 0;
+    return true;
+}
 
-    // 处理负数索引
-    if (c_index < 0)
+// 所有修改列表缓冲区的操作都先调用此函数
+static inline bool py_list_make_writable(PyListObject* list)
+{
+    if (list->base) return py_list_materialize(list);
+    if (list->exports > 0) return py_list_detach_exports(list);
+    return true;
+}
+
+// 释放列表的缓冲区 (列表对象本身由调用者释放)
+void py_list_release_storage(PyListObject* list)
+{
+    if (list->base)
     {
-        c_index += list->length;
+        py_list_unexport(list);
+        py_decref(list->base);
     }
-
-    // 边界检查
-    if (c_index < 0 || c_index >= list->length)
+    else
     {
-        fprintf(stderr, "IndexError: list index %ld out of range [0, %d)\n", c_index, list->length);
-        return NULL;  // Indicate error
+        py_list_decref_items(list);
+        py_mem_free(list->data);
     }
 
-    // 获取元素并增加引用计数
-    PyObject* item = list->data[c_index];
-    if (item)
-    {  // Item could theoretically be NULL if list allows it
-        py_incref(item);
-        return item;
-    }
-    else
+    // 视图持有根列表的引用，根列表释放时不再有视图，剩余的旧缓冲区可以全部释放
+    PyListRetiredBuffer_t* retired = list->retired;
+    while (retired)
     {
-        // If item is NULL, return None (incref'd)
-        PyObject* none_obj = py_get_none();
-        py_incref(none_obj);
-        return none_obj;
+        PyListRetiredBuffer_t* next = retired->next;
+        py_list_free_retired(retired);
+        retired = next;
     }
 }
 
-// 设置列表元素
-void py_list_set_item(PyObject* listObj, PyObject* indexObj, PyObject* item)
+// 循环收集: 视图只引用根列表，根列表引用当前缓冲区和旧缓冲区中的元素
+void py_list_traverse(PyListObject* list, PyGCVisitProc visit, void* arg)
 {
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_set_item called.\n");
-#endif
-    if (!py_check_type(listObj, llvmpy::PY_TYPE_LIST))
+    if (list->base)
     {
-        py_type_error(listObj, llvmpy::PY_TYPE_LIST);
+        visit(list->base, arg);
         return;
     }
-
-    PyListObject* list = (PyListObject*)listObj;
-
-    // 提取 GMP 整数索引
-    mpz_ptr idx_mpz = py_extract_int(indexObj);
-    long c_index;
-
-    if (!idx_mpz)
+    if (list->storage == PY_LIST_STORAGE_BOXED)
     {
-        if (py_get_safe_type_id(indexObj) == llvmpy::PY_TYPE_BOOL)
+        for (int i = 0; i < list->length; i++)
         {
-            c_index = py_extract_bool(indexObj) ? 1 : 0;
+            if (list->data[i]) visit(list->data[i], arg);
         }
-        else
+    }
+    for (PyListRetiredBuffer_t* retired = list->retired; retired; retired = retired->next)
+    {
+        if (retired->storage != PY_LIST_STORAGE_BOXED) continue;
+        PyObject** items = (PyObject**)retired->data;
+        for (int i = 0; i < retired->length; i++)
         {
-            fprintf(stderr, "TypeError: list indices must be integers or slices, not '%s'\n",
-                    py_type_name(py_get_safe_type_id(indexObj)));
-            return;
+            if (items[i]) visit(items[i], arg);
         }
     }
-    else
+}
+
+// 打断环: 根列表释放所有元素引用并清空 (视图保持不变，根列表释放时一起回收)
+void py_list_clear_refs(PyListObject* list)
+{
+    if (list->base) return;
+    if (list->storage == PY_LIST_STORAGE_BOXED)
     {
-        if (!mpz_fits_slong_p(idx_mpz))
+        int length = list->length;
+        list->length = 0;
+        for (int i = 0; i < length; i++)
         {
-            fprintf(stderr, "IndexError: cannot fit 'int' index into C long\n");
-            return;
+            PyObject* item = list->data[i];
+            list->data[i] = NULL;
+            py_decref(item);
         }
-        c_index = mpz_get_si(idx_mpz);
     }
-
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_set_item: Extracted C index: %ld\n", c_index);
-#endif
-
-    // 处理负数索引
-    if (c_index < 0)
+    for (PyListRetiredBuffer_t* retired = list->retired; retired; retired = retired->next)
     {
-        c_index += list->length;
+        if (retired->storage != PY_LIST_STORAGE_BOXED) continue;
+        PyObject** items = (PyObject**)retired->data;
+        for (int i = 0; i < retired->length; i++)
+        {
+            PyObject* item = items[i];
+            items[i] = NULL;
+            py_decref(item);
+        }
     }
+}
 
-    // 边界检查 (基于长度，因为这是赋值)
-    if (c_index < 0 || c_index >= list->length)
+// 创建 list[start:start+count] 的视图 (count > 0)。视图的 base 总是根列表。
+static PyObject* py_list_create_view(PyListObject* list, int start, int count)
+{
+    PyListObject* root = list->base ? (PyListObject*)list->base : list;
+    PyListObject* view = (PyListObject*)py_gc_malloc(sizeof(PyListObject));
+    if (!view)
     {
-        fprintf(stderr, "IndexError: list assignment index %ld out of range [0, %d)\n",
-                c_index, list->length);
-        return;
+        fprintf(stderr, "Error: Out of memory for list\n");
+        return NULL;
     }
 
-    // --- 类型兼容性检查 (使用 py_smart_convert) ---
-    PyObject* final_value = item;
-    bool needs_decref_final = false;
-
-    if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY)
-    {
-        PyObject* converted_value = py_smart_convert(item, list->elemTypeId);
-        if (!converted_value)
-        {
-            // py_smart_convert should print the error
-            // fprintf(stderr, "TypeError: Cannot assign value of type %s to list with element type %s\n",
-            //         py_type_name(py_get_safe_type_id(item)), py_type_name(list->elemTypeId));
-            return;
-        }
-        // If conversion happened and created a new object
-        if (converted_value != item)
-        {
-            final_value = converted_value;
-            needs_decref_final = true;
-        }
-        else
+    view->header.refCount = 1;
+    view->header.typeId = list->header.typeId;
+    view->header.flags = 0;
+    view->length = count;
+    view->capacity = count;
+    view->elemTypeId = list->elemTypeId;
+    view->storage = list->storage;
+    view->data = (PyObject**)((char*)list->data + py_list_storage_bytes(list->storage, start));
+    view->base = (PyObject*)root;
+    view->exports = 0;
+    view->retired = NULL;
+    py_incref((PyObject*)root);
+    PY_MEMSTATS_OBJECT_ALLOC(view);
+    py_gc_track((PyObject*)view);
+    if (py_list_buffer_contains(root, view->data))
+    {
+        root->exports++;
+        return (PyObject*)view;
+    }
+    // 从指向旧缓冲区的视图再切片
+    for (PyListRetiredBuffer_t* retired = root->retired; retired; retired = retired->next)
+    {
+        if (py_buffer_contains(retired->data, retired->storage, retired->capacity, view->data))
         {
-            // smart_convert returned the original object (already compatible),
-            // but it might have incref'd it. Decref the extra reference.
-            py_decref(converted_value);
+            retired->exports++;
+            break;
         }
     }
-    // --- 结束类型兼容性检查 ---
+    return (PyObject*)view;
+}
 
-    // 替换项目前先减少旧项目的引用计数
-    PyObject* old_item = list->data[c_index];
-    if (old_item)
+// 深度复制结果与原对象无法区分的值 (不可变标量、元组与函数)，容器复制时可以直接共享
+static bool py_copy_is_shared(PyObject* obj)
+{
+    if (!obj) return true;
+    switch (llvmpy::getBaseTypeId(obj->typeId))
     {
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_list_set_item: Decref old item at index %ld (%p, refcnt before: %d)\n", c_index, (void*)old_item, old_item->refCount);
-#endif
-        py_decref(old_item);
+        case llvmpy::PY_TYPE_NONE:
+        case llvmpy::PY_TYPE_INT:
+        case llvmpy::PY_TYPE_DOUBLE:
+        case llvmpy::PY_TYPE_BOOL:
+        case llvmpy::PY_TYPE_STRING:
+        case llvmpy::PY_TYPE_TUPLE:
+        case llvmpy::PY_TYPE_FUNC:
+            return true;
+        default:
+            return false;
     }
+}
 
-    // 设置新元素并增加引用计数
-    list->data[c_index] = final_value;
-    if (final_value)
+bool py_list_copy_can_share(PyListObject* list)
+{
+    if (list->storage != PY_LIST_STORAGE_BOXED) return true;
+    for (int i = 0; i < list->length; i++)
     {
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_list_set_item: Incref new item at index %ld (%p, refcnt before: %d)\n", c_index, (void*)final_value, final_value->refCount);
-#endif
-        py_incref(final_value);  // Incref the value being stored in the list
+        if (!py_copy_is_shared(list->data[i])) return false;
     }
+    return true;
+}
 
-    // 如果 final_value 是转换后创建的新对象，减少它的临时引用计数
-    if (needs_decref_final)
+bool py_dict_copy_can_share(PyDictObject* dict)
+{
+    for (int i = 0; i < dict->capacity; i++)
     {
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_list_set_item: Decref temporary converted value (%p, refcnt before: %d)\n", (void*)final_value, final_value->refCount);
-#endif
-        py_decref(final_value);
+        PyDictEntry* entry = &dict->entries[i];
+        if (!entry->used) continue;
+        if (!py_copy_is_shared(entry->key) || !py_copy_is_shared(entry->value)) return false;
     }
-
-    // 注意：py_list_set_item 不应该改变列表长度
+    return true;
 }
 
-// 向列表追加元素
-PyObject* py_list_append(PyObject* listObj, PyObject* item)
+PyObject* py_list_share(PyObject* obj)
 {
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_append called.\n");
-#endif
-    if (!py_check_type(listObj, llvmpy::PY_TYPE_LIST))
+    PyListObject* list = (PyListObject*)obj;
+    if (list->length == 0)
     {
-        py_type_error(listObj, llvmpy::PY_TYPE_LIST);
-        return NULL;  // Return NULL on error
+        return py_create_list(8, list->elemTypeId);  // 空视图没有可借用的缓冲区
     }
+    return py_list_create_view(list, 0, list->length);
+}
 
-    PyListObject* list = (PyListObject*)listObj;
-
-    // --- 类型兼容性检查 (使用 py_smart_convert) ---
-    PyObject* final_value = item;
-    bool needs_decref_final = false;
+// 尝试以非装箱形式写入 index 处，元素无法无损表示时返回 false
+static bool py_list_store_unboxed(PyListObject* list, int index, PyObject* item)
+{
+    if (!item) return false;
 
-    if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY)
+    switch (list->storage)
     {
-        PyObject* converted_value = py_smart_convert(item, list->elemTypeId);
-        if (!converted_value)
+        case PY_LIST_STORAGE_INT64:
         {
-            // py_smart_convert should print the error
-            return NULL;  // Return NULL on type error during append
+            if (item->typeId != llvmpy::PY_TYPE_INT) return false;
+            mpz_ptr value = ((PyPrimitiveObject*)item)->value.intValue;
+            if (!mpz_fits_slong_p(value)) return false;
+            list->ints[index] = (int64_t)mpz_get_si(value);
+            return true;
         }
-        if (converted_value != item)
+        case PY_LIST_STORAGE_DOUBLE:
         {
-            final_value = converted_value;
-            needs_decref_final = true;
+            if (item->typeId != llvmpy::PY_TYPE_DOUBLE) return false;
+            mpf_ptr value = ((PyPrimitiveObject*)item)->value.doubleValue;
+            double d = mpf_get_d(value);
+            // 超出 double 精度的 GMP 浮点数保持装箱，避免丢失精度
+            if (mpf_cmp_d(value, d) != 0) return false;
+            list->doubles[index] = d;
+            return true;
         }
-        else
+        case PY_LIST_STORAGE_BOOL:
         {
-            py_decref(converted_value);  // Decref extra ref if no conversion needed
+            if (item->typeId != llvmpy::PY_TYPE_BOOL) return false;
+            uint64_t mask = (uint64_t)1 << (index & 63);
+            if (((PyPrimitiveObject*)item)->value.boolValue)
+                list->bits[index >> 6] |= mask;
+            else
+                list->bits[index >> 6] &= ~mask;
+            return true;
         }
+        default:
+            return false;
     }
-    // --- 结束类型兼容性检查 ---
+}
 
-    // 检查是否需要扩展容量
-    if (list->length >= list->capacity)
+// 读取 index 处的元素 (返回新引用，空槽返回 None)
+PyObject* py_list_box_item(PyListObject* list, int index)
+{
+    switch (list->storage)
+    {
+        case PY_LIST_STORAGE_INT64:
+            return py_create_int((long long)list->ints[index]);
+        case PY_LIST_STORAGE_DOUBLE:
+            return py_create_double(list->doubles[index]);
+        case PY_LIST_STORAGE_BOOL:
+            return py_create_bool((list->bits[index >> 6] >> (index & 63)) & 1);
+        default:
+            break;
+    }
+
+    PyObject* item = list->data[index];
+    if (!item)
+    {
+        item = py_get_none();
+    }
+    py_incref(item);
+    return item;
+}
+
+// 退化为装箱存储 (插入异构或超出范围的元素时调用)
+bool py_list_despecialize(PyListObject* list)
+{
+    if (list->storage == PY_LIST_STORAGE_BOXED) return true;
+    if (!py_list_make_writable(list)) return false;
+
+    int capacity = list->capacity > 0 ? list->capacity : 8;
+    PyObject** boxed = (PyObject**)py_mem_calloc(capacity, sizeof(PyObject*));
+    if (!boxed)
+    {
+        fprintf(stderr, "MemoryError: Failed to allocate boxed storage for list\n");
+        return false;
+    }
+
+    for (int i = 0; i < list->length; i++)
     {
-        int newCapacity = (list->capacity == 0) ? 8 : list->capacity * 2;  // Start with 8, then double
+        boxed[i] = py_list_box_item(list, i);
+    }
+
 #ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_list_append: Resizing list from %d to %d\n", list->capacity, newCapacity);
+    fprintf(stderr, "DEBUG: py_list_despecialize: List %p storage %d -> BOXED (%d items)\n",
+            (void*)list, list->storage, list->length);
 #endif
-        // Check for potential overflow before multiplication
-        if (list->capacity > INT_MAX / 2)
-        {
-            newCapacity = INT_MAX;  // Cap at INT_MAX
-            if (list->length >= newCapacity)
-            {
-                fprintf(stderr, "MemoryError: Cannot expand list capacity beyond INT_MAX\n");
-                if (needs_decref_final) py_decref(final_value);
-                return NULL;  // Indicate error
-            }
-        }
 
-        PyObject** newData = (PyObject**)realloc(list->data, newCapacity * sizeof(PyObject*));
+    py_mem_free(list->data);
+    list->data = boxed;
+    list->capacity = capacity;
+    list->storage = PY_LIST_STORAGE_BOXED;
+    return true;
+}
+
+// 确保容量至少为 minCapacity (按当前存储策略扩容，新增部分清零)
+bool py_list_reserve(PyListObject* list, int minCapacity)
+{
+    if (!py_list_make_writable(list)) return false;
+    if (minCapacity <= list->capacity) return true;
 
-        if (!newData)
+    int newCapacity = (list->capacity == 0) ? 8 : list->capacity;
+    while (newCapacity < minCapacity)
+    {
+        // Check for potential overflow before multiplication
+        if (newCapacity > INT_MAX / 2)
         {
-            fprintf(stderr, "MemoryError: Failed to expand list capacity to %d\n", newCapacity);
-            if (needs_decref_final) py_decref(final_value);
-            return NULL;  // Indicate error
+            newCapacity = INT_MAX;
+            break;
         }
-
-        // 初始化新分配的内存 (realloc doesn't guarantee zeroing)
-        // Only need to NULL out the newly allocated part
-        memset(newData + list->capacity, 0, (newCapacity - list->capacity) * sizeof(PyObject*));
-
-        list->data = newData;
-        list->capacity = newCapacity;
+        newCapacity *= 2;
     }
-
-    // 添加新元素并增加引用计数
-    list->data[list->length] = final_value;
-    if (final_value)
+    if (newCapacity < minCapacity)
     {
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_list_append: Incref appended item (%p, refcnt before: %d)\n", (void*)final_value, final_value->refCount);
-#endif
-        py_incref(final_value);  // Incref the value being stored
+        fprintf(stderr, "MemoryError: Cannot expand list capacity beyond INT_MAX\n");
+        return false;
     }
+
 #ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_append: List %p, BEFORE length increment. Current length: %d, Capacity: %d. Appending item %p.\n",
-            (void*)list, list->length, list->capacity, (void*)final_value);
-#endif
-    list->length++;
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_append: List %p, AFTER length increment. New length: %d.\n",
-            (void*)list, list->length);
+    fprintf(stderr, "DEBUG: py_list_reserve: Resizing list from %d to %d\n", list->capacity, newCapacity);
 #endif
 
-    // Decref temporary converted value if created
-    if (needs_decref_final)
+    size_t oldBytes = py_list_storage_bytes(list->storage, list->capacity);
+    size_t newBytes = py_list_storage_bytes(list->storage, newCapacity);
+    void* newData = py_mem_realloc(list->data, newBytes);
+    if (!newData)
     {
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_list_append: Decref temporary converted value (%p, refcnt before: %d)\n", (void*)final_value, final_value->refCount);
-#endif
-        py_decref(final_value);
+        fprintf(stderr, "MemoryError: Failed to expand list capacity to %d\n", newCapacity);
+        return false;
     }
 
-    // Python's append returns None, but returning the list might be useful internally sometimes.
-    // Let's return NULL on error, and the list object on success for chaining?
-    // Or stick to Python's void-like return (implicitly None)?
-    // For now, return the list object on success, NULL on error.
-    return listObj;
+    // realloc doesn't guarantee zeroing, only need to clear the newly allocated part
+    memset((char*)newData + oldBytes, 0, newBytes - oldBytes);
+
+    list->data = (PyObject**)newData;
+    list->capacity = newCapacity;
+    return true;
 }
 
-// 复制列表
-PyObject* py_list_copy(PyObject* obj)
+// 把 src 的全部元素追加到 dst 末尾，两者须为同一种非装箱存储 (不经过装箱)
+bool py_list_extend_unboxed(PyListObject* dst, PyListObject* src)
 {
-    if (!py_check_type(obj, llvmpy::PY_TYPE_LIST))
-    {
-        py_type_error(obj, llvmpy::PY_TYPE_LIST);
-        return NULL;
+    if (dst->storage != src->storage || dst->storage == PY_LIST_STORAGE_BOXED) return false;
+    if (src->length == 0) return true;
+    if (dst->length > INT_MAX - src->length) return false;
+
+    int srcLength = src->length;  // dst 与 src 可能是同一个列表
+    if (!py_list_reserve(dst, dst->length + srcLength)) return false;
+
+    switch (dst->storage)
+    {
+        case PY_LIST_STORAGE_INT64:
+            memcpy(dst->ints + dst->length, src->ints, srcLength * sizeof(int64_t));
+            break;
+        case PY_LIST_STORAGE_DOUBLE:
+            memcpy(dst->doubles + dst->length, src->doubles, srcLength * sizeof(double));
+            break;
+        case PY_LIST_STORAGE_BOOL:
+            if (dst->length % 64 == 0)
+            {
+                memcpy(dst->bits + dst->length / 64, src->bits, py_list_storage_bytes(PY_LIST_STORAGE_BOOL, srcLength));
+            }
+            else
+            {
+                // 未按字对齐时逐位复制
+                for (int i = 0; i < srcLength; i++)
+                {
+                    int to = dst->length + i;
+                    uint64_t bit = (src->bits[i >> 6] >> (i & 63)) & 1;
+                    dst->bits[to >> 6] = (dst->bits[to >> 6] & ~((uint64_t)1 << (to & 63))) | (bit << (to & 63));
+                }
+            }
+            break;
     }
+    dst->length += srcLength;
+    return true;
+}
 
-    PyListObject* srcList = (PyListObject*)obj;
-
-    // 创建新列表，与原列表容量相同
-    PyObject* newListObj = py_create_list(srcList->capacity, srcList->elemTypeId);
-    if (!newListObj) return NULL;
-
-    PyListObject* newList = (PyListObject*)newListObj;
+// 将 item 写入 index 处 (调用者已完成类型转换)。
+// 非装箱列表遇到无法表示的元素时先退化为装箱存储。
+static bool py_list_store_item(PyListObject* list, int index, PyObject* item)
+{
+    if (!py_list_make_writable(list)) return false;
+    if (list->storage != PY_LIST_STORAGE_BOXED)
+    {
+        if (py_list_store_unboxed(list, index, item)) return true;
+        if (!py_list_despecialize(list)) return false;
+    }
 
-    if (newList->capacity < srcList->length)
+    PyObject* old_item = list->data[index];
+    list->data[index] = item;
+    if (item)
     {
-        // This shouldn't happen with py_create_list logic above, but check defensively
-        fprintf(stderr, "InternalError: Insufficient capacity in py_list_copy\n");
-        py_decref(newListObj);
-        return NULL;
+        py_incref(item);  // Incref the value being stored in the list
     }
-    // 复制元素
-    for (int i = 0; i < srcList->length; i++)
+    if (old_item)
     {
-        PyObject* srcItem = srcList->data[i];
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_list_store_item: Decref old item at index %d (%p, refcnt before: %d)\n", index, (void*)old_item, old_item->refCount);
+#endif
+        py_decref(old_item);
+    }
+    return true;
+}
 
-        // 对每个元素进行深度复制
-        PyObject* newItem = NULL;
+// 推导式构建结果列表时写入 index 处 (index < capacity，由调用者预留)。
+// 不做 py_smart_convert 转换，元素无法以当前非装箱存储表示时退化为装箱存储；装箱存储增加 item 的引用计数。
+bool py_list_store_reserved(PyListObject* list, int index, PyObject* item)
+{
+    if (index < 0 || index >= list->capacity) return false;
+    return py_list_store_item(list, index, item);
+}
 
-        if (srcItem)
+// 由元素数组一次性构建列表: 缓冲区按 n 只分配一次，逐个写入槽位而不经过 py_list_append。
+// steal 为 true 时接管 items 中每个元素的引用 (出错时也会释放它们)，否则装箱存储为元素增加引用。
+// 与 py_list_append 一致，elemTypeId 为具体类型时类型不同的元素先经 py_smart_convert 转换。
+PyObject* py_create_list_from_array(PyObject** items, int n, int elemTypeId, bool steal)
+{
+    if (n < 0) n = 0;
+    PyObject* listObj = py_create_list(n, elemTypeId);
+    PyListObject* list = (PyListObject*)listObj;
+    bool typed = elemTypeId > 0 && elemTypeId != llvmpy::PY_TYPE_ANY;
+
+    int releaseFrom = 0;  // 出错时 items[releaseFrom..n) 仍由本函数持有 (steal 时)
+    bool ok = listObj != NULL;
+    for (int i = 0; ok && i < n; i++)
+    {
+        PyObject* item = items[i];
+        PyObject* value = item;
+        bool converted = false;
+        if (typed && item && item->typeId != elemTypeId)
         {
-            // 从列表中获取的元素需要复制
-            newItem = py_object_copy(srcItem, srcItem->typeId);
-            if (!newItem)
+            value = py_smart_convert(item, elemTypeId);  // 新引用
+            if (!value)
             {
-                // 如果复制失败，清理已创建的列表
-                py_decref(newListObj);
-                return NULL;
+                releaseFrom = i;
+                ok = false;
+                break;
             }
+            if (steal) py_decref(item);
+            converted = true;
         }
+        bool ownsValue = steal || converted;
 
-        // 添加到新列表
-        newList->data[i] = newItem;
-        newList->length++;
+        if (list->storage != PY_LIST_STORAGE_BOXED)
+        {
+            if (py_list_store_unboxed(list, i, value))
+            {
+                if (ownsValue) py_decref(value);
+                list->length = i + 1;
+                continue;
+            }
+            if (!py_list_despecialize(list))
+            {
+                if (converted) py_decref(value);
+                releaseFrom = converted ? i + 1 : i;
+                ok = false;
+                break;
+            }
+        }
+        list->data[i] = value;
+        if (value && !ownsValue) py_incref(value);
+        list->length = i + 1;
     }
+    if (ok) return listObj;
 
-    return newListObj;
+    if (steal)
+    {
+        for (int j = releaseFrom; j < n; j++)
+        {
+            if (items[j]) py_decref(items[j]);
+        }
+    }
+    if (listObj) py_decref(listObj);
+    return NULL;
 }
 
-// 从列表中减少元素的引用计数
-void py_list_decref_items(PyListObject* list)
+// 获取列表长度
+int py_list_len(PyObject* obj)
 {
-    if (!list) return;
-
-    for (int i = 0; i < list->length; i++)
+    if (!py_check_type(obj, llvmpy::PY_TYPE_LIST))
     {
-        if (list->data[i])
-        {
-            py_decref(list->data[i]);
-            list->data[i] = NULL;
-        }
+        py_type_error(obj, llvmpy::PY_TYPE_LIST);
+        return 0;
     }
+
+    PyListObject* list = (PyListObject*)obj;
+    return list->length;
 }
 
-// 获取列表元素并返回其类型ID - 用于索引操作
-PyObject* py_list_get_item_with_type(PyObject* listObj, PyObject* indexObj, int* out_type_id)
+// 获取列表元素
+PyObject* py_list_get_item(PyObject* listObj, PyObject* indexObj)
 {
 #ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_get_item_with_type called.\n");
+    fprintf(stderr, "DEBUG: py_list_get_item called.\n");
 #endif
-    // Default type ID to NONE in case of early exit
-    if (out_type_id) *out_type_id = llvmpy::PY_TYPE_NONE;
-
-    if (!listObj || !out_type_id)
+    if (!listObj)
     {
-        fprintf(stderr, "RuntimeError: Invalid arguments to py_list_get_item_with_type (list=%p, out_type_id=%p)\n", (void*)listObj, (void*)out_type_id);
-        return NULL;  // Indicate error
+        fprintf(stderr, "RuntimeError: Attempting to get item from NULL list\n");
+        // In Python, this would likely be a crash or earlier error.
+        // Returning None might hide issues. Consider returning NULL.
+        return NULL;  // Indicate error more strongly
     }
 
     // 确保是列表类型
@@ -543,6 +901,7 @@ PyObject* py_list_get_item_with_type(PyObject* listObj, PyObject* indexObj, int*
 
     if (!idx_mpz)
     {
+        // 尝试布尔值? Python 允许 bool 作为索引 (0 或 1)
         if (py_get_safe_type_id(indexObj) == llvmpy::PY_TYPE_BOOL)
         {
             c_index = py_extract_bool(indexObj) ? 1 : 0;
@@ -551,21 +910,22 @@ PyObject* py_list_get_item_with_type(PyObject* listObj, PyObject* indexObj, int*
         {
             fprintf(stderr, "TypeError: list indices must be integers or slices, not '%s'\n",
                     py_type_name(py_get_safe_type_id(indexObj)));
-            return NULL;
+            return NULL;  // Indicate error
         }
     }
     else
     {
+        // 检查 GMP 整数是否适合 C long
         if (!mpz_fits_slong_p(idx_mpz))
         {
             fprintf(stderr, "IndexError: cannot fit 'int' index into C long\n");
-            return NULL;
+            return NULL;  // Indicate error
         }
         c_index = mpz_get_si(idx_mpz);
     }
 
 #ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_list_get_item_with_type: Extracted C index: %ld\n", c_index);
+    fprintf(stderr, "DEBUG: py_list_get_item: Extracted C index: %ld\n", c_index);
 #endif
 
     // 处理负数索引
@@ -581,544 +941,2142 @@ PyObject* py_list_get_item_with_type(PyObject* listObj, PyObject* indexObj, int*
         return NULL;  // Indicate error
     }
 
-    // 获取元素
-    PyObject* item = list->data[c_index];
+    // 获取元素 (装箱存储增加引用计数，非装箱存储创建新对象，空槽返回 None)
+    return py_list_box_item(list, (int)c_index);
+}
 
-    // 设置类型ID
-    if (item)
+// 设置列表元素
+void py_list_set_item(PyObject* listObj, PyObject* indexObj, PyObject* item)
+{
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_list_set_item called.\n");
+#endif
+    if (!py_check_type(listObj, llvmpy::PY_TYPE_LIST))
     {
-        *out_type_id = item->typeId;
+        py_type_error(listObj, llvmpy::PY_TYPE_LIST);
+        return;
+    }
 
-        // If list has specific element type, use that (potentially more specific than item->typeId)
-        // Example: list[int] containing an int object. elemTypeId might be PY_TYPE_LIST_INT.
-        // This logic seems reversed, usually item->typeId is more specific.
-        // Let's prioritize item->typeId unless item is NULL.
-        // if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY)
-        // {
-        //     *out_type_id = list->elemTypeId;
-        // }
+    PyListObject* list = (PyListObject*)listObj;
+
+    // 提取 GMP 整数索引
+    mpz_ptr idx_mpz = py_extract_int(indexObj);
+    long c_index;
+
+    if (!idx_mpz)
+    {
+        if (py_get_safe_type_id(indexObj) == llvmpy::PY_TYPE_BOOL)
+        {
+            c_index = py_extract_bool(indexObj) ? 1 : 0;
+        }
+        else
+        {
+            fprintf(stderr, "TypeError: list indices must be integers or slices, not '%s'\n",
+                    py_type_name(py_get_safe_type_id(indexObj)));
+            return;
+        }
     }
     else
     {
-        *out_type_id = llvmpy::PY_TYPE_NONE;
+        if (!mpz_fits_slong_p(idx_mpz))
+        {
+            fprintf(stderr, "IndexError: cannot fit 'int' index into C long\n");
+            return;
+        }
+        c_index = mpz_get_si(idx_mpz);
     }
 
-    // 增加引用计数并返回 (return NULL if item is NULL)
-    if (item)
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_list_set_item: Extracted C index: %ld\n", c_index);
+#endif
+
+    // 处理负数索引
+    if (c_index < 0)
     {
-        py_incref(item);
-        return item;
+        c_index += list->length;
     }
-    else
+
+    // 边界检查 (基于长度，因为这是赋值)
+    if (c_index < 0 || c_index >= list->length)
     {
-        // Return None if the slot contains NULL
-        PyObject* none_obj = py_get_none();
-        py_incref(none_obj);
-        return none_obj;
+        fprintf(stderr, "IndexError: list assignment index %ld out of range [0, %d)\n",
+                c_index, list->length);
+        return;
+    }
+
+    // --- 类型兼容性检查 (使用 py_smart_convert) ---
+    PyObject* final_value = item;
+    bool needs_decref_final = false;
+
+    if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY)
+    {
+        PyObject* converted_value = py_smart_convert(item, list->elemTypeId);
+        if (!converted_value)
+        {
+            // py_smart_convert should print the error
+            // fprintf(stderr, "TypeError: Cannot assign value of type %s to list with element type %s\n",
+            //         py_type_name(py_get_safe_type_id(item)), py_type_name(list->elemTypeId));
+            return;
+        }
+        // If conversion happened and created a new object
+        if (converted_value != item)
+        {
+            final_value = converted_value;
+            needs_decref_final = true;
+        }
+        else
+        {
+            // smart_convert returned the original object (already compatible),
+            // but it might have incref'd it. Decref the extra reference.
+            py_decref(converted_value);
+        }
+    }
+    // --- 结束类型兼容性检查 ---
+
+    // 设置新元素 (替换并释放旧元素，必要时退化为装箱存储)
+    py_list_store_item(list, (int)c_index, final_value);
+
+    // 如果 final_value 是转换后创建的新对象，减少它的临时引用计数
+    if (needs_decref_final)
+    {
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_list_set_item: Decref temporary converted value (%p, refcnt before: %d)\n", (void*)final_value, final_value->refCount);
+#endif
+        py_decref(final_value);
+    }
+
+    // 注意：py_list_set_item 不应该改变列表长度
+}
+
+// 向列表追加元素
+PyObject* py_list_append(PyObject* listObj, PyObject* item)
+{
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_list_append called.\n");
+#endif
+    if (!py_check_type(listObj, llvmpy::PY_TYPE_LIST))
+    {
+        py_type_error(listObj, llvmpy::PY_TYPE_LIST);
+        return NULL;  // Return NULL on error
+    }
+
+    PyListObject* list = (PyListObject*)listObj;
+
+    // --- 类型兼容性检查 (使用 py_smart_convert) ---
+    PyObject* final_value = item;
+    bool needs_decref_final = false;
+
+    if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY)
+    {
+        PyObject* converted_value = py_smart_convert(item, list->elemTypeId);
+        if (!converted_value)
+        {
+            // py_smart_convert should print the error
+            return NULL;  // Return NULL on type error during append
+        }
+        if (converted_value != item)
+        {
+            final_value = converted_value;
+            needs_decref_final = true;
+        }
+        else
+        {
+            py_decref(converted_value);  // Decref extra ref if no conversion needed
+        }
+    }
+    // --- 结束类型兼容性检查 ---
+
+    // 检查是否需要扩展容量
+    if (!py_list_reserve(list, list->length + 1))
+    {
+        if (needs_decref_final) py_decref(final_value);
+        return NULL;  // Indicate error
+    }
+
+    // 添加新元素 (装箱存储会增加引用计数)
+    if (!py_list_store_item(list, list->length, final_value))
+    {
+        if (needs_decref_final) py_decref(final_value);
+        return NULL;
+    }
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_list_append: List %p, BEFORE length increment. Current length: %d, Capacity: %d. Appending item %p.\n",
+            (void*)list, list->length, list->capacity, (void*)final_value);
+#endif
+    list->length++;
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_list_append: List %p, AFTER length increment. New length: %d.\n",
+            (void*)list, list->length);
+#endif
+
+    // Decref temporary converted value if created
+    if (needs_decref_final)
+    {
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_list_append: Decref temporary converted value (%p, refcnt before: %d)\n", (void*)final_value, final_value->refCount);
+#endif
+        py_decref(final_value);
+    }
+
+    // Python's append returns None, but returning the list might be useful internally sometimes.
+    // Let's return NULL on error, and the list object on success for chaining?
+    // Or stick to Python's void-like return (implicitly None)?
+    // For now, return the list object on success, NULL on error.
+    return listObj;
+}
+
+// 复制列表
+PyObject* py_list_copy(PyObject* obj)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_LIST))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_LIST);
+        return NULL;
+    }
+
+    PyListObject* srcList = (PyListObject*)obj;
+    if (srcList->length > 0 && py_list_copy_can_share(srcList))
+    {
+        return py_list_share(obj);
+    }
+
+    // 创建新列表，与原列表容量相同
+    PyObject* newListObj = py_create_list(srcList->capacity, srcList->elemTypeId);
+    if (!newListObj) return NULL;
+
+    PyListObject* newList = (PyListObject*)newListObj;
+
+    if (newList->capacity < srcList->length)
+    {
+        // This shouldn't happen with py_create_list logic above, but check defensively
+        fprintf(stderr, "InternalError: Insufficient capacity in py_list_copy\n");
+        py_decref(newListObj);
+        return NULL;
+    }
+    // 非装箱存储：元素本身即是值，直接复制缓冲区
+    if (srcList->storage != PY_LIST_STORAGE_BOXED && newList->storage == srcList->storage)
+    {
+        memcpy(newList->data, srcList->data, py_list_storage_bytes(srcList->storage, srcList->length));
+        newList->length = srcList->length;
+        return newListObj;
+    }
+    if (srcList->storage != PY_LIST_STORAGE_BOXED || !py_list_despecialize(newList))
+    {
+        fprintf(stderr, "InternalError: Mismatched list storage in py_list_copy\n");
+        py_decref(newListObj);
+        return NULL;
+    }
+
+    // 复制元素
+    for (int i = 0; i < srcList->length; i++)
+    {
+        PyObject* srcItem = srcList->data[i];
+
+        // 对每个元素进行深度复制
+        PyObject* newItem = NULL;
+
+        if (srcItem)
+        {
+            // 从列表中获取的元素需要复制
+            newItem = py_object_copy(srcItem, srcItem->typeId);
+            if (!newItem)
+            {
+                // 如果复制失败，清理已创建的列表
+                py_decref(newListObj);
+                return NULL;
+            }
+        }
+
+        // 添加到新列表
+        newList->data[i] = newItem;
+        newList->length++;
+    }
+
+    return newListObj;
+}
+
+// 从列表中减少元素的引用计数
+void py_list_decref_items(PyListObject* list)
+{
+    if (!list) return;
+
+    // 非装箱存储不持有任何对象引用
+    if (list->storage != PY_LIST_STORAGE_BOXED) return;
+
+    for (int i = 0; i < list->length; i++)
+    {
+        if (list->data[i])
+        {
+            py_decref(list->data[i]);
+            list->data[i] = NULL;
+        }
+    }
+}
+
+// 获取列表元素并返回其类型ID - 用于索引操作
+PyObject* py_list_get_item_with_type(PyObject* listObj, PyObject* indexObj, int* out_type_id)
+{
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_list_get_item_with_type called.\n");
+#endif
+    // Default type ID to NONE in case of early exit
+    if (out_type_id) *out_type_id = llvmpy::PY_TYPE_NONE;
+
+    if (!listObj || !out_type_id)
+    {
+        fprintf(stderr, "RuntimeError: Invalid arguments to py_list_get_item_with_type (list=%p, out_type_id=%p)\n", (void*)listObj, (void*)out_type_id);
+        return NULL;  // Indicate error
+    }
+
+    // 确保是列表类型
+    if (!py_check_type(listObj, llvmpy::PY_TYPE_LIST))
+    {
+        py_type_error(listObj, llvmpy::PY_TYPE_LIST);
+        return NULL;  // Indicate error
+    }
+
+    PyListObject* list = (PyListObject*)listObj;
+
+    // 提取 GMP 整数索引
+    mpz_ptr idx_mpz = py_extract_int(indexObj);
+    long c_index;
+
+    if (!idx_mpz)
+    {
+        if (py_get_safe_type_id(indexObj) == llvmpy::PY_TYPE_BOOL)
+        {
+            c_index = py_extract_bool(indexObj) ? 1 : 0;
+        }
+        else
+        {
+            fprintf(stderr, "TypeError: list indices must be integers or slices, not '%s'\n",
+                    py_type_name(py_get_safe_type_id(indexObj)));
+            return NULL;
+        }
+    }
+    else
+    {
+        if (!mpz_fits_slong_p(idx_mpz))
+        {
+            fprintf(stderr, "IndexError: cannot fit 'int' index into C long\n");
+            return NULL;
+        }
+        c_index = mpz_get_si(idx_mpz);
+    }
+
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_list_get_item_with_type: Extracted C index: %ld\n", c_index);
+#endif
+
+    // 处理负数索引
+    if (c_index < 0)
+    {
+        c_index += list->length;
+    }
+
+    // 边界检查
+    if (c_index < 0 || c_index >= list->length)
+    {
+        fprintf(stderr, "IndexError: list index %ld out of range [0, %d)\n", c_index, list->length);
+        return NULL;  // Indicate error
+    }
+
+    // 获取元素 (新引用，空槽为 None)
+    PyObject* item = py_list_box_item(list, (int)c_index);
+
+    // 设置类型ID
+    if (item)
+    {
+        *out_type_id = item->typeId;
+
+        // If list has specific element type, use that (potentially more specific than item->typeId)
+        // Example: list[int] containing an int object. elemTypeId might be PY_TYPE_LIST_INT.
+        // This logic seems reversed, usually item->typeId is more specific.
+        // Let's prioritize item->typeId unless item is NULL.
+        // if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY)
+        // {
+        //     *out_type_id = list->elemTypeId;
+        // }
+    }
+    else
+    {
+        *out_type_id = llvmpy::PY_TYPE_NONE;
+    }
+
+    return item;
+}
+
+// 获取列表元素类型ID
+int py_get_list_element_type_id(PyObject* list)
+{
+    if (!list || llvmpy::getBaseTypeId(list->typeId) != llvmpy::PY_TYPE_LIST)
+    {
+        return 0;  // 无效或不是列表
+    }
+
+    PyListObject* listObj = (PyListObject*)list;
+
+    // 如果列表声明了元素类型，直接返回
+    if (listObj->elemTypeId > 0)
+    {
+        return listObj->elemTypeId;
+    }
+
+    // 尝试从第一个元素推断类型
+    if (listObj->length > 0 && listObj->data[0])
+    {
+        return listObj->data[0]->typeId;
+    }
+
+    return 0;  // 未知元素类型
+}
+
+//===----------------------------------------------------------------------===//
+// 元组操作函数
+//===----------------------------------------------------------------------===//
+
+// 获取元组长度
+int py_tuple_len(PyObject* obj)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_TUPLE))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_TUPLE);
+        return 0;
+    }
+    return ((PyTupleObject*)obj)->length;
+}
+
+// 填充元组元素 (仅用于构造阶段，元组增加 item 的引用计数)
+void py_tuple_set_item(PyObject* tupleObj, int index, PyObject* item)
+{
+    PyTupleObject* tuple = (PyTupleObject*)tupleObj;
+    if (!tuple || index < 0 || index >= tuple->length)
+    {
+        fprintf(stderr, "SystemError: tuple construction index %d out of range\n", index);
+        return;
+    }
+    py_incref(item);
+    py_decref(tuple->items[index]);
+    tuple->items[index] = item;
+}
+
+// 获取元组元素 (返回新引用)
+PyObject* py_tuple_get_item(PyObject* tupleObj, PyObject* indexObj)
+{
+    if (!py_check_type(tupleObj, llvmpy::PY_TYPE_TUPLE))
+    {
+        py_type_error(tupleObj, llvmpy::PY_TYPE_TUPLE);
+        return NULL;
+    }
+    PyTupleObject* tuple = (PyTupleObject*)tupleObj;
+
+    long c_index;
+    mpz_ptr idx_mpz = py_extract_int(indexObj);
+    if (idx_mpz)
+    {
+        if (!mpz_fits_slong_p(idx_mpz))
+        {
+            fprintf(stderr, "IndexError: cannot fit 'int' index into C long\n");
+            return NULL;
+        }
+        c_index = mpz_get_si(idx_mpz);
+    }
+    else if (py_get_safe_type_id(indexObj) == llvmpy::PY_TYPE_BOOL)
+    {
+        c_index = py_extract_bool(indexObj) ? 1 : 0;
+    }
+    else
+    {
+        fprintf(stderr, "TypeError: tuple indices must be integers or slices, not '%s'\n",
+                py_type_name(py_get_safe_type_id(indexObj)));
+        return NULL;
+    }
+
+    if (c_index < 0)
+    {
+        c_index += tuple->length;
+    }
+    if (c_index < 0 || c_index >= tuple->length)
+    {
+        fprintf(stderr, "IndexError: tuple index out of range\n");
+        return NULL;
+    }
+
+    PyObject* item = tuple->items[c_index];
+    if (!item) item = py_get_none();
+    py_incref(item);
+    return item;
+}
+
+// 元组哈希 (结果缓存在对象中，元组不可变所以只需计算一次)
+unsigned int py_tuple_hash(PyObject* obj)
+{
+    PyTupleObject* tuple = (PyTupleObject*)obj;
+    if (tuple->hashCached)
+    {
+        return tuple->hash;
+    }
+
+    // 与 CPython 相同的组合方式 (xxHash 的轮函数，32 位版本)
+    const unsigned int prime1 = 2654435761U;
+    const unsigned int prime2 = 2246822519U;
+    const unsigned int prime5 = 374761393U;
+    unsigned int acc = prime5;
+    for (int i = 0; i < tuple->length; i++)
+    {
+        unsigned int lane = py_hash_object(tuple->items[i]);
+        acc += lane * prime2;
+        acc = (acc << 13) | (acc >> 19);
+        acc *= prime1;
+    }
+    acc += (unsigned int)tuple->length ^ (prime5 ^ 3527539U);
+
+    tuple->hash = acc;
+    tuple->hashCached = 1;
+    return acc;
+}
+
+static int py_sequence_equal(PyObject* a, PyObject* b);
+
+// 元组相等比较 (逐元素比较，长度不同或哈希已缓存且不同时直接返回 False)
+PyObject* py_tuple_equals(PyObject* self, PyObject* other)
+{
+    if (self == other)
+    {
+        return py_create_bool(true);
+    }
+    if (py_get_safe_type_id(other) != llvmpy::PY_TYPE_TUPLE)
+    {
+        return py_create_bool(false);
+    }
+
+    PyTupleObject* a = (PyTupleObject*)self;
+    PyTupleObject* b = (PyTupleObject*)other;
+    if (a->length != b->length || (a->hashCached && b->hashCached && a->hash != b->hash))
+    {
+        return py_create_bool(false);
+    }
+    int eq = py_sequence_equal(self, other);
+    return eq < 0 ? NULL : py_create_bool(eq == 1);
+}
+
+// 序列解包: 把 seq 的 count 个元素以新引用写入 out。
+// 元组和列表直接按下标读取，其他可迭代对象通过迭代器读取；元素个数不符时报 ValueError。
+bool py_unpack_sequence(PyObject* seq, int count, PyObject** out)
+{
+    if (!seq || !out)
+    {
+        fprintf(stderr, "TypeError: cannot unpack non-iterable NoneType object\n");
+        return false;
+    }
+
+    int baseTypeId = llvmpy::getBaseTypeId(seq->typeId);
+    if (baseTypeId == llvmpy::PY_TYPE_TUPLE || baseTypeId == llvmpy::PY_TYPE_LIST)
+    {
+        int length = baseTypeId == llvmpy::PY_TYPE_TUPLE ? ((PyTupleObject*)seq)->length : ((PyListObject*)seq)->length;
+        if (length != count)
+        {
+            if (length > count)
+                fprintf(stderr, "ValueError: too many values to unpack (expected %d)\n", count);
+            else
+                fprintf(stderr, "ValueError: not enough values to unpack (expected %d, got %d)\n", count, length);
+            return false;
+        }
+        for (int i = 0; i < count; i++)
+        {
+            if (baseTypeId == llvmpy::PY_TYPE_TUPLE)
+            {
+                PyObject* item = ((PyTupleObject*)seq)->items[i];
+                out[i] = item ? item : py_get_none();
+                py_incref(out[i]);
+            }
+            else
+            {
+                out[i] = py_list_box_item((PyListObject*)seq, i);
+            }
+        }
+        return true;
+    }
+
+    PyObject* iter = py_iter(seq);
+    if (!iter)
+    {
+        return false;
+    }
+    int got = 0;
+    for (; got < count; got++)
+    {
+        out[got] = py_next(iter);
+        if (!out[got]) break;
+    }
+    PyObject* extra = got == count ? py_next(iter) : NULL;
+    py_decref(iter);
+
+    if (got == count && !extra)
+    {
+        return true;
+    }
+    if (extra)
+    {
+        py_decref(extra);
+        fprintf(stderr, "ValueError: too many values to unpack (expected %d)\n", count);
+    }
+    else
+    {
+        fprintf(stderr, "ValueError: not enough values to unpack (expected %d, got %d)\n", count, got);
+    }
+    for (int i = 0; i < got; i++)
+    {
+        py_decref(out[i]);
+    }
+    return false;
+}
+
+//===----------------------------------------------------------------------===//
+// 哈希表探测 (字典与集合共用)
+//===----------------------------------------------------------------------===//
+
+// 线性探测查找 key。返回键相等的槽位，或探测链上第一个从未使用的空槽 (供插入)；
+// 表满且未找到时返回 NULL。used && key == NULL 的槽位是已删除的墓碑，跳过但不终止探测。
+// Entry 需提供 key / hash / used 三个成员 (PyDictEntry、PySetEntry)。
+template <typename Entry>
+static Entry* py_hash_probe(Entry* entries, int capacity, PyObject* key, unsigned int hash)
+{
+    if (capacity <= 0) return NULL;
+
+    unsigned int index = hash % (unsigned int)capacity;
+    for (int probes = 0; probes < capacity; probes++)
+    {
+        Entry* entry = &entries[(index + probes) % capacity];
+        if (!entry->used)
+        {
+            return entry;
+        }
+        if (!entry->key || (unsigned int)entry->hash != hash)
+        {
+            continue;
+        }
+        // 同一对象必然相等，跳过 py_object_compare 以及它分配的 bool 结果
+        if (entry->key == key || py_compare_eq(key, entry->key))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+//===----------------------------------------------------------------------===//
+// 字典的写时复制 (与列表切片视图相同的做法: 副本借用根字典的条目表)
+//===----------------------------------------------------------------------===//
+
+// 根字典写入前换下的条目表，仍被副本借用
+struct PyDictRetiredTable_t
+{
+    struct PyDictRetiredTable_t* next;
+    PyDictEntry* entries;
+    int capacity;
+    int exports;  // 仍借用该条目表的副本个数，归零时立即释放
+};
+
+static void py_dict_entries_incref(PyDictEntry* entries, int capacity)
+{
+    for (int i = 0; i < capacity; i++)
+    {
+        if (!entries[i].used) continue;
+        py_incref(entries[i].key);
+        if (entries[i].value) py_incref(entries[i].value);
+    }
+}
+
+static void py_dict_entries_decref(PyDictEntry* entries, int capacity)
+{
+    for (int i = 0; i < capacity; i++)
+    {
+        if (!entries[i].used) continue;
+        py_decref(entries[i].key);
+        if (entries[i].value) py_decref(entries[i].value);
+    }
+}
+
+static void py_dict_free_retired(PyDictRetiredTable_t* retired)
+{
+    py_dict_entries_decref(retired->entries, retired->capacity);
+    py_mem_free(retired->entries);
+    py_mem_free(retired);
+}
+
+// 副本在释放或复制前调用: 减少其所借条目表 (根字典当前条目表或某个旧条目表) 的导出计数
+static void py_dict_unexport(PyDictObject* copy)
+{
+    PyDictObject* root = (PyDictObject*)copy->base;
+    if (root->exports > 0 && root->entries == copy->entries)
+    {
+        root->exports--;
+        return;
+    }
+
+    PyDictRetiredTable_t** link = &root->retired;
+    while (*link)
+    {
+        PyDictRetiredTable_t* retired = *link;
+        if (retired->entries == copy->entries)
+        {
+            if (--retired->exports == 0)
+            {
+                *link = retired->next;
+                py_dict_free_retired(retired);
+            }
+            return;
+        }
+        link = &retired->next;
+    }
+}
+
+// 复制一份条目表 (槽位位置不变，迭代中换表不影响遍历) 并持有其中的键值引用
+static PyDictEntry* py_dict_copy_entries(PyDictObject* dict)
+{
+    size_t bytes = (size_t)dict->capacity * sizeof(PyDictEntry);
+    PyDictEntry* entries = (PyDictEntry*)py_mem_alloc(bytes);
+    if (!entries)
+    {
+        fprintf(stderr, "MemoryError: Failed to copy dictionary entries (capacity %d)\n", dict->capacity);
+        return NULL;
+    }
+    memcpy(entries, dict->entries, bytes);
+    py_dict_entries_incref(entries, dict->capacity);
+    return entries;
+}
+
+// 副本被写入: 复制借用的条目表，之后与根字典无关
+static bool py_dict_materialize(PyDictObject* dict)
+{
+    PyDictEntry* entries = py_dict_copy_entries(dict);
+    if (!entries) return false;
+
+    PyObject* root = dict->base;
+    py_dict_unexport(dict);
+    dict->entries = entries;
+    dict->base = NULL;
+    py_decref(root);
+    return true;
+}
+
+// 有副本的根字典被写入: 换用一份新条目表，旧条目表留给副本继续读取
+static bool py_dict_detach_exports(PyDictObject* dict)
+{
+    PyDictRetiredTable_t* retired = (PyDictRetiredTable_t*)py_mem_alloc(sizeof(PyDictRetiredTable_t));
+    PyDictEntry* entries = retired ? py_dict_copy_entries(dict) : NULL;
+    if (!entries)
+    {
+        fprintf(stderr, "MemoryError: Failed to copy dictionary entries shared with copies\n");
+        py_mem_free(retired);
+        return false;
+    }
+
+    retired->next = dict->retired;
+    retired->entries = dict->entries;
+    retired->capacity = dict->capacity;
+    retired->exports = dict->exports;
+    dict->retired = retired;
+    dict->entries = entries;
+    dict->exports = 0;
+    return true;
+}
+
+// 所有修改条目表的操作都先调用此函数
+static inline bool py_dict_make_writable(PyDictObject* dict)
+{
+    if (dict->base) return py_dict_materialize(dict);
+    if (dict->exports > 0) return py_dict_detach_exports(dict);
+    return true;
+}
+
+void py_dict_release_storage(PyDictObject* dict)
+{
+    if (dict->base)
+    {
+        py_dict_unexport(dict);
+        py_decref(dict->base);
+    }
+    else
+    {
+        py_dict_entries_decref(dict->entries, dict->capacity);
+        py_mem_free(dict->entries);
+    }
+
+    // 副本持有根字典的引用，根字典释放时不再有副本，剩余的旧条目表可以全部释放
+    PyDictRetiredTable_t* retired = dict->retired;
+    while (retired)
+    {
+        PyDictRetiredTable_t* next = retired->next;
+        py_dict_free_retired(retired);
+        retired = next;
+    }
+}
+
+// 循环收集: 副本只引用根字典，根字典引用当前条目表和旧条目表中的键值
+static void py_dict_visit_entries(PyDictEntry* entries, int capacity, PyGCVisitProc visit, void* arg)
+{
+    for (int i = 0; i < capacity; i++)
+    {
+        if (!entries[i].used) continue;
+        if (entries[i].key) visit(entries[i].key, arg);
+        if (entries[i].value) visit(entries[i].value, arg);
+    }
+}
+
+void py_dict_traverse(PyDictObject* dict, PyGCVisitProc visit, void* arg)
+{
+    if (dict->base)
+    {
+        visit(dict->base, arg);
+        return;
+    }
+    py_dict_visit_entries(dict->entries, dict->capacity, visit, arg);
+    for (PyDictRetiredTable_t* retired = dict->retired; retired; retired = retired->next)
+    {
+        py_dict_visit_entries(retired->entries, retired->capacity, visit, arg);
+    }
+}
+
+static void py_dict_clear_entries(PyDictEntry* entries, int capacity)
+{
+    for (int i = 0; i < capacity; i++)
+    {
+        PyDictEntry* entry = &entries[i];
+        if (!entry->used) continue;
+        PyObject* key = entry->key;
+        PyObject* value = entry->value;
+        entry->key = entry->value = NULL;
+        entry->used = false;
+        py_decref(key);
+        py_decref(value);
+    }
+}
+
+// 打断环: 根字典释放所有键值引用并清空 (副本保持不变，根字典释放时一起回收)
+void py_dict_clear_refs(PyDictObject* dict)
+{
+    if (dict->base) return;
+    py_dict_clear_entries(dict->entries, dict->capacity);
+    for (PyDictRetiredTable_t* retired = dict->retired; retired; retired = retired->next)
+    {
+        py_dict_clear_entries(retired->entries, retired->capacity);
+    }
+    dict->size = 0;
+    dict->version++;
+}
+
+//===----------------------------------------------------------------------===//
+// 字典操作函数
+//===----------------------------------------------------------------------===//
+
+// 获取字典大小
+int py_dict_len(PyObject* obj)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_DICT);
+        return 0;
+    }
+
+    PyDictObject* dict = (PyDictObject*)obj;
+    return dict->size;
+}
+
+// 哈希函数
+unsigned int py_hash_object(PyObject* obj)
+{
+    if (!obj)
+    {
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_hash_object called with NULL object, returning 0.\n");
+#endif
+        return 0;  // Hash of NULL pointer
+    }
+
+    // Handle None explicitly? CPython hashes None to a constant.
+    if (py_get_safe_type_id(obj) == llvmpy::PY_TYPE_NONE)
+    {
+        // Return a constant hash for None, e.g., 0 or a specific value
+        return 0;  // Or some other constant like 1234567
+    }
+
+    int typeId = py_get_safe_type_id(obj);
+    const PyTypeMethods* methods = py_get_type_methods(typeId);
+
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_hash_object: Hashing object %p, typeId %d (%s), methods=%p\n", (void*)obj, typeId, py_type_name(typeId), (void*)methods);
+#endif
+
+    if (methods && methods->hash)
+    {
+        // 调用类型特定的哈希函数 (already GMP-aware if implemented correctly)
+        unsigned int hash_val = methods->hash(obj);
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_hash_object: Got hash %u from type-specific method.\n", hash_val);
+#endif
+        return hash_val;
+    }
+    else
+    {
+        // 处理不可哈希类型
+        int baseTypeId = llvmpy::getBaseTypeId(typeId);
+        // Check known unhashable types explicitly
+        if (baseTypeId == llvmpy::PY_TYPE_LIST || baseTypeId == llvmpy::PY_TYPE_DICT || baseTypeId == llvmpy::PY_TYPE_SET /* || add other known unhashable types */)
+        {
+            fprintf(stderr, "TypeError: unhashable type: '%s'\n", py_type_name(typeId));
+            // How to signal error? Raise exception? Return specific value?
+            // For now, return 0 and rely on caller to handle potential collisions.
+            // Ideally, set an error flag/exception.
+            return 0;  // Problematic: 0 can be a valid hash
+        }
+
+        // Fallback: Use address? (Generally bad for value types)
+        // CPython raises TypeError for instances of classes without __hash__
+        fprintf(stderr, "TypeError: unhashable type: '%s' (no hash method found)\n", py_type_name(typeId));
+        // Raise exception or return error indicator needed here.
+        return 0;  // Problematic
     }
 }
 
-// 获取列表元素类型ID
-int py_get_list_element_type_id(PyObject* list)
+// 查找字典项
+PyDictEntry* py_dict_find_entry(PyDictObject* dict, PyObject* key)
+{
+    if (!dict || !key) return NULL;
+
+    unsigned int hash = py_hash_object(key);
+    // TODO: Handle error from py_hash_object if it indicates unhashable type
+
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_dict_find_entry: Looking for key %p (hash %u) in dict %p (cap %d)\n", (void*)key, hash, (void*)dict, dict->capacity);
+#endif
+    // 返回已有条目、可插入的空槽，或在表满且未找到时返回 NULL
+    return py_hash_probe(dict->entries, dict->capacity, key, hash);
+}
+
+// 重新调整字典大小
+bool py_dict_resize(PyDictObject* dict)
+{
+    if (!dict || !py_dict_make_writable(dict)) return false;
+
+    int oldCapacity = dict->capacity;
+    PyDictEntry* oldEntries = dict->entries;
+
+    // 新容量为旧容量的两倍 (handle zero capacity)
+    int newCapacity = (oldCapacity == 0) ? 8 : oldCapacity * 2;
+    // Check for potential overflow
+    if (oldCapacity > 0 && newCapacity / 2 != oldCapacity)
+    {
+        fprintf(stderr, "MemoryError: Dictionary capacity overflow during resize.\n");
+        return false;  // Cannot resize further
+    }
+
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_dict_resize: Resizing dict %p from %d to %d\n", (void*)dict, oldCapacity, newCapacity);
+#endif
+
+    // 分配新的条目数组 (use calloc for zero-initialization)
+    PyDictEntry* newEntries = (PyDictEntry*)py_mem_calloc(newCapacity, sizeof(PyDictEntry));
+    if (!newEntries)
+    {
+        fprintf(stderr, "MemoryError: Failed to allocate memory for dictionary resize (capacity %d)\n", newCapacity);
+        return false;
+    }
+
+    // Update dictionary structure BEFORE rehashing
+    dict->version++;
+    dict->entries = newEntries;
+    dict->capacity = newCapacity;
+    dict->size = 0;  // Reset size, will be incremented during re-insertion
+
+    // 重新插入所有条目 from old table
+    for (int i = 0; i < oldCapacity; i++)
+    {
+        PyDictEntry* oldEntry = &oldEntries[i];
+        if (oldEntry->used && oldEntry->key /* && oldEntry->value - allow None value */)
+        {
+#ifdef DEBUG_RUNTIME_CONTAINER
+            fprintf(stderr, "DEBUG: py_dict_resize: Rehashing old entry %d (key %p, value %p)\n", i, (void*)oldEntry->key, (void*)oldEntry->value);
+#endif
+            // Re-insert into the *new* table. py_dict_set_item will handle hashing,
+            // finding slot in new table, and incref.
+            py_dict_set_item((PyObject*)dict, oldEntry->key, oldEntry->value);
+
+            // We need to decref the key and value from the *old* table now,
+            // as they are no longer referenced by the old table structure.
+            // py_dict_set_item already incref'd them for the new table.
+            py_decref(oldEntry->key);
+            if (oldEntry->value)
+            {  // Decref value only if it's not NULL
+                py_decref(oldEntry->value);
+            }
+        }
+    }
+
+    // 释放旧条目数组
+    py_mem_free(oldEntries);
+
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_dict_resize: Resize complete for dict %p. New size: %d\n", (void*)dict, dict->size);
+#endif
+    return true;
+}
+
+// 设置字典项
+void py_dict_set_item(PyObject* obj, PyObject* key, PyObject* value)
+{
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_dict_set_item called for dict %p, key %p, value %p.\n", (void*)obj, (void*)key, (void*)value);
+#endif
+    if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_DICT);
+        return;
+    }
+
+    if (!key)
+    {
+        // Python raises TypeError for None key, not KeyError
+        fprintf(stderr, "TypeError: unhashable type: 'NoneType'\n");
+        return;
+    }
+
+    PyDictObject* dict = (PyDictObject*)obj;
+
+    // --- 类型兼容性检查 (Key) ---
+    // Hashability is checked later by py_hash_object.
+    // Check declared key type if specified.
+    if (dict->keyTypeId > 0 && dict->keyTypeId != llvmpy::PY_TYPE_ANY)
+    {
+        // Use py_are_types_compatible or a similar check if needed.
+        // For now, assume hashability check is sufficient.
+        // if (!py_are_types_compatible(py_get_safe_type_id(key), dict->keyTypeId)) {
+        //     fprintf(stderr, "TypeError: Cannot use type %s as dictionary key for dict with key type %s\n",
+        //             py_type_name(py_get_safe_type_id(key)), py_type_name(dict->keyTypeId));
+        //     return;
+        // }
+    }
+    // --- Value type check? ---
+    // Python dicts don't enforce value types by default. Add if needed.
+
+    if (!py_dict_make_writable(dict)) return;
+
+    // 检查是否需要扩容 (Load factor check)
+    // Use > instead of >= for load factor < 1.0 (e.g., 0.75)
+    // Check before insertion attempt.
+    // Python resizes when dict is 2/3 full. Let's use ~0.75.
+    if (dict->size * 4 >= dict->capacity * 3 && dict->capacity > 0)  // Avoid division
+    {
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_dict_set_item: Load factor exceeded (%d/%d). Resizing dict %p.\n", dict->size, dict->capacity, (void*)dict);
+#endif
+        if (!py_dict_resize(dict))
+        {
+            fprintf(stderr, "MemoryError: Failed to resize dictionary during setitem\n");
+            // If resize fails, we cannot insert.
+            return;
+        }
+        // After resize, capacity and entry pointers have changed.
+    }
+
+    // 查找条目 (find entry returns existing entry or first empty slot)
+    PyDictEntry* entry = py_dict_find_entry(dict, key);
+
+    if (!entry)
+    {
+        // This implies the table is full AND the key wasn't found,
+        // which shouldn't happen if resize logic is correct.
+        fprintf(stderr, "InternalError: Dictionary find failed unexpectedly during setitem (table full?). Dict %p, cap %d, size %d\n", (void*)dict, dict->capacity, dict->size);
+        return;
+    }
+
+    // Check if the entry found is already used (i.e., key exists)
+    if (entry->used && entry->key)
+    {
+        // Key found, update value
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_dict_set_item: Key found at entry %p. Updating value.\n", (void*)entry);
+#endif
+        PyObject* old_value = entry->value;
+
+        // Update value and handle ref counts
+        entry->value = value;
+        if (value) py_incref(value);
+        if (old_value) py_decref(old_value);
+    }
+    else
+    {
+        // Key not found, insert new entry into the empty slot returned by find_entry
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_dict_set_item: Key not found. Inserting new entry at %p.\n", (void*)entry);
+#endif
+        // Check if hash object failed earlier (if py_hash_object could signal error)
+        unsigned int hash = py_hash_object(key);  // Re-hash or store hash from find_entry if possible
+        // TODO: Handle hash error signal here
+
+        entry->key = key;
+        entry->value = value;
+        entry->hash = hash;  // Store hash
+        entry->used = true;
+
+        // Incref the new key and value being stored
+        py_incref(key);
+        if (value) py_incref(value);
+
+        dict->size++;
+        dict->version++;
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_dict_set_item: New entry inserted. Dict %p size now %d.\n", (void*)dict, dict->size);
+#endif
+    }
+}
+
+// py_dict_set_item 在 size * 4 >= capacity * 3 时先扩容再插入
+int py_dict_capacity_for(int n)
+{
+    int capacity = 8;
+    while (n * 4 >= capacity * 3 && capacity < (1 << 29))
+    {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// 向容量足够的条目表插入一项 (不检查扩容)。字面量中重复的键按出现顺序覆盖值。
+static void py_dict_insert_presized(PyDictObject* dict, PyObject* key, PyObject* value, bool steal)
+{
+    unsigned int hash = py_hash_object(key);
+    PyDictEntry* entry = py_hash_probe(dict->entries, dict->capacity, key, hash);
+    if (entry->used && entry->key)
+    {
+        PyObject* oldValue = entry->value;
+        entry->value = value;
+        if (!steal && value) py_incref(value);
+        if (oldValue) py_decref(oldValue);
+        if (steal) py_decref(key);  // 表中保留的是先出现的键对象
+        return;
+    }
+
+    entry->key = key;
+    entry->value = value;
+    entry->hash = hash;
+    entry->used = true;
+    if (!steal)
+    {
+        py_incref(key);
+        if (value) py_incref(value);
+    }
+    dict->size++;
+}
+
+PyObject* py_create_dict_from_pairs(PyObject** items, int n, int keyTypeId, bool steal)
+{
+    PyDictObject* dict = (PyDictObject*)py_create_dict(py_dict_capacity_for(n), keyTypeId);
+    if (!dict)
+    {
+        if (steal)
+        {
+            for (int i = 0; i < 2 * n; i++)
+            {
+                if (items[i]) py_decref(items[i]);
+            }
+        }
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        PyObject* key = items[2 * i];
+        PyObject* value = items[2 * i + 1];
+        if (!key)
+        {
+            fprintf(stderr, "TypeError: unhashable type: 'NoneType'\n");
+            if (steal && value) py_decref(value);
+            continue;
+        }
+        py_dict_insert_presized(dict, key, value, steal);
+    }
+    return (PyObject*)dict;
+}
+
+// 副本借用 src 的条目表 (src 本身是副本时借用同一张表)。副本的 base 总是根字典。
+PyObject* py_dict_clone(PyObject* obj)
 {
-    if (!list || llvmpy::getBaseTypeId(list->typeId) != llvmpy::PY_TYPE_LIST)
+    if (llvmpy::getBaseTypeId(py_get_safe_type_id(obj)) != llvmpy::PY_TYPE_DICT)
     {
-        return 0;  // 无效或不是列表
+        py_type_error(obj, llvmpy::PY_TYPE_DICT);
+        return NULL;
     }
+    PyDictObject* src = (PyDictObject*)obj;
+    PyDictObject* root = src->base ? (PyDictObject*)src->base : src;
 
-    PyListObject* listObj = (PyListObject*)list;
-
-    // 如果列表声明了元素类型，直接返回
-    if (listObj->elemTypeId > 0)
+    PyDictObject* dict = (PyDictObject*)py_gc_malloc(sizeof(PyDictObject));
+    if (!dict)
     {
-        return listObj->elemTypeId;
+        fprintf(stderr, "Error: Out of memory for dictionary\n");
+        return NULL;
     }
 
-    // 尝试从第一个元素推断类型
-    if (listObj->length > 0 && listObj->data[0])
+    dict->header.refCount = 1;
+    dict->header.typeId = src->header.typeId;
+    dict->header.flags = 0;
+    dict->size = src->size;
+    dict->capacity = src->capacity;
+    dict->keyTypeId = src->keyTypeId;
+    dict->version = 0;
+    dict->entries = src->entries;
+    dict->base = (PyObject*)root;
+    dict->exports = 0;
+    dict->retired = NULL;
+    py_incref((PyObject*)root);
+
+    if (root->entries == dict->entries)
     {
-        return listObj->data[0]->typeId;
+        root->exports++;
     }
-
-    return 0;  // 未知元素类型
+    else
+    {
+        // 从借用旧条目表的副本再复制
+        for (PyDictRetiredTable_t* retired = root->retired; retired; retired = retired->next)
+        {
+            if (retired->entries == dict->entries)
+            {
+                retired->exports++;
+                break;
+            }
+        }
+    }
+    PY_MEMSTATS_OBJECT_ALLOC(dict);
+    py_gc_track((PyObject*)dict);
+    return (PyObject*)dict;
 }
 
-//===----------------------------------------------------------------------===//
-// 字典操作函数
-//===----------------------------------------------------------------------===//
-
-// 获取字典大小
-int py_dict_len(PyObject* obj)
+// 获取字典项
+PyObject* py_dict_get_item(PyObject* obj, PyObject* key)
 {
+#ifdef DEBUG_RUNTIME_CONTAINER
+    fprintf(stderr, "DEBUG: py_dict_get_item called for dict %p, key %p.\n", (void*)obj, (void*)key);
+#endif
     if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
     {
         py_type_error(obj, llvmpy::PY_TYPE_DICT);
-        return 0;
+        return NULL;  // Indicate error
+    }
+
+    if (!key)
+    {
+        // Python raises KeyError for None key lookup
+        fprintf(stderr, "KeyError: None\n");  // Match Python's KeyError message for None
+        return NULL;                          // Indicate error
     }
 
     PyDictObject* dict = (PyDictObject*)obj;
-    return dict->size;
+
+    // 查找条目
+    PyDictEntry* entry = py_dict_find_entry(dict, key);
+
+    // Check if entry was found AND is used AND key matches (find_entry guarantees match if entry->used)
+    if (entry && entry->used && entry->key)
+    {
+        // Found the key, return value (without incref - caller should incref if needed)
+        PyObject* value = entry->value;
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_dict_get_item: Key found. Returning value %p.\n", (void*)value);
+#endif
+        // NOTE: CPython's PyDict_GetItem does NOT incref the result.
+        // Let's follow that convention. The caller (e.g., index handler) must incref.
+        // if (value) py_incref(value); // NO INCREF HERE
+        return value;  // Return value (can be NULL if None was stored)
+    }
+    else
+    {
+        // Key not found
+        // CPython's PyDict_GetItem returns NULL if key not found (without setting error).
+        // Operations like `dict[key]` check for NULL and raise KeyError.
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_dict_get_item: Key not found.\n");
+#endif
+        // Set KeyError? No, follow PyDict_GetItem convention.
+        // fprintf(stderr, "KeyError: Key not found in dictionary\n"); // Don't print error here
+        return NULL;  // Indicate key not found
+    }
 }
 
-// 哈希函数
-unsigned int py_hash_object(PyObject* obj)
+// 获取字典值并返回其类型ID - 用于索引操作
+PyObject* py_dict_get_item_with_type(PyObject* dictObj, PyObject* key, int* out_type_id)
 {
-    if (!obj)
-    {
 #ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_hash_object called with NULL object, returning 0.\n");
+    fprintf(stderr, "DEBUG: py_dict_get_item_with_type called for dict %p, key %p.\n", (void*)dictObj, (void*)key);
 #endif
-        return 0;  // Hash of NULL pointer
+    // Default type ID to NONE in case of early exit
+    if (out_type_id) *out_type_id = llvmpy::PY_TYPE_NONE;
+
+    if (!dictObj || !key || !out_type_id)
+    {
+        fprintf(stderr, "RuntimeError: Invalid arguments to py_dict_get_item_with_type (dict=%p, key=%p, out_type_id=%p)\n", (void*)dictObj, (void*)key, (void*)out_type_id);
+        return NULL;  // Indicate error
     }
 
-    // Handle None explicitly? CPython hashes None to a constant.
-    if (py_get_safe_type_id(obj) == llvmpy::PY_TYPE_NONE)
+    // 确保是字典类型
+    if (!py_check_type(dictObj, llvmpy::PY_TYPE_DICT))
     {
-        // Return a constant hash for None, e.g., 0 or a specific value
-        return 0;  // Or some other constant like 1234567
+        py_type_error(dictObj, llvmpy::PY_TYPE_DICT);
+        return NULL;  // Indicate error
     }
 
-    int typeId = py_get_safe_type_id(obj);
-    const PyTypeMethods* methods = py_get_type_methods(typeId);
+    PyDictObject* dict = (PyDictObject*)dictObj;
 
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_hash_object: Hashing object %p, typeId %d (%s), methods=%p\n", (void*)obj, typeId, py_type_name(typeId), (void*)methods);
-#endif
+    // 查找条目
+    PyDictEntry* entry = py_dict_find_entry(dict, key);
 
-    if (methods && methods->hash)
+    // Check if entry was found AND is used AND key matches
+    if (entry && entry->used && entry->key)
     {
-        // 调用类型特定的哈希函数 (already GMP-aware if implemented correctly)
-        unsigned int hash_val = methods->hash(obj);
+        PyObject* value = entry->value;
+        if (value)
+        {
+            *out_type_id = value->typeId;
+            py_incref(value);  // Incref the returned value
 #ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_hash_object: Got hash %u from type-specific method.\n", hash_val);
+            fprintf(stderr, "DEBUG: py_dict_get_item_with_type: Found key. Returning value %p (type %d), incref'd.\n", (void*)value, *out_type_id);
 #endif
-        return hash_val;
+            return value;
+        }
+        else
+        {
+            // Value is None (stored as NULL)
+            *out_type_id = llvmpy::PY_TYPE_NONE;
+            PyObject* none_obj = py_get_none();
+            py_incref(none_obj);  // Incref None
+#ifdef DEBUG_RUNTIME_CONTAINER
+            fprintf(stderr, "DEBUG: py_dict_get_item_with_type: Found key. Value is None. Returning None (%p), incref'd.\n", (void*)none_obj);
+#endif
+            return none_obj;
+        }
     }
     else
     {
-        // 处理不可哈希类型
-        int baseTypeId = llvmpy::getBaseTypeId(typeId);
-        // Check known unhashable types explicitly
-        if (baseTypeId == llvmpy::PY_TYPE_LIST || baseTypeId == llvmpy::PY_TYPE_DICT /* || add other known unhashable types */)
+        // Key not found
+#ifdef DEBUG_RUNTIME_CONTAINER
+        fprintf(stderr, "DEBUG: py_dict_get_item_with_type: Key not found.\n");
+#endif
+        // Raise KeyError? No, return NULL like py_dict_get_item.
+        // fprintf(stderr, "KeyError: Key not found in dictionary\n");
+        return NULL;  // Indicate key not found
+    }
+}
+
+// 获取字典键
+PyObject* py_dict_keys(PyObject* obj)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_DICT);
+        return NULL;
+    }
+
+    PyDictObject* dict = (PyDictObject*)obj;
+
+    // 创建列表存储键
+    PyObject* keysList = py_create_list(dict->size, dict->keyTypeId);
+    if (!keysList) return NULL;
+
+    // 收集所有键
+    for (int i = 0; i < dict->capacity; i++)
+    {
+        if (dict->entries[i].used && dict->entries[i].key)
         {
-            fprintf(stderr, "TypeError: unhashable type: '%s'\n", py_type_name(typeId));
-            // How to signal error? Raise exception? Return specific value?
-            // For now, return 0 and rely on caller to handle potential collisions.
-            // Ideally, set an error flag/exception.
-            return 0;  // Problematic: 0 can be a valid hash
+            // 将键添加到列表中
+            py_list_append(keysList, dict->entries[i].key);
         }
+    }
 
-        // Fallback: Use address? (Generally bad for value types)
-        // CPython raises TypeError for instances of classes without __hash__
-        fprintf(stderr, "TypeError: unhashable type: '%s' (no hash method found)\n", py_type_name(typeId));
-        // Raise exception or return error indicator needed here.
-        return 0;  // Problematic
+    return keysList;
+}
+
+// 创建字典迭代器 (keys/values/items)，迭代器持有字典的引用
+PyObject* py_dict_iter(PyObject* obj, int kind)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_DICT);
+        return NULL;
+    }
+
+    PyDictIteratorObject* iter = (PyDictIteratorObject*)py_mem_alloc(sizeof(PyDictIteratorObject));
+    if (!iter)
+    {
+        fprintf(stderr, "MemoryError: failed to allocate dict iterator\n");
+        return NULL;
     }
+    iter->header.refCount = 1;
+    iter->header.typeId = llvmpy::PY_TYPE_DICT_ITERATOR;
+    iter->header.flags = 0;
+    iter->iterable = obj;
+    py_incref(obj);
+    iter->current_slot = 0;
+    iter->version = ((PyDictObject*)obj)->version;
+    iter->kind = kind;
+    PY_MEMSTATS_OBJECT_ALLOC(iter);
+    return (PyObject*)iter;
 }
 
-// 查找字典项
-PyDictEntry* py_dict_find_entry(PyDictObject* dict, PyObject* key)
+//===----------------------------------------------------------------------===//
+// 集合操作函数
+//===----------------------------------------------------------------------===//
+
+// 按新容量重建哈希表: 直接搬移 key 和已缓存的哈希值 (不重新哈希、不改动引用计数)，同时清除墓碑
+static bool py_set_rebuild(PySetObject* set, int newCapacity)
 {
-    if (!dict || !key) return NULL;
+    PySetEntry* newEntries = (PySetEntry*)py_mem_calloc(newCapacity, sizeof(PySetEntry));
+    if (!newEntries)
+    {
+        fprintf(stderr, "MemoryError: Failed to allocate set table (capacity %d)\n", newCapacity);
+        return false;
+    }
 
-    unsigned int hash = py_hash_object(key);
-    // TODO: Handle error from py_hash_object if it indicates unhashable type
+    for (int i = 0; i < set->capacity; i++)
+    {
+        PySetEntry* oldEntry = &set->entries[i];
+        if (!oldEntry->key) continue;
 
-    unsigned int index = hash % dict->capacity;
-    int probes = 0;  // To detect full table loop
+        // 表中的 key 互不相等，只需找到空槽
+        unsigned int index = oldEntry->hash % (unsigned int)newCapacity;
+        while (newEntries[index].used)
+        {
+            index = (index + 1) % newCapacity;
+        }
+        newEntries[index] = *oldEntry;
+    }
 
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_dict_find_entry: Looking for key %p (hash %u) starting at index %u in dict %p (cap %d)\n", (void*)key, hash, index, (void*)dict, dict->capacity);
-#endif
+    py_mem_free(set->entries);
+    set->entries = newEntries;
+    set->capacity = newCapacity;
+    set->fill = set->size;
+    return true;
+}
+
+// 插入一个已知不在表中的 key (来自另一个集合的元素)，跳过相等比较。调用者保证容量足够。
+static void py_set_insert_clean(PySetObject* set, PyObject* key, unsigned int hash)
+{
+    unsigned int index = hash % (unsigned int)set->capacity;
+    while (set->entries[index].used)
+    {
+        index = (index + 1) % set->capacity;
+    }
+    PySetEntry* entry = &set->entries[index];
+    entry->key = key;
+    entry->hash = hash;
+    entry->used = true;
+    py_incref(key);
+    set->size++;
+    set->fill++;
+}
+
+// 插入哈希值已知的 key，返回 true 表示新插入，false 表示已存在 (或分配失败)
+static bool py_set_insert_hashed(PySetObject* set, PyObject* key, unsigned int hash)
+{
+    if ((set->fill + 1) * 4 >= set->capacity * 3)
+    {
+        // 墓碑较多时容量不变，只是清理
+        if (!py_set_rebuild(set, py_set_capacity_for(set->size + 1))) return false;
+    }
+
+    PySetEntry* entry = py_hash_probe(set->entries, set->capacity, key, hash);
+    if (!entry)
+    {
+        fprintf(stderr, "InternalError: Set probe failed unexpectedly (table full?). Set %p, cap %d, fill %d\n", (void*)set, set->capacity, set->fill);
+        return false;
+    }
+    if (entry->used)
+    {
+        return false;  // 已存在
+    }
+
+    entry->key = key;
+    entry->hash = hash;
+    entry->used = true;
+    py_incref(key);
+    set->size++;
+    set->fill++;
+    return true;
+}
+
+int py_set_len(PyObject* obj)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_SET))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_SET);
+        return 0;
+    }
+    return ((PySetObject*)obj)->size;
+}
+
+// 添加元素，返回 true 表示集合发生了变化
+bool py_set_add(PyObject* obj, PyObject* key)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_SET))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_SET);
+        return false;
+    }
+    if (!key) return false;
+    return py_set_insert_hashed((PySetObject*)obj, key, py_hash_object(key));
+}
+
+// 删除元素 (不存在时不报错)，返回 true 表示确实删除了元素。槽位留作墓碑以保持探测链完整。
+bool py_set_discard(PyObject* obj, PyObject* key)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_SET))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_SET);
+        return false;
+    }
+    if (!key) return false;
+
+    PySetObject* set = (PySetObject*)obj;
+    PySetEntry* entry = py_hash_probe(set->entries, set->capacity, key, py_hash_object(key));
+    if (!entry || !entry->key)
+    {
+        return false;
+    }
+    PyObject* oldKey = entry->key;
+    entry->key = NULL;  // used 保持为 true
+    set->size--;
+    py_decref(oldKey);
+    return true;
+}
+
+bool py_set_contains(PyObject* obj, PyObject* key)
+{
+    if (!py_check_type(obj, llvmpy::PY_TYPE_SET))
+    {
+        py_type_error(obj, llvmpy::PY_TYPE_SET);
+        return false;
+    }
+    if (!key) return false;
+
+    PySetObject* set = (PySetObject*)obj;
+    PySetEntry* entry = py_hash_probe(set->entries, set->capacity, key, py_hash_object(key));
+    return entry && entry->key;
+}
 
-    // 线性探测
-    while (probes < dict->capacity)
+// 由任意可迭代对象构造集合 (iterable 为 NULL 时返回空集合)。长度已知时一次性预分配哈希表。
+PyObject* py_set_from_iterable(PyObject* iterable)
+{
+    if (!iterable)
     {
-        unsigned int current_idx = (index + probes) % dict->capacity;
-        PyDictEntry* entry = &dict->entries[current_idx];
+        return py_create_set(0);
+    }
 
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_find_entry: Probing index %u (used=%d)\n", current_idx, entry->used);
-#endif
+    int typeId = llvmpy::getBaseTypeId(py_get_safe_type_id(iterable));
+    if (typeId == llvmpy::PY_TYPE_SET)
+    {
+        return py_object_copy(iterable, llvmpy::PY_TYPE_SET);
+    }
 
-        if (!entry->used)
+    int sizeHint = 0;
+    if (typeId == llvmpy::PY_TYPE_LIST || typeId == llvmpy::PY_TYPE_TUPLE || typeId == llvmpy::PY_TYPE_DICT)
+    {
+        sizeHint = py_object_len(iterable);
+    }
+    PyObject* result = py_create_set(sizeHint);
+    if (!result) return NULL;
+    PySetObject* set = (PySetObject*)result;
+
+    if (typeId == llvmpy::PY_TYPE_TUPLE)
+    {
+        PyTupleObject* tuple = (PyTupleObject*)iterable;
+        for (int i = 0; i < tuple->length; i++)
         {
-            // Found an empty slot, key is not present. Return this slot for potential insertion.
-#ifdef DEBUG_RUNTIME_CONTAINER
-            fprintf(stderr, "DEBUG: py_dict_find_entry: Found empty slot at index %u. Key not present.\n", current_idx);
-#endif
-            return entry;  // Return the empty slot
+            py_set_insert_hashed(set, tuple->items[i], py_hash_object(tuple->items[i]));
         }
-
-        // Check if hash matches AND keys are equal
-        if (entry->hash == hash && entry->key)
+        return result;
+    }
+    if (typeId == llvmpy::PY_TYPE_DICT)
+    {
+        // 字典条目已带哈希值，迭代字典即迭代键
+        PyDictObject* dict = (PyDictObject*)iterable;
+        for (int i = 0; i < dict->capacity; i++)
         {
-#ifdef DEBUG_RUNTIME_CONTAINER
-            fprintf(stderr, "DEBUG: py_dict_find_entry: Hash matches at index %u. Comparing keys (%p vs %p).\n", current_idx, (void*)key, (void*)entry->key);
-#endif
-            // Compare keys using GMP-aware comparison
-            PyObject* cmpResultObj = py_object_compare(key, entry->key, PY_CMP_EQ);
-            bool isEqual = false;
-            if (cmpResultObj)
-            {
-                if (py_get_safe_type_id(cmpResultObj) == llvmpy::PY_TYPE_BOOL)
-                {
-                    isEqual = py_extract_bool(cmpResultObj);
-                }
-                else
-                {
-                    fprintf(stderr, "Warning: Equality comparison returned non-boolean type '%s'\n", py_type_name(py_get_safe_type_id(cmpResultObj)));
-                    // Treat non-bool result as not equal? Or error?
-                }
-                py_decref(cmpResultObj);
-            }
-            else
+            PyDictEntry* entry = &dict->entries[i];
+            if (entry->used && entry->key)
             {
-                // py_object_compare failed (e.g., TypeError)
-                fprintf(stderr, "Warning: Key comparison failed during dictionary lookup.\n");
-                // Treat as not equal? Or propagate error?
+                py_set_insert_hashed(set, entry->key, (unsigned int)entry->hash);
             }
+        }
+        return result;
+    }
+
+    PyObject* iter = py_iter(iterable);
+    if (!iter)
+    {
+        py_decref(result);
+        return NULL;
+    }
+    PyObject* item;
+    while ((item = py_next(iter)) != NULL)
+    {
+        py_set_insert_hashed(set, item, py_hash_object(item));
+        py_decref(item);
+    }
+    py_decref(iter);
+    return result;
+}
+
+// 集合运算的另一侧可以是任意可迭代对象，非集合时先转换成临时集合 (返回新引用)
+static PySetObject* py_set_operand(PyObject* other, const char* opName)
+{
+    if (py_get_safe_type_id(other) == llvmpy::PY_TYPE_SET)
+    {
+        py_incref(other);
+        return (PySetObject*)other;
+    }
+    PyObject* converted = py_set_from_iterable(other);
+    if (!converted)
+    {
+        fprintf(stderr, "TypeError: set.%s() argument must be iterable\n", opName);
+    }
+    return (PySetObject*)converted;
+}
+
+// a | b: 结果按 |a| + |b| 预分配。a 的元素互不相等，直接写入空槽；b 的元素才需要查重。
+PyObject* py_set_union(PyObject* a, PyObject* b)
+{
+    if (!py_check_type(a, llvmpy::PY_TYPE_SET))
+    {
+        py_type_error(a, llvmpy::PY_TYPE_SET);
+        return NULL;
+    }
+    PySetObject* left = (PySetObject*)a;
+    PySetObject* right = py_set_operand(b, "union");
+    if (!right) return NULL;
 
-            if (isEqual)
+    PyObject* result = py_create_set(left->size + right->size);
+    if (result)
+    {
+        PySetObject* out = (PySetObject*)result;
+        for (int i = 0; i < left->capacity; i++)
+        {
+            if (left->entries[i].key)
             {
-#ifdef DEBUG_RUNTIME_CONTAINER
-                fprintf(stderr, "DEBUG: py_dict_find_entry: Keys match! Found entry at index %u.\n", current_idx);
-#endif
-                return entry;  // Found the key
+                py_set_insert_clean(out, left->entries[i].key, left->entries[i].hash);
             }
-#ifdef DEBUG_RUNTIME_CONTAINER
-            else
+        }
+        for (int i = 0; i < right->capacity; i++)
+        {
+            if (right->entries[i].key)
             {
-                fprintf(stderr, "DEBUG: py_dict_find_entry: Keys do not match at index %u.\n", current_idx);
+                py_set_insert_hashed(out, right->entries[i].key, right->entries[i].hash);
             }
-#endif
         }
-        probes++;
     }
-
-    // If we exit the loop, the table is full and the key wasn't found.
-    // This indicates a need to resize *before* calling find_entry for insertion,
-    // or an internal error if just searching.
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_dict_find_entry: Table full or key not found after %d probes.\n", probes);
-#endif
-    return NULL;  // Indicate key not found (or table full)
+    py_decref((PyObject*)right);
+    return result;
 }
 
-// 重新调整字典大小
-bool py_dict_resize(PyDictObject* dict)
+// a & b: 遍历较小的一侧、在较大的一侧查找，结果按较小一侧的大小预分配
+PyObject* py_set_intersection(PyObject* a, PyObject* b)
 {
-    if (!dict) return false;
-
-    int oldCapacity = dict->capacity;
-    PyDictEntry* oldEntries = dict->entries;
-
-    // 新容量为旧容量的两倍 (handle zero capacity)
-    int newCapacity = (oldCapacity == 0) ? 8 : oldCapacity * 2;
-    // Check for potential overflow
-    if (oldCapacity > 0 && newCapacity / 2 != oldCapacity)
+    if (!py_check_type(a, llvmpy::PY_TYPE_SET))
     {
-        fprintf(stderr, "MemoryError: Dictionary capacity overflow during resize.\n");
-        return false;  // Cannot resize further
+        py_type_error(a, llvmpy::PY_TYPE_SET);
+        return NULL;
     }
+    PySetObject* right = py_set_operand(b, "intersection");
+    if (!right) return NULL;
 
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_dict_resize: Resizing dict %p from %d to %d\n", (void*)dict, oldCapacity, newCapacity);
-#endif
-
-    // 分配新的条目数组 (use calloc for zero-initialization)
-    PyDictEntry* newEntries = (PyDictEntry*)calloc(newCapacity, sizeof(PyDictEntry));
-    if (!newEntries)
+    PySetObject* small = (PySetObject*)a;
+    PySetObject* large = right;
+    if (small->size > large->size)
     {
-        fprintf(stderr, "MemoryError: Failed to allocate memory for dictionary resize (capacity %d)\n", newCapacity);
-        return false;
+        small = right;
+        large = (PySetObject*)a;
     }
 
-    // Update dictionary structure BEFORE rehashing
-    dict->entries = newEntries;
-    dict->capacity = newCapacity;
-    dict->size = 0;  // Reset size, will be incremented during re-insertion
-
-    // 重新插入所有条目 from old table
-    for (int i = 0; i < oldCapacity; i++)
+    PyObject* result = py_create_set(small->size);
+    if (result)
     {
-        PyDictEntry* oldEntry = &oldEntries[i];
-        if (oldEntry->used && oldEntry->key /* && oldEntry->value - allow None value */)
+        PySetObject* out = (PySetObject*)result;
+        for (int i = 0; i < small->capacity; i++)
         {
-#ifdef DEBUG_RUNTIME_CONTAINER
-            fprintf(stderr, "DEBUG: py_dict_resize: Rehashing old entry %d (key %p, value %p)\n", i, (void*)oldEntry->key, (void*)oldEntry->value);
-#endif
-            // Re-insert into the *new* table. py_dict_set_item will handle hashing,
-            // finding slot in new table, and incref.
-            py_dict_set_item((PyObject*)dict, oldEntry->key, oldEntry->value);
-
-            // We need to decref the key and value from the *old* table now,
-            // as they are no longer referenced by the old table structure.
-            // py_dict_set_item already incref'd them for the new table.
-            py_decref(oldEntry->key);
-            if (oldEntry->value)
-            {  // Decref value only if it's not NULL
-                py_decref(oldEntry->value);
+            PySetEntry* entry = &small->entries[i];
+            if (!entry->key) continue;
+            PySetEntry* found = py_hash_probe(large->entries, large->capacity, entry->key, entry->hash);
+            if (found && found->key)
+            {
+                py_set_insert_clean(out, entry->key, entry->hash);
             }
         }
     }
-
-    // 释放旧条目数组
-    free(oldEntries);
-
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_dict_resize: Resize complete for dict %p. New size: %d\n", (void*)dict, dict->size);
-#endif
-    return true;
+    py_decref((PyObject*)right);
+    return result;
 }
 
-// 设置字典项
-void py_dict_set_item(PyObject* obj, PyObject* key, PyObject* value)
+// a - b: 结果最多 |a| 个元素，按 |a| 预分配
+PyObject* py_set_difference(PyObject* a, PyObject* b)
 {
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_dict_set_item called for dict %p, key %p, value %p.\n", (void*)obj, (void*)key, (void*)value);
-#endif
-    if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
+    if (!py_check_type(a, llvmpy::PY_TYPE_SET))
     {
-        py_type_error(obj, llvmpy::PY_TYPE_DICT);
-        return;
+        py_type_error(a, llvmpy::PY_TYPE_SET);
+        return NULL;
     }
+    PySetObject* left = (PySetObject*)a;
+    PySetObject* right = py_set_operand(b, "difference");
+    if (!right) return NULL;
 
-    if (!key)
+    PyObject* result = py_create_set(left->size);
+    if (result)
     {
-        // Python raises TypeError for None key, not KeyError
-        fprintf(stderr, "TypeError: unhashable type: 'NoneType'\n");
-        return;
+        PySetObject* out = (PySetObject*)result;
+        for (int i = 0; i < left->capacity; i++)
+        {
+            PySetEntry* entry = &left->entries[i];
+            if (!entry->key) continue;
+            PySetEntry* found = py_hash_probe(right->entries, right->capacity, entry->key, entry->hash);
+            if (!found || !found->key)
+            {
+                py_set_insert_clean(out, entry->key, entry->hash);
+            }
+        }
     }
+    py_decref((PyObject*)right);
+    return result;
+}
 
-    PyDictObject* dict = (PyDictObject*)obj;
-
-    // --- 类型兼容性检查 (Key) ---
-    // Hashability is checked later by py_hash_object.
-    // Check declared key type if specified.
-    if (dict->keyTypeId > 0 && dict->keyTypeId != llvmpy::PY_TYPE_ANY)
+// 集合相等: 元素个数相同且 self 的每个元素都在 other 中
+PyObject* py_set_equals(PyObject* self, PyObject* other)
+{
+    if (self == other)
     {
-        // Use py_are_types_compatible or a similar check if needed.
-        // For now, assume hashability check is sufficient.
-        // if (!py_are_types_compatible(py_get_safe_type_id(key), dict->keyTypeId)) {
-        //     fprintf(stderr, "TypeError: Cannot use type %s as dictionary key for dict with key type %s\n",
-        //             py_type_name(py_get_safe_type_id(key)), py_type_name(dict->keyTypeId));
-        //     return;
-        // }
+        return py_create_bool(true);
+    }
+    if (py_get_safe_type_id(other) != llvmpy::PY_TYPE_SET)
+    {
+        return py_create_bool(false);
     }
-    // --- Value type check? ---
-    // Python dicts don't enforce value types by default. Add if needed.
 
-    // 检查是否需要扩容 (Load factor check)
-    // Use > instead of >= for load factor < 1.0 (e.g., 0.75)
-    // Check before insertion attempt.
-    // Python resizes when dict is 2/3 full. Let's use ~0.75.
-    if (dict->size * 4 >= dict->capacity * 3 && dict->capacity > 0)  // Avoid division
+    PySetObject* a = (PySetObject*)self;
+    PySetObject* b = (PySetObject*)other;
+    if (a->size != b->size)
     {
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_set_item: Load factor exceeded (%d/%d). Resizing dict %p.\n", dict->size, dict->capacity, (void*)dict);
-#endif
-        if (!py_dict_resize(dict))
+        return py_create_bool(false);
+    }
+    for (int i = 0; i < a->capacity; i++)
+    {
+        PySetEntry* entry = &a->entries[i];
+        if (!entry->key) continue;
+        PySetEntry* found = py_hash_probe(b->entries, b->capacity, entry->key, entry->hash);
+        if (!found || !found->key)
         {
-            fprintf(stderr, "MemoryError: Failed to resize dictionary during setitem\n");
-            // If resize fails, we cannot insert.
-            return;
+            return py_create_bool(false);
         }
-        // After resize, capacity and entry pointers have changed.
     }
+    return py_create_bool(true);
+}
 
-    // 查找条目 (find entry returns existing entry or first empty slot)
-    PyDictEntry* entry = py_dict_find_entry(dict, key);
+//===----------------------------------------------------------------------===//
+// 容器比较 (列表 / 元组 / 字典的 == 与字典序 <、<= 等)
+//===----------------------------------------------------------------------===//
 
-    if (!entry)
+// 比较结果 cmp (<0 / 0 / >0) 是否满足 op
+static bool py_cmp_holds(int cmp, PyCompareOp op)
+{
+    switch (op)
     {
-        // This implies the table is full AND the key wasn't found,
-        // which shouldn't happen if resize logic is correct.
-        fprintf(stderr, "InternalError: Dictionary find failed unexpectedly during setitem (table full?). Dict %p, cap %d, size %d\n", (void*)dict, dict->capacity, dict->size);
-        return;
+        case PY_CMP_EQ: return cmp == 0;
+        case PY_CMP_NE: return cmp != 0;
+        case PY_CMP_LT: return cmp < 0;
+        case PY_CMP_LE: return cmp <= 0;
+        case PY_CMP_GT: return cmp > 0;
+        default: return cmp >= 0;
     }
+}
 
-    // Check if the entry found is already used (i.e., key exists)
-    if (entry->used && entry->key)
+// 列表或元组的只读访问: 元组与装箱列表直接读元素数组，非装箱列表按存储类型读取
+struct PySequenceRef
+{
+    PyObject** items;    // 装箱元素数组，非装箱列表为 NULL
+    PyListObject* list;  // 列表本身 (元组为 NULL)
+    int length;
+};
+
+static PySequenceRef py_sequence_ref(PyObject* obj)
+{
+    PySequenceRef ref;
+    if (llvmpy::getBaseTypeId(obj->typeId) == llvmpy::PY_TYPE_TUPLE)
     {
-        // Key found, update value
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_set_item: Key found at entry %p. Updating value.\n", (void*)entry);
-#endif
-        PyObject* old_value = entry->value;
+        PyTupleObject* tuple = (PyTupleObject*)obj;
+        ref.items = tuple->items;
+        ref.list = NULL;
+        ref.length = tuple->length;
+        return ref;
+    }
+    PyListObject* list = (PyListObject*)obj;
+    ref.items = list->storage == PY_LIST_STORAGE_BOXED ? list->data : NULL;
+    ref.list = list;
+    ref.length = list->length;
+    return ref;
+}
 
-        // Update value and handle ref counts
-        entry->value = value;
-        if (value) py_incref(value);
-        if (old_value) py_decref(old_value);
+// 读取第 i 个元素 (返回新引用，空槽为 None)
+static PyObject* py_sequence_ref_item(const PySequenceRef& ref, int i)
+{
+    if (!ref.items)
+    {
+        return py_list_box_item(ref.list, i);
     }
-    else
+    PyObject* item = ref.items[i] ? ref.items[i] : py_get_none();
+    py_incref(item);
+    return item;
+}
+
+// 两个同为非装箱存储 (且存储类型相同) 的列表
+static bool py_sequence_same_unboxed(const PySequenceRef& a, const PySequenceRef& b)
+{
+    return !a.items && !b.items && a.list && b.list && a.list->storage == b.list->storage;
+}
+
+// 前 n 个元素中第一个不相等的下标，全部相等时返回 n，出错返回 -1。
+// 同种非装箱存储直接比较原始数组 (整数 / 浮点用向量内核，位图按 64 位字异或)，不装箱任何元素。
+static int py_sequence_mismatch(const PySequenceRef& a, const PySequenceRef& b, int n)
+{
+    if (py_sequence_same_unboxed(a, b))
     {
-        // Key not found, insert new entry into the empty slot returned by find_entry
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_set_item: Key not found. Inserting new entry at %p.\n", (void*)entry);
-#endif
-        // Check if hash object failed earlier (if py_hash_object could signal error)
-        unsigned int hash = py_hash_object(key);  // Re-hash or store hash from find_entry if possible
-        // TODO: Handle hash error signal here
+        switch (a.list->storage)
+        {
+            case PY_LIST_STORAGE_INT64:
+                return py_simd_mismatch_i64(a.list->ints, b.list->ints, n);
+            case PY_LIST_STORAGE_DOUBLE:
+                return py_simd_mismatch_f64(a.list->doubles, b.list->doubles, n);
+            case PY_LIST_STORAGE_BOOL:
+                for (int w = 0; w * 64 < n; w++)
+                {
+                    uint64_t diff = a.list->bits[w] ^ b.list->bits[w];
+                    if (diff)
+                    {
+                        int i = w * 64 + __builtin_ctzll(diff);
+                        return i < n ? i : n;  // 长度之外的位不参与比较
+                    }
+                }
+                return n;
+            default:
+                break;
+        }
+    }
 
-        entry->key = key;
-        entry->value = value;
-        entry->hash = hash;  // Store hash
-        entry->used = true;
+    for (int i = 0; i < n; i++)
+    {
+        // 同一对象 (包括装箱列表之间共享的元素) 不必比较
+        if (a.items && b.items && a.items[i] == b.items[i]) continue;
 
-        // Incref the new key and value being stored
-        py_incref(key);
-        if (value) py_incref(value);
+        PyObject* x = py_sequence_ref_item(a, i);
+        PyObject* y = py_sequence_ref_item(b, i);
+        int eq = py_object_equal(x, y);
+        py_decref(x);
+        py_decref(y);
+        if (eq != 1)
+        {
+            return eq < 0 ? -1 : i;
+        }
+    }
+    return n;
+}
 
-        dict->size++;
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_set_item: New entry inserted. Dict %p size now %d.\n", (void*)dict, dict->size);
-#endif
+// 列表 / 元组相等: 1 / 0，出错返回 -1。长度不同直接返回 0。
+static int py_sequence_equal(PyObject* a, PyObject* b)
+{
+    if (a == b) return 1;
+    PySequenceRef ra = py_sequence_ref(a);
+    PySequenceRef rb = py_sequence_ref(b);
+    if (ra.length != rb.length) return 0;
+    int i = py_sequence_mismatch(ra, rb, ra.length);
+    return i < 0 ? -1 : i == ra.length;
+}
+
+// 字典相等: 大小相同且每个键在另一方中存在且值相等。1 / 0，出错返回 -1。
+static int py_dict_equal(PyObject* a, PyObject* b)
+{
+    if (a == b) return 1;
+    PyDictObject* x = (PyDictObject*)a;
+    PyDictObject* y = (PyDictObject*)b;
+    if (x->size != y->size) return 0;
+
+    for (int i = 0; i < x->capacity; i++)
+    {
+        PyDictEntry* entry = &x->entries[i];
+        if (!entry->used || !entry->key) continue;
+        // 条目中保存了哈希值，探测对方时不必重新计算
+        PyDictEntry* found = py_hash_probe(y->entries, y->capacity, entry->key, (unsigned int)entry->hash);
+        if (!found || !found->key)
+        {
+            return 0;
+        }
+        int eq = py_object_equal(entry->value, found->value);
+        if (eq != 1)
+        {
+            return eq;
+        }
     }
+    return 1;
 }
 
-// 获取字典项
-PyObject* py_dict_get_item(PyObject* obj, PyObject* key)
+// a == b 的 C 层判断 (1 / 0，出错返回 -1)。同类型的数值、字符串与容器直接比较，
+// 其余情况交给 py_object_compare_result，逐元素比较不会为每个元素分配 bool 结果。
+int py_object_equal(PyObject* a, PyObject* b)
 {
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_dict_get_item called for dict %p, key %p.\n", (void*)obj, (void*)key);
-#endif
-    if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
+    if (a == b) return 1;
+    if (!a || !b) return 0;
+
+    int aTypeId = llvmpy::getBaseTypeId(a->typeId);
+    int bTypeId = llvmpy::getBaseTypeId(b->typeId);
+    if (aTypeId == bTypeId)
+    {
+        switch (aTypeId)
+        {
+            case llvmpy::PY_TYPE_INT:
+                return mpz_cmp(py_extract_int(a), py_extract_int(b)) == 0;
+            case llvmpy::PY_TYPE_DOUBLE:
+                return mpf_cmp(py_extract_double(a), py_extract_double(b)) == 0;
+            case llvmpy::PY_TYPE_BOOL:
+                return py_extract_bool(a) == py_extract_bool(b);
+            case llvmpy::PY_TYPE_STRING:
+                return strcmp(py_extract_string(a), py_extract_string(b)) == 0;
+            case llvmpy::PY_TYPE_LIST:
+            case llvmpy::PY_TYPE_TUPLE:
+                return py_sequence_equal(a, b);
+            case llvmpy::PY_TYPE_DICT:
+                return py_dict_equal(a, b);
+            default:
+                break;
+        }
+    }
+
+    return py_object_compare_result(a, b, PY_CMP_EQ);
+}
+
+// 列表 / 元组按字典序比较: 找到第一个不相等的元素后只比较这一对，公共前缀都相等时比较长度。
+// 返回 1 / 0，出错返回 -1。
+int py_sequence_compare(PyObject* a, PyObject* b, PyCompareOp op)
+{
+    PySequenceRef ra = py_sequence_ref(a);
+    PySequenceRef rb = py_sequence_ref(b);
+
+    if (op == PY_CMP_EQ || op == PY_CMP_NE)
     {
-        py_type_error(obj, llvmpy::PY_TYPE_DICT);
-        return NULL;  // Indicate error
+        int eq = py_sequence_equal(a, b);
+        if (eq < 0) return -1;
+        return (eq == 1) == (op == PY_CMP_EQ);
+    }
+    if (a == b)
+    {
+        return py_cmp_holds(0, op);
     }
 
-    if (!key)
+    int n = ra.length < rb.length ? ra.length : rb.length;
+    int i = py_sequence_mismatch(ra, rb, n);
+    if (i < 0) return -1;
+    if (i == n)
     {
-        // Python raises KeyError for None key lookup
-        fprintf(stderr, "KeyError: None\n");  // Match Python's KeyError message for None
-        return NULL;                          // Indicate error
+        return py_cmp_holds((ra.length > rb.length) - (ra.length < rb.length), op);
     }
 
-    PyDictObject* dict = (PyDictObject*)obj;
+    if (py_sequence_same_unboxed(ra, rb))
+    {
+        int cmp;
+        switch (ra.list->storage)
+        {
+            case PY_LIST_STORAGE_INT64:
+                cmp = (ra.list->ints[i] > rb.list->ints[i]) - (ra.list->ints[i] < rb.list->ints[i]);
+                break;
+            case PY_LIST_STORAGE_DOUBLE:
+                cmp = (ra.list->doubles[i] > rb.list->doubles[i]) - (ra.list->doubles[i] < rb.list->doubles[i]);
+                break;
+            default:  // BOOL: 不相等的位中为 1 的一方更大
+                cmp = (int)((ra.list->bits[i >> 6] >> (i & 63)) & 1) * 2 - 1;
+                break;
+        }
+        return py_cmp_holds(cmp, op);
+    }
 
-    // 查找条目
-    PyDictEntry* entry = py_dict_find_entry(dict, key);
+    PyObject* x = py_sequence_ref_item(ra, i);
+    PyObject* y = py_sequence_ref_item(rb, i);
+    int result = py_object_compare_result(x, y, op);
+    py_decref(x);
+    py_decref(y);
+    return result;
+}
 
-    // Check if entry was found AND is used AND key matches (find_entry guarantees match if entry->used)
-    if (entry && entry->used && entry->key)
+// 同类型容器之间的比较 (由 py_object_compare 分派)。字典只支持 == / !=。返回 1 / 0，出错返回 -1。
+int py_container_compare(PyObject* a, PyObject* b, PyCompareOp op)
+{
+    if (llvmpy::getBaseTypeId(a->typeId) != llvmpy::PY_TYPE_DICT)
     {
-        // Found the key, return value (without incref - caller should incref if needed)
-        PyObject* value = entry->value;
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_get_item: Key found. Returning value %p.\n", (void*)value);
-#endif
-        // NOTE: CPython's PyDict_GetItem does NOT incref the result.
-        // Let's follow that convention. The caller (e.g., index handler) must incref.
-        // if (value) py_incref(value); // NO INCREF HERE
-        return value;  // Return value (can be NULL if None was stored)
+        return py_sequence_compare(a, b, op);
     }
-    else
+    if (op != PY_CMP_EQ && op != PY_CMP_NE)
     {
-        // Key not found
-        // CPython's PyDict_GetItem returns NULL if key not found (without setting error).
-        // Operations like `dict[key]` check for NULL and raise KeyError.
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_get_item: Key not found.\n");
-#endif
-        // Set KeyError? No, follow PyDict_GetItem convention.
-        // fprintf(stderr, "KeyError: Key not found in dictionary\n"); // Don't print error here
-        return NULL;  // Indicate key not found
+        fprintf(stderr, "TypeError: '%s' not supported between instances of 'dict' and 'dict'\n",
+                py_compare_op_name(op));
+        return -1;
     }
+    int eq = py_dict_equal(a, b);
+    if (eq < 0) return -1;
+    return (eq == 1) == (op == PY_CMP_EQ);
 }
 
-// 获取字典值并返回其类型ID - 用于索引操作
-PyObject* py_dict_get_item_with_type(PyObject* dictObj, PyObject* key, int* out_type_id)
+// 类型分派表中的 equals 槽位 (other 类型不同时不相等)
+PyObject* py_list_equals(PyObject* self, PyObject* other)
 {
-#ifdef DEBUG_RUNTIME_CONTAINER
-    fprintf(stderr, "DEBUG: py_dict_get_item_with_type called for dict %p, key %p.\n", (void*)dictObj, (void*)key);
-#endif
-    // Default type ID to NONE in case of early exit
-    if (out_type_id) *out_type_id = llvmpy::PY_TYPE_NONE;
-
-    if (!dictObj || !key || !out_type_id)
+    if (llvmpy::getBaseTypeId(py_get_safe_type_id(other)) != llvmpy::PY_TYPE_LIST)
     {
-        fprintf(stderr, "RuntimeError: Invalid arguments to py_dict_get_item_with_type (dict=%p, key=%p, out_type_id=%p)\n", (void*)dictObj, (void*)key, (void*)out_type_id);
-        return NULL;  // Indicate error
+        return py_create_bool(false);
     }
+    int eq = py_sequence_equal(self, other);
+    return eq < 0 ? NULL : py_create_bool(eq == 1);
+}
 
-    // 确保是字典类型
-    if (!py_check_type(dictObj, llvmpy::PY_TYPE_DICT))
+PyObject* py_dict_equals(PyObject* self, PyObject* other)
+{
+    if (llvmpy::getBaseTypeId(py_get_safe_type_id(other)) != llvmpy::PY_TYPE_DICT)
     {
-        py_type_error(dictObj, llvmpy::PY_TYPE_DICT);
-        return NULL;  // Indicate error
+        return py_create_bool(false);
     }
+    int eq = py_dict_equal(self, other);
+    return eq < 0 ? NULL : py_create_bool(eq == 1);
+}
 
-    PyDictObject* dict = (PyDictObject*)dictObj;
+//===----------------------------------------------------------------------===//
+// 成员测试 (in / not in)
+//===----------------------------------------------------------------------===//
 
-    // 查找条目
-    PyDictEntry* entry = py_dict_find_entry(dict, key);
+// item in container，返回 bool 对象 (出错时返回 NULL)。参数顺序与源码书写顺序一致，
+// not in 由代码生成在结果上再取反。集合和字典走哈希查找，序列逐个比较。
+PyObject* py_object_contains(PyObject* item, PyObject* container)
+{
+    if (!container)
+    {
+        fprintf(stderr, "TypeError: argument of type 'NoneType' is not iterable\n");
+        return NULL;
+    }
 
-    // Check if entry was found AND is used AND key matches
-    if (entry && entry->used && entry->key)
+    int typeId = llvmpy::getBaseTypeId(py_get_safe_type_id(container));
+    switch (typeId)
     {
-        PyObject* value = entry->value;
-        if (value)
+        case llvmpy::PY_TYPE_SET:
+            return py_create_bool(py_set_contains(container, item));
+
+        case llvmpy::PY_TYPE_DICT:
         {
-            *out_type_id = value->typeId;
-            py_incref(value);  // Incref the returned value
-#ifdef DEBUG_RUNTIME_CONTAINER
-            fprintf(stderr, "DEBUG: py_dict_get_item_with_type: Found key. Returning value %p (type %d), incref'd.\n", (void*)value, *out_type_id);
-#endif
-            return value;
+            PyDictEntry* entry = py_dict_find_entry((PyDictObject*)container, item);
+            return py_create_bool(entry && entry->used && entry->key);
         }
-        else
+
+        case llvmpy::PY_TYPE_STRING:
         {
-            // Value is None (stored as NULL)
-            *out_type_id = llvmpy::PY_TYPE_NONE;
-            PyObject* none_obj = py_get_none();
-            py_incref(none_obj);  // Incref None
-#ifdef DEBUG_RUNTIME_CONTAINER
-            fprintf(stderr, "DEBUG: py_dict_get_item_with_type: Found key. Value is None. Returning None (%p), incref'd.\n", (void*)none_obj);
-#endif
-            return none_obj;
+            if (py_get_safe_type_id(item) != llvmpy::PY_TYPE_STRING)
+            {
+                fprintf(stderr, "TypeError: 'in <string>' requires string as left operand, not %s\n",
+                        py_type_name(py_get_safe_type_id(item)));
+                return NULL;
+            }
+            const char* haystack = ((PyPrimitiveObject*)container)->value.stringValue;
+            const char* needle = ((PyPrimitiveObject*)item)->value.stringValue;
+            return py_create_bool(strstr(haystack ? haystack : "", needle ? needle : "") != NULL);
         }
-    }
-    else
-    {
-        // Key not found
-#ifdef DEBUG_RUNTIME_CONTAINER
-        fprintf(stderr, "DEBUG: py_dict_get_item_with_type: Key not found.\n");
-#endif
-        // Raise KeyError? No, return NULL like py_dict_get_item.
-        // fprintf(stderr, "KeyError: Key not found in dictionary\n");
-        return NULL;  // Indicate key not found
-    }
-}
-
-// 获取字典键
-PyObject* py_dict_keys(PyObject* obj)
-{
-    if (!py_check_type(obj, llvmpy::PY_TYPE_DICT))
-    {
-        py_type_error(obj, llvmpy::PY_TYPE_DICT);
-        return NULL;
-    }
 
-    PyDictObject* dict = (PyDictObject*)obj;
+        case llvmpy::PY_TYPE_TUPLE:
+        {
+            PyTupleObject* tuple = (PyTupleObject*)container;
+            for (int i = 0; i < tuple->length; i++)
+            {
+                if (tuple->items[i] == item || py_compare_eq(item, tuple->items[i]))
+                {
+                    return py_create_bool(true);
+                }
+            }
+            return py_create_bool(false);
+        }
 
-    // 创建列表存储键
-    PyObject* keysList = py_create_list(dict->size, dict->keyTypeId);
-    if (!keysList) return NULL;
+        case llvmpy::PY_TYPE_LIST:
+        {
+            PyListObject* list = (PyListObject*)container;
+            // 非装箱整数列表: 直接在 int64 数组上查找，不逐个装箱
+            if (list->storage == PY_LIST_STORAGE_INT64 && py_get_safe_type_id(item) == llvmpy::PY_TYPE_INT)
+            {
+                mpz_ptr value = py_extract_int(item);
+                if (!mpz_fits_slong_p(value))
+                {
+                    return py_create_bool(false);
+                }
+                int64_t needle = (int64_t)mpz_get_si(value);
+                for (int i = 0; i < list->length; i++)
+                {
+                    if (list->ints[i] == needle)
+                    {
+                        return py_create_bool(true);
+                    }
+                }
+                return py_create_bool(false);
+            }
+            for (int i = 0; i < list->length; i++)
+            {
+                PyObject* elem = py_list_box_item(list, i);
+                bool found = elem == item || py_compare_eq(item, elem);
+                py_decref(elem);
+                if (found)
+                {
+                    return py_create_bool(true);
+                }
+            }
+            return py_create_bool(false);
+        }
 
-    // 收集所有键
-    for (int i = 0; i < dict->capacity; i++)
-    {
-        if (dict->entries[i].used && dict->entries[i].key)
+        case llvmpy::PY_TYPE_RANGE:
         {
-            // 将键添加到列表中
-            py_list_append(keysList, dict->entries[i].key);
+            PyRangeObject* range = (PyRangeObject*)container;
+            int itemType = py_get_safe_type_id(item);
+            if (itemType == llvmpy::PY_TYPE_INT || itemType == llvmpy::PY_TYPE_BOOL)
+            {
+                // 整数直接按算术判断，不展开 range
+                int64_t value;
+                if (itemType == llvmpy::PY_TYPE_BOOL)
+                {
+                    value = py_extract_bool(item) ? 1 : 0;
+                }
+                else
+                {
+                    mpz_ptr z = py_extract_int(item);
+                    if (!mpz_fits_slong_p(z)) return py_create_bool(false);
+                    value = (int64_t)mpz_get_si(z);
+                }
+                bool inBounds = range->step > 0 ? (value >= range->start && value < range->stop)
+                                                : (value <= range->start && value > range->stop);
+                return py_create_bool(inBounds && (value - range->start) % range->step == 0);
+            }
+            break;  // 其他类型按迭代比较
         }
+
+        default:
+            break;
     }
 
-    return keysList;
+    // 通用路径: 迭代并逐个比较
+    PyObject* iter = py_iter(container);
+    if (!iter)
+    {
+        return NULL;
+    }
+    bool found = false;
+    PyObject* elem;
+    while (!found && (elem = py_next(iter)) != NULL)
+    {
+        found = elem == item || py_compare_eq(item, elem);
+        py_decref(elem);
+    }
+    py_decref(iter);
+    return py_create_bool(found);
 }
 
 //===----------------------------------------------------------------------===//
@@ -1231,25 +3189,14 @@ PyObject* py_object_index_with_type(PyObject* obj, PyObject* index, int* out_typ
                 return NULL;  // Return NULL on error
             }
 
-            PyObject* item = list->data[c_index];
+            // 获取元素 (新引用，空槽为 None)
+            PyObject* item = py_list_box_item(list, (int)c_index);
 
             // 确定结果类型
-            if (item)
-            {
-                *out_type_id = item->typeId;
-                // Optional: Refine type based on list->elemTypeId (logic seems complex/potentially reversed, keep simple for now)
-                // if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY) { ... }
-                py_incref(item);  // Incref the item being returned
-                return item;
-            }
-            else
-            {
-                // Item is NULL, return None (incref'd)
-                *out_type_id = llvmpy::PY_TYPE_NONE;
-                PyObject* none_obj = py_get_none();
-                py_incref(none_obj);
-                return none_obj;
-            }
+            // Optional: Refine type based on list->elemTypeId (logic seems complex/potentially reversed, keep simple for now)
+            // if (list->elemTypeId > 0 && list->elemTypeId != llvmpy::PY_TYPE_ANY) { ... }
+            *out_type_id = item->typeId;
+            return item;
         }
 
         case llvmpy::PY_TYPE_DICT:
@@ -1519,6 +3466,205 @@ PyObject* py_object_index(PyObject* obj, PyObject* index)
     }
 }
 
+//===----------------------------------------------------------------------===//
+// 切片 (obj[start:stop:step])
+//===----------------------------------------------------------------------===//
+
+// 读取一个切片边界。NULL 或 None 表示省略；超出 C long 范围的整数截断到极值
+static bool py_slice_bound(PyObject* obj, long* out, bool* present)
+{
+    *present = false;
+    if (!obj || py_get_safe_type_id(obj) == llvmpy::PY_TYPE_NONE) return true;
+
+    if (py_get_safe_type_id(obj) == llvmpy::PY_TYPE_BOOL)
+    {
+        *out = py_extract_bool(obj) ? 1 : 0;
+        *present = true;
+        return true;
+    }
+
+    mpz_ptr value = py_extract_int(obj);
+    if (!value)
+    {
+        fprintf(stderr, "TypeError: slice indices must be integers or None, not '%s'\n",
+                py_type_name(py_get_safe_type_id(obj)));
+        return false;
+    }
+    if (mpz_fits_slong_p(value))
+    {
+        *out = mpz_get_si(value);
+    }
+    else
+    {
+        *out = mpz_sgn(value) < 0 ? LONG_MIN / 2 : LONG_MAX / 2;
+    }
+    *present = true;
+    return true;
+}
+
+// 按 Python 语义把 start/stop/step 规范到长度为 length 的序列上，返回元素个数 (出错返回 -1)
+static long py_slice_resolve(PyObject* startObj, PyObject* stopObj, PyObject* stepObj,
+                             long length, long* start, long* step)
+{
+    long stop = 0;
+    bool hasStart, hasStop, hasStep;
+    *step = 1;
+    if (!py_slice_bound(startObj, start, &hasStart)) return -1;
+    if (!py_slice_bound(stopObj, &stop, &hasStop)) return -1;
+    if (!py_slice_bound(stepObj, step, &hasStep)) return -1;
+    if (!hasStep) *step = 1;
+    if (*step == 0)
+    {
+        fprintf(stderr, "ValueError: slice step cannot be zero\n");
+        return -1;
+    }
+
+    bool backward = *step < 0;
+    if (!hasStart) *start = backward ? length - 1 : 0;
+    if (!hasStop) stop = backward ? -1 : length;
+
+    if (hasStart)
+    {
+        if (*start < 0)
+        {
+            *start += length;
+            if (*start < 0) *start = backward ? -1 : 0;
+        }
+        else if (*start >= length)
+        {
+            *start = backward ? length - 1 : length;
+        }
+    }
+    if (hasStop)
+    {
+        if (stop < 0)
+        {
+            stop += length;
+            if (stop < 0) stop = backward ? -1 : 0;
+        }
+        else if (stop >= length)
+        {
+            stop = backward ? length - 1 : length;
+        }
+    }
+
+    if (backward)
+    {
+        return stop < *start ? (*start - stop - 1) / (-*step) + 1 : 0;
+    }
+    return *start < stop ? (stop - *start - 1) / *step + 1 : 0;
+}
+
+// 列表切片: 连续的非位图切片返回共享缓冲区的视图，其余情况复制
+static PyObject* py_list_slice(PyListObject* list, long start, long step, long count)
+{
+    if (step == 1 && count > 0 && list->storage != PY_LIST_STORAGE_BOOL)
+    {
+        return py_list_create_view(list, (int)start, (int)count);
+    }
+
+    PyObject* result = py_create_list((int)count, list->elemTypeId);
+    if (!result) return NULL;
+    for (long i = 0; i < count; i++)
+    {
+        PyObject* item = py_list_box_item(list, (int)(start + i * step));
+        bool ok = py_list_append(result, item) != NULL;
+        py_decref(item);
+        if (!ok)
+        {
+            py_decref(result);
+            return NULL;
+        }
+    }
+    return result;
+}
+
+// 字符串切片: 完整切片返回自身，后缀切片共享缓冲区 (字符串以 NUL 结尾，只有后缀可以零拷贝)
+static PyObject* py_string_slice(PyObject* strObj, long length, long start, long step, long count)
+{
+    const char* chars = ((PyPrimitiveObject*)strObj)->value.stringValue;
+    if (step == 1)
+    {
+        if (count == length)
+        {
+            py_incref(strObj);
+            return strObj;
+        }
+        if (count > 0 && start + count == length)
+        {
+            return py_create_string_view(strObj, (size_t)start);
+        }
+        return py_create_string_with_length(chars + start, (size_t)count);
+    }
+
+    char* buffer = (char*)py_mem_alloc((size_t)count + 1);
+    if (!buffer)
+    {
+        fprintf(stderr, "Error: Out of memory for string\n");
+        return NULL;
+    }
+    for (long i = 0; i < count; i++)
+    {
+        buffer[i] = chars[start + i * step];
+    }
+    PyObject* result = py_create_string_with_length(buffer, (size_t)count);
+    py_mem_free(buffer);
+    return result;
+}
+
+// 通用切片 (start/stop/step 可以为 NULL 表示省略，返回新引用)
+PyObject* py_object_slice(PyObject* obj, PyObject* start, PyObject* stop, PyObject* step)
+{
+    int typeId = py_get_safe_type_id(obj);
+    long length;
+    switch (typeId)
+    {
+        case llvmpy::PY_TYPE_LIST:
+            length = ((PyListObject*)obj)->length;
+            break;
+        case llvmpy::PY_TYPE_TUPLE:
+            length = ((PyTupleObject*)obj)->length;
+            break;
+        case llvmpy::PY_TYPE_STRING:
+        {
+            const char* chars = ((PyPrimitiveObject*)obj)->value.stringValue;
+            length = chars ? (long)strlen(chars) : 0;
+            break;
+        }
+        default:
+            fprintf(stderr, "TypeError: '%s' object is not subscriptable\n", py_type_name(typeId));
+            return NULL;
+    }
+
+    long first, stride;
+    long count = py_slice_resolve(start, stop, step, length, &first, &stride);
+    if (count < 0) return NULL;
+
+    if (typeId == llvmpy::PY_TYPE_LIST)
+    {
+        return py_list_slice((PyListObject*)obj, first, stride, count);
+    }
+    if (typeId == llvmpy::PY_TYPE_STRING)
+    {
+        return py_string_slice(obj, length, first, stride, count);
+    }
+
+    PyTupleObject* tuple = (PyTupleObject*)obj;
+    if (count == length && stride == 1)
+    {
+        py_incref(obj);
+        return obj;
+    }
+    PyObject* result = py_create_tuple((int)count);
+    if (!result) return NULL;
+    for (long i = 0; i < count; i++)
+    {
+        PyObject* item = tuple->items[first + i * stride];
+        py_tuple_set_item(result, (int)i, item ? item : py_get_none());
+    }
+    return result;
+}
+
 // 字符串字符访问
 PyObject* py_string_get_char(PyObject* strObj, PyObject* indexObj)
 {
@@ -13,6 +13,15 @@ void py_runtime_error(const char* error_key, int line_number) {
     if (strcmp(error_key, "TypeError_NotIterable") == 0) {
         error_type_name = "TypeError";
         snprintf(message_buffer, sizeof(message_buffer), "object is not iterable");
+    } else if (strcmp(error_key, "MemoryError_ListTooLarge") == 0) {
+        error_type_name = "MemoryError";
+        snprintf(message_buffer, sizeof(message_buffer), "list is too large");
+    } else if (strcmp(error_key, "RuntimeError_DictChangedSize") == 0) {
+        error_type_name = "RuntimeError";
+        snprintf(message_buffer, sizeof(message_buffer), "dictionary changed size during iteration");
+    } else if (strcmp(error_key, "ErrorAlreadyReported") == 0) {
+        // 失败的运行时调用 (如 py_range_unpack) 已打印具体的错误信息，这里只补充位置
+        error_type_name = NULL;
     } else if (strcmp(error_key, "StopIteration") == 0) {
         // py_next 返回 NULL 表示 StopIteration，通常不通过此函数报告
         // 但如果需要显式引发 StopIteration 异常，可以在此处理
@@ -26,10 +35,18 @@ void py_runtime_error(const char* error_key, int line_number) {
         // 实际应用中，文件名和模块名需要从调用栈或其他上下文中获取
         fprintf(stderr, "  File \"<unknown>\", line %d, in <module>\n", line_number);
     }
-    fprintf(stderr, "%s: %s\n", error_type_name, message_buffer);
+    if (error_type_name) {
+        fprintf(stderr, "%s: %s\n", error_type_name, message_buffer);
+    }
     
     // 注意：LLVM IR 在调用此函数后通常有 unreachable 指令。
     // 在一个完整的运行时中，这里可能会设置一个全局异常状态并通过 longjmp 返回到主事件循环，
     // 或者如果这是不可恢复的错误，则调用 exit()。
     // 对于当前链接错误，仅打印错误信息即可。
-}
\ No newline at end of file
+}
+
+// 不可恢复的错误: 报告后以状态 1 退出。生成的代码在调用之后紧跟 unreachable。
+void py_runtime_fatal_error(const char* error_key, int line_number) {
+    py_runtime_error(error_key, line_number);
+    exit(1);
+}
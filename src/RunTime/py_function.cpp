@@ -203,7 +203,7 @@ PyObject* py_create_function(void* func_ptr, int signature_type_id) // 新
         return NULL;
     }
 
-    PyFunctionObject* func_obj = (PyFunctionObject*)malloc(sizeof(PyFunctionObject));
+    PyFunctionObject* func_obj = (PyFunctionObject*)py_mem_alloc(sizeof(PyFunctionObject));
     if (!func_obj)
     {
         fprintf(stderr, "Runtime Error: Failed to allocate memory for function object.\n");
@@ -214,6 +214,7 @@ PyObject* py_create_function(void* func_ptr, int signature_type_id) // 新
     // 初始化对象头 (使用 PyObject 结构)
     func_obj->header.refCount = 1;                   // 新对象引用计数为 1
     func_obj->header.typeId = llvmpy::PY_TYPE_FUNC;  // 设置类型为函数
+    func_obj->header.flags = 0;
 
     // 设置函数特定字段
     func_obj->func_ptr = func_ptr;
@@ -222,6 +223,7 @@ PyObject* py_create_function(void* func_ptr, int signature_type_id) // 新
 
     // TODO: 初始化其他可能的字段 (如 __name__)
 
+    PY_MEMSTATS_OBJECT_ALLOC(func_obj);
     return (PyObject*)func_obj;  // 返回 PyObject* 指针
 }
 
@@ -0,0 +1,372 @@
+#include "RunTime/runtime.h"
+#include "TypeIDs.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace llvmpy;
+
+//===----------------------------------------------------------------------===//
+// GC 头与各代链表
+//===----------------------------------------------------------------------===//
+
+namespace
+{
+
+constexpr int kUntracked = -1;
+constexpr int kCollecting = -2;  // 本次收集的候选对象
+constexpr int kReachable = -3;   // 候选对象中确认从外部可达的
+
+struct GCState
+{
+    PyGCHead generations[PY_GC_GENERATIONS];  // 循环链表的哨兵
+    int thresholds[PY_GC_GENERATIONS] = {700, 10, 10};
+    int counts[PY_GC_GENERATIONS] = {0, 0, 0};  // 第 0 代: 跟踪数增量；其余: 更年轻一代的收集次数
+    bool collecting = false;
+
+    GCState()
+    {
+        for (PyGCHead& sentinel : generations)
+        {
+            sentinel.next = sentinel.prev = &sentinel;
+        }
+    }
+};
+
+GCState& gc()
+{
+    static GCState state;
+    return state;
+}
+
+inline PyGCHead* head_of(const PyObject* obj)
+{
+    return (PyGCHead*)obj - 1;
+}
+
+inline PyObject* object_of(PyGCHead* head)
+{
+    return (PyObject*)(head + 1);
+}
+
+void list_unlink(PyGCHead* head)
+{
+    head->prev->next = head->next;
+    head->next->prev = head->prev;
+    head->next = head->prev = head;
+}
+
+void list_append(PyGCHead* sentinel, PyGCHead* head)
+{
+    head->prev = sentinel->prev;
+    head->next = sentinel;
+    sentinel->prev->next = head;
+    sentinel->prev = head;
+}
+
+// 把 from 中的所有节点接到 to 的末尾，from 变为空
+void list_splice(PyGCHead* from, PyGCHead* to)
+{
+    if (from->next == from) return;
+    from->next->prev = to->prev;
+    to->prev->next = from->next;
+    from->prev->next = to;
+    to->prev = from->prev;
+    from->next = from->prev = from;
+}
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// 容器的遍历与清空
+//===----------------------------------------------------------------------===//
+
+static void py_gc_traverse(PyObject* obj, PyGCVisitProc visit, void* arg)
+{
+    switch (getBaseTypeId(obj->typeId))
+    {
+        case PY_TYPE_LIST:
+            py_list_traverse((PyListObject*)obj, visit, arg);
+            break;
+        case PY_TYPE_DICT:
+            py_dict_traverse((PyDictObject*)obj, visit, arg);
+            break;
+        case PY_TYPE_TUPLE:
+        {
+            PyTupleObject* tuple = (PyTupleObject*)obj;
+            for (int i = 0; i < tuple->length; i++)
+            {
+                if (tuple->items[i]) visit(tuple->items[i], arg);
+            }
+            break;
+        }
+        case PY_TYPE_SET:
+        {
+            PySetObject* set = (PySetObject*)obj;
+            for (int i = 0; i < set->capacity; i++)
+            {
+                if (set->entries[i].key) visit(set->entries[i].key, arg);
+            }
+            break;
+        }
+        case PY_TYPE_CLASS:
+        {
+            PyClassObject* cls = (PyClassObject*)obj;
+            if (cls->base) visit((PyObject*)cls->base, arg);
+            if (cls->class_dict) visit((PyObject*)cls->class_dict, arg);
+            break;
+        }
+        case PY_TYPE_INSTANCE:
+        {
+            PyInstanceObject* instance = (PyInstanceObject*)obj;
+            if (instance->cls) visit((PyObject*)instance->cls, arg);
+            if (instance->instance_dict) visit((PyObject*)instance->instance_dict, arg);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+// 释放对象持有的引用 (对象本身保持可以正常释放的状态)，用于打断不可达的环
+static void py_gc_clear(PyObject* obj)
+{
+    switch (getBaseTypeId(obj->typeId))
+    {
+        case PY_TYPE_LIST:
+            py_list_clear_refs((PyListObject*)obj);
+            break;
+        case PY_TYPE_DICT:
+            py_dict_clear_refs((PyDictObject*)obj);
+            break;
+        case PY_TYPE_TUPLE:
+        {
+            PyTupleObject* tuple = (PyTupleObject*)obj;
+            for (int i = 0; i < tuple->length; i++)
+            {
+                PyObject* item = tuple->items[i];
+                tuple->items[i] = NULL;
+                py_decref(item);
+            }
+            break;
+        }
+        case PY_TYPE_SET:
+        {
+            PySetObject* set = (PySetObject*)obj;
+            for (int i = 0; i < set->capacity; i++)
+            {
+                PyObject* key = set->entries[i].key;
+                set->entries[i].key = NULL;
+                py_decref(key);
+            }
+            set->size = 0;
+            break;
+        }
+        case PY_TYPE_CLASS:
+        {
+            PyClassObject* cls = (PyClassObject*)obj;
+            PyObject* base = (PyObject*)cls->base;
+            PyObject* classDict = (PyObject*)cls->class_dict;
+            cls->base = NULL;
+            cls->class_dict = NULL;
+            py_decref(base);
+            py_decref(classDict);
+            break;
+        }
+        case PY_TYPE_INSTANCE:
+        {
+            PyInstanceObject* instance = (PyInstanceObject*)obj;
+            PyObject* cls = (PyObject*)instance->cls;
+            PyObject* instanceDict = (PyObject*)instance->instance_dict;
+            instance->cls = NULL;
+            instance->instance_dict = NULL;
+            py_decref(cls);
+            py_decref(instanceDict);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// 分配与跟踪
+//===----------------------------------------------------------------------===//
+
+void* py_gc_malloc(size_t size)
+{
+    PyGCHead* head = (PyGCHead*)py_mem_alloc(sizeof(PyGCHead) + size);
+    if (!head) return NULL;
+    head->next = head->prev = head;
+    head->gcRefs = 0;
+    head->generation = kUntracked;
+    return head + 1;
+}
+
+void py_gc_free(PyObject* obj)
+{
+    if (!obj) return;
+    py_gc_untrack(obj);
+    py_mem_free(head_of(obj));
+}
+
+void py_gc_track(PyObject* obj)
+{
+    PyGCHead* head = head_of(obj);
+    if (head->generation != kUntracked) return;
+
+    GCState& state = gc();
+    head->generation = 0;
+    obj->flags |= PY_OBJECT_FLAG_GC_TRACKED;
+    list_append(&state.generations[0], head);
+
+    if (++state.counts[0] > state.thresholds[0] && state.thresholds[0] > 0 && !state.collecting)
+    {
+        // 最老的一代: 其上一代的收集次数超过阈值的最老一代
+        int generation = 0;
+        for (int g = PY_GC_GENERATIONS - 1; g > 0; g--)
+        {
+            if (state.counts[g] > state.thresholds[g])
+            {
+                generation = g;
+                break;
+            }
+        }
+        py_gc_collect(generation);
+    }
+}
+
+void py_gc_untrack(PyObject* obj)
+{
+    PyGCHead* head = head_of(obj);
+    if (head->generation == kUntracked) return;
+
+    GCState& state = gc();
+    if (head->generation == 0 && state.counts[0] > 0) state.counts[0]--;
+    list_unlink(head);
+    head->generation = kUntracked;
+    obj->flags &= ~PY_OBJECT_FLAG_GC_TRACKED;
+}
+
+bool py_gc_is_tracked(const PyObject* obj)
+{
+    return obj && (obj->flags & PY_OBJECT_FLAG_GC_TRACKED);
+}
+
+void py_gc_set_threshold(int threshold0, int threshold1, int threshold2)
+{
+    GCState& state = gc();
+    state.thresholds[0] = threshold0 > 0 ? threshold0 : 0;
+    state.thresholds[1] = threshold1 > 0 ? threshold1 : 1;
+    state.thresholds[2] = threshold2 > 0 ? threshold2 : 1;
+}
+
+//===----------------------------------------------------------------------===//
+// 收集
+//===----------------------------------------------------------------------===//
+
+// 不是本次候选对象的子对象 (标量、未跟踪或更老一代的容器) 直接忽略
+static bool py_gc_is_candidate(PyObject* obj, int state)
+{
+    int baseTypeId = getBaseTypeId(obj->typeId);
+    switch (baseTypeId)
+    {
+        case PY_TYPE_LIST:
+        case PY_TYPE_DICT:
+        case PY_TYPE_TUPLE:
+        case PY_TYPE_SET:
+        case PY_TYPE_CLASS:
+        case PY_TYPE_INSTANCE:
+            return head_of(obj)->generation == state;
+        default:
+            return false;
+    }
+}
+
+static void py_gc_subtract_ref(PyObject* child, void*)
+{
+    if (py_gc_is_candidate(child, kCollecting)) head_of(child)->gcRefs--;
+}
+
+static void py_gc_mark_reachable(PyObject* child, void* reachable)
+{
+    if (!py_gc_is_candidate(child, kCollecting)) return;
+    PyGCHead* head = head_of(child);
+    head->generation = kReachable;
+    list_unlink(head);
+    list_append((PyGCHead*)reachable, head);
+}
+
+int py_gc_collect(int generation)
+{
+    GCState& state = gc();
+    if (state.collecting) return 0;
+    if (generation < 0 || generation >= PY_GC_GENERATIONS) generation = PY_GC_GENERATIONS - 1;
+    state.collecting = true;
+
+    PyGCHead young;
+    young.next = young.prev = &young;
+    for (int g = 0; g <= generation; g++)
+    {
+        list_splice(&state.generations[g], &young);
+    }
+
+    // 1. gcRefs = 引用计数 - 来自候选对象的引用；结果大于 0 说明还有外部引用
+    for (PyGCHead* head = young.next; head != &young; head = head->next)
+    {
+        head->generation = kCollecting;
+        head->gcRefs = object_of(head)->refCount;
+    }
+    for (PyGCHead* head = young.next; head != &young; head = head->next)
+    {
+        py_gc_traverse(object_of(head), py_gc_subtract_ref, NULL);
+    }
+
+    // 2. 从有外部引用的对象出发标记可达对象 (追加到 reachable 末尾的对象也会被继续遍历)
+    PyGCHead reachable;
+    reachable.next = reachable.prev = &reachable;
+    for (PyGCHead* head = young.next; head != &young;)
+    {
+        PyGCHead* next = head->next;
+        if (head->gcRefs > 0)
+        {
+            head->generation = kReachable;
+            list_unlink(head);
+            list_append(&reachable, head);
+        }
+        head = next;
+    }
+    for (PyGCHead* head = reachable.next; head != &reachable; head = head->next)
+    {
+        py_gc_traverse(object_of(head), py_gc_mark_reachable, &reachable);
+    }
+
+    // 3. 存活对象升入下一代
+    int survivorGeneration = generation + 1 < PY_GC_GENERATIONS ? generation + 1 : generation;
+    for (PyGCHead* head = reachable.next; head != &reachable; head = head->next)
+    {
+        head->generation = survivorGeneration;
+    }
+    list_splice(&reachable, &state.generations[survivorGeneration]);
+
+    // 4. 剩下的是只被彼此引用的垃圾: 先全部持有一个引用，清空后再释放
+    std::vector<PyObject*> garbage;
+    for (PyGCHead* head = young.next; head != &young; head = head->next)
+    {
+        head->generation = survivorGeneration;
+        garbage.push_back(object_of(head));
+    }
+    list_splice(&young, &state.generations[survivorGeneration]);
+
+    for (PyObject* obj : garbage) py_incref(obj);
+    for (PyObject* obj : garbage) py_gc_clear(obj);
+    for (PyObject* obj : garbage) py_decref(obj);
+
+    for (int g = 0; g <= generation; g++)
+    {
+        state.counts[g] = 0;
+    }
+    if (generation + 1 < PY_GC_GENERATIONS) state.counts[generation + 1]++;
+    state.collecting = false;
+    return (int)garbage.size();
+}
@@ -70,7 +70,9 @@ void py_print_object(PyObject* obj)
             for (int i = 0; i < list->length; i++)
             {
                 if (i > 0) printf(", ");
-                py_print_object_inline(list->data[i]); // 递归调用内联打印
+                PyObject* item = py_list_box_item(list, i);
+                py_print_object_inline(item); // 递归调用内联打印
+                py_decref(item);
             }
             printf("]\n");
             break;
@@ -109,6 +111,13 @@ void py_print_object(PyObject* obj)
         case llvmpy::PY_TYPE_CLASS:
              printf("<class '%s'>\n", ((PyClassObject*)obj)->name ? ((PyClassObject*)obj)->name : "unknown");
              break;
+
+        case llvmpy::PY_TYPE_RANGE:
+        case llvmpy::PY_TYPE_TUPLE:
+        case llvmpy::PY_TYPE_SET:
+            py_print_object_inline(obj);
+            printf("\n");
+            break;
         // case llvmpy::PY_TYPE_INSTANCE: // 实例的打印通常调用 __repr__ 或 __str__
 
         default:
@@ -121,7 +130,9 @@ void py_print_object(PyObject* obj)
                 for (int i = 0; i < list->length; i++)
                 {
                     if (i > 0) printf(", ");
-                    py_print_object_inline(list->data[i]);
+                    PyObject* item = py_list_box_item(list, i);
+                    py_print_object_inline(item);
+                    py_decref(item);
                 }
                 printf("]\n");
             }
@@ -212,7 +223,9 @@ static void py_print_object_inline(PyObject* obj)
             for (int i = 0; i < list->length; i++)
             {
                 if (i > 0) printf(", ");
-                py_print_object_inline(list->data[i]); // 递归调用
+                PyObject* item = py_list_box_item(list, i);
+                py_print_object_inline(item); // 递归调用
+                py_decref(item);
             }
             printf("]");
             break;
@@ -250,6 +263,53 @@ static void py_print_object_inline(PyObject* obj)
              printf("<class '%s'>", ((PyClassObject*)obj)->name ? ((PyClassObject*)obj)->name : "unknown");
              break;
 
+        case llvmpy::PY_TYPE_TUPLE:
+        {
+            PyTupleObject* tuple = (PyTupleObject*)obj;
+            printf("(");
+            for (int i = 0; i < tuple->length; i++)
+            {
+                if (i > 0) printf(", ");
+                py_print_object_inline(tuple->items[i]);
+            }
+            // 单元素元组需要尾随逗号
+            printf(tuple->length == 1 ? ",)" : ")");
+            break;
+        }
+
+        case llvmpy::PY_TYPE_SET:
+        {
+            PySetObject* set = (PySetObject*)obj;
+            if (set->size == 0)
+            {
+                printf("set()");  // {} 是空字典
+                break;
+            }
+            printf("{");
+            bool first = true;
+            for (int i = 0; i < set->capacity; i++)
+            {
+                if (set->entries[i].key)
+                {
+                    if (!first) printf(", ");
+                    first = false;
+                    py_print_object_inline(set->entries[i].key);
+                }
+            }
+            printf("}");
+            break;
+        }
+
+        case llvmpy::PY_TYPE_RANGE:
+        {
+            PyRangeObject* range = (PyRangeObject*)obj;
+            if (range->step == 1)
+                printf("range(%lld, %lld)", (long long)range->start, (long long)range->stop);
+            else
+                printf("range(%lld, %lld, %lld)", (long long)range->start, (long long)range->stop, (long long)range->step);
+            break;
+        }
+
         default:
              // 尝试获取基类类型
             int baseTypeId = py_get_base_type_id(typeId);
@@ -260,7 +320,9 @@ static void py_print_object_inline(PyObject* obj)
                 for (int i = 0; i < list->length; i++)
                 {
                     if (i > 0) printf(", ");
-                    py_print_object_inline(list->data[i]);
+                    PyObject* item = py_list_box_item(list, i);
+                    py_print_object_inline(item);
+                    py_decref(item);
                 }
                 printf("]");
             }
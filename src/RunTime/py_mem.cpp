@@ -0,0 +1,396 @@
+#include "RunTime/runtime.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+
+#ifndef PY_MEM_DEFAULT_BACKEND
+#define PY_MEM_DEFAULT_BACKEND PY_MEM_BACKEND_SLAB
+#endif
+
+//===----------------------------------------------------------------------===//
+// slab 存储: 1 MiB 对齐的 arena 切成 16 KiB 的页，每页只存放一个大小级别的对象
+//===----------------------------------------------------------------------===//
+
+namespace
+{
+
+constexpr unsigned kArenaShift = 20;
+constexpr size_t kArenaSize = (size_t)1 << kArenaShift;
+constexpr unsigned kPageShift = 14;
+constexpr size_t kPageSize = (size_t)1 << kPageShift;
+constexpr size_t kPagesPerArena = kArenaSize / kPageSize;
+constexpr size_t kPageHeaderSize = 64;
+
+// 按 8 字节分级: 24 字节的 int 对象不必占用 32 字节的槽位 (槽位只保证 8 字节对齐)
+constexpr size_t kSizeClassStep = 8;
+constexpr size_t kSizeClassCount = PY_MEM_SMALL_MAX / kSizeClassStep;
+
+// 地址 -> 是否属于某个 arena 的两级表 (覆盖 48 位地址空间，叶子按需分配)
+constexpr unsigned kArenaIndexBits = 48 - kArenaShift;
+constexpr unsigned kArenaLeafBits = 14;
+constexpr size_t kArenaLeafSize = (size_t)1 << kArenaLeafBits;
+constexpr size_t kArenaRootSize = (size_t)1 << (kArenaIndexBits - kArenaLeafBits);
+
+struct SlabPage
+{
+    SlabPage* next;  // 同级别的未满页链表 / 空闲页链表
+    SlabPage* prev;
+    void* freeList;  // 释放后的槽位 (槽位的前 8 字节保存下一个)
+    char* bump;      // 从未分配过的槽位从这里开始
+    char* end;
+    uint32_t slotSize;
+    uint32_t sizeClass;
+    uint32_t used;
+    bool inClassList;
+};
+static_assert(sizeof(SlabPage) <= kPageHeaderSize, "slab page header too large");
+
+struct SlabState
+{
+    SlabPage* partial[kSizeClassCount] = {};  // 每个级别还有空槽位的页
+    SlabPage* freePages = NULL;               // 未分配给任何级别的页
+    uint8_t* arenaMap[kArenaRootSize] = {};
+};
+
+SlabState& slab()
+{
+    static SlabState state;
+    return state;
+}
+
+inline bool slab_contains(const void* ptr)
+{
+    uintptr_t index = (uintptr_t)ptr >> kArenaShift;
+    if (index >> kArenaIndexBits) return false;
+    const uint8_t* leaf = slab().arenaMap[index >> kArenaLeafBits];
+    return leaf && leaf[index & (kArenaLeafSize - 1)];
+}
+
+inline SlabPage* page_of(const void* ptr)
+{
+    return (SlabPage*)((uintptr_t)ptr & ~(uintptr_t)(kPageSize - 1));
+}
+
+bool slab_new_arena(SlabState& state)
+{
+    char* arena = (char*)aligned_alloc(kArenaSize, kArenaSize);
+    if (!arena) return false;
+
+    uintptr_t index = (uintptr_t)arena >> kArenaShift;
+    if (index >> kArenaIndexBits)
+    {
+        free(arena);
+        return false;
+    }
+    uint8_t*& leaf = state.arenaMap[index >> kArenaLeafBits];
+    if (!leaf)
+    {
+        leaf = (uint8_t*)calloc(kArenaLeafSize, 1);
+        if (!leaf)
+        {
+            free(arena);
+            return false;
+        }
+    }
+    leaf[index & (kArenaLeafSize - 1)] = 1;
+
+    // arena 不归还给系统，页在各级别之间复用
+    for (size_t i = kPagesPerArena; i-- > 0;)
+    {
+        SlabPage* page = (SlabPage*)(arena + i * kPageSize);
+        page->next = state.freePages;
+        state.freePages = page;
+    }
+    return true;
+}
+
+void class_list_push(SlabState& state, SlabPage* page)
+{
+    SlabPage*& head = state.partial[page->sizeClass];
+    page->prev = NULL;
+    page->next = head;
+    if (head) head->prev = page;
+    head = page;
+    page->inClassList = true;
+}
+
+void class_list_remove(SlabState& state, SlabPage* page)
+{
+    if (page->prev)
+        page->prev->next = page->next;
+    else
+        state.partial[page->sizeClass] = page->next;
+    if (page->next) page->next->prev = page->prev;
+    page->next = page->prev = NULL;
+    page->inClassList = false;
+}
+
+void* slab_alloc(size_t size)
+{
+    SlabState& state = slab();
+    size_t sizeClass = size > 0 ? (size - 1) / kSizeClassStep : 0;
+
+    SlabPage* page = state.partial[sizeClass];
+    if (!page)
+    {
+        if (!state.freePages && !slab_new_arena(state)) return NULL;
+        page = state.freePages;
+        state.freePages = page->next;
+
+        page->freeList = NULL;
+        page->bump = (char*)page + kPageHeaderSize;
+        page->end = (char*)page + kPageSize;
+        page->slotSize = (uint32_t)((sizeClass + 1) * kSizeClassStep);
+        page->sizeClass = (uint32_t)sizeClass;
+        page->used = 0;
+        class_list_push(state, page);
+    }
+
+    void* slot;
+    if (page->freeList)
+    {
+        slot = page->freeList;
+        page->freeList = *(void**)slot;
+    }
+    else
+    {
+        slot = page->bump;
+        page->bump += page->slotSize;
+    }
+    page->used++;
+
+    if (!page->freeList && page->bump + page->slotSize > page->end)
+    {
+        class_list_remove(state, page);  // 页已满
+    }
+    return slot;
+}
+
+void slab_free(void* ptr)
+{
+    SlabState& state = slab();
+    SlabPage* page = page_of(ptr);
+
+    *(void**)ptr = page->freeList;
+    page->freeList = ptr;
+    page->used--;
+
+    if (!page->inClassList)
+    {
+        class_list_push(state, page);
+    }
+    else if (page->used == 0 && (page->prev || page->next))
+    {
+        // 空页交还给空闲页链表 (级别中唯一的页保留，避免反复申请同一页)
+        class_list_remove(state, page);
+        page->next = state.freePages;
+        state.freePages = page;
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// 后端选择
+//===----------------------------------------------------------------------===//
+
+struct MemState
+{
+    int backend = -1;  // 第一次分配时确定
+    const PyMemAllocator* external = NULL;
+};
+
+MemState mem;
+
+PyMemBackend select_backend()
+{
+    const PyMemAllocator* external = py_mem_external_allocator();
+    if (external && external->alloc && external->realloc && external->free)
+    {
+        mem.external = external;
+        return PY_MEM_BACKEND_EXTERNAL;
+    }
+
+    const char* env = getenv("PYRT_ALLOCATOR");
+    if (env && *env)
+    {
+        if (strcmp(env, "slab") == 0) return PY_MEM_BACKEND_SLAB;
+        if (strcmp(env, "malloc") == 0 || strcmp(env, "passthrough") == 0) return PY_MEM_BACKEND_PASSTHROUGH;
+        fprintf(stderr, "Warning: Unknown PYRT_ALLOCATOR value '%s' (expected slab or malloc)\n", env);
+    }
+    return PY_MEM_DEFAULT_BACKEND;
+}
+
+inline PyMemBackend backend()
+{
+    if (mem.backend < 0) mem.backend = select_backend();
+    return (PyMemBackend)mem.backend;
+}
+
+//===----------------------------------------------------------------------===//
+// 各后端的分配 (不经过统计钩子)
+//===----------------------------------------------------------------------===//
+
+void* raw_alloc(size_t size)
+{
+    switch (backend())
+    {
+        case PY_MEM_BACKEND_SLAB:
+            if (size <= PY_MEM_SMALL_MAX) return slab_alloc(size);
+            return malloc(size);
+        case PY_MEM_BACKEND_EXTERNAL:
+            return mem.external->alloc(size);
+        default:
+            return malloc(size);
+    }
+}
+
+void* raw_calloc(size_t count, size_t size)
+{
+    if (size && count > SIZE_MAX / size) return NULL;
+    size_t bytes = count * size;
+
+    switch (backend())
+    {
+        case PY_MEM_BACKEND_SLAB:
+            if (bytes <= PY_MEM_SMALL_MAX)
+            {
+                void* ptr = slab_alloc(bytes);
+                if (ptr) memset(ptr, 0, bytes);
+                return ptr;
+            }
+            return calloc(count, size);
+        case PY_MEM_BACKEND_EXTERNAL:
+        {
+            if (mem.external->calloc) return mem.external->calloc(count, size);
+            void* ptr = mem.external->alloc(bytes);
+            if (ptr) memset(ptr, 0, bytes);
+            return ptr;
+        }
+        default:
+            return calloc(count, size);
+    }
+}
+
+void* raw_realloc(void* ptr, size_t size)
+{
+    if (!ptr) return raw_alloc(size);
+
+    if (slab_contains(ptr))
+    {
+        size_t slotSize = page_of(ptr)->slotSize;
+        if (size <= slotSize) return ptr;  // 槽位放得下，缩小时也不搬动
+
+        void* grown = raw_alloc(size);
+        if (!grown) return NULL;
+        memcpy(grown, ptr, size < slotSize ? size : slotSize);
+        slab_free(ptr);
+        return grown;
+    }
+
+    if (backend() == PY_MEM_BACKEND_EXTERNAL) return mem.external->realloc(ptr, size);
+    return realloc(ptr, size);
+}
+
+void raw_free(void* ptr)
+{
+    if (slab_contains(ptr))
+    {
+        slab_free(ptr);
+        return;
+    }
+    if (backend() == PY_MEM_BACKEND_EXTERNAL)
+    {
+        mem.external->free(ptr);
+        return;
+    }
+    free(ptr);
+}
+
+// 统计用的实际占用大小 (外部分配器无法查询，记为 0)
+[[maybe_unused]] size_t usable_size(void* ptr)
+{
+    if (slab_contains(ptr)) return page_of(ptr)->slotSize;
+    if (backend() == PY_MEM_BACKEND_EXTERNAL) return 0;
+    return malloc_usable_size(ptr);
+}
+
+inline void heap_alloc_hook(void* ptr)
+{
+#ifdef RUNTIME_MEMSTATS
+    if (ptr && (py_memstats_active || py_memprof_active)) py_memstats_heap_alloc(ptr, usable_size(ptr));
+#endif
+}
+
+inline void heap_free_hook(void* ptr, size_t bytes)
+{
+#ifdef RUNTIME_MEMSTATS
+    if (py_memstats_active || py_memprof_active) py_memstats_heap_free(ptr, bytes);
+#endif
+}
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// 分配 API
+//===----------------------------------------------------------------------===//
+
+extern "C" __attribute__((weak)) const PyMemAllocator* py_mem_external_allocator(void)
+{
+    return NULL;
+}
+
+void* py_mem_alloc(size_t size)
+{
+    void* ptr = raw_alloc(size);
+    heap_alloc_hook(ptr);
+    return ptr;
+}
+
+void* py_mem_calloc(size_t count, size_t size)
+{
+    void* ptr = raw_calloc(count, size);
+    heap_alloc_hook(ptr);
+    return ptr;
+}
+
+void* py_mem_realloc(void* ptr, size_t size)
+{
+    if (!ptr) return py_mem_alloc(size);
+
+#ifdef RUNTIME_MEMSTATS
+    size_t oldBytes = (py_memstats_active || py_memprof_active) ? usable_size(ptr) : 0;
+#else
+    size_t oldBytes = 0;
+#endif
+    void* result = raw_realloc(ptr, size);
+    if (result)
+    {
+        heap_free_hook(ptr, oldBytes);  // 只用地址作为键，旧块即使已释放也没有关系
+        heap_alloc_hook(result);
+    }
+    return result;
+}
+
+void py_mem_free(void* ptr)
+{
+    if (!ptr) return;
+#ifdef RUNTIME_MEMSTATS
+    if (py_memstats_active || py_memprof_active) heap_free_hook(ptr, usable_size(ptr));
+#endif
+    raw_free(ptr);
+}
+
+PyMemBackend py_mem_backend(void)
+{
+    return backend();
+}
+
+bool py_mem_set_backend(PyMemBackend requested)
+{
+    PyMemBackend current = backend();
+    if (current == PY_MEM_BACKEND_EXTERNAL) return requested == PY_MEM_BACKEND_EXTERNAL;
+    if (requested != PY_MEM_BACKEND_SLAB && requested != PY_MEM_BACKEND_PASSTHROUGH) return false;
+    mem.backend = requested;
+    return true;
+}
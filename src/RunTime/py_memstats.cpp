@@ -0,0 +1,326 @@
+#include "RunTime/runtime.h"
+#include "TypeIDs.h"
+
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <execinfo.h>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+using namespace llvmpy;
+
+bool py_memstats_active = false;
+bool py_memprof_active = false;
+
+//===----------------------------------------------------------------------===//
+// 计数器
+//===----------------------------------------------------------------------===//
+
+namespace
+{
+
+// 小于 PY_TYPE_LIST_BASE 的 typeId (包括各种迭代器) 各占一行，更大的按基础类型合并
+constexpr int kStatsSlots = PY_TYPE_LIST_BASE;
+
+struct AllocCounters
+{
+    uint64_t allocs = 0;
+    uint64_t frees = 0;
+    int64_t liveBytes = 0;
+    int64_t peakBytes = 0;
+
+    void add(size_t bytes)
+    {
+        allocs++;
+        liveBytes += (int64_t)bytes;
+        if (liveBytes > peakBytes) peakBytes = liveBytes;
+    }
+
+    void remove(size_t bytes)
+    {
+        frees++;
+        liveBytes -= (int64_t)bytes;
+    }
+};
+
+struct MemStats
+{
+    AllocCounters types[kStatsSlots];
+    AllocCounters heap;  // py_mem 层的所有分配
+};
+
+MemStats stats;
+
+int stats_slot(int typeId)
+{
+    int slot = typeId < PY_TYPE_LIST_BASE ? typeId : getBaseTypeId(typeId);
+    return slot >= 0 && slot < kStatsSlots ? slot : PY_TYPE_NONE;
+}
+
+// 对象本身占用的字节数，分配与释放时必须得到相同的结果
+size_t object_bytes(PyObject* obj)
+{
+    switch (obj->typeId)
+    {
+        case PY_TYPE_LIST_ITERATOR: return sizeof(PyListIteratorObject);
+        case PY_TYPE_STRING_ITERATOR: return sizeof(PyStringIteratorObject);
+        case PY_TYPE_DICT_ITERATOR: return sizeof(PyDictIteratorObject);
+        case PY_TYPE_RANGE_ITERATOR: return sizeof(PyRangeIteratorObject);
+        case PY_TYPE_TUPLE_ITERATOR: return sizeof(PyTupleIteratorObject);
+        case PY_TYPE_SET_ITERATOR: return sizeof(PySetIteratorObject);
+        default: break;
+    }
+
+    switch (getBaseTypeId(obj->typeId))
+    {
+        case PY_TYPE_INT: return sizeof(PyIntObject);
+        case PY_TYPE_DOUBLE: return sizeof(PyFloatObject);
+        case PY_TYPE_BOOL: return sizeof(PyBoolObject);
+        case PY_TYPE_STRING: return sizeof(PyStringObject);
+        case PY_TYPE_LIST: return sizeof(PyGCHead) + sizeof(PyListObject);
+        case PY_TYPE_DICT: return sizeof(PyGCHead) + sizeof(PyDictObject);
+        case PY_TYPE_SET: return sizeof(PyGCHead) + sizeof(PySetObject);
+        case PY_TYPE_CLASS: return sizeof(PyGCHead) + sizeof(PyClassObject);
+        case PY_TYPE_INSTANCE: return sizeof(PyGCHead) + sizeof(PyInstanceObject);
+        case PY_TYPE_TUPLE:
+        {
+            int slots = ((PyTupleObject*)obj)->length > 0 ? ((PyTupleObject*)obj)->length : 1;
+            return sizeof(PyGCHead) + sizeof(PyTupleObject) + (size_t)slots * sizeof(PyObject*);
+        }
+        case PY_TYPE_RANGE: return sizeof(PyRangeObject);
+        case PY_TYPE_FUNC: return sizeof(PyFunctionObject);
+        default: return sizeof(PyObject);
+    }
+}
+
+// py_type_name 只认识基础类型，迭代器、类与实例在这里单独命名
+const char* stats_slot_name(int slot)
+{
+    switch (slot)
+    {
+        case PY_TYPE_LIST_ITERATOR: return "list_iterator";
+        case PY_TYPE_STRING_ITERATOR: return "str_iterator";
+        case PY_TYPE_DICT_ITERATOR: return "dict_iterator";
+        case PY_TYPE_RANGE_ITERATOR: return "range_iterator";
+        case PY_TYPE_TUPLE_ITERATOR: return "tuple_iterator";
+        case PY_TYPE_SET_ITERATOR: return "set_iterator";
+        case PY_TYPE_CLASS: return "class";
+        case PY_TYPE_INSTANCE: return "instance";
+        default: return py_type_name(slot);
+    }
+}
+
+//===----------------------------------------------------------------------===//
+// 采样分配分析
+//===----------------------------------------------------------------------===//
+
+constexpr int kMaxStackDepth = 32;
+
+struct SampleBucket
+{
+    uint64_t allocs = 0;
+    uint64_t allocBytes = 0;
+    int64_t inuse = 0;
+    int64_t inuseBytes = 0;
+};
+
+struct LiveSample
+{
+    SampleBucket* bucket;
+    size_t bytes;
+};
+
+struct Profiler
+{
+    const char* path = NULL;
+    int rate = 512;
+    int countdown = 512;
+    std::map<std::vector<void*>, SampleBucket> buckets;  // 调用栈 -> 计数
+    std::unordered_map<void*, LiveSample> live;          // 仍未释放的采样块
+};
+
+Profiler profiler;
+
+void profiler_sample(void* ptr, size_t bytes)
+{
+    void* frames[kMaxStackDepth];
+    int depth = backtrace(frames, kMaxStackDepth);
+    // frames[0] 是本函数，从调用者 (py_memstats_heap_alloc) 开始保留
+    std::vector<void*> stack(frames + (depth > 1 ? 1 : 0), frames + depth);
+
+    SampleBucket& bucket = profiler.buckets[stack];
+    bucket.allocs++;
+    bucket.allocBytes += bytes;
+    bucket.inuse++;
+    bucket.inuseBytes += (int64_t)bytes;
+    profiler.live[ptr] = {&bucket, bytes};
+}
+
+// gperftools 的 heap profile 文本格式 (pprof 可以直接读取)，计数按采样间隔放大
+void profiler_write()
+{
+    FILE* out = fopen(profiler.path, "w");
+    if (!out)
+    {
+        fprintf(stderr, "Warning: Cannot open PYRT_MEMPROF output '%s'\n", profiler.path);
+        return;
+    }
+
+    int64_t rate = profiler.rate;
+    SampleBucket total;
+    for (auto& entry : profiler.buckets)
+    {
+        total.allocs += entry.second.allocs;
+        total.allocBytes += entry.second.allocBytes;
+        total.inuse += entry.second.inuse;
+        total.inuseBytes += entry.second.inuseBytes;
+    }
+
+    fprintf(out, "heap profile: %6" PRId64 ": %8" PRId64 " [%6" PRIu64 ": %8" PRIu64 "] @ heapprofile\n",
+            total.inuse * rate, total.inuseBytes * rate, total.allocs * rate, total.allocBytes * rate);
+    for (auto& entry : profiler.buckets)
+    {
+        const SampleBucket& bucket = entry.second;
+        fprintf(out, "%6" PRId64 ": %8" PRId64 " [%6" PRIu64 ": %8" PRIu64 "] @",
+                bucket.inuse * rate, bucket.inuseBytes * rate, bucket.allocs * rate, bucket.allocBytes * rate);
+        for (void* frame : entry.first)
+        {
+            fprintf(out, " %p", frame);
+        }
+        fputc('\n', out);
+    }
+
+    // 符号化需要的地址映射
+    fputs("\nMAPPED_LIBRARIES:\n", out);
+    FILE* maps = fopen("/proc/self/maps", "r");
+    if (maps)
+    {
+        char buffer[4096];
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), maps)) > 0)
+        {
+            fwrite(buffer, 1, n, out);
+        }
+        fclose(maps);
+    }
+    fclose(out);
+}
+
+//===----------------------------------------------------------------------===//
+// 启动时读取环境变量
+//===----------------------------------------------------------------------===//
+
+bool env_flag(const char* name)
+{
+    const char* value = getenv(name);
+    return value && *value && strcmp(value, "0") != 0;
+}
+
+struct MemStatsInit
+{
+    MemStatsInit()
+    {
+        const char* profilePath = getenv("PYRT_MEMPROF");
+#ifdef RUNTIME_MEMSTATS
+        py_memstats_active = env_flag("PYRT_MEMSTATS");
+        if (profilePath && *profilePath)
+        {
+            profiler.path = profilePath;
+            const char* rate = getenv("PYRT_MEMPROF_RATE");
+            if (rate && atoi(rate) > 0) profiler.rate = atoi(rate);
+            profiler.countdown = profiler.rate;
+            py_memprof_active = true;
+        }
+#else
+        if (env_flag("PYRT_MEMSTATS") || (profilePath && *profilePath))
+        {
+            fprintf(stderr, "Warning: PYRT_MEMSTATS / PYRT_MEMPROF ignored: runtime built without RUNTIME_MEMSTATS\n");
+        }
+#endif
+    }
+};
+
+MemStatsInit memStatsInit;
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// 钩子
+//===----------------------------------------------------------------------===//
+
+void py_memstats_object_alloc(PyObject* obj)
+{
+    if (!obj) return;
+    stats.types[stats_slot(obj->typeId)].add(object_bytes(obj));
+}
+
+void py_memstats_object_free(PyObject* obj)
+{
+    if (!obj) return;
+    stats.types[stats_slot(obj->typeId)].remove(object_bytes(obj));
+}
+
+void py_memstats_heap_alloc(void* ptr, size_t bytes)
+{
+    if (py_memstats_active) stats.heap.add(bytes);
+    if (py_memprof_active && --profiler.countdown <= 0)
+    {
+        profiler.countdown = profiler.rate;
+        profiler_sample(ptr, bytes);
+    }
+}
+
+void py_memstats_heap_free(void* ptr, size_t bytes)
+{
+    if (py_memstats_active) stats.heap.remove(bytes);
+    if (py_memprof_active && !profiler.live.empty())
+    {
+        auto it = profiler.live.find(ptr);
+        if (it != profiler.live.end())
+        {
+            it->second.bucket->inuse--;
+            it->second.bucket->inuseBytes -= (int64_t)it->second.bytes;
+            profiler.live.erase(it);
+        }
+    }
+}
+
+int64_t py_memstats_live_objects(int typeId)
+{
+    const AllocCounters& counters = stats.types[stats_slot(typeId)];
+    return (int64_t)(counters.allocs - counters.frees);
+}
+
+//===----------------------------------------------------------------------===//
+// 退出时的报告
+//===----------------------------------------------------------------------===//
+
+static void py_memstats_print_row(const char* name, const AllocCounters& counters)
+{
+    fprintf(stderr, "%-16s %12" PRIu64 " %12" PRIu64 " %12" PRId64 " %14" PRId64 " %14" PRId64 "\n",
+            name, counters.allocs, counters.frees, (int64_t)(counters.allocs - counters.frees),
+            counters.liveBytes, counters.peakBytes);
+}
+
+void py_memstats_report(void)
+{
+    if (py_memstats_active)
+    {
+        fprintf(stderr, "\n--- llvmpy runtime memory stats ---\n");
+        fprintf(stderr, "%-16s %12s %12s %12s %14s %14s\n", "type", "allocs", "frees", "live", "live bytes", "peak bytes");
+        for (int slot = 0; slot < kStatsSlots; slot++)
+        {
+            const AllocCounters& counters = stats.types[slot];
+            if (counters.allocs == 0 && counters.frees == 0) continue;
+            py_memstats_print_row(stats_slot_name(slot), counters);
+        }
+        py_memstats_print_row("py_mem (total)", stats.heap);
+    }
+    if (py_memprof_active)
+    {
+        py_memprof_active = false;  // 写文件期间不再采样
+        profiler_write();
+    }
+}
@@ -4,8 +4,21 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <string>
+#include <unordered_map>
 
 using namespace llvmpy;
+
+// 按类型收紧的布局必须与 PyPrimitiveObject::value 的成员对齐，运行时其余部分仍通过 PyPrimitiveObject 访问它们
+static_assert(sizeof(PyObject) == 8, "PyObject header must stay 8 bytes (codegen reads it as {i32, i16, i16})");
+static_assert(offsetof(PyBoolObject, value) == offsetof(PyPrimitiveObject, value.boolValue), "bool layout mismatch");
+static_assert(offsetof(PyIntObject, value) == offsetof(PyPrimitiveObject, value.intValue), "int layout mismatch");
+static_assert(offsetof(PyFloatObject, value) == offsetof(PyPrimitiveObject, value.doubleValue), "float layout mismatch");
+static_assert(offsetof(PyStringObject, chars) == offsetof(PyPrimitiveObject, value.stringView.chars) &&
+                  offsetof(PyStringObject, capacity) == offsetof(PyPrimitiveObject, value.stringView.capacity) &&
+                  sizeof(PyStringObject) <= sizeof(PyPrimitiveObject),
+              "string layout mismatch");
+
 //===----------------------------------------------------------------------===//
 // 对象创建函数实现
 //===----------------------------------------------------------------------===//
@@ -24,7 +37,7 @@ PyObject* py_create_class(const char* name, PyObject* base_cls_obj, PyObject* cl
         return NULL;
     }
 
-    PyClassObject* cls = (PyClassObject*)malloc(sizeof(PyClassObject));
+    PyClassObject* cls = (PyClassObject*)py_gc_malloc(sizeof(PyClassObject));
     if (!cls)
     {
         fprintf(stderr, "MemoryError: Failed to allocate class object\n");
@@ -33,10 +46,14 @@ PyObject* py_create_class(const char* name, PyObject* base_cls_obj, PyObject* cl
 
     cls->header.refCount = 1;  // 初始引用计数为 1
     cls->header.typeId = llvmpy::PY_TYPE_CLASS;
-    cls->name = strdup(name);  // 复制类名
+    cls->header.flags = 0;
+    size_t nameLen = strlen(name) + 1;
+    char* nameCopy = (char*)py_mem_alloc(nameLen);  // 复制类名 (与对象一样由 py_mem_free 释放)
+    if (nameCopy) memcpy(nameCopy, name, nameLen);
+    cls->name = nameCopy;
     if (!cls->name)
     {
-        free(cls);
+        py_gc_free((PyObject*)cls);
         fprintf(stderr, "MemoryError: Failed to duplicate class name\n");
         return NULL;
     }
@@ -49,6 +66,8 @@ PyObject* py_create_class(const char* name, PyObject* base_cls_obj, PyObject* cl
 
     // TODO: 可以在这里查找或注册特定于此类的 PyTypeMethods
 
+    PY_MEMSTATS_OBJECT_ALLOC(cls);
+    py_gc_track((PyObject*)cls);
     return (PyObject*)cls;
 }
 
@@ -61,7 +80,7 @@ PyObject* py_create_instance(PyObject* cls_obj)
     }
     PyClassObject* cls = (PyClassObject*)cls_obj;
 
-    PyInstanceObject* instance = (PyInstanceObject*)malloc(sizeof(PyInstanceObject));
+    PyInstanceObject* instance = (PyInstanceObject*)py_gc_malloc(sizeof(PyInstanceObject));
     if (!instance)
     {
         fprintf(stderr, "MemoryError: Failed to allocate instance object\n");
@@ -69,6 +88,7 @@ PyObject* py_create_instance(PyObject* cls_obj)
     }
 
     instance->header.refCount = 1;
+    instance->header.flags = 0;
     // TODO: 分配具体的实例类型 ID，可能需要一个全局计数器或更复杂的方案
     // 暂时使用通用的 INSTANCE ID，或者如果类对象存储了实例类型ID，则使用它
     instance->header.typeId = llvmpy::PY_TYPE_INSTANCE;  // 或者 >= PY_TYPE_INSTANCE_BASE
@@ -76,7 +96,7 @@ PyObject* py_create_instance(PyObject* cls_obj)
     instance->instance_dict = (PyDictObject*)py_create_dict(8, llvmpy::PY_TYPE_STRING);  // 创建空的实例字典
     if (!instance->instance_dict)
     {
-        free(instance);
+        py_gc_free((PyObject*)instance);
         fprintf(stderr, "MemoryError: Failed to create instance dictionary\n");
         return NULL;
     }
@@ -85,13 +105,15 @@ PyObject* py_create_instance(PyObject* cls_obj)
 
     // TODO: 调用类的 __init__ 方法 (需要函数调用机制)
 
+    PY_MEMSTATS_OBJECT_ALLOC(instance);
+    py_gc_track((PyObject*)instance);
     return (PyObject*)instance;
 }
 
 // 创建一个基本对象
 static PyObject* py_create_basic_object(int typeId)
 {
-    PyObject* obj = (PyObject*)malloc(sizeof(PyObject));
+    PyObject* obj = (PyObject*)py_mem_alloc(sizeof(PyObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory\n");
@@ -99,13 +121,88 @@ static PyObject* py_create_basic_object(int typeId)
     }
     obj->refCount = 1;
     obj->typeId = typeId;
+    obj->flags = 0;
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return obj;
 }
 
+//===----------------------------------------------------------------------===//
+// 永生对象: 小整数、驻留字符串与字面量常量
+//===----------------------------------------------------------------------===//
+
+// [_PY_SMALL_INT_MIN, _PY_SMALL_INT_MAX] 内的 int 共享同一个对象，第一次使用时初始化
+static PyIntObject py_small_ints[_PY_SMALL_INT_MAX - _PY_SMALL_INT_MIN + 1];
+static bool py_small_ints_ready = false;
+
+static inline bool py_is_small_int(long long value)
+{
+    return value >= _PY_SMALL_INT_MIN && value <= _PY_SMALL_INT_MAX;
+}
+
+static PyObject* py_small_int(long long value)
+{
+    if (!py_small_ints_ready)
+    {
+        for (long long v = _PY_SMALL_INT_MIN; v <= _PY_SMALL_INT_MAX; v++)
+        {
+            PyIntObject* obj = &py_small_ints[v - _PY_SMALL_INT_MIN];
+            obj->header.refCount = INT_MAX;
+            obj->header.typeId = PY_TYPE_INT;
+            obj->header.flags = PY_OBJECT_FLAG_IMMORTAL;
+            mpz_init_set_si(obj->value, v);
+        }
+        py_small_ints_ready = true;
+    }
+    return (PyObject*)&py_small_ints[value - _PY_SMALL_INT_MIN];
+}
+
+PyObject* py_make_immortal(PyObject* obj)
+{
+    if (obj)
+    {
+        obj->refCount = INT_MAX;
+        obj->flags |= PY_OBJECT_FLAG_IMMORTAL;
+    }
+    return obj;
+}
+
+PyObject* py_intern_string(const char* value)
+{
+    static std::unordered_map<std::string, PyObject*> interned;
+    if (!value) value = "";
+
+    auto it = interned.find(value);
+    if (it != interned.end()) return it->second;
+
+    PyObject* str = py_make_immortal(py_create_string(value));
+    if (str) interned.emplace(value, str);
+    return str;
+}
+
+PyObject* py_const_int(PyObject** slot, const char* text)
+{
+    if (!*slot) *slot = py_make_immortal(py_create_int_bystring(text, 10));
+    return *slot;
+}
+
+PyObject* py_const_double(PyObject** slot, const char* text)
+{
+    if (!*slot) *slot = py_make_immortal(py_create_double_bystring(text, 10, 0));
+    return *slot;
+}
+
+PyObject* py_const_string(PyObject** slot, const char* text)
+{
+    if (!*slot) *slot = py_intern_string(text);
+    return *slot;
+}
+
 // 创建整数对象
 PyObject* py_create_int(long long int value)  // <-- Changed parameter type for wider input
 {
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
+    if (py_is_small_int(value)) return py_small_int(value);
+
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyIntObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory creating int object\n");
@@ -113,15 +210,19 @@ PyObject* py_create_int(long long int value)  // <-- Changed parameter type for
     }
     obj->header.refCount = 1;
     obj->header.typeId = PY_TYPE_INT;
+    obj->header.flags = 0;
     // 初始化 GMP 整数
     mpz_init_set_si(obj->value.intValue, value);
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return (PyObject*)obj;
 }
 
 // 从 mpz_t 创建整数对象 (辅助函数)
 PyObject* py_create_int_from_mpz(mpz_srcptr src)
 {
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
+    if (mpz_fits_slong_p(src) && py_is_small_int(mpz_get_si(src))) return py_small_int(mpz_get_si(src));
+
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyIntObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory creating int object from mpz\n");
@@ -129,7 +230,9 @@ PyObject* py_create_int_from_mpz(mpz_srcptr src)
     }
     obj->header.refCount = 1;
     obj->header.typeId = PY_TYPE_INT;
+    obj->header.flags = 0;
     mpz_init_set(obj->value.intValue, src);  // Initialize from existing mpz_t
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return (PyObject*)obj;
 }
 PyObject* py_create_int_bystring(const char* s, int base)
@@ -140,7 +243,7 @@ PyObject* py_create_int_bystring(const char* s, int base)
         return NULL;
     }
 
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyIntObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory creating int object from string.\n");
@@ -148,6 +251,7 @@ PyObject* py_create_int_bystring(const char* s, int base)
     }
     obj->header.refCount = 1;
     obj->header.typeId = PY_TYPE_INT;
+    obj->header.flags = 0;
 
     // Initialize and set the value from the string using GMP
     // mpz_init_set_str returns 0 on success, -1 on failure (invalid string)
@@ -155,12 +259,77 @@ PyObject* py_create_int_bystring(const char* s, int base)
     {
         fprintf(stderr, "Error: Invalid integer string format: \"%s\" with base %d\n", s, base);
         mpz_clear(obj->value.intValue);  // Clear the partially initialized mpz_t
-        free(obj);
+        py_mem_free(obj);
         return NULL;  // Indicate failure
     }
+    if (mpz_fits_slong_p(obj->value.intValue) && py_is_small_int(mpz_get_si(obj->value.intValue)))
+    {
+        PyObject* small = py_small_int(mpz_get_si(obj->value.intValue));
+        mpz_clear(obj->value.intValue);
+        py_mem_free(obj);
+        return small;
+    }
 
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return (PyObject*)obj;
 }
+
+// 在调用者提供的 storage (通常是栈上的 alloca) 中初始化对象，不调用 malloc。
+// 引用计数设为 INT_MAX: py_incref 忽略它，py_decref 也不会把它减到 0 而去 free 栈内存。
+// 生命周期结束时调用 py_release_into 释放 GMP 数据。
+static PyObject* py_init_header_into(PyPrimitiveObject* storage, int typeId)
+{
+    storage->header.refCount = INT_MAX;
+    storage->header.typeId = typeId;
+    storage->header.flags = PY_OBJECT_FLAG_IMMORTAL;
+    return (PyObject*)storage;
+}
+
+PyObject* py_init_int_into(PyPrimitiveObject* storage, long long value)
+{
+    mpz_init_set_si(storage->value.intValue, value);
+    return py_init_header_into(storage, PY_TYPE_INT);
+}
+
+PyObject* py_init_int_bystring_into(PyPrimitiveObject* storage, const char* s, int base)
+{
+    if (!s || mpz_init_set_str(storage->value.intValue, s, base) != 0)
+    {
+        if (s) mpz_clear(storage->value.intValue);
+        fprintf(stderr, "Error: Invalid integer string format: \"%s\" with base %d\n", s ? s : "(null)", base);
+        return NULL;
+    }
+    return py_init_header_into(storage, PY_TYPE_INT);
+}
+
+PyObject* py_init_bool_into(PyPrimitiveObject* storage, bool value)
+{
+    storage->value.boolValue = value;
+    return py_init_header_into(storage, PY_TYPE_BOOL);
+}
+
+// 结束 py_*_into 结果的生命周期: 位于 storage 中时清理 GMP 数据，回退到堆上的结果则 decref
+void py_release_into(PyObject* obj, PyPrimitiveObject* storage)
+{
+    if (!obj) return;
+    if (obj != (PyObject*)storage)
+    {
+        py_decref(obj);
+        return;
+    }
+    switch (obj->typeId)
+    {
+        case PY_TYPE_INT:
+            mpz_clear(storage->value.intValue);
+            break;
+        case PY_TYPE_DOUBLE:
+            mpf_clear(storage->value.doubleValue);
+            break;
+        default:
+            break;
+    }
+}
+
 PyObject* py_create_double_bystring(const char* s, int base, mp_bitcnt_t precision)
 {
     if (!s)
@@ -169,7 +338,7 @@ PyObject* py_create_double_bystring(const char* s, int base, mp_bitcnt_t precisi
         return NULL;
     }
 
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyFloatObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory creating double object from string.\n");
@@ -177,6 +346,7 @@ PyObject* py_create_double_bystring(const char* s, int base, mp_bitcnt_t precisi
     }
     obj->header.refCount = 1;
     obj->header.typeId = PY_TYPE_DOUBLE;
+    obj->header.flags = 0;
 
     // Determine precision: use provided precision or a default (e.g., 256)
     mp_bitcnt_t prec_to_use = (precision > 0) ? precision : RUNTIME_FLOATE_PRECISION;  // Default precision
@@ -191,18 +361,19 @@ PyObject* py_create_double_bystring(const char* s, int base, mp_bitcnt_t precisi
     {
         fprintf(stderr, "Error: Invalid double string format: \"%s\" with base %d\n", s, base);
         mpf_clear(obj->value.doubleValue);  // Clear the initialized mpf_t
-        free(obj);
+        py_mem_free(obj);
         return NULL;  // Indicate failure
     }
     // --- END MODIFICATION ---
 
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return (PyObject*)obj;
 }
 
 // 创建浮点数对象
 PyObject* py_create_double(double value)
 {
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyFloatObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory creating double object\n");
@@ -210,14 +381,16 @@ PyObject* py_create_double(double value)
     }
     obj->header.refCount = 1;
     obj->header.typeId = PY_TYPE_DOUBLE;
+    obj->header.flags = 0;
     // 初始化 GMP 浮点数 (设置默认精度，例如 256 位)
     mpf_init2(obj->value.doubleValue, RUNTIME_FLOATE_PRECISION);
     mpf_set_d(obj->value.doubleValue, value);
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return (PyObject*)obj;
 }
 PyObject* py_create_double_from_mpf(mpf_srcptr src)
 {
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyFloatObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory creating double object from mpf\n");
@@ -225,30 +398,27 @@ PyObject* py_create_double_from_mpf(mpf_srcptr src)
     }
     obj->header.refCount = 1;
     obj->header.typeId = PY_TYPE_DOUBLE;
+    obj->header.flags = 0;
     // Initialize with the same precision as the source
     mpf_init2(obj->value.doubleValue, mpf_get_prec(src));
     mpf_set(obj->value.doubleValue, src);
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return (PyObject*)obj;
 }
-// 创建布尔对象
+// True / False 单例: 不计数、不释放，比较与复制都直接返回它们
+static PyBoolObject py_true_object = {{INT_MAX, PY_TYPE_BOOL, PY_OBJECT_FLAG_IMMORTAL}, true};
+static PyBoolObject py_false_object = {{INT_MAX, PY_TYPE_BOOL, PY_OBJECT_FLAG_IMMORTAL}, false};
+
+// 创建布尔对象 (返回单例，不分配内存)
 PyObject* py_create_bool(bool value)
 {
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
-    if (!obj)
-    {
-        fprintf(stderr, "Error: Out of memory creating bool object\n");
-        return NULL;
-    }
-    obj->header.refCount = 1;
-    obj->header.typeId = PY_TYPE_BOOL;
-    obj->value.boolValue = value;
-    return (PyObject*)obj;
+    return value ? (PyObject*)&py_true_object : (PyObject*)&py_false_object;
 }
 
 // 创建字符串对象
 PyObject* py_create_string(const char* value)
 {
-    PyPrimitiveObject* obj = (PyPrimitiveObject*)malloc(sizeof(PyPrimitiveObject));
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyStringObject));
     if (!obj)
     {
         fprintf(stderr, "Error: Out of memory\n");
@@ -256,15 +426,16 @@ PyObject* py_create_string(const char* value)
     }
     obj->header.refCount = 1;
     obj->header.typeId = PY_TYPE_STRING;
+    obj->header.flags = 0;
 
     if (value)
     {
         size_t len = strlen(value) + 1;
-        obj->value.stringValue = (char*)malloc(len);
+        obj->value.stringValue = (char*)py_mem_alloc(len);
         if (!obj->value.stringValue)
         {
             fprintf(stderr, "Error: Out of memory for string\n");
-            free(obj);
+            py_mem_free(obj);
             return NULL;
         }
         strcpy(obj->value.stringValue, value);
@@ -273,7 +444,60 @@ PyObject* py_create_string(const char* value)
     {
         obj->value.stringValue = NULL;
     }
+    obj->value.stringView.owner = NULL;
+    obj->value.stringView.capacity = 0;
 
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
+    return (PyObject*)obj;
+}
+
+// 创建字符串对象，复制 value 的前 len 个字节 (value 不要求以 NUL 结尾)。
+// value 为 NULL 时只分配 len 字节的缓冲区，内容由调用者填写。
+PyObject* py_create_string_with_length(const char* value, size_t len)
+{
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyStringObject));
+    char* buffer = (char*)py_mem_alloc(len + 1);
+    if (!obj || !buffer)
+    {
+        fprintf(stderr, "Error: Out of memory for string\n");
+        py_mem_free(obj);
+        py_mem_free(buffer);
+        return NULL;
+    }
+    if (value) memcpy(buffer, value, len);
+    buffer[len] = '\0';
+
+    obj->header.refCount = 1;
+    obj->header.typeId = PY_TYPE_STRING;
+    obj->header.flags = 0;
+    obj->value.stringView.chars = buffer;
+    obj->value.stringView.owner = NULL;
+    obj->value.stringView.capacity = 0;
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
+    return (PyObject*)obj;
+}
+
+// 创建共享 str 缓冲区的后缀视图 (从第 offset 个字节到结尾)。
+// 字符串不可变且以 NUL 结尾，后缀可以直接借用原缓冲区；视图持有缓冲区所有者的引用。
+PyObject* py_create_string_view(PyObject* str, size_t offset)
+{
+    PyPrimitiveObject* src = (PyPrimitiveObject*)str;
+    PyObject* owner = src->value.stringView.owner ? src->value.stringView.owner : str;
+
+    PyPrimitiveObject* obj = (PyPrimitiveObject*)py_mem_alloc(sizeof(PyStringObject));
+    if (!obj)
+    {
+        fprintf(stderr, "Error: Out of memory\n");
+        return NULL;
+    }
+    obj->header.refCount = 1;
+    obj->header.typeId = PY_TYPE_STRING;
+    obj->header.flags = 0;
+    obj->value.stringView.chars = src->value.stringView.chars + offset;
+    obj->value.stringView.owner = owner;
+    obj->value.stringView.capacity = 0;
+    py_incref(owner);
+    PY_MEMSTATS_OBJECT_ALLOC(obj);
     return (PyObject*)obj;
 }
 
@@ -281,7 +505,7 @@ PyObject* py_create_string(const char* value)
 PyObject* py_create_list(int size, int elemTypeId)
 {
     // 分配列表对象内存
-    PyListObject* list = (PyListObject*)malloc(sizeof(PyListObject));
+    PyListObject* list = (PyListObject*)py_gc_malloc(sizeof(PyListObject));
     if (!list)
     {
         fprintf(stderr, "Error: Out of memory for list\n");
@@ -291,29 +515,226 @@ PyObject* py_create_list(int size, int elemTypeId)
     // 初始化列表头
     list->header.refCount = 1;
     list->header.typeId = PY_TYPE_LIST;
+    list->header.flags = 0;
     list->length = 0;
     list->elemTypeId = elemTypeId;
+    list->base = NULL;
+    list->exports = 0;
+    list->retired = NULL;
+
+    // 根据元素类型选择存储策略 (int/float/bool 使用非装箱存储)
+    list->storage = py_list_storage_for_type(elemTypeId);
 
     // 分配数据数组内存
     int capacity = size > 0 ? size : 8;  // 默认初始容量为8
     list->capacity = capacity;
-    list->data = (PyObject**)calloc(capacity, sizeof(PyObject*));
+    list->data = (PyObject**)py_mem_calloc(1, py_list_storage_bytes(list->storage, capacity));
 
     if (!list->data)
     {
         fprintf(stderr, "Error: Out of memory for list data\n");
-        free(list);
+        py_gc_free((PyObject*)list);
         return NULL;
     }
 
+    PY_MEMSTATS_OBJECT_ALLOC(list);
+    py_gc_track((PyObject*)list);
     return (PyObject*)list;
 }
 
+// range(start, stop, step) 的元素个数 (step != 0)
+int64_t py_range_length(int64_t start, int64_t stop, int64_t step)
+{
+    __int128 span = step > 0 ? (__int128)stop - start : (__int128)start - stop;
+    __int128 absStep = step > 0 ? (__int128)step : -(__int128)step;
+    if (span <= 0) return 0;
+    return (int64_t)((span - 1) / absStep + 1);
+}
+
+/**
+ * @brief 把 range 循环当前的计数值绑定到循环变量槽位 *slot。
+ *
+ * 槽位中的整数只被该槽位持有时 (循环变量不逃逸，见 CodeGenStmt::tryHandleRangeForStmt)
+ * 直接原地改写它的值；否则 (首次迭代、循环体重新绑定了变量或值被别处持有)
+ * 分配一个新的私有整数对象替换旧值。私有对象不取自小整数缓存，之后的迭代可以继续原地改写，
+ * 整个循环只分配一次。
+ */
+void py_range_bind_counter(PyObject** slot, int64_t value)
+{
+    PyObject* current = *slot;
+    if (current && current->typeId == PY_TYPE_INT && current->refCount == 1)
+    {
+        mpz_set_si(((PyIntObject*)current)->value, value);
+        return;
+    }
+
+    PyIntObject* counter = (PyIntObject*)py_mem_alloc(sizeof(PyIntObject));
+    if (!counter)
+    {
+        fprintf(stderr, "Error: Out of memory creating int object\n");
+        return;
+    }
+    counter->header.refCount = 1;
+    counter->header.typeId = PY_TYPE_INT;
+    counter->header.flags = 0;
+    mpz_init_set_si(counter->value, value);
+    PY_MEMSTATS_OBJECT_ALLOC(counter);
+
+    *slot = (PyObject*)counter;
+    if (current) py_decref(current);
+}
+
+// 创建range对象 (惰性，不生成元素)
+PyObject* py_create_range(int64_t start, int64_t stop, int64_t step)
+{
+    if (step == 0)
+    {
+        fprintf(stderr, "ValueError: range() arg 3 must not be zero\n");
+        return NULL;
+    }
+
+    PyRangeObject* range = (PyRangeObject*)py_mem_alloc(sizeof(PyRangeObject));
+    if (!range)
+    {
+        fprintf(stderr, "MemoryError: Failed to allocate range object\n");
+        return NULL;
+    }
+    range->header.refCount = 1;
+    range->header.typeId = PY_TYPE_RANGE;
+    range->header.flags = 0;
+    range->start = start;
+    range->stop = stop;
+    range->step = step;
+    range->length = py_range_length(start, stop, step);
+    PY_MEMSTATS_OBJECT_ALLOC(range);
+    return (PyObject*)range;
+}
+
+//===----------------------------------------------------------------------===//
+// 元组对象 (元素内联存储 + 小元组空闲链表)
+//===----------------------------------------------------------------------===//
+
+// 长度不超过 PY_TUPLE_FREELIST_MAX_ARITY 的元组释放后按长度缓存，下次创建时直接复用
+#define PY_TUPLE_FREELIST_MAX_ARITY 8
+#define PY_TUPLE_FREELIST_MAX_COUNT 64
+
+static PyTupleObject* tuple_freelist[PY_TUPLE_FREELIST_MAX_ARITY + 1] = {NULL};
+static int tuple_freelist_count[PY_TUPLE_FREELIST_MAX_ARITY + 1] = {0};
+
+// 创建长度为 size 的元组，元素初始化为 NULL，由调用者通过 py_tuple_set_item 填充
+PyObject* py_create_tuple(int size)
+{
+    if (size < 0)
+    {
+        fprintf(stderr, "SystemError: negative tuple size %d\n", size);
+        return NULL;
+    }
+
+    PyTupleObject* tuple = NULL;
+    if (size <= PY_TUPLE_FREELIST_MAX_ARITY && tuple_freelist[size])
+    {
+        // 空闲链表借用 items[0] 保存下一个节点
+        tuple = tuple_freelist[size];
+        tuple_freelist[size] = (PyTupleObject*)tuple->items[0];
+        tuple_freelist_count[size]--;
+    }
+    else
+    {
+        // 空元组也分配一个槽位，供空闲链表使用
+        int slots = size > 0 ? size : 1;
+        tuple = (PyTupleObject*)py_gc_malloc(sizeof(PyTupleObject) + (size_t)slots * sizeof(PyObject*));
+        if (!tuple)
+        {
+            fprintf(stderr, "MemoryError: Failed to allocate tuple of size %d\n", size);
+            return NULL;
+        }
+    }
+
+    tuple->header.refCount = 1;
+    tuple->header.typeId = PY_TYPE_TUPLE;
+    tuple->header.flags = 0;
+    tuple->length = size;
+    tuple->hashCached = 0;
+    tuple->hash = 0;
+    for (int i = 0; i < size; i++)
+    {
+        tuple->items[i] = NULL;
+    }
+    PY_MEMSTATS_OBJECT_ALLOC(tuple);
+    py_gc_track((PyObject*)tuple);
+    return (PyObject*)tuple;
+}
+
+// 释放元组持有的元素，并把元组本身放回空闲链表 (链表已满时释放内存)
+static void py_tuple_dealloc(PyTupleObject* tuple)
+{
+    py_gc_untrack((PyObject*)tuple);  // 空闲链表中的元组不跟踪，复用时重新跟踪
+    int size = tuple->length;
+    for (int i = 0; i < size; i++)
+    {
+        py_decref(tuple->items[i]);
+    }
+
+    if (size <= PY_TUPLE_FREELIST_MAX_ARITY && tuple_freelist_count[size] < PY_TUPLE_FREELIST_MAX_COUNT)
+    {
+        tuple->items[0] = (PyObject*)tuple_freelist[size];
+        tuple_freelist[size] = tuple;
+        tuple_freelist_count[size]++;
+        return;
+    }
+    py_gc_free((PyObject*)tuple);
+}
+
+//===----------------------------------------------------------------------===//
+// 集合对象
+//===----------------------------------------------------------------------===//
+
+// 能容纳 n 个元素且装载因子低于 3/4 的最小容量 (2 的幂，至少为 8)
+int py_set_capacity_for(int n)
+{
+    int capacity = 8;
+    while (capacity * 3 <= n * 4)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// 创建空集合，按 minSize 个元素预分配哈希表，批量插入时不再扩容
+PyObject* py_create_set(int minSize)
+{
+    PySetObject* set = (PySetObject*)py_gc_malloc(sizeof(PySetObject));
+    if (!set)
+    {
+        fprintf(stderr, "MemoryError: Failed to allocate set\n");
+        return NULL;
+    }
+
+    int capacity = py_set_capacity_for(minSize > 0 ? minSize : 0);
+    set->entries = (PySetEntry*)py_mem_calloc(capacity, sizeof(PySetEntry));
+    if (!set->entries)
+    {
+        fprintf(stderr, "MemoryError: Failed to allocate set table (capacity %d)\n", capacity);
+        py_gc_free((PyObject*)set);
+        return NULL;
+    }
+
+    set->header.refCount = 1;
+    set->header.typeId = PY_TYPE_SET;
+    set->header.flags = 0;
+    set->size = 0;
+    set->fill = 0;
+    set->capacity = capacity;
+    PY_MEMSTATS_OBJECT_ALLOC(set);
+    py_gc_track((PyObject*)set);
+    return (PyObject*)set;
+}
+
 // 创建字典对象
 PyObject* py_create_dict(int initialCapacity, int keyTypeId)
 {
     // 分配字典对象内存
-    PyDictObject* dict = (PyDictObject*)malloc(sizeof(PyDictObject));
+    PyDictObject* dict = (PyDictObject*)py_gc_malloc(sizeof(PyDictObject));
     if (!dict)
     {
         fprintf(stderr, "Error: Out of memory for dictionary\n");
@@ -323,18 +744,23 @@ PyObject* py_create_dict(int initialCapacity, int keyTypeId)
     // 初始化字典头
     dict->header.refCount = 1;
     dict->header.typeId = PY_TYPE_DICT;
+    dict->header.flags = 0;
     dict->size = 0;
     dict->keyTypeId = keyTypeId;
+    dict->version = 0;
+    dict->base = NULL;
+    dict->exports = 0;
+    dict->retired = NULL;
 
     // 分配条目数组内存
     int capacity = initialCapacity > 0 ? initialCapacity : 8;  // 默认初始容量为8
     dict->capacity = capacity;
-    dict->entries = (PyDictEntry*)calloc(capacity, sizeof(PyDictEntry));
+    dict->entries = (PyDictEntry*)py_mem_calloc(capacity, sizeof(PyDictEntry));
 
     if (!dict->entries)
     {
         fprintf(stderr, "Error: Out of memory for dictionary entries\n");
-        free(dict);
+        py_gc_free((PyObject*)dict);
         return NULL;
     }
 
@@ -347,6 +773,8 @@ PyObject* py_create_dict(int initialCapacity, int keyTypeId)
         dict->entries[i].used = false;
     }
 
+    PY_MEMSTATS_OBJECT_ALLOC(dict);
+    py_gc_track((PyObject*)dict);
     return (PyObject*)dict;
 }
 
@@ -366,6 +794,7 @@ PyObject* py_get_none(void)
         }
         // None对象是单例，引用计数设为很大
         noneObj->refCount = INT_MAX;
+        noneObj->flags = PY_OBJECT_FLAG_IMMORTAL;
     }
 
     return noneObj;
@@ -378,7 +807,7 @@ PyObject* py_get_none(void)
 // 增加对象引用计数
 void py_incref(PyObject* obj)
 {
-    if (obj && obj->refCount < INT_MAX)
+    if (obj && !py_is_immortal(obj))
     {
         // LOG_DEBUG("py_incref: %p, type: %s (%d), refCount before: %d", // Original
         //          (void*)obj, py_type_name(obj->typeId), obj->typeId, obj->refCount);
@@ -414,6 +843,27 @@ void py_iterator_decref_specialized(PyObject* obj)
             py_decref(iter->iterable);
         }
         break;
+        case llvmpy::PY_TYPE_RANGE_ITERATOR:
+            // range 迭代器只保存整数状态，没有需要释放的引用
+            break;
+        case llvmpy::PY_TYPE_TUPLE_ITERATOR:
+        {
+            PyTupleIteratorObject* iter = (PyTupleIteratorObject*)obj;
+            py_decref(iter->iterable);
+        }
+        break;
+        case llvmpy::PY_TYPE_SET_ITERATOR:
+        {
+            PySetIteratorObject* iter = (PySetIteratorObject*)obj;
+            py_decref(iter->iterable);
+        }
+        break;
+        case llvmpy::PY_TYPE_DICT_ITERATOR:
+        {
+            PyDictIteratorObject* iter = (PyDictIteratorObject*)obj;
+            py_decref(iter->iterable);
+        }
+        break;
         default:
             LOG_WARN("py_iterator_decref_specialized called with unhandled specific iterator typeId %d (%s) for obj %p",
                      obj->typeId, py_type_name(obj->typeId), (void*)obj);
@@ -421,12 +871,166 @@ void py_iterator_decref_specialized(PyObject* obj)
             break;
     }
     LOG_DEBUG("py_iterator_decref_specialized EXIT: Freeing obj %p", (void*)obj);
-    free(obj);
+    py_mem_free(obj);
 }
+//===----------------------------------------------------------------------===//
+// 对象释放与延迟释放栈 (trashcan)
+//===----------------------------------------------------------------------===//
+
+// 容器释放时对元素 py_decref，元素本身又可能是容器，深层嵌套的结构 (如百万层的链表)
+// 逐层递归释放会耗尽 C 栈。嵌套释放达到 PY_TRASHCAN_DEPTH_LIMIT 层后，引用计数归零的
+// 对象先压入延迟释放栈，由最外层的释放循环成批处理。
+#define PY_TRASHCAN_DEPTH_LIMIT 50
+
+static int py_dealloc_depth = 0;
+static PyObject** py_trashcan = NULL;
+static size_t py_trashcan_count = 0;
+static size_t py_trashcan_capacity = 0;
+
+// 引用计数已归零，按类型释放对象持有的引用和内存
+static void py_object_dealloc(PyObject* obj)
+{
+    PY_MEMSTATS_OBJECT_FREE(obj);
+
+    // 根据类型执行清理
+    int original_typeId_at_decref_zero = obj->typeId;
+    int baseTypeId = llvmpy::getBaseTypeId(original_typeId_at_decref_zero);
+    LOG_DEBUG("py_decref: %p, refCount is 0. original_typeId: %s (%d), baseTypeId: %s (%d). Preparing to free/spec_decref.",
+              (void*)obj, py_type_name(original_typeId_at_decref_zero), original_typeId_at_decref_zero,
+              py_type_name(baseTypeId), baseTypeId);  // Assuming py_type_name can handle baseTypeIds too
+
+    switch (baseTypeId)
+    {
+        case llvmpy::PY_TYPE_LIST:
+            LOG_DEBUG("py_decref (%p): Freeing List.", (void*)obj);
+            py_list_release_storage((PyListObject*)obj);
+            py_gc_free(obj);
+            break;
+        case llvmpy::PY_TYPE_DICT:
+            py_dict_release_storage((PyDictObject*)obj);
+            py_gc_free(obj);
+            break;
+        case llvmpy::PY_TYPE_STRING:
+            LOG_DEBUG("py_decref (%p): Freeing String.", (void*)obj);
+            if (((PyPrimitiveObject*)obj)->value.stringView.owner)
+            {
+                // 切片视图只借用缓冲区
+                py_decref(((PyPrimitiveObject*)obj)->value.stringView.owner);
+            }
+            else if (((PyPrimitiveObject*)obj)->value.stringValue)
+            {
+                py_mem_free(((PyPrimitiveObject*)obj)->value.stringValue);
+            }
+            py_mem_free(obj);
+            break;
+        case llvmpy::PY_TYPE_CLASS:
+        {
+            PyClassObject* cls = (PyClassObject*)obj;
+            // Name might be shared in the future, but free the copy made in py_create_class
+            py_mem_free((void*)cls->name);
+            py_decref((PyObject*)cls->base);
+            py_decref((PyObject*)cls->class_dict);
+            py_gc_free(obj);
+        }
+        break;
+        case llvmpy::PY_TYPE_INSTANCE:
+        {
+            PyInstanceObject* instance = (PyInstanceObject*)obj;
+            py_decref((PyObject*)instance->cls);
+            py_decref((PyObject*)instance->instance_dict);
+            py_gc_free(obj);
+        }
+        break;
+        case llvmpy::PY_TYPE_RANGE:
+            py_mem_free(obj);
+            break;
+        case llvmpy::PY_TYPE_TUPLE:
+            py_tuple_dealloc((PyTupleObject*)obj);
+            break;
+        case llvmpy::PY_TYPE_SET:
+        {
+            PySetObject* set = (PySetObject*)obj;
+            for (int i = 0; i < set->capacity; i++)
+            {
+                py_decref(set->entries[i].key);  // 空槽和墓碑的 key 为 NULL
+            }
+            py_mem_free(set->entries);
+            py_gc_free(obj);
+        }
+        break;
+        case llvmpy::PY_TYPE_FUNC:
+            // Add cleanup for PyFunctionObject if needed (e.g., free name/docstring)
+            // Assuming func_ptr doesn't need freeing here
+            py_mem_free(obj);
+            break;
+
+        // --- GMP Cleanup ---
+        case llvmpy::PY_TYPE_INT:
+            mpz_clear(((PyPrimitiveObject*)obj)->value.intValue);  // 清理 GMP 整数
+            py_mem_free(obj);
+            break;
+        case llvmpy::PY_TYPE_DOUBLE:
+            mpf_clear(((PyPrimitiveObject*)obj)->value.doubleValue);  // 清理 GMP 浮点数
+            py_mem_free(obj);
+            break;
+            // --- End GMP Cleanup ---
+        case llvmpy::PY_TYPE_ITERATOR_BASE:
+            LOG_DEBUG("py_decref: %p, baseTypeId is ITERATOR_BASE. Calling py_iterator_decref_specialized. Current obj->typeId: %s (%d)",
+                      (void*)obj, py_type_name(obj->typeId), obj->typeId);
+            py_iterator_decref_specialized(obj);
+            break;
+        case llvmpy::PY_TYPE_BOOL:  // True / False 是不计数的单例，不会走到这里
+            LOG_DEBUG("py_decref (%p): Freeing Bool.", (void*)obj);
+            py_mem_free(obj);
+            break;
+        case llvmpy::PY_TYPE_NONE:  // Should not reach here due to initial check
+
+        default:  // 包含其他基本类型和未知类型
+                 LOG_WARN("py_decref on unhandled base typeId %d (original typeId %d, name: %s) for obj %p",
+                     baseTypeId, obj->typeId, py_type_name(obj->typeId), (void*)obj);
+            // fprintf(stderr, "Warning: py_decref on unhandled base typeId %d (original typeId %d, name: %s)\n", baseTypeId, obj->typeId, py_type_name(obj->typeId)); // Replaced
+            py_mem_free(obj);
+            break;
+    }
+}
+
+static bool py_trashcan_push(PyObject* obj)
+{
+    if (py_trashcan_count == py_trashcan_capacity)
+    {
+        size_t capacity = py_trashcan_capacity ? py_trashcan_capacity * 2 : 256;
+        PyObject** grown = (PyObject**)py_mem_realloc(py_trashcan, capacity * sizeof(PyObject*));
+        if (!grown) return false;
+        py_trashcan = grown;
+        py_trashcan_capacity = capacity;
+    }
+    py_trashcan[py_trashcan_count++] = obj;
+    return true;
+}
+
+static void py_object_release(PyObject* obj)
+{
+    // 延迟栈扩容失败时只能继续递归释放
+    if (py_dealloc_depth >= PY_TRASHCAN_DEPTH_LIMIT && py_trashcan_push(obj)) return;
+
+    py_dealloc_depth++;
+    py_object_dealloc(obj);
+    if (py_dealloc_depth == 1)
+    {
+        // 最外层释放: 处理积累的对象 (处理过程中可能继续积累)
+        while (py_trashcan_count > 0)
+        {
+            py_object_dealloc(py_trashcan[--py_trashcan_count]);
+        }
+    }
+    py_dealloc_depth--;
+}
+
 // 减少对象引用计数，如果减至0则释放对象
 void py_decref(PyObject* obj)
 {
     if (!obj || obj->typeId == PY_TYPE_NONE) return;
+    if (py_is_immortal(obj)) return;  // 与 py_incref 一致: 单例、栈上 / 区域中的对象不计数
 
     // LOG_DEBUG("py_decref ENTER: %p, type: %s (%d), refCount before: %d", // Original
     //           (void*)obj, py_type_name(obj->typeId), obj->typeId, obj->refCount);
@@ -456,95 +1060,7 @@ void py_decref(PyObject* obj)
 
     if (obj->refCount == 0)
     {
-        // 根据类型执行清理
-        int original_typeId_at_decref_zero = obj->typeId;
-        int baseTypeId = llvmpy::getBaseTypeId(original_typeId_at_decref_zero);
-        LOG_DEBUG("py_decref: %p, refCount is 0. original_typeId: %s (%d), baseTypeId: %s (%d). Preparing to free/spec_decref.",
-                  (void*)obj, py_type_name(original_typeId_at_decref_zero), original_typeId_at_decref_zero,
-                  py_type_name(baseTypeId), baseTypeId);  // Assuming py_type_name can handle baseTypeIds too
-
-        switch (baseTypeId)
-        {
-            case llvmpy::PY_TYPE_LIST:
-                LOG_DEBUG("py_decref (%p): Freeing List.", (void*)obj);
-                py_list_decref_items((PyListObject*)obj);
-                free(((PyListObject*)obj)->data);
-                free(obj);
-                break;
-            case llvmpy::PY_TYPE_DICT:
-                // 释放字典条目中的键和值
-                for (int i = 0; i < ((PyDictObject*)obj)->capacity; i++)
-                {
-                    PyDictEntry* entry = &((PyDictObject*)obj)->entries[i];
-                    if (entry->used)
-                    {
-                        py_decref(entry->key);    // Decref key
-                        py_decref(entry->value);  // Decref value
-                    }
-                }
-                free(((PyDictObject*)obj)->entries);  // 释放条目数组
-                free(obj);
-                break;
-            case llvmpy::PY_TYPE_STRING:
-                LOG_DEBUG("py_decref (%p): Freeing String.", (void*)obj);
-                if (((PyPrimitiveObject*)obj)->value.stringValue)
-                {
-                    free(((PyPrimitiveObject*)obj)->value.stringValue);
-                }
-                free(obj);
-                break;
-            case llvmpy::PY_TYPE_CLASS:
-            {
-                PyClassObject* cls = (PyClassObject*)obj;
-                // Name might be shared in the future, but free if strdup'd
-                free((void*)cls->name);
-                py_decref((PyObject*)cls->base);
-                py_decref((PyObject*)cls->class_dict);
-                free(obj);
-            }
-            break;
-            case llvmpy::PY_TYPE_INSTANCE:
-            {
-                PyInstanceObject* instance = (PyInstanceObject*)obj;
-                py_decref((PyObject*)instance->cls);
-                py_decref((PyObject*)instance->instance_dict);
-                free(obj);
-            }
-            break;
-            case llvmpy::PY_TYPE_FUNC:
-                // Add cleanup for PyFunctionObject if needed (e.g., free name/docstring)
-                // Assuming func_ptr doesn't need freeing here
-                free(obj);
-                break;
-
-            // --- GMP Cleanup ---
-            case llvmpy::PY_TYPE_INT:
-                mpz_clear(((PyPrimitiveObject*)obj)->value.intValue);  // 清理 GMP 整数
-                free(obj);
-                break;
-            case llvmpy::PY_TYPE_DOUBLE:
-                mpf_clear(((PyPrimitiveObject*)obj)->value.doubleValue);  // 清理 GMP 浮点数
-                free(obj);
-                break;
-                // --- End GMP Cleanup ---
-            case llvmpy::PY_TYPE_ITERATOR_BASE:
-                LOG_DEBUG("py_decref: %p, baseTypeId is ITERATOR_BASE. Calling py_iterator_decref_specialized. Current obj->typeId: %s (%d)",
-                          (void*)obj, py_type_name(obj->typeId), obj->typeId);
-                py_iterator_decref_specialized(obj);
-                break;
-            case llvmpy::PY_TYPE_BOOL:
-                LOG_DEBUG("py_decref (%p): Freeing Bool.", (void*)obj);
-                free(obj);
-                break;
-            case llvmpy::PY_TYPE_NONE:  // Should not reach here due to initial check
-
-            default:  // 包含其他基本类型和未知类型
-                     LOG_WARN("py_decref on unhandled base typeId %d (original typeId %d, name: %s) for obj %p",
-                         baseTypeId, obj->typeId, py_type_name(obj->typeId), (void*)obj);
-                // fprintf(stderr, "Warning: py_decref on unhandled base typeId %d (original typeId %d, name: %s)\n", baseTypeId, obj->typeId, py_type_name(obj->typeId)); // Replaced
-                free(obj);
-                break;
-        }
+        py_object_release(obj);
     }
     else if (obj->refCount < 0)
    {
@@ -558,7 +1074,7 @@ void py_decref(PyObject* obj)
 // 对象复制实现
 //===----------------------------------------------------------------------===//
 
-// 深度复制对象
+// 深度复制对象。列表与字典的元素都不需要复制时返回写时复制的副本 (见 py_list_share / py_dict_clone)
 PyObject* py_object_copy(PyObject* obj, int typeId)
 {
     if (!obj) return NULL;
@@ -611,12 +1127,30 @@ PyObject* py_object_copy(PyObject* obj, int typeId)
         case PY_TYPE_LIST:
         {
             PyListObject* srcList = (PyListObject*)obj;
+            // 元素复制后与原对象无法区分时共享缓冲区，第一次写入时才真正复制
+            if (srcList->length > 0 && py_list_copy_can_share(srcList))
+            {
+                return py_list_share(obj);
+            }
             // Create a new list with the same capacity and element type ID
             PyObject* newListObj = py_create_list(srcList->capacity, srcList->elemTypeId);
             if (!newListObj) return NULL;
 
             PyListObject* newList = (PyListObject*)newListObj;
 
+            // Unboxed storage holds plain values, copy the buffer directly
+            if (srcList->storage != PY_LIST_STORAGE_BOXED && newList->storage == srcList->storage)
+            {
+                memcpy(newList->data, srcList->data, py_list_storage_bytes(srcList->storage, srcList->length));
+                newList->length = srcList->length;
+                return newListObj;
+            }
+            if (srcList->storage != PY_LIST_STORAGE_BOXED || !py_list_despecialize(newList))
+            {
+                py_decref(newListObj);
+                return NULL;
+            }
+
             // Deep copy elements
             for (int i = 0; i < srcList->length; i++)
             {
@@ -643,6 +1177,10 @@ PyObject* py_object_copy(PyObject* obj, int typeId)
         case PY_TYPE_DICT:
         {
             PyDictObject* srcDict = (PyDictObject*)obj;
+            if (py_dict_copy_can_share(srcDict))
+            {
+                return py_dict_clone(obj);  // 写时复制
+            }
             // Create a new dict with same capacity and key type ID
             PyObject* newDictObj = py_create_dict(srcDict->capacity, srcDict->keyTypeId);
             if (!newDictObj) return NULL;
@@ -693,6 +1231,36 @@ PyObject* py_object_copy(PyObject* obj, int typeId)
             return newDictObj;
         }
 
+        case PY_TYPE_TUPLE:
+            // 元组不可变，复制时直接共享同一对象
+            py_incref(obj);
+            return obj;
+
+        case PY_TYPE_SET:
+        {
+            // 集合元素都是可哈希的不可变对象，复制槽位表并共享元素即可，无需重新哈希
+            PySetObject* srcSet = (PySetObject*)obj;
+            PySetObject* newSet = (PySetObject*)py_create_set(0);
+            if (!newSet) return NULL;
+            PySetEntry* entries = (PySetEntry*)py_mem_alloc((size_t)srcSet->capacity * sizeof(PySetEntry));
+            if (!entries)
+            {
+                py_decref((PyObject*)newSet);
+                return NULL;
+            }
+            memcpy(entries, srcSet->entries, (size_t)srcSet->capacity * sizeof(PySetEntry));
+            for (int i = 0; i < srcSet->capacity; i++)
+            {
+                py_incref(entries[i].key);
+            }
+            py_mem_free(newSet->entries);
+            newSet->entries = entries;
+            newSet->capacity = srcSet->capacity;
+            newSet->size = srcSet->size;
+            newSet->fill = srcSet->fill;
+            return (PyObject*)newSet;
+        }
+
         case PY_TYPE_NONE:  // Already handled at the beginning
             return py_get_none();
 
@@ -756,12 +1324,40 @@ int py_object_len(PyObject* obj)
             return dict->size;
         }
 
+        case PY_TYPE_TUPLE:
+            return ((PyTupleObject*)obj)->length;
+
+        case PY_TYPE_SET:
+            return ((PySetObject*)obj)->size;
+
         default:
             fprintf(stderr, "TypeError: Object of type %d has no len()\n", baseTypeId);
             return 0;
     }
 }
 
+// 推导式等按来源长度预分配时使用: 与 py_object_len 相同，但对没有长度的对象 (迭代器等) 静默返回 0
+int py_object_length_hint(PyObject* obj)
+{
+    if (!obj) return 0;
+    switch (getBaseTypeId(obj->typeId))
+    {
+        case PY_TYPE_STRING:
+        case PY_TYPE_LIST:
+        case PY_TYPE_DICT:
+        case PY_TYPE_TUPLE:
+        case PY_TYPE_SET:
+            return py_object_len(obj);
+        case PY_TYPE_RANGE:
+        {
+            int64_t length = ((PyRangeObject*)obj)->length;
+            return length > INT_MAX ? INT_MAX : (int)length;
+        }
+        default:
+            return 0;
+    }
+}
+
 //===----------------------------------------------------------------------===//
 // 类型提取工具函数 (支持索引操作)
 //===----------------------------------------------------------------------===//
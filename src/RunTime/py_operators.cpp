@@ -244,21 +244,13 @@ PyObject* py_object_add(PyObject* a, PyObject* b)
             fprintf(stderr, "MemoryError: String concatenation result too large\n");
             return NULL;
         }
-        char* result = (char*)malloc(lenA + lenB + 1);
-
-        if (!result)
+        PyObject* resultObj = py_create_string_with_length(NULL, lenA + lenB);
+        if (resultObj)
         {
-            fprintf(stderr, "MemoryError: Failed to allocate memory for string concatenation\n");
-            return NULL;
+            char* chars = ((PyPrimitiveObject*)resultObj)->value.stringValue;
+            memcpy(chars, strA, lenA);
+            memcpy(chars + lenA, strB, lenB);
         }
-
-        // Use memcpy for potentially better performance with long strings
-        memcpy(result, strA, lenA);
-        memcpy(result + lenA, strB, lenB);
-        result[lenA + lenB] = '\0';
-
-        PyObject* resultObj = py_create_string(result);
-        free(result);  // py_create_string makes a copy
         return resultObj;
     }
 
@@ -305,20 +297,42 @@ PyObject* py_object_add(PyObject* a, PyObject* b)
             return NULL;
         }
 
+        // Same unboxed storage on both sides: copy the raw buffers
+        if (listA->storage != PY_LIST_STORAGE_BOXED && listA->storage == listB->storage && resultList->storage == listA->storage)
+        {
+            if (!py_list_extend_unboxed(resultList, listA) || !py_list_extend_unboxed(resultList, listB))
+            {
+                py_decref(resultListObj);
+                return NULL;
+            }
+            return resultListObj;
+        }
+
+        // Elements go through py_list_append so that the storage strategy of
+        // the result (boxed or unboxed) is respected
         for (int i = 0; i < listA->length; i++)
         {
-            PyObject* item = listA->data[i];
-            if (item) py_incref(item);
-            resultList->data[i] = item;
+            PyObject* item = py_list_box_item(listA, i);
+            PyObject* ok = py_list_append(resultListObj, item);
+            py_decref(item);
+            if (!ok)
+            {
+                py_decref(resultListObj);
+                return NULL;
+            }
         }
         for (int i = 0; i < listB->length; i++)
         {
-            PyObject* item = listB->data[i];
-            if (item) py_incref(item);
-            resultList->data[listA->length + i] = item;
+            PyObject* item = py_list_box_item(listB, i);
+            PyObject* ok = py_list_append(resultListObj, item);
+            py_decref(item);
+            if (!ok)
+            {
+                py_decref(resultListObj);
+                return NULL;
+            }
         }
 
-        resultList->length = newLength;
         return resultListObj;
     }
 
@@ -328,6 +342,86 @@ PyObject* py_object_add(PyObject* a, PyObject* b)
     return NULL;
 }
 
+// 字符串变量的自拼接 x = x + piece / x += piece (由代码生成识别)，slot 是变量的存储位置。
+// ownsBuffer 由代码生成维护: 为 true 表示变量当前的值由本函数为该变量创建，且之后没有被别处引用，
+// 此时直接在其缓冲区末尾追加，缓冲区按倍数增长，重复拼接摊还为线性。
+// 否则复制出一个带预留空间的新字符串，按普通赋值的约定替换变量的值。
+// 缓冲区始终以 NUL 结尾，其他操作照常读取，不需要额外的展开步骤。
+// 返回变量是否持有可原地追加的缓冲区 (作为下一次调用的 ownsBuffer)。
+bool py_string_append_to(PyObject** slot, PyObject* piece, bool ownsBuffer)
+{
+    PyObject* target = *slot;
+    if (py_get_safe_type_id(target) != PY_TYPE_STRING || py_get_safe_type_id(piece) != PY_TYPE_STRING)
+    {
+        PyObject* result = py_object_add(target, piece);
+        py_decref(target);
+        *slot = result;
+        py_incref(result);
+        return false;
+    }
+
+    PyPrimitiveObject* str = (PyPrimitiveObject*)target;
+    const char* pieceChars = py_extract_string(piece);
+    if (!pieceChars) pieceChars = "";
+    size_t pieceLen = strlen(pieceChars);
+
+    bool inPlace = ownsBuffer && !str->value.stringView.owner && str->value.stringView.capacity > 0;
+    size_t len = inPlace ? (size_t)str->value.stringView.length
+                         : (str->value.stringValue ? strlen(str->value.stringValue) : 0);
+    size_t needed = len + pieceLen + 1;
+    if (needed > INT_MAX)
+    {
+        fprintf(stderr, "MemoryError: String concatenation result too large\n");
+        return inPlace;
+    }
+    size_t capacity = needed < 16 ? 16 : needed + needed / 2;
+    if (capacity > INT_MAX) capacity = INT_MAX;
+
+    if (inPlace)
+    {
+        if (needed > (size_t)str->value.stringView.capacity)
+        {
+            char* grown = (char*)py_mem_realloc(str->value.stringValue, capacity);
+            if (!grown)
+            {
+                fprintf(stderr, "MemoryError: Failed to allocate memory for string concatenation\n");
+                return true;
+            }
+            if (piece == target) pieceChars = grown;  // s = s + s
+            str->value.stringValue = grown;
+            str->value.stringView.capacity = (int)capacity;
+        }
+        memmove(str->value.stringValue + len, pieceChars, pieceLen);
+        str->value.stringValue[len + pieceLen] = '\0';
+        str->value.stringView.length = (int)(len + pieceLen);
+        py_incref(target);  // 与普通赋值相同的计数 (旧值 -1，新值 +2)，作用域结束时的 decRef 依赖它
+        return true;
+    }
+
+    char* buffer = (char*)py_mem_alloc(capacity);
+    PyObject* result = buffer ? py_create_string_with_length("", 0) : NULL;
+    if (!result)
+    {
+        fprintf(stderr, "MemoryError: Failed to allocate memory for string concatenation\n");
+        py_mem_free(buffer);
+        return false;
+    }
+    memcpy(buffer, str->value.stringValue ? str->value.stringValue : "", len);
+    memcpy(buffer + len, pieceChars, pieceLen);
+    buffer[len + pieceLen] = '\0';
+
+    PyPrimitiveObject* builder = (PyPrimitiveObject*)result;
+    py_mem_free(builder->value.stringValue);
+    builder->value.stringValue = buffer;
+    builder->value.stringView.length = (int)(len + pieceLen);
+    builder->value.stringView.capacity = (int)capacity;
+
+    py_decref(target);
+    *slot = result;
+    py_incref(result);
+    return true;
+}
+
 // 减法操作符
 PyObject* py_object_subtract(PyObject* a, PyObject* b)
 {
@@ -718,7 +812,7 @@ PyObject* py_object_multiply(PyObject* a, PyObject* b)
 #ifdef DEBUG_RUNTIME_OPERATORS
             fprintf(stderr, "DEBUG:   Calculated total_len: %zu\n", total_len);
 #endif
-            char* result = (char*)malloc(total_len + 1);
+            char* result = (char*)py_mem_alloc(total_len + 1);
             if (!result)
             {
                 fprintf(stderr, "MemoryError: Failed to allocate memory for string repetition\n");
@@ -737,7 +831,7 @@ PyObject* py_object_multiply(PyObject* a, PyObject* b)
 #ifdef DEBUG_RUNTIME_OPERATORS
             fprintf(stderr, "DEBUG:   Created repeated string: '%s', object: %p\n", result, (void*)resultObj);
 #endif
-            free(result);
+            py_mem_free(result);
             return resultObj;
         }
         else if (seqTypeId == PY_TYPE_LIST)
@@ -757,47 +851,40 @@ PyObject* py_object_multiply(PyObject* a, PyObject* b)
 #ifdef DEBUG_RUNTIME_OPERATORS
             fprintf(stderr, "DEBUG:   Calculated newLength: %d\n", newLength);
 #endif
-            // Create list with capacity hint = newLength
-            PyObject* resultListObj = py_create_list(newLength, list->elemTypeId);
-            if (!resultListObj) return NULL;
-            PyListObject* resultList = (PyListObject*)resultListObj;
-#ifdef DEBUG_RUNTIME_OPERATORS
-            fprintf(stderr, "DEBUG:   py_create_list returned: %p, initial length: %d, capacity: %d\n",
-                    (void*)resultList, resultList->length, resultList->capacity);
-#endif
-            // Check if capacity is sufficient (py_create_list should guarantee this)
-            if (resultList->capacity < newLength)
+            // Boxed storage: gather the (borrowed) element pointers count times and
+            // build the result in one pass, without per-element append/type checks
+            if (list->storage == PY_LIST_STORAGE_BOXED)
             {
-                fprintf(stderr, "Internal Error: Insufficient capacity (%d < %d) after py_create_list in list repetition.\n",
-                        resultList->capacity, newLength);
-                py_decref(resultListObj);
-                return NULL;
+                PyObject** items = (PyObject**)py_mem_alloc((size_t)(newLength > 0 ? newLength : 1) * sizeof(PyObject*));
+                if (!items)
+                {
+                    fprintf(stderr, "MemoryError: Failed to allocate memory for list repetition\n");
+                    return NULL;
+                }
+                for (long c = 0; c < count_val; ++c)
+                {
+                    memcpy(items + c * list->length, list->data, (size_t)list->length * sizeof(PyObject*));
+                }
+                PyObject* resultListObj = py_create_list_from_array(items, newLength, list->elemTypeId, false);
+                py_mem_free(items);
+                return resultListObj;
             }
 
-            PyObject** dest_ptr = resultList->data;
+            // Unboxed storage (the result picks the same storage from elemTypeId):
+            // append the raw buffer count times
+            PyObject* resultListObj = py_create_list(newLength, list->elemTypeId);
+            if (!resultListObj) return NULL;
+            PyListObject* resultList = (PyListObject*)resultListObj;
             for (long c = 0; c < count_val; ++c)
             {
-                for (int i = 0; i < list->length; ++i)
+                if (!py_list_extend_unboxed(resultList, list))
                 {
-                    PyObject* item = list->data[i];
-#ifdef DEBUG_RUNTIME_OPERATORS
-                    // Be cautious with printing item details if it could be complex
-                    // fprintf(stderr, "DEBUG:     Copying item %p from original index %d to new index %ld\n",
-                    //         (void*)item, i, (long)(dest_ptr - resultList->data));
-#endif
-                    if (item) py_incref(item); // Incref item from original list
-                    *dest_ptr++ = item;        // Copy pointer to new list
+                    py_decref(resultListObj);
+                    return NULL;
                 }
             }
 #ifdef DEBUG_RUNTIME_OPERATORS
-            long items_copied = dest_ptr - resultList->data;
-            fprintf(stderr, "DEBUG:   Finished copying elements. items_copied = %ld (expected %d)\n", items_copied, newLength);
-#endif
-            // Set the final length of the new list
-            resultList->length = newLength;
-#ifdef DEBUG_RUNTIME_OPERATORS
-            fprintf(stderr, "DEBUG:   Set resultList->length = %d\n", resultList->length);
-            fprintf(stderr, "DEBUG:   Returning new list object: %p\n", (void*)resultListObj);
+            fprintf(stderr, "DEBUG:   Returning new list object: %p, length = %d\n", (void*)resultListObj, resultList->length);
 #endif
             return resultListObj;
         }
@@ -1593,9 +1680,8 @@ PyObject* py_object_not(PyObject* a)
 // 比较操作符实现
 //===----------------------------------------------------------------------===//
 
-// 比较操作
-// 比较操作 (根据之前的讨论修改)
-PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
+// 比较操作: 返回 1 / 0，出错返回 -1 (不分配结果对象)
+int py_object_compare_result(PyObject* a, PyObject* b, PyCompareOp op)
 {
     // Step 0: Handle C NULL pointers.
     // These are distinct from Python's None object.
@@ -1607,9 +1693,9 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
         else {
             // Ordering comparisons with a C NULL pointer should be an error.
             fprintf(stderr, "TypeError: '%s' not supported with NULL pointer operand\n", py_compare_op_name(op));
-            return NULL; // Indicate error
+            return -1; // Indicate error
         }
-        return py_create_bool(result);
+        return result ? 1 : 0;
     }
 
     PyObject* none_singleton = py_get_none(); // Get the unique None object
@@ -1622,22 +1708,35 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
         // If either operand is Python's None:
         bool identity_match = (a == b); // Since None is a singleton, pointer comparison is key.
         if (op == PY_CMP_EQ) {
-            return py_create_bool(identity_match);
+            return identity_match ? 1 : 0;
         } else if (op == PY_CMP_NE) {
-            return py_create_bool(!identity_match);
+            return !identity_match ? 1 : 0;
         } else {
             // Ordering comparisons (<, <=, >, >=) with None raise TypeError in Python 3.
             fprintf(stderr, "TypeError: '%s' not supported between instances of '%s' and '%s'\n",
                     py_compare_op_name(op),
                     py_type_name(py_get_safe_type_id(a)), // py_get_safe_type_id should correctly name PY_TYPE_NONE
                     py_type_name(py_get_safe_type_id(b)));
-            return NULL; // Indicate TypeError
+            return -1; // Indicate TypeError
         }
     }
 
+    // 同类型的列表 / 元组 / 字典: 逐元素比较 (派生的列表类型 ID 也按基础类型处理)
+    int aBaseTypeId = getBaseTypeId(a->typeId);
+    if ((aBaseTypeId == PY_TYPE_LIST || aBaseTypeId == PY_TYPE_TUPLE || aBaseTypeId == PY_TYPE_DICT) &&
+        aBaseTypeId == getBaseTypeId(b->typeId)) {
+        return py_container_compare(a, b, op);
+    }
+
     // Step 2: Neither 'a' nor 'b' is Python's None. Proceed with rich comparison / other types.
     // Handle EQ and NE via type-specific 'equals' method or fallback to identity.
     if (op == PY_CMP_EQ || op == PY_CMP_NE) {
+        // 同类型的数值与字符串直接比较，不经过 equals 槽位分配的 bool 对象
+        if (aBaseTypeId == getBaseTypeId(b->typeId) &&
+            (aBaseTypeId == PY_TYPE_INT || aBaseTypeId == PY_TYPE_DOUBLE ||
+             aBaseTypeId == PY_TYPE_BOOL || aBaseTypeId == PY_TYPE_STRING)) {
+            return (py_object_equal(a, b) == 1) == (op == PY_CMP_EQ);
+        }
         int typeIdA = py_get_safe_type_id(a);
         const PyTypeMethods* methodsA = py_get_type_methods(typeIdA);
 
@@ -1647,13 +1746,13 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
                 if (py_get_safe_type_id(resultObj) == PY_TYPE_BOOL) {
                     bool eq_result = py_extract_bool(resultObj);
                     py_decref(resultObj);
-                    return py_create_bool(op == PY_CMP_EQ ? eq_result : !eq_result);
+                    return (op == PY_CMP_EQ ? eq_result : !eq_result) ? 1 : 0;
                 } else {
                     // __eq__ should return a boolean or NotImplemented.
                     // If it's not bool, it's a TypeError.
                     fprintf(stderr, "TypeError: __eq__ returned non-boolean (type %s)\n", py_type_name(resultObj->typeId));
                     py_decref(resultObj);
-                    return NULL;
+                    return -1;
                 }
             } else {
                 // methodsA->equals returned NULL. This could mean an error,
@@ -1665,7 +1764,7 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
         }
         // Fallback to identity comparison if no specific 'equals' or if it returned NULL (simplified).
         bool identity_result = (a == b); // C pointer comparison
-        return py_create_bool(op == PY_CMP_EQ ? identity_result : !identity_result);
+        return (op == PY_CMP_EQ ? identity_result : !identity_result) ? 1 : 0;
     }
 
     // Step 3: Handle ordering comparisons (<, <=, >, >=) for non-None types.
@@ -1704,12 +1803,12 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
             if (a_float) op_a_f = a_float;
             else if (a_int) { mpf_set_z(temp_a, a_int); op_a_f = temp_a; use_temp_a = true; }
             else if (a_is_bool) { mpf_set_ui(temp_a, a_bool_val ? 1 : 0); op_a_f = temp_a; use_temp_a = true; }
-            else { mpf_clear(temp_a); mpf_clear(temp_b); return NULL; }
+            else { mpf_clear(temp_a); mpf_clear(temp_b); return -1; }
 
             if (b_float) op_b_f = b_float;
             else if (b_int) { mpf_set_z(temp_b, b_int); op_b_f = temp_b; use_temp_b = true; }
             else if (b_is_bool) { mpf_set_ui(temp_b, b_bool_val ? 1 : 0); op_b_f = temp_b; use_temp_b = true; }
-            else { if(use_temp_a) mpf_clear(temp_a); mpf_clear(temp_b); return NULL; }
+            else { if(use_temp_a) mpf_clear(temp_a); mpf_clear(temp_b); return -1; }
             
             cmp_val = mpf_cmp(op_a_f, op_b_f);
             if (use_temp_a) mpf_clear(temp_a);
@@ -1722,11 +1821,11 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
 
             if (a_int) op_a_z = a_int;
             else if (a_is_bool) { mpz_set_ui(temp_a_z, a_bool_val ? 1 : 0); op_a_z = temp_a_z; use_temp_a_z = true; }
-            else { mpz_clear(temp_a_z); mpz_clear(temp_b_z); return NULL; }
+            else { mpz_clear(temp_a_z); mpz_clear(temp_b_z); return -1; }
 
             if (b_int) op_b_z = b_int;
             else if (b_is_bool) { mpz_set_ui(temp_b_z, b_bool_val ? 1 : 0); op_b_z = temp_b_z; use_temp_b_z = true; }
-            else { if(use_temp_a_z) mpz_clear(temp_a_z); mpz_clear(temp_b_z); return NULL; }
+            else { if(use_temp_a_z) mpz_clear(temp_a_z); mpz_clear(temp_b_z); return -1; }
 
             cmp_val = mpz_cmp(op_a_z, op_b_z);
             if (use_temp_a_z) mpz_clear(temp_a_z);
@@ -1739,9 +1838,9 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
             case PY_CMP_LE: final_result = (cmp_val <= 0); break;
             case PY_CMP_GT: final_result = (cmp_val > 0); break;
             case PY_CMP_GE: final_result = (cmp_val >= 0); break;
-            default: fprintf(stderr, "Internal Error: Unhandled numeric comparison op %d\n", op); return NULL;
+            default: fprintf(stderr, "Internal Error: Unhandled numeric comparison op %d\n", op); return -1;
         }
-        return py_create_bool(final_result);
+        return final_result ? 1 : 0;
     }
 
     // --- String Comparison ---
@@ -1760,16 +1859,22 @@ PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
             case PY_CMP_LE: final_result_str = (cmpResult_str <= 0); break;
             case PY_CMP_GT: final_result_str = (cmpResult_str > 0); break;
             case PY_CMP_GE: final_result_str = (cmpResult_str >= 0); break;
-            default: fprintf(stderr, "Internal Error: Unhandled string comparison op %d\n", op); return NULL;
+            default: fprintf(stderr, "Internal Error: Unhandled string comparison op %d\n", op); return -1;
         }
-        return py_create_bool(final_result_str);
+        return final_result_str ? 1 : 0;
     }
 
     // Step 4: Incompatible types for ordering comparison.
     fprintf(stderr, "TypeError: '%s' not supported between instances of '%s' and '%s'\n",
             py_compare_op_name(op),
             py_type_name(aTypeId), py_type_name(bTypeId));
-    return NULL; // Indicate TypeError
+    return -1; // Indicate TypeError
+}
+
+PyObject* py_object_compare(PyObject* a, PyObject* b, PyCompareOp op)
+{
+    int result = py_object_compare_result(a, b, op);
+    return result < 0 ? NULL : py_create_bool(result == 1);
 }
 
 // 获取compare_op名字的赋值函数
@@ -1797,70 +1902,101 @@ const char* py_compare_op_name(PyCompareOp op)
 // 相等性比较辅助函数 (可以保留，但现在主要逻辑在 py_object_compare 中)
 bool py_compare_eq(PyObject* a, PyObject* b)
 {
-    PyObject* result = py_object_compare(a, b, PY_CMP_EQ);
-    if (!result)
+    int result = py_object_compare_result(a, b, PY_CMP_EQ);
+    if (result < 0)
     {
         fprintf(stderr, "Error: py_object_compare(EQ) failed\n");
         return false;
     }  // Error occurred in compare
-    bool eq = py_extract_bool(result);
-    py_decref(result);
-    return eq;
+    return result == 1;
 }
 
 bool py_compare_ne(PyObject* a, PyObject* b) {
-    PyObject* result = py_object_compare(a, b, PY_CMP_NE);
-    if (!result){
+    int result = py_object_compare_result(a, b, PY_CMP_NE);
+    if (result < 0){
         fprintf(stderr, "Error: py_object_compare(NE) failed\n");
          return true;
      } // Error occurred, maybe treat as unequal? Or propagate error?
-    bool ne = py_extract_bool(result);
-    py_decref(result);
-    return ne;
+    return result == 1;
 }
 
 // 小于比较辅助函数
 bool py_compare_lt(PyObject* a, PyObject* b) {
-    PyObject* result = py_object_compare(a, b, PY_CMP_LT);
-    if (!result) {
+    int result = py_object_compare_result(a, b, PY_CMP_LT);
+    if (result < 0) {
         fprintf(stderr, "Error: py_object_compare(LT) failed\n");
         return false;} // Error (TypeError) occurred
-    bool lt = py_extract_bool(result);
-    py_decref(result);
-    return lt;
+    return result == 1;
 }
 
 // 小于等于比较辅助函数
 bool py_compare_le(PyObject* a, PyObject* b) {
-    PyObject* result = py_object_compare(a, b, PY_CMP_LE);
-    if (!result){
+    int result = py_object_compare_result(a, b, PY_CMP_LE);
+    if (result < 0){
         fprintf(stderr, "Error: py_object_compare(LE) failed\n");
         return false; }// Error (TypeError) occurred
-    bool le = py_extract_bool(result);
-    py_decref(result);
-    return le;
+    return result == 1;
 }
 
 // 大于比较辅助函数
 bool py_compare_gt(PyObject* a, PyObject* b) {
-    PyObject* result = py_object_compare(a, b, PY_CMP_GT);
-    if (!result) {
+    int result = py_object_compare_result(a, b, PY_CMP_GT);
+    if (result < 0) {
         fprintf(stderr, "Error: py_object_compare(GT) failed\n");
         return false;} // Error (TypeError) occurred
-    bool gt = py_extract_bool(result);
-    py_decref(result);
-    return gt;
+    return result == 1;
 }
 
 // 大于等于比较辅助函数
 bool py_compare_ge(PyObject* a, PyObject* b) {
-    PyObject* result = py_object_compare(a, b, PY_CMP_GE);
-    if (!result) {
+    int result = py_object_compare_result(a, b, PY_CMP_GE);
+    if (result < 0) {
         fprintf(stderr, "Error: py_object_compare(GE) failed\n");
         return false;} // Error (TypeError) occurred
-    bool ge = py_extract_bool(result);
-    py_decref(result);
-    return ge;
+    return result == 1;
+}
+
+//===----------------------------------------------------------------------===//
+// 写入调用者提供的存储 (不逃逸的临时对象)
+//===----------------------------------------------------------------------===//
+//
+// 代码生成的逃逸分析把只在一个表达式内使用的结果放进栈上的 storage，见 py_init_*_into。
+// 算术结果只有 int 与 int 运算时写入 storage，其余情况回退到堆上的普通结果；
+// 调用者随后总是以 py_release_into 结束其生命周期。
+
+PyObject* py_object_compare_into(PyObject* a, PyObject* b, PyCompareOp op, PyPrimitiveObject* storage)
+{
+    int result = py_object_compare_result(a, b, op);
+    return result < 0 ? NULL : py_init_bool_into(storage, result == 1);
+}
+
+static bool py_both_int(PyObject* a, PyObject* b)
+{
+    return a && b && getBaseTypeId(a->typeId) == PY_TYPE_INT && getBaseTypeId(b->typeId) == PY_TYPE_INT;
+}
+
+PyObject* py_object_add_into(PyObject* a, PyObject* b, PyPrimitiveObject* storage)
+{
+    if (!py_both_int(a, b)) return py_object_add(a, b);
+    PyObject* result = py_init_int_into(storage, 0);
+    mpz_add(storage->value.intValue, py_extract_int(a), py_extract_int(b));
+    return result;
+}
+
+PyObject* py_object_subtract_into(PyObject* a, PyObject* b, PyPrimitiveObject* storage)
+{
+    if (!py_both_int(a, b)) return py_object_subtract(a, b);
+    PyObject* result = py_init_int_into(storage, 0);
+    mpz_sub(storage->value.intValue, py_extract_int(a), py_extract_int(b));
+    return result;
+}
+
+PyObject* py_object_multiply_into(PyObject* a, PyObject* b, PyPrimitiveObject* storage)
+{
+    if (!py_both_int(a, b)) return py_object_multiply(a, b);
+    PyObject* result = py_init_int_into(storage, 0);
+    mpz_mul(storage->value.intValue, py_extract_int(a), py_extract_int(b));
+    return result;
 }
 
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,131 @@
+#include "RunTime/runtime.h"
+#include "TypeIDs.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace llvmpy;
+
+//===----------------------------------------------------------------------===//
+// 区域存储: 固定大小的槽位块，槽位按全局序号 bump 分配
+//===----------------------------------------------------------------------===//
+
+namespace
+{
+
+constexpr size_t kRegionChunkSlots = 256;
+
+struct RegionChunk
+{
+    PyPrimitiveObject slots[kRegionChunkSlots];
+};
+
+struct RegionStack
+{
+    std::vector<RegionChunk*> chunks;  // 只增不减，pop 后留给之后的区域复用
+    std::vector<size_t> marks;         // 每层区域开始时的 top
+    size_t top = 0;                    // 已分配的槽位数
+
+    PyPrimitiveObject* slot(size_t index)
+    {
+        return &chunks[index / kRegionChunkSlots]->slots[index % kRegionChunkSlots];
+    }
+};
+
+RegionStack& regions()
+{
+    static RegionStack stack;
+    return stack;
+}
+
+}  // namespace
+
+//===----------------------------------------------------------------------===//
+// 区域 API
+//===----------------------------------------------------------------------===//
+
+void py_region_push(void)
+{
+    RegionStack& stack = regions();
+    stack.marks.push_back(stack.top);
+}
+
+void py_region_pop(void)
+{
+    RegionStack& stack = regions();
+    if (stack.marks.empty())
+    {
+        fprintf(stderr, "Warning: py_region_pop called without a matching py_region_push\n");
+        return;
+    }
+
+    size_t mark = stack.marks.back();
+    stack.marks.pop_back();
+    for (size_t i = mark; i < stack.top; i++)
+    {
+        // 槽位清零分配，*_into 回退到堆上时 typeId 保持为 0，不需要清理
+        PyPrimitiveObject* storage = stack.slot(i);
+        py_release_into((PyObject*)storage, storage);
+    }
+    stack.top = mark;
+}
+
+PyPrimitiveObject* py_region_alloc_object(void)
+{
+    RegionStack& stack = regions();
+    if (stack.marks.empty()) return NULL;
+
+    if (stack.top == stack.chunks.size() * kRegionChunkSlots)
+    {
+        RegionChunk* chunk = (RegionChunk*)py_mem_alloc(sizeof(RegionChunk));
+        if (!chunk)
+        {
+            fprintf(stderr, "MemoryError: Failed to allocate region chunk\n");
+            return NULL;
+        }
+        stack.chunks.push_back(chunk);
+    }
+
+    PyPrimitiveObject* storage = stack.slot(stack.top++);
+    memset(storage, 0, sizeof(PyPrimitiveObject));
+    return storage;
+}
+
+bool py_region_contains(const PyObject* obj)
+{
+    RegionStack& stack = regions();
+    if (!obj || stack.marks.empty()) return false;
+
+    // 逃逸点与分配在同一个函数调用中，只需要检查当前区域的槽位 [mark, top)
+    size_t begin = stack.marks.back();
+    const PyPrimitiveObject* p = (const PyPrimitiveObject*)obj;
+    for (size_t i = begin; i < stack.top; i += kRegionChunkSlots - i % kRegionChunkSlots)
+    {
+        // 同一块中连续的一段槽位
+        size_t end = i - i % kRegionChunkSlots + kRegionChunkSlots;
+        if (end > stack.top) end = stack.top;
+        const PyPrimitiveObject* first = stack.slot(i);
+        if (p >= first && p < first + (end - i)) return true;
+    }
+    return false;
+}
+
+PyObject* py_region_promote(PyObject* obj)
+{
+    if (!py_region_contains(obj)) return obj;
+
+    PyPrimitiveObject* storage = (PyPrimitiveObject*)obj;
+    switch (obj->typeId)
+    {
+        case PY_TYPE_INT:
+            return py_create_int_from_mpz(storage->value.intValue);
+        case PY_TYPE_DOUBLE:
+            return py_create_double_from_mpf(storage->value.doubleValue);
+        case PY_TYPE_BOOL:
+            return py_create_bool(storage->value.boolValue);
+        default:
+            fprintf(stderr, "Error: Cannot promote region object of type %s\n", py_type_name(obj->typeId));
+            return obj;
+    }
+}
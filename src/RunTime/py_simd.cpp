@@ -0,0 +1,611 @@
+#include "RunTime/runtime.h"
+
+#include <cstdint>
+
+#if !defined(RUNTIME_DISABLE_SIMD) && (defined(__x86_64__) || defined(__i386__))
+#define PY_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+//===----------------------------------------------------------------------===//
+// 标量实现 (所有平台的兜底)
+//===----------------------------------------------------------------------===//
+
+static __int128 sum_i64_scalar(const int64_t* data, int n)
+{
+    __int128 total = 0;
+    for (int i = 0; i < n; i++) total += data[i];
+    return total;
+}
+
+template <bool IsMax>
+static int64_t minmax_i64_scalar(const int64_t* data, int n)
+{
+    int64_t best = data[0];
+    for (int i = 1; i < n; i++)
+    {
+        if (IsMax ? data[i] > best : data[i] < best) best = data[i];
+    }
+    return best;
+}
+
+template <bool IsMax>
+static double minmax_f64_scalar(const double* data, int n)
+{
+    double best = data[0];
+    for (int i = 1; i < n; i++)
+    {
+        if (IsMax ? data[i] > best : data[i] < best) best = data[i];
+    }
+    return best;
+}
+
+// WantAll == false: 是否存在非零元素; WantAll == true: 是否全部非零
+template <bool WantAll, typename T>
+static bool truth_scalar(const T* data, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if ((data[i] != 0) != WantAll) return !WantAll;
+    }
+    return WantAll;
+}
+
+// 逐元素 int64 运算，检测到溢出时返回 false
+static bool binop_i64_scalar(PySimdBinOp op, const int64_t* a, int strideA, const int64_t* b, int strideB, int64_t* out, int n)
+{
+    bool overflow = false;
+    for (int i = 0; i < n; i++)
+    {
+        int64_t x = a[i * strideA], y = b[i * strideB];
+        switch (op)
+        {
+            case PY_SIMD_ADD: overflow |= __builtin_add_overflow(x, y, &out[i]); break;
+            case PY_SIMD_SUB: overflow |= __builtin_sub_overflow(x, y, &out[i]); break;
+            case PY_SIMD_MUL: overflow |= __builtin_mul_overflow(x, y, &out[i]); break;
+            default: return false;
+        }
+    }
+    return !overflow;
+}
+
+static void binop_f64_scalar(PySimdBinOp op, const double* a, int strideA, const double* b, int strideB, double* out, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        double x = a[i * strideA], y = b[i * strideB];
+        switch (op)
+        {
+            case PY_SIMD_ADD: out[i] = x + y; break;
+            case PY_SIMD_SUB: out[i] = x - y; break;
+            case PY_SIMD_MUL: out[i] = x * y; break;
+            case PY_SIMD_DIV: out[i] = x / y; break;
+        }
+    }
+}
+
+// 第一个 a[i] != b[i] 的下标，全部相等时返回 n (double 按数值比较，0.0 == -0.0)
+template <typename T>
+static int mismatch_scalar(const T* a, const T* b, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if (a[i] != b[i]) return i;
+    }
+    return n;
+}
+
+#ifdef PY_SIMD_X86
+//===----------------------------------------------------------------------===//
+// SSE4.2 / AVX2 实现
+//===----------------------------------------------------------------------===//
+//
+// 整数求和把每个元素拆成高/低 32 位分别累加 (再统计负数个数修正符号)，
+// 各 lane 在 n < 2^31 时都不会溢出，合并后得到精确的 128 位结果。
+
+// 合并 lane 部分和: x = hi * 2^32 + lo - neg * 2^64
+static __int128 combine_split_sums(const uint64_t* lo, const uint64_t* hi, const uint64_t* neg, int lanes)
+{
+    __int128 total = 0;
+    for (int l = 0; l < lanes; l++)
+    {
+        total += ((__int128)hi[l] << 32) + (__int128)lo[l] - ((__int128)neg[l] << 64);
+    }
+    return total;
+}
+
+__attribute__((target("sse4.2"))) static __int128 sum_i64_sse42(const int64_t* data, int n)
+{
+    const __m128i lowMask = _mm_set1_epi64x(0xffffffffLL);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = zero, hi = zero, neg = zero;
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        lo = _mm_add_epi64(lo, _mm_and_si128(v, lowMask));
+        hi = _mm_add_epi64(hi, _mm_srli_epi64(v, 32));
+        neg = _mm_sub_epi64(neg, _mm_cmpgt_epi64(zero, v));  // 负数 lane 为 -1
+    }
+    uint64_t l[2], h[2], g[2];
+    _mm_storeu_si128((__m128i*)l, lo);
+    _mm_storeu_si128((__m128i*)h, hi);
+    _mm_storeu_si128((__m128i*)g, neg);
+    return combine_split_sums(l, h, g, 2) + sum_i64_scalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) static __int128 sum_i64_avx2(const int64_t* data, int n)
+{
+    const __m256i lowMask = _mm256_set1_epi64x(0xffffffffLL);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = zero, hi = zero, neg = zero;
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        lo = _mm256_add_epi64(lo, _mm256_and_si256(v, lowMask));
+        hi = _mm256_add_epi64(hi, _mm256_srli_epi64(v, 32));
+        neg = _mm256_sub_epi64(neg, _mm256_cmpgt_epi64(zero, v));
+    }
+    uint64_t l[4], h[4], g[4];
+    _mm256_storeu_si256((__m256i*)l, lo);
+    _mm256_storeu_si256((__m256i*)h, hi);
+    _mm256_storeu_si256((__m256i*)g, neg);
+    return combine_split_sums(l, h, g, 4) + sum_i64_scalar(data + i, n - i);
+}
+
+template <bool IsMax>
+__attribute__((target("sse4.2"))) static int64_t minmax_i64_sse42(const int64_t* data, int n)
+{
+    if (n < 2) return data[0];
+    __m128i best = _mm_loadu_si128((const __m128i*)data);
+    int i = 2;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i take = IsMax ? _mm_cmpgt_epi64(v, best) : _mm_cmpgt_epi64(best, v);
+        best = _mm_blendv_epi8(best, v, take);
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, best);
+    int64_t result = minmax_i64_scalar<IsMax>(lanes, 2);
+    for (; i < n; i++)
+    {
+        if (IsMax ? data[i] > result : data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+template <bool IsMax>
+__attribute__((target("avx2"))) static int64_t minmax_i64_avx2(const int64_t* data, int n)
+{
+    if (n < 4) return minmax_i64_scalar<IsMax>(data, n);
+    __m256i best = _mm256_loadu_si256((const __m256i*)data);
+    int i = 4;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i take = IsMax ? _mm256_cmpgt_epi64(v, best) : _mm256_cmpgt_epi64(best, v);
+        best = _mm256_blendv_epi8(best, v, take);
+    }
+    int64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, best);
+    int64_t result = minmax_i64_scalar<IsMax>(lanes, 4);
+    for (; i < n; i++)
+    {
+        if (IsMax ? data[i] > result : data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+// 列表中的 double 来自 GMP 浮点数，不会出现 NaN，min/max 的结果与顺序无关
+template <bool IsMax>
+__attribute__((target("sse4.2"))) static double minmax_f64_sse42(const double* data, int n)
+{
+    if (n < 2) return data[0];
+    __m128d best = _mm_loadu_pd(data);
+    int i = 2;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d v = _mm_loadu_pd(data + i);
+        best = IsMax ? _mm_max_pd(best, v) : _mm_min_pd(best, v);
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, best);
+    double result = minmax_f64_scalar<IsMax>(lanes, 2);
+    for (; i < n; i++)
+    {
+        if (IsMax ? data[i] > result : data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+template <bool IsMax>
+__attribute__((target("avx2"))) static double minmax_f64_avx2(const double* data, int n)
+{
+    if (n < 4) return minmax_f64_scalar<IsMax>(data, n);
+    __m256d best = _mm256_loadu_pd(data);
+    int i = 4;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d v = _mm256_loadu_pd(data + i);
+        best = IsMax ? _mm256_max_pd(best, v) : _mm256_min_pd(best, v);
+    }
+    double lanes[4];
+    _mm256_storeu_pd(lanes, best);
+    double result = minmax_f64_scalar<IsMax>(lanes, 4);
+    for (; i < n; i++)
+    {
+        if (IsMax ? data[i] > result : data[i] < result) result = data[i];
+    }
+    return result;
+}
+
+template <bool WantAll>
+__attribute__((target("sse4.2"))) static bool truth_i64_sse42(const int64_t* data, int n)
+{
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(data + i));
+        if (WantAll)
+        {
+            __m128i isZero = _mm_cmpeq_epi64(v, zero);
+            if (!_mm_testz_si128(isZero, isZero)) return false;
+        }
+        else if (!_mm_testz_si128(v, v))
+        {
+            return true;
+        }
+    }
+    return truth_scalar<WantAll>(data + i, n - i);
+}
+
+template <bool WantAll>
+__attribute__((target("avx2"))) static bool truth_i64_avx2(const int64_t* data, int n)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(data + i));
+        if (WantAll)
+        {
+            __m256i isZero = _mm256_cmpeq_epi64(v, zero);
+            if (!_mm256_testz_si256(isZero, isZero)) return false;
+        }
+        else if (!_mm256_testz_si256(v, v))
+        {
+            return true;
+        }
+    }
+    return truth_scalar<WantAll>(data + i, n - i);
+}
+
+template <bool WantAll>
+__attribute__((target("sse4.2"))) static bool truth_f64_sse42(const double* data, int n)
+{
+    const __m128d zero = _mm_setzero_pd();
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        int nonZero = _mm_movemask_pd(_mm_cmpneq_pd(_mm_loadu_pd(data + i), zero));
+        if (WantAll ? nonZero != 0x3 : nonZero != 0) return !WantAll;
+    }
+    return truth_scalar<WantAll>(data + i, n - i);
+}
+
+template <bool WantAll>
+__attribute__((target("avx2"))) static bool truth_f64_avx2(const double* data, int n)
+{
+    const __m256d zero = _mm256_setzero_pd();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        int nonZero = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(data + i), zero, _CMP_NEQ_UQ));
+        if (WantAll ? nonZero != 0xf : nonZero != 0) return !WantAll;
+    }
+    return truth_scalar<WantAll>(data + i, n - i);
+}
+
+// 逐元素加减: 有符号溢出当且仅当结果与两个 (减法为被减数与取反的减数) 操作数符号都不同
+__attribute__((target("sse4.2"))) static bool binop_i64_sse42(PySimdBinOp op, const int64_t* a, int strideA, const int64_t* b, int strideB, int64_t* out, int n)
+{
+    if (op == PY_SIMD_MUL) return binop_i64_scalar(op, a, strideA, b, strideB, out, n);
+
+    __m128i ovf = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i x = strideA ? _mm_loadu_si128((const __m128i*)(a + i)) : _mm_set1_epi64x(a[0]);
+        __m128i y = strideB ? _mm_loadu_si128((const __m128i*)(b + i)) : _mm_set1_epi64x(b[0]);
+        __m128i r;
+        if (op == PY_SIMD_ADD)
+        {
+            r = _mm_add_epi64(x, y);
+            ovf = _mm_or_si128(ovf, _mm_and_si128(_mm_xor_si128(x, r), _mm_xor_si128(y, r)));
+        }
+        else
+        {
+            r = _mm_sub_epi64(x, y);
+            ovf = _mm_or_si128(ovf, _mm_and_si128(_mm_xor_si128(x, y), _mm_xor_si128(x, r)));
+        }
+        _mm_storeu_si128((__m128i*)(out + i), r);
+    }
+    if (_mm_movemask_pd(_mm_castsi128_pd(ovf))) return false;
+    return binop_i64_scalar(op, a + i * strideA, strideA, b + i * strideB, strideB, out + i, n - i);
+}
+
+__attribute__((target("avx2"))) static bool binop_i64_avx2(PySimdBinOp op, const int64_t* a, int strideA, const int64_t* b, int strideB, int64_t* out, int n)
+{
+    if (op == PY_SIMD_MUL) return binop_i64_scalar(op, a, strideA, b, strideB, out, n);
+
+    __m256i ovf = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i x = strideA ? _mm256_loadu_si256((const __m256i*)(a + i)) : _mm256_set1_epi64x(a[0]);
+        __m256i y = strideB ? _mm256_loadu_si256((const __m256i*)(b + i)) : _mm256_set1_epi64x(b[0]);
+        __m256i r;
+        if (op == PY_SIMD_ADD)
+        {
+            r = _mm256_add_epi64(x, y);
+            ovf = _mm256_or_si256(ovf, _mm256_and_si256(_mm256_xor_si256(x, r), _mm256_xor_si256(y, r)));
+        }
+        else
+        {
+            r = _mm256_sub_epi64(x, y);
+            ovf = _mm256_or_si256(ovf, _mm256_and_si256(_mm256_xor_si256(x, y), _mm256_xor_si256(x, r)));
+        }
+        _mm256_storeu_si256((__m256i*)(out + i), r);
+    }
+    if (_mm256_movemask_pd(_mm256_castsi256_pd(ovf))) return false;
+    return binop_i64_scalar(op, a + i * strideA, strideA, b + i * strideB, strideB, out + i, n - i);
+}
+
+__attribute__((target("sse4.2"))) static void binop_f64_sse42(PySimdBinOp op, const double* a, int strideA, const double* b, int strideB, double* out, int n)
+{
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128d x = strideA ? _mm_loadu_pd(a + i) : _mm_set1_pd(a[0]);
+        __m128d y = strideB ? _mm_loadu_pd(b + i) : _mm_set1_pd(b[0]);
+        __m128d r;
+        switch (op)
+        {
+            case PY_SIMD_ADD: r = _mm_add_pd(x, y); break;
+            case PY_SIMD_SUB: r = _mm_sub_pd(x, y); break;
+            case PY_SIMD_MUL: r = _mm_mul_pd(x, y); break;
+            default: r = _mm_div_pd(x, y); break;
+        }
+        _mm_storeu_pd(out + i, r);
+    }
+    binop_f64_scalar(op, a + i * strideA, strideA, b + i * strideB, strideB, out + i, n - i);
+}
+
+__attribute__((target("avx2"))) static void binop_f64_avx2(PySimdBinOp op, const double* a, int strideA, const double* b, int strideB, double* out, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d x = strideA ? _mm256_loadu_pd(a + i) : _mm256_set1_pd(a[0]);
+        __m256d y = strideB ? _mm256_loadu_pd(b + i) : _mm256_set1_pd(b[0]);
+        __m256d r;
+        switch (op)
+        {
+            case PY_SIMD_ADD: r = _mm256_add_pd(x, y); break;
+            case PY_SIMD_SUB: r = _mm256_sub_pd(x, y); break;
+            case PY_SIMD_MUL: r = _mm256_mul_pd(x, y); break;
+            default: r = _mm256_div_pd(x, y); break;
+        }
+        _mm256_storeu_pd(out + i, r);
+    }
+    binop_f64_scalar(op, a + i * strideA, strideA, b + i * strideB, strideB, out + i, n - i);
+}
+
+// 逐块比较，遇到第一个不相等的块立即返回 (掩码中第一个为 0 的 lane 即不相等的元素)
+__attribute__((target("sse4.2"))) static int mismatch_i64_sse42(const int64_t* a, const int64_t* b, int n)
+{
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        __m128i eq = _mm_cmpeq_epi64(_mm_loadu_si128((const __m128i*)(a + i)), _mm_loadu_si128((const __m128i*)(b + i)));
+        int mask = _mm_movemask_pd(_mm_castsi128_pd(eq));
+        if (mask != 0x3) return i + __builtin_ctz(~mask);
+    }
+    return i + mismatch_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) static int mismatch_i64_avx2(const int64_t* a, const int64_t* b, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(a + i)), _mm256_loadu_si256((const __m256i*)(b + i)));
+        int mask = _mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        if (mask != 0xf) return i + __builtin_ctz(~mask);
+    }
+    return i + mismatch_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse4.2"))) static int mismatch_f64_sse42(const double* a, const double* b, int n)
+{
+    int i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        int mask = _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        if (mask != 0x3) return i + __builtin_ctz(~mask);
+    }
+    return i + mismatch_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) static int mismatch_f64_avx2(const double* a, const double* b, int n)
+{
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        int mask = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i), _CMP_EQ_OQ));
+        if (mask != 0xf) return i + __builtin_ctz(~mask);
+    }
+    return i + mismatch_scalar(a + i, b + i, n - i);
+}
+#endif  // PY_SIMD_X86
+
+//===----------------------------------------------------------------------===//
+// 运行时分派
+//===----------------------------------------------------------------------===//
+
+struct PySimdKernels
+{
+    const char* isa;
+    __int128 (*sum_i64)(const int64_t*, int);
+    int64_t (*min_i64)(const int64_t*, int);
+    int64_t (*max_i64)(const int64_t*, int);
+    double (*min_f64)(const double*, int);
+    double (*max_f64)(const double*, int);
+    bool (*any_i64)(const int64_t*, int);
+    bool (*all_i64)(const int64_t*, int);
+    bool (*any_f64)(const double*, int);
+    bool (*all_f64)(const double*, int);
+    bool (*binop_i64)(PySimdBinOp, const int64_t*, int, const int64_t*, int, int64_t*, int);
+    void (*binop_f64)(PySimdBinOp, const double*, int, const double*, int, double*, int);
+    int (*mismatch_i64)(const int64_t*, const int64_t*, int);
+    int (*mismatch_f64)(const double*, const double*, int);
+};
+
+static const PySimdKernels py_simd_scalar_kernels = {
+        "scalar",
+        sum_i64_scalar,
+        minmax_i64_scalar<false>,
+        minmax_i64_scalar<true>,
+        minmax_f64_scalar<false>,
+        minmax_f64_scalar<true>,
+        truth_scalar<false, int64_t>,
+        truth_scalar<true, int64_t>,
+        truth_scalar<false, double>,
+        truth_scalar<true, double>,
+        binop_i64_scalar,
+        binop_f64_scalar,
+        mismatch_scalar<int64_t>,
+        mismatch_scalar<double>};
+
+#ifdef PY_SIMD_X86
+static const PySimdKernels py_simd_sse42_kernels = {
+        "sse4.2",
+        sum_i64_sse42,
+        minmax_i64_sse42<false>,
+        minmax_i64_sse42<true>,
+        minmax_f64_sse42<false>,
+        minmax_f64_sse42<true>,
+        truth_i64_sse42<false>,
+        truth_i64_sse42<true>,
+        truth_f64_sse42<false>,
+        truth_f64_sse42<true>,
+        binop_i64_sse42,
+        binop_f64_sse42,
+        mismatch_i64_sse42,
+        mismatch_f64_sse42};
+
+static const PySimdKernels py_simd_avx2_kernels = {
+        "avx2",
+        sum_i64_avx2,
+        minmax_i64_avx2<false>,
+        minmax_i64_avx2<true>,
+        minmax_f64_avx2<false>,
+        minmax_f64_avx2<true>,
+        truth_i64_avx2<false>,
+        truth_i64_avx2<true>,
+        truth_f64_avx2<false>,
+        truth_f64_avx2<true>,
+        binop_i64_avx2,
+        binop_f64_avx2,
+        mismatch_i64_avx2,
+        mismatch_f64_avx2};
+#endif
+
+static const PySimdKernels* py_simd_select_kernels()
+{
+#ifdef PY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &py_simd_avx2_kernels;
+    if (__builtin_cpu_supports("sse4.2")) return &py_simd_sse42_kernels;
+#endif
+    return &py_simd_scalar_kernels;
+}
+
+static inline const PySimdKernels* py_simd_kernels()
+{
+    static const PySimdKernels* kernels = py_simd_select_kernels();
+    return kernels;
+}
+
+const char* py_simd_isa_name(void)
+{
+    return py_simd_kernels()->isa;
+}
+
+__int128 py_simd_sum_i64(const int64_t* data, int n)
+{
+    return n > 0 ? py_simd_kernels()->sum_i64(data, n) : 0;
+}
+
+int64_t py_simd_min_i64(const int64_t* data, int n)
+{
+    return py_simd_kernels()->min_i64(data, n);
+}
+
+int64_t py_simd_max_i64(const int64_t* data, int n)
+{
+    return py_simd_kernels()->max_i64(data, n);
+}
+
+double py_simd_min_f64(const double* data, int n)
+{
+    return py_simd_kernels()->min_f64(data, n);
+}
+
+double py_simd_max_f64(const double* data, int n)
+{
+    return py_simd_kernels()->max_f64(data, n);
+}
+
+bool py_simd_any_i64(const int64_t* data, int n)
+{
+    return py_simd_kernels()->any_i64(data, n);
+}
+
+bool py_simd_all_i64(const int64_t* data, int n)
+{
+    return py_simd_kernels()->all_i64(data, n);
+}
+
+bool py_simd_any_f64(const double* data, int n)
+{
+    return py_simd_kernels()->any_f64(data, n);
+}
+
+bool py_simd_all_f64(const double* data, int n)
+{
+    return py_simd_kernels()->all_f64(data, n);
+}
+
+bool py_simd_binop_i64(PySimdBinOp op, const int64_t* a, int strideA, const int64_t* b, int strideB, int64_t* out, int n)
+{
+    return py_simd_kernels()->binop_i64(op, a, strideA, b, strideB, out, n);
+}
+
+void py_simd_binop_f64(PySimdBinOp op, const double* a, int strideA, const double* b, int strideB, double* out, int n)
+{
+    py_simd_kernels()->binop_f64(op, a, strideA, b, strideB, out, n);
+}
+
+int py_simd_mismatch_i64(const int64_t* a, const int64_t* b, int n)
+{
+    return n > 0 ? py_simd_kernels()->mismatch_i64(a, b, n) : 0;
+}
+
+int py_simd_mismatch_f64(const double* a, const double* b, int n)
+{
+    return n > 0 ? py_simd_kernels()->mismatch_f64(a, b, n) : 0;
+}
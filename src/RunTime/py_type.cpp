@@ -192,8 +192,12 @@ const char* py_type_name(int typeId)
             return "any";
         case PY_TYPE_TUPLE:
             return "tuple";
+        case PY_TYPE_SET:
+            return "set";
         case PY_TYPE_FUNC:
             return "function";
+        case PY_TYPE_RANGE:
+            return "range";
         default:
             return "unknown";
     }
@@ -208,7 +212,7 @@ int py_get_base_type_id(int typeId)
 // 获取对象的类型ID
 int py_get_object_type_id(PyObject* obj)
 {
-    return obj ? obj->typeId : PY_TYPE_NONE;
+    return obj ? (int)obj->typeId : (int)PY_TYPE_NONE;
 }
 
 // 获取对象类型ID，考虑可能的指针解引用
@@ -303,7 +307,7 @@ bool py_is_container(PyObject* obj)
     int typeId = obj->typeId;
     int baseTypeId = getBaseTypeId(typeId);
 
-    return (baseTypeId == PY_TYPE_LIST || baseTypeId == PY_TYPE_DICT || baseTypeId == PY_TYPE_TUPLE || (typeId >= PY_TYPE_LIST_BASE && typeId < PY_TYPE_DICT_BASE) || (typeId >= PY_TYPE_DICT_BASE && typeId < PY_TYPE_FUNC_BASE));
+    return (baseTypeId == PY_TYPE_LIST || baseTypeId == PY_TYPE_DICT || baseTypeId == PY_TYPE_TUPLE || baseTypeId == PY_TYPE_SET || (typeId >= PY_TYPE_LIST_BASE && typeId < PY_TYPE_DICT_BASE) || (typeId >= PY_TYPE_DICT_BASE && typeId < PY_TYPE_FUNC_BASE));
 }
 
 // 检查对象是否为序列类型
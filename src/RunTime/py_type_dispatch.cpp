@@ -24,7 +24,7 @@ static const PyTypeMethods list_methods = {
         /*.getattr   =*/NULL,
         /*.setattr   =*/NULL,
         /*.hash      =*/NULL,  // Lists are unhashable
-        /*.equals    =*/NULL,  // TODO: Implement list comparison if needed
+        /*.equals    =*/py_list_equals,
 };
 
 static const PyTypeMethods dict_methods = {
@@ -34,7 +34,27 @@ static const PyTypeMethods dict_methods = {
         /*.getattr   =*/NULL,
         /*.setattr   =*/NULL,
         /*.hash      =*/NULL,  // Dicts are unhashable
-        /*.equals    =*/NULL,  // TODO: Implement dict comparison if needed
+        /*.equals    =*/py_dict_equals,
+};
+
+static const PyTypeMethods tuple_methods = {
+        /*.index_get =*/py_tuple_get_item,
+        /*.index_set =*/NULL,  // Tuples are immutable
+        /*.len       =*/py_tuple_len,
+        /*.getattr   =*/NULL,
+        /*.setattr   =*/NULL,
+        /*.hash      =*/py_tuple_hash,  // Cached after the first call
+        /*.equals    =*/py_tuple_equals,
+};
+
+static const PyTypeMethods set_methods = {
+        /*.index_get =*/NULL,  // Sets are not subscriptable
+        /*.index_set =*/NULL,
+        /*.len       =*/py_set_len,
+        /*.getattr   =*/NULL,
+        /*.setattr   =*/NULL,
+        /*.hash      =*/NULL,  // Sets are unhashable
+        /*.equals    =*/py_set_equals,
 };
 
 static const PyTypeMethods instance_methods = {
@@ -239,6 +259,8 @@ void py_initialize_builtin_type_methods()
     // 注册 List 和 Dict 的方法 (假设它们已定义并包含 index_set 等)
     py_register_type_methods(llvmpy::PY_TYPE_LIST, &list_methods);
     py_register_type_methods(llvmpy::PY_TYPE_DICT, &dict_methods);
+    py_register_type_methods(llvmpy::PY_TYPE_TUPLE, &tuple_methods);
+    py_register_type_methods(llvmpy::PY_TYPE_SET, &set_methods);
 
     initialize_static_gmp_bools();
     // 注意：List 和 Dict 应该是不可哈希的，所以它们的 hash 槽位应该是 NULL
@@ -543,20 +565,8 @@ static PyObject* py_list_index_get_handler(PyObject* container, PyObject* index)
         return NULL;  // Return NULL on error
     }
 
-    // Get Item and Incref
-    PyObject* item = list->data[int_index];
-    if (item)
-    {
-        py_incref(item);
-        return item;
-    }
-    else
-    {
-        // If item is somehow NULL, return None (incref'd)
-        PyObject* none_obj = py_get_none();
-        py_incref(none_obj);  // py_get_none might not incref
-        return none_obj;
-    }
+    // Get Item (new reference, None for an empty slot)
+    return py_list_box_item(list, (int)int_index);
 }
 
 static PyObject* _py_string_index_get_handler(PyObject* container, PyObject* index)
@@ -109,7 +109,13 @@ void TypeOperationRegistry::initializeBuiltinOperations()
     // Add comparison operators for list (usually identity or element-wise, handled by runtime)
     registerBinaryOp(TOK_EQ, PY_TYPE_LIST, PY_TYPE_LIST, PY_TYPE_BOOL, "py_object_compare", true);
     registerBinaryOp(TOK_NEQ, PY_TYPE_LIST, PY_TYPE_LIST, PY_TYPE_BOOL, "py_object_compare", true);
-    // LT, GT, LE, GE are generally not defined for lists in the same way as numbers/strings
+    // 列表按字典序比较，字典只比较相等 (运行时 py_container_compare)
+    registerBinaryOp(TOK_LT, PY_TYPE_LIST, PY_TYPE_LIST, PY_TYPE_BOOL, "py_object_compare", true);
+    registerBinaryOp(TOK_GT, PY_TYPE_LIST, PY_TYPE_LIST, PY_TYPE_BOOL, "py_object_compare", true);
+    registerBinaryOp(TOK_LE, PY_TYPE_LIST, PY_TYPE_LIST, PY_TYPE_BOOL, "py_object_compare", true);
+    registerBinaryOp(TOK_GE, PY_TYPE_LIST, PY_TYPE_LIST, PY_TYPE_BOOL, "py_object_compare", true);
+    registerBinaryOp(TOK_EQ, PY_TYPE_DICT, PY_TYPE_DICT, PY_TYPE_BOOL, "py_object_compare", true);
+    registerBinaryOp(TOK_NEQ, PY_TYPE_DICT, PY_TYPE_DICT, PY_TYPE_BOOL, "py_object_compare", true);
 
     // For TOK_EQ (==)
     registerBinaryOp(TOK_EQ, PY_TYPE_BOOL, PY_TYPE_BOOL, PY_TYPE_BOOL, "py_object_compare", true);
@@ -3,6 +3,8 @@
 #include "Debugdefine.h"
 
 extern int __llvmpy_entry();
+// Runtime memory stats / allocation profile (enabled by PYRT_MEMSTATS / PYRT_MEMPROF).
+extern void py_memstats_report(void);
 
 #ifdef RUNTIME_TIMER
 #include <stdio.h>
@@ -33,5 +35,7 @@ int main(int argc, char **argv) {
     printf("Execution time: %f seconds\n", time_spent);
 #endif
 
+    py_memstats_report();
+
     return exit_code;
 }
\ No newline at end of file
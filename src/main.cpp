@@ -4,6 +4,8 @@
 
 // 先包含完整代码生成器定义
 #include "CodeGen/codegen.h"  // 包含统一的头文件
+#include "CodeGen/RefCountElision.h"
+#include "CodeGen/StackPromotion.h"
 
 // 然后包含其他库
 #include <llvm/Support/raw_ostream.h>
@@ -133,6 +135,23 @@ int main(int argc, char** argv)
         return 1;
     }
 
+    // 引用计数消除: 抵消成对的 py_incref/py_decref，去掉永生对象的计数；
+    // 之后不逃逸的临时对象改为在栈上初始化 (被消除的计数不再算作逃逸)，
+    // 跨基本块存活的临时对象分配在函数作用域的区域中，返回时整体释放
+    llvm::legacy::FunctionPassManager refCountPasses(codegen.getModule());
+    refCountPasses.add(createRefCountElisionPass());
+    refCountPasses.add(createTempStackPromotionPass());
+    refCountPasses.add(createRegionAllocationPass());
+    refCountPasses.doInitialization();
+    for (auto& F : *codegen.getModule())
+    {
+        if (!F.isDeclaration())
+        {
+            refCountPasses.run(F);
+        }
+    }
+    refCountPasses.doFinalization();
+
     /*     // 优化LLVM IR (可选)
     llvm::legacy::FunctionPassManager passManager(codegen.getModule());
 
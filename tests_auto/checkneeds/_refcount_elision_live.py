@@ -0,0 +1,33 @@
+def rebind_back(a, b):
+    t = a
+    t = b
+    t = a
+    return t[0]
+
+def make_pair(n):
+    p = [n, n + 1]
+    q = p
+    return q
+
+def store_into(box, n):
+    t = [n, n * 2]
+    box[0] = t
+    t = None
+    return 0
+
+def main():
+    a = [1000, 1001]
+    b = [2000, 2001]
+    i = 0
+    while i < 50:
+        rebind_back(a, b)
+        i = i + 1
+    pair = make_pair(600)
+    box = [0]
+    store_into(box, 700)
+    kept = box[0]
+    if pair[1] != 601:
+        return 1
+    if kept[1] != 1400:
+        return 1
+    return 0
@@ -0,0 +1,137 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+# Test 1: Element-wise list equality (nested lists, strings, mixed lengths)
+def test_list_equality():
+    test_name = "test_list_equality"
+    a = [1, "two", [3, 4]]
+    b = [1, "two", [3, 4]]
+    c = [1, "two", [3, 5]]
+    passed = False
+    if a == b:
+        if a != c:
+            if not (a == [1, "two"]):
+                if [] == []:
+                    passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Lexicographic list ordering (first differing element, then length)
+def test_list_ordering():
+    test_name = "test_list_ordering"
+    passed = False
+    if [1, 2, 3] < [1, 2, 4]:
+        if [1, 2] < [1, 2, 0]:
+            if [2] > [1, 9, 9]:
+                if [1, 2] <= [1, 2]:
+                    if ["b", "a"] >= ["a", "z"]:
+                        passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Long int and float lists built by comprehensions (unboxed storage)
+def test_unboxed_list_compare():
+    test_name = "test_unboxed_list_compare"
+    a = [i * 3 for i in range(100)]
+    b = [i * 3 for i in range(100)]
+    c = [i * 3 for i in range(100)]
+    c[77] = 0
+    f = [i * 0.5 for i in range(40)]
+    g = [i * 0.5 for i in range(40)]
+    passed = False
+    if a == b:
+        if a != c:
+            if c < a:
+                if a > c:
+                    if f == g:
+                        if f <= g:
+                            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Tuple equality and ordering
+def test_tuple_compare():
+    test_name = "test_tuple_compare"
+    t = (1, 2)
+    passed = False
+    if t < (1, 3):
+        if (2, "a") > (1, "z"):
+            if t == (1, 2):
+                if (1, 2) <= (1, 2, 0):
+                    passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: Dict equality ignores insertion order and compares values
+def test_dict_equality():
+    test_name = "test_dict_equality"
+    d = {"a": 1, "b": [1, 2]}
+    e = {"b": [1, 2], "a": 1}
+    f = {"a": 1, "b": [1, 3]}
+    passed = False
+    if d == e:
+        if d != f:
+            if not (d == {"a": 1}):
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Container Comparison Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_list_equality()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_list_ordering()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_unboxed_list_compare()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_tuple_compare()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_equality()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
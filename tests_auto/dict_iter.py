@@ -0,0 +1,138 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+# Test 1: Iterating a dict yields its keys
+def test_dict_iter_keys():
+    test_name = "test_dict_iter_keys"
+    d = {"a": 1, "b": 2, "c": 3}
+    count = 0
+    total = 0
+    for k in d:
+        count = count + 1
+        total = total + d[k]
+    passed = False
+    if count == 3:
+        if total == 6:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: items() unpacked into key and value
+def test_dict_iter_items():
+    test_name = "test_dict_iter_items"
+    d = {}
+    i = 0
+    while i < 50:
+        d[i] = i * 2
+        i = i + 1
+    good = 0
+    for k, v in items(d):
+        if v == k * 2:
+            good = good + 1
+    passed = good == 50
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: values() and keys() views
+def test_dict_iter_views():
+    test_name = "test_dict_iter_views"
+    d = {1: 10, 2: 20, 3: 30}
+    vsum = 0
+    for v in values(d):
+        vsum = vsum + v
+    ksum = 0
+    for k in keys(d):
+        ksum = ksum + k
+    passed = False
+    if vsum == 60:
+        if ksum == 6:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Updating existing keys during iteration is allowed
+def test_dict_iter_update_values():
+    test_name = "test_dict_iter_update_values"
+    d = {"x": 1, "y": 2}
+    for k in d:
+        d[k] = d[k] * 10
+    passed = False
+    if d["x"] == 10:
+        if d["y"] == 20:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: Views returned from a function go through the iterator protocol
+def get_items(d):
+    return items(d)
+
+def test_dict_iter_generic():
+    test_name = "test_dict_iter_generic"
+    d = {"p": 3, "q": 4}
+    total = 0
+    for k, v in get_items(d):
+        total = total + v
+    passed = total == 7
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Dict Iterator Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_dict_iter_keys()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_iter_items()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_iter_views()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_iter_update_values()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_iter_generic()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
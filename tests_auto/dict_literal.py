@@ -0,0 +1,123 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+def make_config(level):
+    return {"name": "cfg", "level": level, "debug": False}
+
+def number_names():
+    return {1: "one", 2: "two", 3: "three", 4: "four", 5: "five", 6: "six", 7: "seven", 8: "eight", 9: "nine", 10: "ten"}
+
+# Test 1: Literal with computed values
+def test_dict_literal_values():
+    test_name = "test_dict_literal_values"
+    cfg = make_config(3)
+    passed = False
+    if cfg["level"] == 3:
+        if cfg["name"] == "cfg":
+            if len(cfg) == 3:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Large constant literal (built once, copied on every evaluation)
+def test_dict_constant_literal():
+    test_name = "test_dict_constant_literal"
+    first = number_names()
+    first[11] = "eleven"
+    first[1] = "uno"
+    second = number_names()
+    passed = False
+    if len(first) == 11:
+        if len(second) == 10:
+            if second[1] == "one":
+                if first[1] == "uno":
+                    if second[10] == "ten":
+                        passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Repeated keys keep the last value
+def test_dict_duplicate_keys():
+    test_name = "test_dict_duplicate_keys"
+    d = {"k": 1, "j": 2, "k": 3}
+    passed = False
+    if len(d) == 2:
+        if d["k"] == 3:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Updating a literal copy while iterating it leaves other copies untouched
+def test_dict_literal_copy_on_write():
+    test_name = "test_dict_literal_copy_on_write"
+    first = number_names()
+    second = number_names()
+    count = 0
+    for k in first:
+        first[k] = k * 2
+        count = count + 1
+    third = number_names()
+    passed = False
+    if count == 10:
+        if first[3] == 6:
+            if second[3] == "three":
+                if third[10] == "ten":
+                    passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Dict Literal Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_dict_literal_values()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_constant_literal()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_duplicate_keys()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_dict_literal_copy_on_write()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
@@ -314,6 +314,81 @@ def test_for_else_complex_break_continue():
     print_test_result(test_name, passed)
     return passed
 
+# Test 10: range() loops with start/stop/step, break and loop variable after the loop
+def test_for_range():
+    test_name = "test_for_range"
+    total = 0
+    for i in range(10):
+        total = total + i
+    down = 0
+    for i in range(10, 0, -3):
+        down = down + i
+    count = 0
+    for k in range(100):
+        if count == 5:
+            break
+        count = count + 1
+    else_executed = False
+    for k2 in range(3, 3):
+        count = count + 100
+    else:
+        else_executed = True
+    passed = False
+    if total == 45:
+        if down == 22:
+            if k == 5:
+                if count == 5:
+                    if else_executed:
+                        passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 11: range object stored in a variable and iterated twice
+def test_for_range_object():
+    test_name = "test_for_range_object"
+    r = range(1, 10, 2)
+    first = 0
+    for x in r:
+        first = first + x
+    second = 0
+    for x in r:
+        second = second + x
+    passed = False
+    if first == 25:
+        if second == 25:
+            if sum(range(101)) == 5050:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 12: Loop variable bindings: read-only use, escaping values, rebinding and empty ranges
+def test_for_range_bindings():
+    test_name = "test_for_range_bindings"
+    total = 0
+    for i in range(1000, 1010):
+        total = total + i % 7
+    kept = []
+    for j in range(1000, 1003):
+        kept = kept + [j]
+    shifted = 0
+    for m in range(2000, 2003):
+        m = m + 1
+        shifted = shifted + m
+    n = 7
+    for n in range(5, 5):
+        total = total + 1000000
+    passed = False
+    if total == 28:
+        if kept[0] == 1000:
+            if kept[2] == 1002:
+                if i == 1009:
+                    if shifted == 6006:
+                        if m == 2003:
+                            if n == 7:
+                                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
 # Main execution
 def main():
     print("--- Running For...Else Test Suite ---")
@@ -360,6 +435,18 @@ def main():
     results = results + [current_result]
     results_count = results_count + 1
 
+    current_result = test_for_range()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_for_range_object()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_for_range_bindings()
+    results = results + [current_result]
+    results_count = results_count + 1
+
     print("\n--- Test Summary ---")
     passed_count = 0
     idx = 0
@@ -0,0 +1,146 @@
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+def make_cycles(n):
+    i = 0
+    while i < n:
+        a = [0]
+        a[0] = a
+        d = {"k": 1}
+        d["self"] = d
+        b = [1, 2]
+        c = [b]
+        b[0] = c
+        i = i + 1
+    return n
+
+# Test 1: Explicit collection returns a count and leaves live data intact
+def test_collect_keeps_live_data():
+    test_name = "test_collect_keeps_live_data"
+    keep = [1, 2, 3]
+    node = {"name": "root"}
+    node["self"] = node
+    keep = keep + [node]
+    make_cycles(50)
+    freed = gc_collect()
+    passed = freed >= 0
+    if gc_collect(0) < 0:
+        passed = False
+    if len(keep) != 4:
+        passed = False
+    if keep[0] != 1:
+        passed = False
+    if keep[2] != 3:
+        passed = False
+    last = keep[3]
+    if last["name"] != "root":
+        passed = False
+    again = last["self"]
+    if again["name"] != "root":
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Automatic collection with a low threshold during allocation
+def test_threshold_collection():
+    test_name = "test_threshold_collection"
+    gc_set_threshold(5, 2, 2)
+    rows = []
+    i = 0
+    while i < 200:
+        rows = rows + [[i, (i, i + 1), {"v": i}]]
+        i = i + 1
+    make_cycles(200)
+    passed = len(rows) == 200
+    j = 0
+    while j < 200:
+        row = rows[j]
+        pair = row[1]
+        cell = row[2]
+        if row[0] != j:
+            passed = False
+        if pair[1] != j + 1:
+            passed = False
+        if cell["v"] != j:
+            passed = False
+        j = j + 1
+    gc_set_threshold(700)
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Nested containers referencing each other survive repeated full collections
+def test_repeated_full_collection():
+    test_name = "test_repeated_full_collection"
+    root = {"value": 0}
+    children = []
+    k = 1
+    while k < 20:
+        child = {"value": k, "parent": root}
+        children = children + [child]
+        root["children"] = children
+        gc_collect(2)
+        k = k + 1
+    total = 0
+    for child in root["children"]:
+        total = total + child["value"]
+    passed = False
+    if total == 190:
+        if len(root["children"]) == 19:
+            passed = True
+    sixth = root["children"][5]
+    parent = sixth["parent"]
+    if parent["value"] != 0:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Cycle Collector Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_collect_keeps_live_data()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_threshold_collection()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_repeated_full_collection()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
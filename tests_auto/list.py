@@ -0,0 +1,174 @@
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+# Test 1: Homogeneous int list, read back through index and iteration
+def test_list_int_storage():
+    test_name = "test_list_int_storage"
+    items = [1, 2, 3]
+    items[0] = 10
+    total = 0
+    for item in items:
+        total = total + item
+    passed = False
+    if total == 15:
+        if items[2] == 3:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Int too large for native storage falls back to boxed storage
+def test_list_int_overflow_fallback():
+    test_name = "test_list_int_overflow_fallback"
+    items = [1, 2, 3]
+    items[1] = 100000000000000000000000
+    passed = False
+    if items[1] == 100000000000000000000000:
+        if items[0] + items[2] == 4:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Float and bool lists
+def test_list_float_bool_storage():
+    test_name = "test_list_float_bool_storage"
+    floats = [1.5, 2.5]
+    floats[0] = 3.25
+    flags = [True, False, True]
+    flags[1] = True
+    count = 0
+    for flag in flags:
+        if flag:
+            count = count + 1
+    passed = False
+    if floats[0] + floats[1] == 5.75:
+        if count == 3:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Concatenation and repetition keep element values
+def test_list_concat_repeat():
+    test_name = "test_list_concat_repeat"
+    a = [1, 2] + [3]
+    b = a * 2
+    total = 0
+    for item in b:
+        total = total + item
+    passed = False
+    if total == 12:
+        if b[3] == 1:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: Builtin reductions over unboxed and boxed lists
+def test_list_builtin_reductions():
+    test_name = "test_list_builtin_reductions"
+    ints = [3, -7, 10, 2, 9223372036854775807, 9223372036854775807]
+    floats = [1.5, -2.25, 8.0]
+    flags = [True, False, True]
+    checks = 0
+    if sum(ints) == 18446744073709551622:
+        checks = checks + 1
+    if min(ints) == -7:
+        checks = checks + 1
+    if max(floats) == 8.0:
+        checks = checks + 1
+    if sum(flags) == 2:
+        checks = checks + 1
+    if any(flags):
+        checks = checks + 1
+    if not all(flags):
+        checks = checks + 1
+    if min(4, 2, 8) == 2:
+        checks = checks + 1
+    if max("abc") == "c":
+        checks = checks + 1
+    passed = checks == 8
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 6: Elementwise arithmetic builtins
+def test_list_elementwise():
+    test_name = "test_list_elementwise"
+    a = [1, 2, 3, 4, 5]
+    b = [10, 20, 30, 40, 50]
+    checks = 0
+    if sum(vec_add(a, b)) == 165:
+        checks = checks + 1
+    if vec_sub(b, 1)[4] == 49:
+        checks = checks + 1
+    if vec_div(b, a)[2] == 10.0:
+        checks = checks + 1
+    if vec_add([9223372036854775807], [1])[0] == 9223372036854775808:
+        checks = checks + 1
+    if vec_mul([1.5, 2.5], 2)[1] == 5.0:
+        checks = checks + 1
+    if vec_add([9223372036854775807], [0.5])[0] > 9223372036854775000.0:
+        checks = checks + 1
+    passed = checks == 6
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running List Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_list_int_storage()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_list_int_overflow_fallback()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_list_float_bool_storage()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_list_concat_repeat()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_list_builtin_reductions()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_list_elementwise()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
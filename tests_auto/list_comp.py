@@ -0,0 +1,117 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+def add_ten(x):
+    return x + 10
+
+# Test 1: Comprehension over range (native int elements, pre-sized output)
+def test_comp_range():
+    test_name = "test_comp_range"
+    squares = [i * i for i in range(8)]
+    total = 0
+    for v in squares:
+        total = total + v
+    passed = False
+    if squares[7] == 49:
+        if total == 140:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Filter clause and a list source
+def test_comp_filter():
+    test_name = "test_comp_filter"
+    src = [5, 1, 8, 3, 9]
+    big = [x * 2 for x in src if x > 4]
+    count = 0
+    for v in big:
+        count = count + 1
+    passed = False
+    if count == 3:
+        if big[0] == 10:
+            if big[2] == 18:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: The loop variable does not leak and overflow falls back to big ints
+def test_comp_scope_overflow():
+    test_name = "test_comp_scope_overflow"
+    i = 42
+    big = [i * 4611686018427387904 for i in range(3, 5)]
+    passed = False
+    if i == 42:
+        if big[1] == 18446744073709551616:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Calls, strings and nested comprehensions
+def test_comp_mixed():
+    test_name = "test_comp_mixed"
+    shifted = [add_ten(k) for k in range(0, 9, 4)]
+    letters = [c + "!" for c in "ab"]
+    grid = [[r * 3 + c for c in range(3)] for r in range(2)]
+    passed = False
+    if shifted[2] == 18:
+        if letters[1] == "b!":
+            if grid[1][2] == 5:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running List Comprehension Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_comp_range()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_comp_filter()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_comp_scope_overflow()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_comp_mixed()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
@@ -0,0 +1,137 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+# Test 1: len() of the built-in containers and strings
+def test_len_builtin():
+    test_name = "test_len_builtin"
+    d = {"a": 1, "b": 2}
+    passed = False
+    if len([1, 2, 3]) == 3:
+        if len("hello") == 5:
+            if len((1, 2)) == 2:
+                if len(d) == 2:
+                    if len([]) == 0:
+                        passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Indexing int, float and string lists (negative indices included)
+def test_list_index_storages():
+    test_name = "test_list_index_storages"
+    ints = [10, 20, 30]
+    floats = [1.5, 2.5]
+    words = ["x", "y", "z"]
+    k = 2
+    passed = False
+    if ints[k] == 30:
+        if floats[1] == 2.5:
+            if words[0] == "x":
+                if words[-1] == "z":
+                    if ints[-3] == 10:
+                        passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: while i < len(a) sums the list with the hoisted bounds check
+def test_while_len_loop():
+    test_name = "test_while_len_loop"
+    a = [3, 1, 4, 1, 5, 9, 2, 6]
+    total = 0
+    i = 0
+    while i < len(a):
+        total = total + a[i]
+        i = i + 1
+    passed = total == 31
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: The list grows inside the loop, so len(a) is re-read every iteration
+def test_while_len_growing():
+    test_name = "test_while_len_growing"
+    a = [1, 2]
+    i = 0
+    while i < len(a):
+        if a[i] < 5:
+            a = a + [a[i] + 2]
+        i = i + 1
+    passed = False
+    if len(a) == 6:
+        if a[5] == 6:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: Element type changes (int list becomes boxed) while indexing in the loop
+def test_while_len_mixed():
+    test_name = "test_while_len_mixed"
+    a = [1, 2, 3]
+    a[1] = "two"
+    seen = ""
+    i = 0
+    while i < len(a):
+        if a[i] == "two":
+            seen = "found"
+        i = i + 1
+    passed = seen == "found"
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running List Index Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_len_builtin()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_list_index_storages()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_while_len_loop()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_while_len_growing()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_while_len_mixed()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
@@ -0,0 +1,189 @@
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+# 赋值后立即改绑: incref(a) ... decref(a) 在同一直线区域内抵消
+def rebind_once(a, b):
+    t = a
+    t = b
+    return t[0]
+
+# 改绑后又绑回原对象: decref(a) 下沉到下一次 incref(a) 一起删除
+def rebind_back(a, b):
+    t = a
+    t = b
+    t = a
+    return t[0]
+
+# None 与小整数是永生对象，它们的 incref / decref 直接删除
+def immortal_values(n):
+    k = None
+    k = 5
+    m = k
+    m = 7
+    total = 0
+    i = 0
+    while i < n:
+        k = 3
+        total = total + k + m
+        i = i + 1
+    return total
+
+# 局部变量作为返回值: 赋值时的 incref 没有配对的 decref，不能删除
+def make_pair(n):
+    p = [n, n + 1]
+    q = p
+    return q
+
+# 局部变量写入调用方的容器后改绑: 容器持有的引用不能被抵消掉
+def store_into(box, n):
+    t = [n, n * 2]
+    box[0] = t
+    t = None
+    return 0
+
+# Test 1: incref / decref pairs on rebinding
+def test_rebind_pairs():
+    test_name = "test_rebind_pairs"
+    a = [1000, 1001]
+    b = [2000, 2001]
+    passed = True
+    i = 0
+    while i < 50:
+        if rebind_once(a, b) != 2000:
+            passed = False
+        i = i + 1
+    if a[0] != 1000:
+        passed = False
+    if b[1] != 2001:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: a sunk decref meets a later incref of the same object
+def test_sink_decref():
+    test_name = "test_sink_decref"
+    a = [3000, 3001]
+    b = [4000, 4001]
+    passed = True
+    i = 0
+    while i < 50:
+        if rebind_back(a, b) != 3000:
+            passed = False
+        i = i + 1
+    if a[1] != 3001:
+        passed = False
+    if b[0] != 4000:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: immortal objects
+def test_immortal_values():
+    test_name = "test_immortal_values"
+    passed = immortal_values(100) == 1000
+    if immortal_values(0) != 0:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: a returned value must keep its reference
+def test_returned_value():
+    test_name = "test_returned_value"
+    pairs = []
+    i = 0
+    while i < 20:
+        pairs = pairs + [make_pair(i + 600)]
+        i = i + 1
+    passed = len(pairs) == 20
+    i = 0
+    while i < 20:
+        p = pairs[i]
+        if p[0] != i + 600:
+            passed = False
+        if p[1] != i + 601:
+            passed = False
+        i = i + 1
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: a value stored into a container must keep its reference
+def test_stored_value():
+    test_name = "test_stored_value"
+    boxes = []
+    i = 0
+    while i < 20:
+        box = [0]
+        store_into(box, i + 700)
+        boxes = boxes + [box]
+        i = i + 1
+    passed = True
+    i = 0
+    while i < 20:
+        box = boxes[i]
+        t = box[0]
+        if t[0] != i + 700:
+            passed = False
+        if t[1] != (i + 700) * 2:
+            passed = False
+        i = i + 1
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Reference Count Elision Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_rebind_pairs()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_sink_decref()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_immortal_values()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_returned_value()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_stored_value()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
@@ -0,0 +1,145 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+def count_items(s):
+    n = 0
+    for x in s:
+        n = n + 1
+    return n
+
+# Test 1: Set literals remove duplicates and support membership tests
+def test_set_literal_membership():
+    test_name = "test_set_literal_membership"
+    s = {3, 1, 2, 3, 1}
+    passed = False
+    if count_items(s) == 3:
+        if 2 in s:
+            if 5 not in s:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: add and discard (discarding a missing element is not an error)
+def test_set_add_discard():
+    test_name = "test_set_add_discard"
+    s = set()
+    set_add(s, "a")
+    set_add(s, "b")
+    set_add(s, "a")
+    set_discard(s, "b")
+    set_discard(s, "zzz")
+    passed = False
+    if count_items(s) == 1:
+        if "a" in s:
+            if "b" not in s:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: union / intersection / difference
+def test_set_bulk_operations():
+    test_name = "test_set_bulk_operations"
+    a = {1, 2, 3, 4}
+    b = set([3, 4, 5])
+    passed = False
+    if set_union(a, b) == {1, 2, 3, 4, 5}:
+        if set_intersection(a, b) == {3, 4}:
+            if set_difference(a, b) == {1, 2}:
+                if set_difference(a, [1, 2, 3]) == {4}:
+                    passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Growing and shrinking a set keeps lookups correct
+def test_set_grow_shrink():
+    test_name = "test_set_grow_shrink"
+    s = set()
+    i = 0
+    while i < 1000:
+        set_add(s, i)
+        i = i + 1
+    i = 0
+    while i < 1000:
+        if i % 3 != 0:
+            set_discard(s, i)
+        i = i + 1
+    passed = False
+    if count_items(s) == 334:
+        if 999 in s:
+            if 998 not in s:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: Tuples as set elements
+def test_set_tuple_elements():
+    test_name = "test_set_tuple_elements"
+    seen = {(0, 0), (1, 2)}
+    set_add(seen, (1, 2))
+    passed = False
+    if count_items(seen) == 2:
+        if (1, 2) in seen:
+            if (2, 1) not in seen:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Set Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_set_literal_membership()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_set_add_discard()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_set_bulk_operations()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_set_grow_shrink()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_set_tuple_elements()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
@@ -0,0 +1,141 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+# Test 1: Basic list slices with omitted and negative bounds
+def test_list_slice_bounds():
+    test_name = "test_list_slice_bounds"
+    a = [10, 20, 30, 40, 50]
+    b = a[1:3]
+    c = a[:2]
+    d = a[-2:]
+    passed = False
+    if b[0] == 20:
+        if b[-1] == 30:
+            if c[-1] == 20:
+                if d[0] == 40:
+                    passed = True
+    for x in a[10:]:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Stepped and reversed slices
+def test_slice_step():
+    test_name = "test_slice_step"
+    a = [0, 1, 2, 3, 4, 5]
+    s = "abcdef"
+    passed = False
+    evens = a[::2]
+    rev = a[::-1]
+    if evens[1] == 2:
+        if rev[0] == 5:
+            if s[::-1] == "fedcba":
+                if s[1:5:2] == "bd":
+                    passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Writing to a slice does not change the original list
+def test_slice_write_view():
+    test_name = "test_slice_write_view"
+    a = [1, 2, 3, 4]
+    b = a[1:3]
+    b[0] = 99
+    passed = False
+    if a[1] == 2:
+        if b[0] == 99:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Writing to the original list does not change an existing slice
+def test_slice_write_parent():
+    test_name = "test_slice_write_parent"
+    a = ["x", "y", "z"]
+    b = a[0:2]
+    a[0] = "changed"
+    c = b[1:]
+    a[1] = "again"
+    passed = False
+    if b[1] == "y":
+        if c[0] == "y":
+            if a[0] == "changed":
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: String slices, including suffixes that share the buffer
+def test_string_slice():
+    test_name = "test_string_slice"
+    s = "hello world"
+    word = s[6:]
+    head = s[:5]
+    tail = word[1:]
+    passed = False
+    if word == "world":
+        if head == "hello":
+            if tail == "orld":
+                if s[3:3] == "":
+                    passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Slice Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_list_slice_bounds()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_slice_step()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_slice_write_view()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_slice_write_parent()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_string_slice()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
@@ -0,0 +1,103 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+def repeat_piece(piece, n):
+    s = ""
+    i = 0
+    while i < n:
+        s += piece
+        i = i + 1
+    return s
+
+# Test 1: Repeated concatenation in a loop
+def test_concat_loop():
+    test_name = "test_concat_loop"
+    s = repeat_piece("ab", 1000)
+    tail = s[1996:]
+    passed = False
+    if tail == "abab":
+        if s[0] == "a":
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Appending to one name does not change another name bound to the same string
+def test_concat_shared():
+    test_name = "test_concat_shared"
+    a = repeat_piece("x", 3)
+    b = a
+    a = a + "y"
+    b += "z"
+    passed = False
+    if a == "xxxy":
+        if b == "xxxz":
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Strings stored in containers keep their value
+def test_concat_container():
+    test_name = "test_concat_container"
+    s = "k"
+    s = s + "1"
+    items = [s]
+    s = s + "2"
+    s = s + s
+    passed = False
+    if items[0] == "k1":
+        if s == "k12k12":
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running String Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_concat_loop()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_concat_shared()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_concat_container()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
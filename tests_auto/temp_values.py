@@ -0,0 +1,155 @@
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+def square_sum(n):
+    total = 0
+    i = 0
+    while i < n:
+        total = total + i * i - 1
+        i = i + 1
+    return total
+
+# Test 1: Arithmetic temporaries inside loops
+def test_loop_temporaries():
+    test_name = "test_loop_temporaries"
+    passed = square_sum(5) == 25
+    big = 1
+    k = 0
+    while k < 70:
+        big = big * 2 + 0
+        k = k + 1
+    if big - 1180591620717411303424 != 0:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Comparison results used as conditions and stored
+def test_compare_temporaries():
+    test_name = "test_compare_temporaries"
+    a = 3
+    b = 4
+    passed = True
+    if not (a + 1 == b):
+        passed = False
+    flag = a * 2 > b
+    if not flag:
+        passed = False
+    if a - b >= 0:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Nested functions redefined on different branches
+def test_nested_redefinition():
+    test_name = "test_nested_redefinition"
+    def pick(n):
+        if n < 2:
+            def f(x):
+                return x
+        else:
+            def f(x):
+                return pick(x - 1) + pick(x - 2)
+        return f(n)
+    passed = pick(10) == 55
+    print_test_result(test_name, passed)
+    return passed
+
+def escape_on_branch(c):
+    x = 10
+    y = x + 5
+    if c:
+        return y
+    if y > 12:
+        return 1
+    return 0
+
+# Test 4: Values that outlive a basic block and escape only on some paths
+def test_branch_escape():
+    test_name = "test_branch_escape"
+    kept = escape_on_branch(True)
+    passed = escape_on_branch(False) == 1
+    other = escape_on_branch(True)
+    if kept + other != 30:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+def pass_through(v):
+    return v
+
+def escape_in_loop(n):
+    x = n + 1
+    s = 0
+    k = 0
+    while k < n:
+        s = s + pass_through(x)
+        k = k + 1
+    return s
+
+# Test 5: A value produced before a loop and escaping on every iteration
+def test_loop_escape():
+    test_name = "test_loop_escape"
+    passed = escape_in_loop(1000) == 1001000
+    if escape_in_loop(0) != 0:
+        passed = False
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Temporary Value Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_loop_temporaries()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_compare_temporaries()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_nested_redefinition()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_branch_escape()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_loop_escape()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
@@ -0,0 +1,144 @@
+
+# Helper to print test results
+def print_test_result(test_name, passed):
+    if passed:
+        print("\033[32mPASSED:\033[0m")
+        print(test_name)
+    else:
+        print("\033[31mFAILED:\033[0m")
+        print(test_name)
+
+def min_max(a, b):
+    if a < b:
+        return a, b
+    return b, a
+
+# Test 1: Tuple literals and indexing
+def test_tuple_literal_index():
+    test_name = "test_tuple_literal_index"
+    t = (10, "a", 2.5)
+    single = (7,)
+    passed = False
+    if t[0] == 10:
+        if t[1] == "a":
+            if t[-1] == 2.5:
+                if single[0] == 7:
+                    passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 2: Multiple return values unpacked into variables
+def test_tuple_multiple_return():
+    test_name = "test_tuple_multiple_return"
+    lo, hi = min_max(9, 4)
+    passed = False
+    if lo == 4:
+        if hi == 9:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 3: Swap without a temporary
+def test_tuple_swap():
+    test_name = "test_tuple_swap"
+    a = 1
+    b = 2
+    a, b = b, a
+    passed = False
+    if a == 2:
+        if b == 1:
+            passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 4: Iterating over a tuple
+def test_tuple_iteration():
+    test_name = "test_tuple_iteration"
+    total = 0
+    for x in (1, 2, 3, 4):
+        total = total + x
+    passed = total == 10
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 5: Equality and use as a dict key (hash)
+def test_tuple_equality_hash():
+    test_name = "test_tuple_equality_hash"
+    key = (1, "x")
+    d = {}
+    d[key] = 42
+    passed = False
+    if key == (1, "x"):
+        if key != (1, "y"):
+            if d[(1, "x")] == 42:
+                passed = True
+    print_test_result(test_name, passed)
+    return passed
+
+# Test 6: Unpacking in a loop (tuples are recycled through the freelist)
+def test_tuple_unpack_loop():
+    test_name = "test_tuple_unpack_loop"
+    total = 0
+    for i in range(100):
+        lo, hi = min_max(i, 50)
+        total = total + hi - lo
+    passed = total == 2500
+    print_test_result(test_name, passed)
+    return passed
+
+def main():
+    print("--- Running Tuple Test Suite ---")
+    results = []
+    results_count = 0
+
+    current_result = test_tuple_literal_index()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_tuple_multiple_return()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_tuple_swap()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_tuple_iteration()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_tuple_equality_hash()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    current_result = test_tuple_unpack_loop()
+    results = results + [current_result]
+    results_count = results_count + 1
+
+    passed_count = 0
+    idx = 0
+    while idx < results_count:
+        if results[idx]:
+            passed_count = passed_count + 1
+        idx = idx + 1
+
+    total_tests = results_count
+    failed_count = total_tests - passed_count
+
+    print("\033[32mTotal Passed: ")
+    print(passed_count)
+    print("/")
+    print(total_tests)
+    print("\033[0m")
+
+    if failed_count > 0:
+        print("\033[31mTotal Failed: ")
+        print(failed_count)
+        print("/")
+        print(total_tests)
+        print("\033[0m")
+        print("\033[31mSome tests failed.\033[0m")
+        return 1
+    else:
+        print("\033[32mAll tests passed successfully!\033[0m")
+        return 0
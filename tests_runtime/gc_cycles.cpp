@@ -0,0 +1,114 @@
+// 循环垃圾收集的运行时测试: 通过 C API 构造引用环，py_gc_collect 之后检查释放个数与存活对象数
+//
+// 构建: cmake -DLLVMPY_BUILD_RUNTIME_TESTS=ON ... && cmake --build . --target gc_cycles_test
+// 运行: ctest -R runtime_gc_cycles (或直接 ./gc_cycles_test)
+#include "RunTime/runtime.h"
+#include "TypeIDs.h"
+
+#include <cstdio>
+
+static int failures = 0;
+
+static void check(bool passed, const char* what)
+{
+    if (passed)
+    {
+        printf("\033[32mPASSED:\033[0m %s\n", what);
+    }
+    else
+    {
+        printf("\033[31mFAILED:\033[0m %s\n", what);
+        failures++;
+    }
+}
+
+// a = [a]
+static void make_self_list()
+{
+    PyObject* a = py_create_list(1, llvmpy::PY_TYPE_ANY);
+    py_list_append(a, a);
+    py_decref(a);
+}
+
+// d = {"self": d}
+static void make_self_dict()
+{
+    PyObject* d = py_create_dict(8, llvmpy::PY_TYPE_STRING);
+    PyObject* key = py_create_string("self");
+    py_dict_set_item(d, key, d);
+    py_decref(key);
+    py_decref(d);
+}
+
+// b = [c], c = [b]
+static void make_list_pair()
+{
+    PyObject* b = py_create_list(1, llvmpy::PY_TYPE_ANY);
+    PyObject* c = py_create_list(1, llvmpy::PY_TYPE_ANY);
+    py_list_append(b, c);
+    py_list_append(c, b);
+    py_decref(b);
+    py_decref(c);
+}
+
+int main()
+{
+    const int cycles = 100;
+    const int listsPerRound = 3;  // 自引用列表 1 个，互相引用的列表 2 个
+    const int dictsPerRound = 1;
+
+    py_runtime_initialize();
+    py_memstats_active = true;  // 只用于读取存活对象数，不打印报告
+    py_gc_set_threshold(0, 10, 10);  // 关闭自动收集，环只由下面的 py_gc_collect 回收
+
+    // 仍被外部引用的环: 收集后必须完好
+    PyObject* kept = py_create_list(2, llvmpy::PY_TYPE_ANY);
+    PyObject* value = py_create_int(12345);
+    py_list_append(kept, value);
+    py_list_append(kept, kept);
+    py_decref(value);
+
+    int64_t listsBefore = py_memstats_live_objects(llvmpy::PY_TYPE_LIST);
+    int64_t dictsBefore = py_memstats_live_objects(llvmpy::PY_TYPE_DICT);
+    for (int i = 0; i < cycles; i++)
+    {
+        make_self_list();
+        make_self_dict();
+        make_list_pair();
+    }
+    int64_t listsWithCycles = py_memstats_live_objects(llvmpy::PY_TYPE_LIST);
+    int64_t dictsWithCycles = py_memstats_live_objects(llvmpy::PY_TYPE_DICT);
+
+    int freed = py_gc_collect(PY_GC_GENERATIONS - 1);
+    int64_t listsAfter = py_memstats_live_objects(llvmpy::PY_TYPE_LIST);
+    int64_t dictsAfter = py_memstats_live_objects(llvmpy::PY_TYPE_DICT);
+
+    check(freed == cycles * (listsPerRound + dictsPerRound), "collect frees every unreachable container");
+#ifdef RUNTIME_MEMSTATS
+    check(listsWithCycles == listsBefore + cycles * listsPerRound, "cyclic lists are live before collection");
+    check(dictsWithCycles == dictsBefore + cycles * dictsPerRound, "cyclic dicts are live before collection");
+    check(listsAfter == listsBefore, "collection drops the live list count");
+    check(dictsAfter == dictsBefore, "collection drops the live dict count");
+#else
+    (void)listsWithCycles;
+    (void)dictsWithCycles;
+    (void)listsAfter;
+    (void)dictsAfter;
+    printf("runtime built without RUNTIME_MEMSTATS, live counts not checked\n");
+#endif
+
+    check(py_list_len(kept) == 2, "referenced cycle survives collection");
+    PyObject* index = py_create_int(0);
+    PyObject* item = py_list_get_item(kept, index);
+    check(item && item->typeId == llvmpy::PY_TYPE_INT && mpz_cmp_si(py_extract_int(item), 12345) == 0,
+          "referenced cycle keeps its elements");
+    py_decref(item);
+    py_decref(index);
+
+    check(py_gc_collect(PY_GC_GENERATIONS - 1) == 0, "second collection finds no garbage");
+
+    py_decref(kept);
+    check(py_gc_collect(PY_GC_GENERATIONS - 1) == 1, "dropped cycle is collected");
+
+    return failures > 0 ? 1 : 0;
+}